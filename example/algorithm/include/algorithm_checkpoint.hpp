@@ -0,0 +1,261 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_checkpoint.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_CHECKPOINT_HPP
+#define MCKL_EXAMPLE_ALGORITHM_CHECKPOINT_HPP
+
+#include <mckl/algorithm/mcmc.hpp>
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+template <mckl::MatrixLayout Layout>
+class AlgorithmCheckpointState : public mckl::StateMatrix<Layout, double>
+{
+  public:
+    using rng_set_type = mckl::RNGSetVector<>;
+
+    using mckl::StateMatrix<Layout, double>::StateMatrix;
+}; // class AlgorithmCheckpointState
+
+template <mckl::MatrixLayout Layout>
+inline void algorithm_checkpoint_smc_config(
+    mckl::SMCSampler<AlgorithmCheckpointState<Layout>> &sampler,
+    mckl::Vector<std::size_t> &iters)
+{
+    using T = AlgorithmCheckpointState<Layout>;
+
+    sampler.resample_threshold(0.5);
+    sampler.resample(mckl::Multinomial);
+    sampler.mutation([&iters](std::size_t iter, mckl::Particle<T> &particle) {
+        iters.push_back(iter);
+        mckl::NormalDistribution<double> normal(0, 1);
+        mckl::Vector<double> w(particle.size());
+        for (std::size_t i = 0; i != particle.size(); ++i) {
+            auto &rng = particle.rng(i);
+            for (std::size_t d = 0; d != particle.state().dim(); ++d)
+                particle.state()(i, d) += normal(rng);
+            w[i] = -0.5 * particle.state()(i, 0) * particle.state()(i, 0);
+        }
+        particle.weight().add_log(w.data());
+    });
+    sampler.mutation_estimator(mckl::SMCEstimator<T>(
+        sampler.particle().state().dim(),
+        [](std::size_t, std::size_t dim, mckl::Particle<T> &particle,
+            double *r) {
+            for (std::size_t i = 0; i != particle.size(); ++i)
+                for (std::size_t d = 0; d != dim; ++d)
+                    *r++ = particle.state()(i, d);
+        }));
+}
+
+template <mckl::MatrixLayout Layout>
+inline bool algorithm_checkpoint_smc(
+    std::size_t N, std::size_t dim, std::size_t n)
+{
+    using T = AlgorithmCheckpointState<Layout>;
+
+    const std::string filename("algorithm_checkpoint.ckpt");
+
+    mckl::Vector<std::size_t> iters1;
+    mckl::SMCSampler<T> sampler1(N, dim);
+    algorithm_checkpoint_smc_config<Layout>(sampler1, iters1);
+    sampler1.iterate(n);
+
+    mckl::StopWatch watch1;
+    watch1.start();
+    bool passed = sampler1.save(filename);
+    watch1.stop();
+
+    mckl::Vector<std::size_t> iters2;
+    mckl::SMCSampler<T> sampler2(N, dim);
+    algorithm_checkpoint_smc_config<Layout>(sampler2, iters2);
+    mckl::StopWatch watch2;
+    watch2.start();
+    passed = passed && sampler2.load(filename);
+    watch2.stop();
+
+    sampler1.iterate(n);
+    sampler2.iterate(n);
+
+    passed = passed && sampler1.num_iter() == sampler2.num_iter();
+    passed = passed && iters2.size() == n &&
+        std::equal(iters2.begin(), iters2.end(), iters1.end() - n);
+    passed = passed &&
+        sampler1.particle().state() == sampler2.particle().state();
+    passed = passed &&
+        sampler1.particle().weight() == sampler2.particle().weight();
+    passed = passed &&
+        sampler1.template summary<double, mckl::RowMajor>() ==
+            sampler2.template summary<double, mckl::RowMajor>();
+
+    const std::size_t bytes = N * dim * sizeof(double);
+    std::cout << std::setw(60) << std::left << "SMCSampler save (MB/s)"
+              << std::setw(20) << std::right << std::fixed
+              << 1e-6 * bytes / watch1.seconds() << std::endl;
+    std::cout << std::setw(60) << std::left << "SMCSampler load (MB/s)"
+              << std::setw(20) << std::right << std::fixed
+              << 1e-6 * bytes / watch2.seconds() << std::endl;
+
+    return passed;
+}
+
+inline void algorithm_checkpoint_mcmc_config(
+    mckl::MCMCSampler<mckl::Vector<double>> &sampler, mckl::RNG &rng,
+    mckl::Vector<std::size_t> &iters)
+{
+    sampler.mutation([&](std::size_t iter, mckl::Vector<double> &x) {
+        iters.push_back(iter);
+        mckl::NormalDistribution<double> normal(0, 1);
+        std::size_t acc = 0;
+        for (auto &v : x) {
+            const double y = v + normal(rng);
+            if (std::abs(y) < std::abs(v) + 0.5) {
+                v = y;
+                ++acc;
+            }
+        }
+        return acc;
+    });
+    sampler.estimator(mckl::MCMCEstimator<mckl::Vector<double>>(2,
+        [](std::size_t iter, std::size_t, mckl::Vector<double> &x,
+            double *r) {
+            r[0] = std::accumulate(x.begin(), x.end(), 0.0);
+            r[1] = static_cast<double>(iter);
+        }));
+}
+
+inline bool algorithm_checkpoint_mcmc(std::size_t dim, std::size_t n)
+{
+    const std::string filename("algorithm_checkpoint.ckpt");
+
+    mckl::RNG rng1;
+    mckl::Vector<std::size_t> iters1;
+    mckl::MCMCSampler<mckl::Vector<double>> sampler1(dim, 0.0);
+    algorithm_checkpoint_mcmc_config(sampler1, rng1, iters1);
+    sampler1.callback(
+        mckl::SamplerCheckpoint<mckl::MCMCSampler<mckl::Vector<double>>>(
+            filename));
+    bool passed = mckl::checkpoint_signal(SIGINT);
+    sampler1.iterate(n - 1);
+    std::raise(SIGINT);
+    sampler1.iterate(1);
+    sampler1.callback(0) = [](std::size_t,
+                               mckl::MCMCSampler<mckl::Vector<double>> &) {};
+
+    mckl::RNG rng2(rng1);
+    mckl::Vector<std::size_t> iters2;
+    mckl::MCMCSampler<mckl::Vector<double>> sampler2;
+    algorithm_checkpoint_mcmc_config(sampler2, rng2, iters2);
+    passed = passed && sampler2.load(filename);
+
+    sampler1.iterate(n);
+    sampler2.iterate(n);
+
+    mckl::Vector<std::size_t> acc1(sampler1.num_iter());
+    mckl::Vector<std::size_t> acc2(sampler2.num_iter());
+    sampler1.read_accept_history(0, acc1.data());
+    sampler2.read_accept_history(0, acc2.data());
+
+    passed = passed && sampler1.state() == sampler2.state();
+    passed = passed && acc1 == acc2;
+    passed = passed && iters2.size() == n &&
+        std::equal(iters2.begin(), iters2.end(), iters1.end() - n);
+    passed = passed &&
+        sampler1.summary<double, mckl::RowMajor>() ==
+            sampler2.summary<double, mckl::RowMajor>();
+
+    sampler1.clear_estimate();
+    sampler1.iterate(2);
+    const auto rmat = sampler1.summary<double, mckl::RowMajor>();
+    const auto cmat = sampler1.summary<double, mckl::ColMajor>();
+    passed = passed && rmat.nrow() == 2 && cmat.nrow() == 2;
+    passed = passed && rmat(1, 0) == cmat(1, 0);
+
+    return passed;
+}
+
+// Load truncated copies of a checkpoint, which shall either fail or throw
+inline bool algorithm_checkpoint_corrupt(std::size_t dim, std::size_t n)
+{
+    const std::string filename("algorithm_checkpoint.ckpt");
+    const std::string corrupt("algorithm_checkpoint_corrupt.ckpt");
+
+    mckl::RNG rng;
+    mckl::Vector<std::size_t> iters;
+    mckl::MCMCSampler<mckl::Vector<double>> sampler1(dim, 0.0);
+    algorithm_checkpoint_mcmc_config(sampler1, rng, iters);
+    sampler1.iterate(n);
+    bool passed = sampler1.save(filename);
+
+    std::ifstream is(filename, std::ios_base::binary);
+    std::string data((std::istreambuf_iterator<char>(is)),
+        std::istreambuf_iterator<char>());
+    is.close();
+
+    const std::size_t a = mckl::CheckpointWriter::alignment();
+    for (std::size_t k : {a / 2, data.size() / 2, data.size() - a}) {
+        std::ofstream os(corrupt, std::ios_base::binary);
+        os.write(data.data(), static_cast<std::streamsize>(k));
+        os.close();
+
+        mckl::MCMCSampler<mckl::Vector<double>> sampler2;
+        algorithm_checkpoint_mcmc_config(sampler2, rng, iters);
+        try {
+            passed = passed && !sampler2.load(corrupt);
+        } catch (const std::runtime_error &) {
+        }
+    }
+    std::remove(corrupt.c_str());
+
+    return passed;
+}
+
+inline void algorithm_checkpoint(std::size_t N, std::size_t dim, std::size_t n)
+{
+    std::cout << std::string(80, '=') << std::endl;
+
+    bool passed = true;
+    passed = passed && algorithm_checkpoint_smc<mckl::RowMajor>(N, dim, n);
+    passed = passed && algorithm_checkpoint_smc<mckl::ColMajor>(N, dim, n);
+    passed = passed && algorithm_checkpoint_mcmc(dim, n);
+    passed = passed && algorithm_checkpoint_corrupt(dim, n);
+
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(60) << std::left << "Test result" << std::setw(20)
+              << std::right << std::fixed << (passed ? "Passed" : "Failed")
+              << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_CHECKPOINT_HPP
@@ -0,0 +1,247 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_ensemble.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_ENSEMBLE_HPP
+#define MCKL_EXAMPLE_ALGORITHM_ENSEMBLE_HPP
+
+#include <mckl/algorithm/ensemble.hpp>
+#include <mckl/algorithm/mcmc.hpp>
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+class AlgorithmEnsemble : public mckl::StateMatrix<mckl::RowMajor, double, 1>
+{
+  public:
+    using rng_set_type = mckl::RNGSetVector<>;
+
+    using mckl::StateMatrix<mckl::RowMajor, double, 1>::StateMatrix;
+}; // class AlgorithmEnsemble
+
+class AlgorithmEnsembleSelection
+    : public mckl::SMCSamplerEvalSEQ<AlgorithmEnsemble,
+          AlgorithmEnsembleSelection>
+{
+  public:
+    void eval_first(std::size_t, mckl::Particle<AlgorithmEnsemble> &particle)
+    {
+        w_.resize(particle.size());
+    }
+
+    void eval_each(std::size_t, mckl::ParticleIndex<AlgorithmEnsemble> idx)
+    {
+        w_[idx.i()] = -0.5 * idx(0) * idx(0);
+    }
+
+    void eval_last(std::size_t, mckl::Particle<AlgorithmEnsemble> &particle)
+    {
+        particle.weight().add_log(w_.data());
+    }
+
+  private:
+    mckl::Vector<double> w_;
+}; // class AlgorithmEnsembleSelection
+
+class AlgorithmEnsembleMutation
+    : public mckl::SMCSamplerEvalSEQ<AlgorithmEnsemble,
+          AlgorithmEnsembleMutation>
+{
+  public:
+    void eval_each(std::size_t, mckl::ParticleIndex<AlgorithmEnsemble> idx)
+    {
+        mckl::NormalDistribution<double> normal(0, 1);
+        mckl::U01Distribution<double> u01;
+        auto &rng = idx.rng();
+        const double y = idx(0) + normal(rng);
+        const double r = 0.5 * (idx(0) * idx(0) - y * y);
+        if (std::log(u01(rng)) < r) {
+            idx(0) = y;
+        }
+    }
+}; // class AlgorithmEnsembleMutation
+
+// Random walk Metropolis for the standard Normal distribution
+class AlgorithmEnsembleMCMC
+{
+  public:
+    AlgorithmEnsembleMCMC()
+    {
+        rng_.seed(mckl::Seed<mckl::RNG>::instance().get());
+    }
+
+    std::size_t operator()(std::size_t, double &x)
+    {
+        mckl::NormalDistribution<double> normal(0, 1);
+        mckl::U01Distribution<double> u01;
+        const double y = x + normal(rng_);
+        if (std::log(u01(rng_)) < 0.5 * (x * x - y * y)) {
+            x = y;
+            return 1;
+        }
+
+        return 0;
+    }
+
+  private:
+    mckl::RNG rng_;
+}; // class AlgorithmEnsembleMCMC
+
+inline bool algorithm_ensemble_check(const std::string &name, bool passed)
+{
+    std::cout << std::setw(60) << std::left << name << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+
+    return passed;
+}
+
+inline void algorithm_ensemble_time(const std::string &name, double ms)
+{
+    std::cout << std::setw(60) << std::left << name << std::setw(20)
+              << std::right << ms << std::endl;
+}
+
+template <typename Backend>
+inline bool algorithm_ensemble_smc(std::size_t N, std::size_t n,
+    std::size_t m, const std::string &name)
+{
+    using T = AlgorithmEnsemble;
+    using ensemble_type = mckl::Ensemble<mckl::SMCSampler<T>, Backend>;
+
+    // Samplers of different sizes
+    ensemble_type ensemble;
+    for (std::size_t i = 0; i != m; ++i) {
+        mckl::SMCSampler<T> sampler(N * (1 + i % 4));
+        std::fill_n(sampler.particle().state().data(), sampler.size(), 0.0);
+        sampler.selection(AlgorithmEnsembleSelection());
+        sampler.resample(mckl::Systematic);
+        sampler.resample_threshold(0.5);
+        sampler.mutation(AlgorithmEnsembleMutation());
+        ensemble.push_back(std::move(sampler));
+    }
+
+    ensemble_type reference(ensemble);
+    mckl::StopWatch watch1;
+    watch1.start();
+    for (auto &sampler : reference) {
+        sampler.iterate(n);
+    }
+    watch1.stop();
+
+    mckl::StopWatch watch2;
+    watch2.start();
+    ensemble.iterate(n);
+    watch2.stop();
+
+    bool same = ensemble.size() == reference.size();
+    bool distinct = true;
+    for (std::size_t i = 0; i != ensemble.size(); ++i) {
+        same = same &&
+            ensemble[i].particle().state() == reference[i].particle().state();
+        same = same && ensemble[i].num_iter() == n;
+        if (i >= 4) {
+            distinct = distinct &&
+                !(ensemble[i].particle().state() ==
+                    ensemble[i - 4].particle().state());
+        }
+    }
+
+    bool passed = true;
+    passed =
+        algorithm_ensemble_check(name + " SMC Same as sequential", same) &&
+        passed;
+    passed =
+        algorithm_ensemble_check(name + " SMC Distinct streams", distinct) &&
+        passed;
+    algorithm_ensemble_time(
+        name + " SMC Sequential (ms)", watch1.milliseconds());
+    algorithm_ensemble_time(
+        name + " SMC Ensemble (ms)", watch2.milliseconds());
+
+    return passed;
+}
+
+template <typename Backend>
+inline bool algorithm_ensemble_mcmc(
+    std::size_t n, std::size_t m, const std::string &name)
+{
+    using ensemble_type = mckl::Ensemble<mckl::MCMCSampler<double>, Backend>;
+
+    ensemble_type ensemble(0, mckl::MCMCSampler<double>(0.0), 4);
+    for (std::size_t i = 0; i != m; ++i) {
+        ensemble.emplace_back(0.0);
+        ensemble[i].mutation(AlgorithmEnsembleMCMC());
+    }
+
+    ensemble_type reference(ensemble);
+    for (auto &sampler : reference) {
+        sampler.iterate(n);
+    }
+    ensemble.iterate(n);
+
+    bool same = ensemble.size() == m;
+    for (std::size_t i = 0; i != ensemble.size(); ++i) {
+        same = same && ensemble[i].state() == reference[i].state();
+        same = same && ensemble[i].num_iter() == n;
+    }
+
+    return algorithm_ensemble_check(name + " MCMC Same as sequential", same);
+}
+
+template <typename Backend>
+inline bool algorithm_ensemble(std::size_t N, std::size_t n, std::size_t m,
+    const std::string &name)
+{
+    bool passed = true;
+    passed = algorithm_ensemble_smc<Backend>(N, n, m, name) && passed;
+    passed = algorithm_ensemble_mcmc<Backend>(n * N, m, name) && passed;
+
+    return passed;
+}
+
+inline void algorithm_ensemble(std::size_t N, std::size_t n, std::size_t m)
+{
+    bool passed = true;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::string(80, '=') << std::endl;
+    passed = algorithm_ensemble<mckl::BackendSEQ>(N, n, m, "SEQ") && passed;
+    passed = algorithm_ensemble<mckl::BackendSTD>(N, n, m, "STD") && passed;
+    passed = algorithm_ensemble<mckl::BackendOMP>(N, n, m, "OMP") && passed;
+#if MCKL_HAS_TBB
+    passed = algorithm_ensemble<mckl::BackendTBB>(N, n, m, "TBB") && passed;
+#endif
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(60) << std::left << "Test result" << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_ENSEMBLE_HPP
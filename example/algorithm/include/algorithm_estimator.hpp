@@ -0,0 +1,239 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_estimator.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_ESTIMATOR_HPP
+#define MCKL_EXAMPLE_ALGORITHM_ESTIMATOR_HPP
+
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/smp.hpp>
+
+class AlgorithmEstimator : public mckl::StateMatrix<mckl::RowMajor, double, 1>
+{
+  public:
+    using rng_set_type = mckl::RNGSetVector<>;
+
+    using mckl::StateMatrix<mckl::RowMajor, double, 1>::StateMatrix;
+}; // class AlgorithmEstimator
+
+template <typename Backend>
+class AlgorithmEstimatorSelection
+    : public mckl::SMCSamplerEvalSMP<AlgorithmEstimator,
+          AlgorithmEstimatorSelection<Backend>, Backend>
+{
+  public:
+    void eval_first(std::size_t, mckl::Particle<AlgorithmEstimator> &particle)
+    {
+        w_.resize(particle.size());
+    }
+
+    void eval_range(
+        std::size_t, const mckl::ParticleRange<AlgorithmEstimator> &range)
+    {
+        for (auto idx : range) {
+            w_[idx.i()] = -0.5 * idx(0) * idx(0);
+        }
+    }
+
+    void eval_last(std::size_t, mckl::Particle<AlgorithmEstimator> &particle)
+    {
+        particle.weight().add_log(w_.data());
+    }
+
+  private:
+    mckl::Vector<double> w_;
+}; // class AlgorithmEstimatorSelection
+
+template <typename Backend>
+class AlgorithmEstimatorMutation
+    : public mckl::SMCSamplerEvalSMP<AlgorithmEstimator,
+          AlgorithmEstimatorMutation<Backend>, Backend>
+{
+  public:
+    void eval_range(
+        std::size_t, const mckl::ParticleRange<AlgorithmEstimator> &range)
+    {
+        mckl::NormalDistribution<double> normal(0, 1);
+        mckl::U01Distribution<double> u01;
+        for (auto idx : range) {
+            auto &rng = idx.rng();
+            const double y = idx(0) + normal(rng);
+            const double r = 0.5 * (idx(0) * idx(0) - y * y);
+            if (std::log(u01(rng)) < r) {
+                idx(0) = y;
+            }
+        }
+    }
+}; // class AlgorithmEstimatorMutation
+
+// Estimate the k-th moment
+template <typename Backend>
+class AlgorithmEstimatorMoment
+    : public mckl::SMCEstimatorEvalSMP<AlgorithmEstimator,
+          AlgorithmEstimatorMoment<Backend>, Backend>
+{
+  public:
+    explicit AlgorithmEstimatorMoment(int k = 1) : k_(k) {}
+
+    void eval_each(std::size_t, std::size_t,
+        mckl::ParticleIndex<AlgorithmEstimator> idx, double *r)
+    {
+        r[0] = std::pow(idx(0), k_);
+    }
+
+  private:
+    int k_;
+}; // class AlgorithmEstimatorMoment
+
+inline bool algorithm_estimator_check(const std::string &name, bool passed)
+{
+    std::cout << std::setw(60) << std::left << name << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+
+    return passed;
+}
+
+template <typename Backend>
+inline mckl::SMCSampler<AlgorithmEstimator> algorithm_estimator_sampler(
+    const mckl::SMCSampler<AlgorithmEstimator> &base, std::size_t m)
+{
+    using T = AlgorithmEstimator;
+
+    mckl::SMCSampler<T> sampler(base);
+    sampler.selection(AlgorithmEstimatorSelection<Backend>());
+    sampler.resample(mckl::Systematic);
+    sampler.resample_threshold(0.5);
+    sampler.mutation(AlgorithmEstimatorMutation<Backend>());
+    for (std::size_t k = 0; k != m; ++k) {
+        sampler.selection_estimator(mckl::SMCEstimator<T>(1,
+            AlgorithmEstimatorMoment<Backend>(static_cast<int>(k + 1))));
+        sampler.mutation_estimator(mckl::SMCEstimator<T>(1,
+            AlgorithmEstimatorMoment<Backend>(static_cast<int>(k + 1))));
+    }
+
+    return sampler;
+}
+
+inline bool algorithm_estimator_same(
+    const mckl::SMCSampler<AlgorithmEstimator> &sampler,
+    const mckl::SMCSampler<AlgorithmEstimator> &reference, std::size_t m)
+{
+    bool same = sampler.particle().state() == reference.particle().state();
+    for (std::size_t k = 0; k != m; ++k) {
+        using matrix_type = mckl::Matrix<double, mckl::RowMajor>;
+        same = same &&
+            static_cast<const matrix_type &>(sampler.selection_estimator(k)) ==
+                static_cast<const matrix_type &>(
+                    reference.selection_estimator(k));
+        same = same &&
+            static_cast<const matrix_type &>(sampler.mutation_estimator(k)) ==
+                static_cast<const matrix_type &>(
+                    reference.mutation_estimator(k));
+    }
+
+    return same;
+}
+
+template <typename Backend>
+inline bool algorithm_estimator(
+    std::size_t N, std::size_t n, std::size_t m, const std::string &name)
+{
+    using T = AlgorithmEstimator;
+
+    const mckl::SMCSampler<T> base(N);
+
+    auto reference = algorithm_estimator_sampler<Backend>(base, m);
+    mckl::StopWatch watch1;
+    watch1.start();
+    reference.iterate(n);
+    watch1.stop();
+
+    auto sampler = algorithm_estimator_sampler<Backend>(base, m);
+    sampler.estimator_for_each(mckl::SMPForEach<Backend>());
+    mckl::StopWatch watch2;
+    watch2.start();
+    sampler.iterate(n);
+    watch2.stop();
+
+    auto profiled = algorithm_estimator_sampler<Backend>(base, m);
+    profiled.estimator_for_each(mckl::SMPForEach<Backend>());
+    profiled.profile().enable(n);
+    profiled.iterate(n);
+    bool profile = profiled.profile().size() == n;
+    for (std::size_t i = 0; i != profiled.profile().size(); ++i) {
+        const auto &record = profiled.profile()[i];
+        profile = profile && record.estimator_ns[0].size() == m &&
+            record.estimator_ns[1].size() == 0 &&
+            record.estimator_ns[2].size() == m;
+        for (std::size_t s = 0; s != 3; ++s) {
+            for (double t : record.estimator_ns[s]) {
+                profile = profile && t > 0 && t <= record.step_ns[s];
+            }
+        }
+    }
+
+    bool passed = true;
+    passed = algorithm_estimator_check(name + " Same as sequential",
+                 algorithm_estimator_same(sampler, reference, m)) &&
+        passed;
+    passed = algorithm_estimator_check(name + " Profiled",
+                 profile &&
+                     algorithm_estimator_same(profiled, reference, m)) &&
+        passed;
+    std::cout << std::setw(60) << std::left << name + " Sequential (ms)"
+              << std::setw(20) << std::right << watch1.milliseconds()
+              << std::endl;
+    std::cout << std::setw(60) << std::left << name + " Concurrent (ms)"
+              << std::setw(20) << std::right << watch2.milliseconds()
+              << std::endl;
+
+    return passed;
+}
+
+inline void algorithm_estimator(std::size_t N, std::size_t n, std::size_t m)
+{
+    bool passed = true;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::string(80, '=') << std::endl;
+    passed = algorithm_estimator<mckl::BackendSEQ>(N, n, m, "SEQ") && passed;
+    passed = algorithm_estimator<mckl::BackendSTD>(N, n, m, "STD") && passed;
+    passed = algorithm_estimator<mckl::BackendOMP>(N, n, m, "OMP") && passed;
+#if MCKL_HAS_TBB
+    passed = algorithm_estimator<mckl::BackendTBB>(N, n, m, "TBB") && passed;
+#endif
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(60) << std::left << "Test result" << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_ESTIMATOR_HPP
@@ -0,0 +1,245 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_mh.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_MH_HPP
+#define MCKL_EXAMPLE_ALGORITHM_MH_HPP
+
+#include <mckl/algorithm/mh.hpp>
+#include <mckl/utility/covariance.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+using AlgorithmMH = mckl::Vector<double>;
+
+// Normal distribution with AR(1) correlation and heterogeneous scales
+class AlgorithmMHTarget
+{
+  public:
+    AlgorithmMHTarget(std::size_t dim, double rho) : rho_(rho), s_(dim) {}
+
+    double scale(std::size_t i) const
+    {
+        const double d = static_cast<double>(s_.size());
+
+        return std::pow(10.0, static_cast<double>(i) / d - 0.5);
+    }
+
+    double cov(std::size_t i, std::size_t j) const
+    {
+        const double k = i > j ? static_cast<double>(i - j) :
+                                 static_cast<double>(j - i);
+
+        return scale(i) * scale(j) * std::pow(rho_, k);
+    }
+
+    double operator()(std::size_t dim, const double *x)
+    {
+        for (std::size_t i = 0; i != dim; ++i) {
+            s_[i] = x[i] / scale(i);
+        }
+
+        double q = s_[0] * s_[0] + s_[dim - 1] * s_[dim - 1];
+        for (std::size_t i = 1; i < dim - 1; ++i) {
+            q += (1 + rho_ * rho_) * s_[i] * s_[i];
+        }
+        for (std::size_t i = 1; i < dim; ++i) {
+            q -= 2 * rho_ * s_[i] * s_[i - 1];
+        }
+
+        return -0.5 * q / (1 - rho_ * rho_);
+    }
+
+  private:
+    double rho_;
+    mckl::Vector<double> s_;
+}; // class AlgorithmMHTarget
+
+inline double algorithm_mh_error(
+    std::size_t n, const double *r1, const double *r2)
+{
+    double e = 0;
+    double s = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        e += (r1[i] - r2[i]) * (r1[i] - r2[i]);
+        s += r2[i] * r2[i];
+    }
+
+    return std::sqrt(e / s);
+}
+
+inline bool algorithm_mh_check(
+    const std::string &name, double error, double tolerance)
+{
+    bool passed = error < tolerance;
+    std::cout << std::setw(40) << std::left << name << std::setw(20)
+              << std::right << std::scientific << std::setprecision(2)
+              << error << std::setw(20) << std::right
+              << (passed ? "Passed" : "Failed") << std::endl;
+
+    return passed;
+}
+
+inline void algorithm_mh(std::size_t N, std::size_t dim)
+{
+    using mutation_type = mckl::MHAdaptiveMutation<>;
+
+    constexpr double rho = 0.9;
+    const double eps = std::numeric_limits<double>::epsilon();
+    const std::size_t p2 = dim * dim;
+
+    mckl::MCMCSampler<AlgorithmMH> sampler(dim, 0.0);
+    sampler.mutation(mutation_type(dim, AlgorithmMHTarget(dim, rho)));
+    const std::size_t k = sampler.estimator(
+        mckl::MCMCEstimator<AlgorithmMH>(dim, [](std::size_t, std::size_t d,
+                                                  AlgorithmMH &state,
+                                                  double *r) {
+            std::copy_n(state.data(), d, r);
+        }));
+
+    mckl::StopWatch watch;
+    watch.start();
+    sampler.iterate(N);
+    watch.stop();
+
+    const auto &mutation = *sampler.mutation(0).target<mutation_type>();
+    const auto &online = mutation.covariance();
+    const auto &estimator = sampler.estimator(k);
+
+    // The chain history accumulated by the mutation
+    mckl::Vector<double> x(N * dim);
+    std::fill_n(x.data(), dim, 0.0);
+    for (std::size_t i = 1; i != N; ++i) {
+        std::copy_n(estimator.row_data(i - 1), dim, x.data() + i * dim);
+    }
+
+    mckl::Covariance<double> covariance;
+    mckl::Vector<double> mean1(dim);
+    mckl::Vector<double> mean2(dim);
+    mckl::Vector<double> cov1(p2);
+    mckl::Vector<double> cov2(p2);
+    mckl::Vector<double> chol((dim * (dim + 1)) / 2);
+    mckl::Vector<double> llt(p2);
+
+    std::size_t accept = 0;
+    for (std::size_t i = 0; i != N; ++i) {
+        accept += sampler.accept_history(0, i);
+    }
+
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << std::setw(40) << std::left << "Test" << std::setw(20)
+              << std::right << "Error" << std::setw(20) << std::right
+              << "Result" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    bool passed = true;
+
+    covariance(mckl::RowMajor, N, dim, x.data(), nullptr, mean1.data(),
+        cov1.data());
+    online(mean2.data(), cov2.data());
+    passed = algorithm_mh_check("Online mean",
+                 algorithm_mh_error(dim, mean2.data(), mean1.data()),
+                 eps * 1e5) &&
+        passed;
+    passed = algorithm_mh_check("Online covariance",
+                 algorithm_mh_error(p2, cov2.data(), cov1.data()),
+                 eps * 1e5) &&
+        passed;
+
+    online.chol(chol.data());
+    for (std::size_t i = 0; i != dim; ++i) {
+        for (std::size_t j = 0; j != dim; ++j) {
+            const std::size_t k = std::min(i, j);
+            const double *li = chol.data() + i * (i + 1) / 2;
+            const double *lj = chol.data() + j * (j + 1) / 2;
+            llt[i * dim + j] = std::inner_product(li, li + k + 1, lj, 0.0);
+        }
+    }
+    passed = algorithm_mh_check("Online Cholesky factor",
+                 algorithm_mh_error(p2, llt.data(), cov1.data()), eps * 1e5) &&
+        passed;
+
+    mckl::OnlineCovariance<double> online1(dim);
+    mckl::OnlineCovariance<double> online2(dim);
+    for (std::size_t i = 0; i != N / 3; ++i) {
+        online1.add(x.data() + i * dim);
+    }
+    for (std::size_t i = N / 3; i != N; ++i) {
+        online2.add(x.data() + i * dim);
+    }
+    online1.merge(online2);
+    online1(mean2.data(), cov2.data());
+    passed = algorithm_mh_check("Merged covariance",
+                 algorithm_mh_error(p2, cov2.data(), cov1.data()),
+                 eps * 1e5) &&
+        passed;
+
+    bool removed = true;
+    for (std::size_t i = N / 3; i != N; ++i) {
+        removed = online1.remove(x.data() + i * dim) && removed;
+    }
+    covariance(mckl::RowMajor, N / 3, dim, x.data(), nullptr, mean1.data(),
+        cov1.data());
+    online1(mean2.data(), cov2.data());
+    passed = algorithm_mh_check("Downdated covariance",
+                 removed ? algorithm_mh_error(p2, cov2.data(), cov1.data()) :
+                           1.0,
+                 eps * 1e5) &&
+        passed;
+
+    AlgorithmMHTarget target(dim, rho);
+    for (std::size_t i = 0; i != dim; ++i) {
+        for (std::size_t j = 0; j != dim; ++j) {
+            cov2[i * dim + j] = target.cov(i, j);
+        }
+    }
+    covariance(mckl::RowMajor, N / 2, dim, x.data() + (N / 2) * dim, nullptr,
+        mean1.data(), cov1.data());
+    passed = algorithm_mh_check("Chain covariance",
+                 algorithm_mh_error(p2, cov1.data(), cov2.data()), 0.2) &&
+        passed;
+
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(60) << std::left << "Acceptance rate"
+              << std::setw(20) << std::right << std::fixed
+              << std::setprecision(4)
+              << static_cast<double>(accept) / static_cast<double>(N)
+              << std::endl;
+    std::cout << std::setw(60) << std::left << "Time per iteration (us)"
+              << std::setw(20) << std::right << std::fixed
+              << std::setprecision(4)
+              << watch.microseconds() / static_cast<double>(N) << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(60) << std::left << "Test result" << std::setw(20)
+              << std::right << std::fixed << (passed ? "Passed" : "Failed")
+              << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_MH_HPP
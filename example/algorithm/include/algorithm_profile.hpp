@@ -0,0 +1,306 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_profile.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_PROFILE_HPP
+#define MCKL_EXAMPLE_ALGORITHM_PROFILE_HPP
+
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/smp.hpp>
+
+class AlgorithmProfile : public mckl::StateMatrix<mckl::RowMajor, double, 2>
+{
+  public:
+    using rng_set_type = mckl::RNGSetVector<>;
+
+    using mckl::StateMatrix<mckl::RowMajor, double, 2>::StateMatrix;
+}; // class AlgorithmProfile
+
+template <typename Backend>
+class AlgorithmProfileSelection
+    : public mckl::SMCSamplerEvalSMP<AlgorithmProfile,
+          AlgorithmProfileSelection<Backend>, Backend>
+{
+  public:
+    void eval_first(std::size_t, mckl::Particle<AlgorithmProfile> &particle)
+    {
+        w_.resize(particle.size());
+    }
+
+    void eval_range(
+        std::size_t, const mckl::ParticleRange<AlgorithmProfile> &range)
+    {
+        for (auto idx : range) {
+            w_[idx.i()] = -0.5 * idx(0) * idx(0);
+        }
+    }
+
+    void eval_last(std::size_t, mckl::Particle<AlgorithmProfile> &particle)
+    {
+        particle.weight().add_log(w_.data());
+    }
+
+  private:
+    mckl::Vector<double> w_;
+}; // class AlgorithmProfileSelection
+
+template <typename Backend>
+class AlgorithmProfileMutation
+    : public mckl::SMCSamplerEvalSMP<AlgorithmProfile,
+          AlgorithmProfileMutation<Backend>, Backend>
+{
+  public:
+    void eval_range(
+        std::size_t, const mckl::ParticleRange<AlgorithmProfile> &range)
+    {
+        mckl::NormalDistribution<double> normal(0, 1);
+        mckl::U01Distribution<double> u01;
+        std::size_t accepted = 0;
+        for (auto idx : range) {
+            auto &rng = idx.rng();
+            const double y0 = idx(0) + normal(rng);
+            const double y1 = idx(1) + normal(rng);
+            const double r = 0.5 *
+                (idx(0) * idx(0) + idx(1) * idx(1) - y0 * y0 - y1 * y1);
+            if (std::log(u01(rng)) < r) {
+                idx(0) = y0;
+                idx(1) = y1;
+                ++accepted;
+            }
+        }
+        mckl::smc_profile_accept(range.particle(), accepted, range.size());
+    }
+}; // class AlgorithmProfileMutation
+
+template <typename Backend>
+class AlgorithmProfileEstimator
+    : public mckl::SMCEstimatorEvalSMP<AlgorithmProfile,
+          AlgorithmProfileEstimator<Backend>, Backend>
+{
+  public:
+    void eval_each(std::size_t, std::size_t,
+        mckl::ParticleIndex<AlgorithmProfile> idx, double *r)
+    {
+        r[0] = idx(0);
+        r[1] = idx(1);
+    }
+}; // class AlgorithmProfileEstimator
+
+template <typename Backend>
+inline std::string algorithm_profile_name();
+
+template <>
+inline std::string algorithm_profile_name<mckl::BackendSEQ>()
+{
+    return "SEQ";
+}
+
+template <>
+inline std::string algorithm_profile_name<mckl::BackendSTD>()
+{
+    return "STD";
+}
+
+template <>
+inline std::string algorithm_profile_name<mckl::BackendOMP>()
+{
+    return "OMP";
+}
+
+#if MCKL_HAS_TBB
+template <>
+inline std::string algorithm_profile_name<mckl::BackendTBB>()
+{
+    return "TBB";
+}
+#endif
+
+// Check that the ranges of a step cover [0, N) without overlap
+inline bool algorithm_profile_cover(const mckl::SMCProfileRecord &record,
+    std::size_t step, bool estimator, std::size_t N)
+{
+    mckl::Vector<std::pair<std::size_t, std::size_t>> r;
+    for (const auto &range : record.range) {
+        if (range.step == step && range.estimator == estimator) {
+            r.emplace_back(range.ibegin, range.iend);
+        }
+    }
+    std::sort(r.begin(), r.end());
+
+    std::size_t i = 0;
+    for (const auto &p : r) {
+        if (p.first != i) {
+            return false;
+        }
+        i = p.second;
+    }
+
+    return i == N;
+}
+
+inline bool algorithm_profile_check(const std::string &name, bool passed)
+{
+    std::cout << std::setw(60) << std::left << name << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+
+    return passed;
+}
+
+template <typename Backend>
+inline bool algorithm_profile(std::size_t N, std::size_t n)
+{
+    using T = AlgorithmProfile;
+
+    mckl::SMCSampler<T> sampler(N);
+    sampler.selection(AlgorithmProfileSelection<Backend>());
+    sampler.resample(mckl::Systematic);
+    sampler.resample_threshold(0.5);
+    sampler.mutation(AlgorithmProfileMutation<Backend>());
+    sampler.mutation_estimator(
+        mckl::SMCEstimator<T>(2, AlgorithmProfileEstimator<Backend>()));
+
+    mckl::SMCSampler<T> reference(sampler);
+
+    std::size_t count = 0;
+    sampler.profile().enable(n / 2);
+    sampler.profile().callback(
+        [&count](const mckl::SMCProfileRecord &) { ++count; });
+    sampler.iterate(n);
+    reference.iterate(n);
+
+    const mckl::SMCProfile &profile = sampler.profile();
+    const std::string name = algorithm_profile_name<Backend>();
+
+    bool records = count == n && profile.size() == n / 2;
+    records = records && profile[0].iter == n - n / 2;
+    records = records && profile.back().iter == n - 1;
+
+    bool resampled = true;
+    bool ranges = true;
+    bool accept = true;
+    bool times = true;
+    std::size_t nresampled = 0;
+    double step_ns[3] = {0, 0, 0};
+    double imbalance = 0;
+    for (std::size_t k = 0; k != profile.size(); ++k) {
+        const mckl::SMCProfileRecord &r = profile[k];
+
+        const bool flag = r.ess < r.size * sampler.resample_threshold();
+        resampled = resampled && r.resampled == flag;
+        resampled = resampled && r.eval_ns[1].size() == (flag ? 1 : 0);
+        resampled = resampled && r.moved <= r.size;
+        resampled = resampled && r.bytes == r.moved * 2 * sizeof(double);
+        resampled = resampled && (flag || r.moved == 0);
+        resampled = resampled &&
+            r.ess == sampler.ess_history(r.iter) &&
+            r.size == sampler.size_history(r.iter);
+        nresampled += r.resampled ? 1 : 0;
+
+        ranges = ranges && algorithm_profile_cover(r, 0, false, N);
+        ranges = ranges && algorithm_profile_cover(r, 2, false, N);
+        ranges = ranges && algorithm_profile_cover(r, 2, true, N);
+
+        accept = accept && r.proposed == N && r.accepted <= r.proposed;
+
+        double sum = 0;
+        for (std::size_t s = 0; s != 3; ++s) {
+            double t = 0;
+            for (double e : r.eval_ns[s]) {
+                t += e;
+            }
+            for (double e : r.estimator_ns[s]) {
+                t += e;
+            }
+            times = times && t <= r.step_ns[s];
+            sum += r.step_ns[s];
+            step_ns[s] += r.step_ns[s];
+        }
+        times = times && sum <= r.ns;
+        imbalance += r.imbalance(2);
+    }
+
+    const bool same =
+        sampler.particle().state() == reference.particle().state() &&
+        reference.profile().size() == 0 &&
+        sampler.particle().profiler() == nullptr &&
+        reference.particle().profiler() == nullptr;
+
+    bool passed = true;
+    std::cout << std::string(80, '=') << std::endl;
+    passed = algorithm_profile_check(name + " Records", records) && passed;
+    passed =
+        algorithm_profile_check(name + " Resampling", resampled) && passed;
+    passed = algorithm_profile_check(name + " Ranges", ranges) && passed;
+    passed = algorithm_profile_check(name + " Acceptance", accept) && passed;
+    passed = algorithm_profile_check(name + " Times", times) && passed;
+    passed = algorithm_profile_check(name + " Same as unprofiled", same) &&
+        passed;
+    std::cout << std::string(80, '-') << std::endl;
+
+    const double m = static_cast<double>(profile.size());
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(60) << std::left << "Resampled iterations"
+              << std::setw(20) << std::right << nresampled << std::endl;
+    std::cout << std::setw(60) << std::left << "Acceptance rate"
+              << std::setw(20) << std::right << profile.back().acceptance()
+              << std::endl;
+    std::cout << std::setw(60) << std::left << "Selection (us)"
+              << std::setw(20) << std::right << step_ns[0] / m * 1e-3
+              << std::endl;
+    std::cout << std::setw(60) << std::left << "Resampling (us)"
+              << std::setw(20) << std::right << step_ns[1] / m * 1e-3
+              << std::endl;
+    std::cout << std::setw(60) << std::left << "Mutation (us)"
+              << std::setw(20) << std::right << step_ns[2] / m * 1e-3
+              << std::endl;
+    std::cout << std::setw(60) << std::left << "Mutation imbalance"
+              << std::setw(20) << std::right << imbalance / m << std::endl;
+
+    return passed;
+}
+
+inline void algorithm_profile(std::size_t N, std::size_t n)
+{
+    bool passed = true;
+    passed = algorithm_profile<mckl::BackendSEQ>(N, n) && passed;
+    passed = algorithm_profile<mckl::BackendSTD>(N, n) && passed;
+    passed = algorithm_profile<mckl::BackendOMP>(N, n) && passed;
+#if MCKL_HAS_TBB
+    passed = algorithm_profile<mckl::BackendTBB>(N, n) && passed;
+#endif
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(60) << std::left << "Test result" << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_PROFILE_HPP
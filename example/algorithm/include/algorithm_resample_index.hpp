@@ -139,6 +139,42 @@ inline AlgorithmResampleState<Layout> algorithm_resample_index_trace(
     return state;
 }
 
+template <mckl::MatrixLayout Layout>
+inline AlgorithmResampleState<Layout> algorithm_resample_index_genealogy(
+    const mckl::Vector<std::size_t> &size,
+    const mckl::Vector<mckl::Vector<int>> &value,
+    const mckl::Vector<mckl::Vector<std::size_t>> &index)
+{
+    const std::size_t dim = size.size() - 1;
+    const std::size_t N = size[dim];
+    AlgorithmResampleState<Layout> state(0);
+    AlgorithmResampleState<Layout> idxmat(0);
+    state.resize(N, dim);
+    idxmat.resize(N, dim);
+
+    mckl::StopWatch watch;
+    watch.start();
+    mckl::ResampleGenealogy<int> genealogy;
+    for (std::size_t d = 0; d != dim; ++d)
+        genealogy.push_back(index[d].size(), index[d].begin());
+    genealogy.read_index_matrix(Layout, idxmat.data());
+    for (std::size_t j = 0; j != dim; ++j) {
+        auto val = value[j].data();
+        for (std::size_t i = 0; i != N; ++i)
+            state(i, j) = val[idxmat(i, j)];
+    }
+    watch.stop();
+    std::cout << std::setw(60) << std::left
+              << "Time (ms) using genealogy trace" << std::setw(20)
+              << std::right << std::fixed << watch.milliseconds()
+              << std::endl;
+    std::cout << std::setw(60) << std::left << "Number of genealogy nodes"
+              << std::setw(20) << std::right << genealogy.num_nodes()
+              << std::endl;
+
+    return state;
+}
+
 template <mckl::MatrixLayout Layout1, mckl::MatrixLayout Layout2>
 inline bool algorithm_resample_index_check(
     const AlgorithmResampleState<Layout1> &state1,
@@ -182,10 +218,15 @@ inline void algorithm_resample_index(
     auto value = algorithm_resample_value(rng, size);
     auto weight = algorithm_resample_weight(rng, size);
     auto index = algorithm_resample_index(rng, size, weight);
+    auto direct = fixed ?
+        algorithm_resample_index_fixed<Layout2>(size, value, index) :
+        algorithm_resample_index_rands<Layout2>(size, value, index);
     bool passed = algorithm_resample_index_check(
-        algorithm_resample_index_trace<Layout1>(size, value, index),
-        fixed ? algorithm_resample_index_fixed<Layout2>(size, value, index) :
-                algorithm_resample_index_rands<Layout2>(size, value, index));
+        algorithm_resample_index_trace<Layout1>(size, value, index), direct);
+    passed = passed &&
+        algorithm_resample_index_check(
+            algorithm_resample_index_genealogy<Layout1>(size, value, index),
+            direct);
 
     std::cout << std::setw(60) << std::left << "Test result" << std::setw(20)
               << std::right << std::fixed << (passed ? "Passed" : "Failed")
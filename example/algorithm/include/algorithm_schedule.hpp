@@ -0,0 +1,357 @@
+//============================================================================
+// MCKL/example/algorithm/include/algorithm_schedule.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_ALGORITHM_SCHEDULE_HPP
+#define MCKL_EXAMPLE_ALGORITHM_SCHEDULE_HPP
+
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/smp.hpp>
+
+class AlgorithmSchedule : public mckl::StateMatrix<mckl::RowMajor, double, 1>
+{
+  public:
+    using rng_set_type = mckl::RNGSetVector<>;
+
+    using mckl::StateMatrix<mckl::RowMajor, double, 1>::StateMatrix;
+}; // class AlgorithmSchedule
+
+template <typename Backend>
+class AlgorithmScheduleSelection
+    : public mckl::SMCSamplerEvalSMP<AlgorithmSchedule,
+          AlgorithmScheduleSelection<Backend>, Backend>
+{
+  public:
+    void eval_first(std::size_t, mckl::Particle<AlgorithmSchedule> &particle)
+    {
+        w_.resize(particle.size());
+    }
+
+    void eval_range(
+        std::size_t, const mckl::ParticleRange<AlgorithmSchedule> &range)
+    {
+        for (auto idx : range) {
+            w_[idx.i()] = -0.5 * idx(0) * idx(0);
+        }
+    }
+
+    void eval_last(std::size_t, mckl::Particle<AlgorithmSchedule> &particle)
+    {
+        particle.weight().add_log(w_.data());
+    }
+
+  private:
+    mckl::Vector<double> w_;
+}; // class AlgorithmScheduleSelection
+
+// The first quarter of the particles are moved by many more Metropolis
+// steps than the others
+template <typename Backend>
+class AlgorithmScheduleMutation
+    : public mckl::SMCSamplerEvalSMP<AlgorithmSchedule,
+          AlgorithmScheduleMutation<Backend>, Backend>
+{
+  public:
+    void eval_range(
+        std::size_t, const mckl::ParticleRange<AlgorithmSchedule> &range)
+    {
+        mckl::NormalDistribution<double> normal(0, 1);
+        mckl::U01Distribution<double> u01;
+        const std::size_t N = range.particle().size();
+        for (auto idx : range) {
+            auto &rng = idx.rng();
+            const std::size_t n = idx.i() < N / 4 ? 100 : 4;
+            for (std::size_t k = 0; k != n; ++k) {
+                const double y = idx(0) + normal(rng);
+                const double r = 0.5 * (idx(0) * idx(0) - y * y);
+                if (std::log(u01(rng)) < r) {
+                    idx(0) = y;
+                }
+            }
+        }
+    }
+}; // class AlgorithmScheduleMutation
+
+template <typename Backend>
+class AlgorithmScheduleEstimator
+    : public mckl::SMCEstimatorEvalSMP<AlgorithmSchedule,
+          AlgorithmScheduleEstimator<Backend>, Backend>
+{
+  public:
+    void eval_each(std::size_t, std::size_t,
+        mckl::ParticleIndex<AlgorithmSchedule> idx, double *r)
+    {
+        r[0] = idx(0);
+    }
+}; // class AlgorithmScheduleEstimator
+
+inline std::string algorithm_schedule_name(mckl::SMPSchedule schedule)
+{
+    switch (schedule) {
+        case mckl::SMPSchedule::Static:
+            return "Static";
+        case mckl::SMPSchedule::Dynamic:
+            return "Dynamic";
+        case mckl::SMPSchedule::Guided:
+            return "Guided";
+        case mckl::SMPSchedule::Adaptive:
+            return "Adaptive";
+        case mckl::SMPSchedule::Affinity:
+            return "Affinity";
+    }
+
+    return std::string();
+}
+
+// Check that the ranges of a step cover [0, N) without overlap, and that
+// the boundaries other than N are aligned to cache lines
+inline bool algorithm_schedule_cover(const mckl::SMCProfileRecord &record,
+    std::size_t step, bool estimator, std::size_t N, bool aligned)
+{
+    mckl::Vector<std::pair<std::size_t, std::size_t>> r;
+    for (const auto &range : record.range) {
+        if (range.step == step && range.estimator == estimator) {
+            r.emplace_back(range.ibegin, range.iend);
+        }
+    }
+    std::sort(r.begin(), r.end());
+
+    const std::size_t a = 64 / sizeof(double);
+    std::size_t i = 0;
+    for (const auto &p : r) {
+        if (p.first != i || p.first == p.second) {
+            return false;
+        }
+        if (aligned && p.second != N && p.second % a != 0) {
+            return false;
+        }
+        i = p.second;
+    }
+
+    return i == N;
+}
+
+// Check that the ranges with the same beginning are evaluated by the same
+// thread in all steps of an iteration
+inline bool algorithm_schedule_affinity(const mckl::SMCProfileRecord &record)
+{
+    std::map<std::size_t, std::size_t> thread;
+    for (const auto &range : record.range) {
+        auto iter = thread.insert(std::make_pair(range.ibegin, range.thread));
+        if (iter.first->second != range.thread) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline bool algorithm_schedule_check(const std::string &name, bool passed)
+{
+    std::cout << std::setw(60) << std::left << name << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+
+    return passed;
+}
+
+// Throw from the range of the last particle
+template <typename Backend>
+class AlgorithmScheduleThrow
+    : public mckl::SMCSamplerEvalSMP<AlgorithmSchedule,
+          AlgorithmScheduleThrow<Backend>, Backend>
+{
+  public:
+    void eval_range(
+        std::size_t, const mckl::ParticleRange<AlgorithmSchedule> &range)
+    {
+        if (range.iend() == range.particle().size()) {
+            throw std::runtime_error("AlgorithmScheduleThrow");
+        }
+    }
+}; // class AlgorithmScheduleThrow
+
+// An exception thrown by a worker is rethrown by the calling thread, and the
+// workers remain usable
+template <typename Backend>
+inline bool algorithm_schedule_throw(
+    std::size_t N, const mckl::SMCSampler<AlgorithmSchedule> &base)
+{
+    using T = AlgorithmSchedule;
+
+    AlgorithmScheduleThrow<Backend> eval;
+    AlgorithmScheduleMutation<Backend> mutation;
+    eval.schedule(mckl::SMPSchedule::Affinity);
+    mutation.schedule(mckl::SMPSchedule::Affinity);
+
+    mckl::SMCSampler<T> sampler(base);
+    sampler.mutation(eval);
+
+    bool passed = false;
+    try {
+        sampler.iterate();
+    } catch (const std::runtime_error &e) {
+        passed = std::string(e.what()) == "AlgorithmScheduleThrow";
+    }
+
+    sampler.mutation(0) = mutation;
+    try {
+        sampler.iterate();
+    } catch (...) {
+        passed = false;
+    }
+
+    return passed && sampler.particle().size() == N;
+}
+
+template <typename Backend>
+inline bool algorithm_schedule(std::size_t N, std::size_t n,
+    const std::string &backend, mckl::SMPSchedule schedule,
+    const mckl::SMCSampler<AlgorithmSchedule> &base,
+    const mckl::SMCSampler<AlgorithmSchedule> &reference)
+{
+    using T = AlgorithmSchedule;
+
+    AlgorithmScheduleSelection<Backend> selection;
+    AlgorithmScheduleMutation<Backend> mutation;
+    AlgorithmScheduleEstimator<Backend> estimator;
+    selection.schedule(schedule);
+    mutation.schedule(schedule);
+    estimator.schedule(schedule);
+    bool passed = selection.schedule() == schedule &&
+        mutation.schedule() == schedule && estimator.schedule() == schedule;
+
+    mckl::SMCSampler<T> sampler(base);
+    sampler.selection(selection);
+    sampler.resample(mckl::Systematic);
+    sampler.resample_threshold(0.5);
+    sampler.mutation(mutation);
+    sampler.mutation_estimator(mckl::SMCEstimator<T>(1, estimator));
+    sampler.profile().enable(n);
+    sampler.iterate(n);
+
+    const bool aligned = schedule != mckl::SMPSchedule::Static &&
+        !std::is_same<Backend, mckl::BackendTBB>::value;
+    const mckl::SMCProfile &profile = sampler.profile();
+    bool ranges = true;
+    bool affinity = true;
+    double imbalance = 0;
+    for (std::size_t k = 0; k != profile.size(); ++k) {
+        const mckl::SMCProfileRecord &r = profile[k];
+        ranges = ranges && algorithm_schedule_cover(r, 0, false, N, aligned);
+        ranges = ranges && algorithm_schedule_cover(r, 2, false, N, aligned);
+        ranges = ranges && algorithm_schedule_cover(r, 2, true, N, aligned);
+        affinity = affinity && algorithm_schedule_affinity(r);
+        if (k >= profile.size() / 2) {
+            imbalance += r.imbalance(2);
+        }
+    }
+
+    const auto &est = sampler.mutation_estimator(0);
+    const auto &ref = reference.mutation_estimator(0);
+    bool same = sampler.particle().state() == reference.particle().state();
+    for (std::size_t i = 0; i != n; ++i) {
+        same = same && est(i, 0) == ref(i, 0);
+    }
+
+    const std::string name =
+        backend + " " + algorithm_schedule_name(schedule);
+    passed = algorithm_schedule_check(name + " Ranges", ranges) && passed;
+    passed = algorithm_schedule_check(name + " Same as SEQ", same) && passed;
+    if (schedule == mckl::SMPSchedule::Affinity &&
+        !std::is_same<Backend, mckl::BackendTBB>::value) {
+        passed =
+            algorithm_schedule_check(name + " Affinity", affinity) && passed;
+    }
+    std::cout << std::setw(60) << std::left << name + " Mutation imbalance"
+              << std::setw(20) << std::right
+              << imbalance / (profile.size() - profile.size() / 2)
+              << std::endl;
+
+    return passed;
+}
+
+inline void algorithm_schedule(std::size_t N, std::size_t n, std::size_t np)
+{
+    using T = AlgorithmSchedule;
+
+    const mckl::SMCSampler<T> base(N);
+    mckl::SMCSampler<T> reference(base);
+    reference.selection(AlgorithmScheduleSelection<mckl::BackendSEQ>());
+    reference.resample(mckl::Systematic);
+    reference.resample_threshold(0.5);
+    reference.mutation(AlgorithmScheduleMutation<mckl::BackendSEQ>());
+    reference.mutation_estimator(mckl::SMCEstimator<T>(
+        1, AlgorithmScheduleEstimator<mckl::BackendSEQ>()));
+    reference.iterate(n);
+
+    mckl::BackendSTD::instance().np(static_cast<unsigned>(np));
+#if MCKL_HAS_OMP
+    ::omp_set_num_threads(static_cast<int>(np));
+#endif
+
+    const mckl::SMPSchedule schedule[] = {mckl::SMPSchedule::Static,
+        mckl::SMPSchedule::Dynamic, mckl::SMPSchedule::Guided,
+        mckl::SMPSchedule::Adaptive, mckl::SMPSchedule::Affinity};
+
+    bool passed = true;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::string(80, '=') << std::endl;
+    for (auto s : schedule) {
+        passed = algorithm_schedule<mckl::BackendSTD>(
+                     N, n, "STD", s, base, reference) &&
+            passed;
+    }
+    passed = algorithm_schedule_check("STD Affinity Exception",
+                 algorithm_schedule_throw<mckl::BackendSTD>(N, base)) &&
+        passed;
+    std::cout << std::string(80, '-') << std::endl;
+    for (auto s : schedule) {
+        passed = algorithm_schedule<mckl::BackendOMP>(
+                     N, n, "OMP", s, base, reference) &&
+            passed;
+    }
+#if MCKL_HAS_TBB
+    std::cout << std::string(80, '-') << std::endl;
+    passed = algorithm_schedule<mckl::BackendTBB>(N, n, "TBB",
+                 mckl::SMPSchedule::Static, base, reference) &&
+        passed;
+    passed = algorithm_schedule<mckl::BackendTBB>(N, n, "TBB",
+                 mckl::SMPSchedule::Affinity, base, reference) &&
+        passed;
+#endif
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(60) << std::left << "Test result" << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_ALGORITHM_SCHEDULE_HPP
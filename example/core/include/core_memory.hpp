@@ -112,6 +112,11 @@ inline void core_memory(std::size_t N, std::size_t M, const std::string &tname)
 #if MCKL_HAS_POSIX || defined(MCKL_MSVC)
     core_memory<T, mckl::MemorySYS<alignment>>(N, M, tname, "MemorySYS");
 #endif
+#if MCKL_HAS_POSIX
+    core_memory<T, mckl::MemoryMMAP<alignment>>(
+        N, std::min<std::size_t>(M, 10), tname, "MemoryMMAP");
+    core_memory<T, mckl::MemoryHUGE<alignment>>(N, M, tname, "MemoryHUGE");
+#endif
 #if MCKL_HAS_JEMALLOC
     core_memory<T, mckl::MemoryJEM<alignment>>(N, M, tname, "MemoryJEM");
 #endif
@@ -0,0 +1,230 @@
+//============================================================================
+// MCKL/example/core/include/core_relayout.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_CORE_RELAYOUT_HPP
+#define MCKL_EXAMPLE_CORE_RELAYOUT_HPP
+
+#include <mckl/core/matrix.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/uniform_int_distribution.hpp>
+#include <mckl/smp/backend_std.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+template <typename T, mckl::MatrixLayout Layout, mckl::MatrixLayout Trans>
+inline bool core_relayout_check(
+    const mckl::Matrix<T, Layout> &mat, const mckl::Matrix<T, Trans> &tmat)
+{
+    if (mat.nrow() != tmat.nrow() || mat.ncol() != tmat.ncol()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i != mat.nrow(); ++i) {
+        for (std::size_t j = 0; j != mat.ncol(); ++j) {
+            if (mat(i, j) != tmat(i, j)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename T, mckl::MatrixLayout Layout>
+inline void core_relayout(
+    std::size_t N, std::size_t M, const std::string &name)
+{
+    using matrix_type = mckl::Matrix<T, Layout>;
+    using transpose_type = typename matrix_type::transpose_type;
+    using state_type = mckl::StateMatrix<Layout, T>;
+
+    mckl::RNG rng;
+    mckl::UniformIntDistribution<std::size_t> rsize(0, N);
+
+    bool pass1 = true;
+    bool pass2 = true;
+    bool pass3 = true;
+    bool pass4 = true;
+    bool pass5 = true;
+    mckl::StopWatch watch1;
+    mckl::StopWatch watch2;
+    mckl::StopWatch watch3;
+    mckl::StopWatch watch4;
+    mckl::StopWatch watch5;
+    std::size_t l = 0;
+    for (std::size_t k = 0; k != M; ++k) {
+        const std::size_t n = rsize(rng);
+        const std::size_t m = k % 4 == 0 ? n : rsize(rng);
+        l += n * m;
+        matrix_type mat(n, m);
+        for (std::size_t i = 0; i != n; ++i) {
+            for (std::size_t j = 0; j != m; ++j) {
+                mat(i, j) = static_cast<T>(i * m + j);
+            }
+        }
+
+        transpose_type tmat1(n, m);
+        std::fill(tmat1.begin(), tmat1.end(), static_cast<T>(0));
+        watch1.start();
+        for (std::size_t i = 0; i != n; ++i) {
+            for (std::size_t j = 0; j != m; ++j) {
+                tmat1(i, j) = mat(i, j);
+            }
+        }
+        watch1.stop();
+        pass1 = pass1 && core_relayout_check(mat, tmat1);
+
+        transpose_type tmat2(n, m);
+        std::fill(tmat2.begin(), tmat2.end(), static_cast<T>(0));
+        watch2.start();
+        mat.relayout(tmat2);
+        watch2.stop();
+        pass2 = pass2 && core_relayout_check(mat, tmat2);
+        pass2 = pass2 && static_cast<transpose_type>(mat) == tmat2;
+
+        transpose_type tmat3(n, m);
+        std::fill(tmat3.begin(), tmat3.end(), static_cast<T>(0));
+        watch3.start();
+        mckl::smp_relayout<mckl::BackendSTD>(mat, tmat3);
+        watch3.stop();
+        pass3 = pass3 && core_relayout_check(mat, tmat3);
+
+        matrix_type tmp(mat);
+        watch4.start();
+        transpose_type tmat4(tmp.relayout_inplace());
+        watch4.stop();
+        pass4 = pass4 && core_relayout_check(mat, tmat4);
+        pass4 = pass4 && tmp.empty();
+        pass4 = pass4 && (matrix_type(tmat4.relayout_inplace()) == mat);
+
+        // The fallback of relayout_inplace when allocation fails
+        matrix_type tmp4(mat);
+        mckl::internal::matrix_transpose_inplace(
+            Layout == mckl::RowMajor ? n : m,
+            Layout == mckl::RowMajor ? m : n, tmp4.data());
+        pass4 = pass4 && std::equal(tmp4.begin(), tmp4.end(), tmat2.begin());
+
+        state_type state(n, m);
+        static_cast<matrix_type &>(state) = mat;
+        watch5.start();
+        typename state_type::relayout_type tstate(state.relayout_inplace());
+        watch5.stop();
+        pass5 = pass5 && core_relayout_check(mat, tstate);
+        pass5 = pass5 && tstate.size() == n && tstate.dim() == m;
+        pass5 = pass5 && state.size() == 0;
+        mckl::smp_relayout<mckl::BackendSTD>(tstate, state);
+        pass5 = pass5 && static_cast<const matrix_type &>(state) == mat;
+    }
+
+    double p1 = 0;
+    double p2 = 0;
+    double p3 = 0;
+    double p4 = 0;
+    double p5 = 0;
+    if (mckl::StopWatch::has_cycles()) {
+        p1 = 1.0 * watch1.cycles() / l;
+        p2 = 1.0 * watch2.cycles() / l;
+        p3 = 1.0 * watch3.cycles() / l;
+        p4 = 1.0 * watch4.cycles() / l;
+        p5 = 1.0 * watch5.cycles() / l;
+    } else {
+        p1 = 1e-6 * l / watch1.seconds();
+        p2 = 1e-6 * l / watch2.seconds();
+        p3 = 1e-6 * l / watch3.seconds();
+        p4 = 1e-6 * l / watch4.seconds();
+        p5 = 1e-6 * l / watch5.seconds();
+    }
+
+    std::cout << std::setw(30) << std::left << name + " (naive)";
+    std::cout << std::setw(10) << std::right << p1;
+    std::cout << std::setw(15) << std::right << (pass1 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    std::cout << std::setw(30) << std::left << name + " (relayout)";
+    std::cout << std::setw(10) << std::right << p2;
+    std::cout << std::setw(15) << std::right << (pass2 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    std::cout << std::setw(30) << std::left << name + " (smp_relayout)";
+    std::cout << std::setw(10) << std::right << p3;
+    std::cout << std::setw(15) << std::right << (pass3 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    std::cout << std::setw(30) << std::left << name + " (Matrix)";
+    std::cout << std::setw(10) << std::right << p4;
+    std::cout << std::setw(15) << std::right << (pass4 ? "Passed" : "Failed");
+    std::cout << std::endl;
+
+    std::cout << std::setw(30) << std::left << name + " (StateMatrix)";
+    std::cout << std::setw(10) << std::right << p5;
+    std::cout << std::setw(15) << std::right << (pass5 ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+template <mckl::MatrixLayout Layout>
+inline void core_relayout(std::size_t N, std::size_t M)
+{
+    core_relayout<std::uint64_t, Layout>(N, M, "std::uint64_t");
+    core_relayout<double, Layout>(N, M, "double");
+    core_relayout<float, Layout>(N, M, "float");
+    core_relayout<std::uint16_t, Layout>(N, M, "std::uint16_t");
+}
+
+inline void core_relayout(std::size_t N, std::size_t M)
+{
+    std::cout << std::fixed << std::setprecision(5);
+
+    std::string perf;
+    if (mckl::StopWatch::has_cycles())
+        perf = "cpE";
+    else
+        perf = "ME/s";
+
+    std::cout << std::string(55, '=') << std::endl;
+    std::cout << std::setw(30) << std::left << "RowMajor";
+    std::cout << std::setw(10) << std::right << perf;
+    std::cout << std::setw(15) << std::right << "Determinstics";
+    std::cout << std::endl;
+    std::cout << std::string(55, '-') << std::endl;
+    core_relayout<mckl::RowMajor>(N, M);
+    std::cout << std::string(55, '-') << std::endl;
+
+    std::cout << std::string(55, '=') << std::endl;
+    std::cout << std::setw(30) << std::left << "ColMajor";
+    std::cout << std::setw(10) << std::right << perf;
+    std::cout << std::setw(15) << std::right << "Determinstics";
+    std::cout << std::endl;
+    std::cout << std::string(55, '-') << std::endl;
+    core_relayout<mckl::ColMajor>(N, M);
+    std::cout << std::string(55, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_CORE_RELAYOUT_HPP
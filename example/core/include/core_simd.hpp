@@ -0,0 +1,225 @@
+//============================================================================
+// MCKL/example/core/include/core_simd.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_CORE_SIMD_HPP
+#define MCKL_EXAMPLE_CORE_SIMD_HPP
+
+#include <mckl/core/particle.hpp>
+#include <mckl/core/simd.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/uniform_real_distribution.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+template <typename T>
+inline T core_simd_error(T y, T r, bool relative)
+{
+    if (std::isnan(r)) {
+        return std::isnan(y) ? 0 : std::numeric_limits<T>::infinity();
+    }
+    if (std::isinf(r)) {
+        return y == r ? 0 : std::numeric_limits<T>::infinity();
+    }
+
+    const T d = std::abs(y - r);
+    const T e = std::numeric_limits<T>::epsilon();
+
+    return relative ? d / (e * std::abs(r)) : d / (e * std::max(std::abs(r),
+                                                          static_cast<T>(1)));
+}
+
+inline void core_simd_output(
+    const std::string &name, double error, double perf, bool pass)
+{
+    std::cout << std::setw(30) << std::left << name;
+    std::cout << std::setw(10) << std::right << error;
+    std::cout << std::setw(10) << std::right << perf;
+    std::cout << std::setw(10) << std::right << (pass ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+template <typename T, std::size_t W, typename SIMDFunc, typename STDFunc>
+inline void core_simd_math(std::size_t N, std::size_t M,
+    const std::string &name, T lb, T ub, bool relative, T tol,
+    SIMDFunc &&simd_func, STDFunc &&std_func)
+{
+    mckl::RNG rng;
+    mckl::UniformRealDistribution<T> runif(lb, ub);
+    mckl::Vector<T> a(N);
+    mckl::Vector<T> r(N);
+    mckl::Vector<T> y(N);
+
+    T error = 0;
+    mckl::StopWatch watch;
+    for (std::size_t k = 0; k != M; ++k) {
+        for (std::size_t i = 0; i != N; ++i) {
+            a[i] = runif(rng);
+        }
+        for (std::size_t i = 0; i != N; ++i) {
+            r[i] = std_func(a[i]);
+        }
+        watch.start();
+        std::size_t i = 0;
+        for (; i + W <= N; i += W) {
+            simd_func(mckl::SIMD<T, W>::load(a.data() + i))
+                .store(y.data() + i);
+        }
+        if (i != N) {
+            simd_func(mckl::SIMD<T, W>::load(a.data() + i, N - i))
+                .store(y.data() + i, N - i);
+        }
+        watch.stop();
+        for (std::size_t j = 0; j != N; ++j) {
+            error = std::max(error, core_simd_error(y[j], r[j], relative));
+        }
+    }
+
+    const T special[] = {std::numeric_limits<T>::quiet_NaN(),
+        std::numeric_limits<T>::infinity(),
+        -std::numeric_limits<T>::infinity(), static_cast<T>(0),
+        static_cast<T>(-0.0), static_cast<T>(-1000), static_cast<T>(1000),
+        static_cast<T>(1e6), static_cast<T>(1e9), static_cast<T>(-1e10)};
+    for (T s : special) {
+        const T v = simd_func(mckl::SIMD<T, W>(s))[0];
+        error = std::max(error, core_simd_error(v, std_func(s), relative));
+    }
+
+    const double perf = mckl::StopWatch::has_cycles() ?
+        1.0 * watch.cycles() / (N * M) :
+        1e-6 * N * M / watch.seconds();
+
+    core_simd_output(name + "<" + std::to_string(W) + ">",
+        static_cast<double>(error), perf, error <= tol);
+}
+
+template <typename T, std::size_t W>
+inline void core_simd_math(
+    std::size_t N, std::size_t M, const std::string &name, T tol_sincos)
+{
+    using simd = mckl::SIMD<T, W>;
+
+    const T emax = std::is_same<T, double>::value ? 700 : 87;
+    core_simd_math<T, W>(N, M, name + " exp", -emax, emax, true,
+        static_cast<T>(4), [](const simd &x) { return mckl::exp(x); },
+        [](T x) { return std::exp(x); });
+    core_simd_math<T, W>(N, M, name + " log", 0, emax, true,
+        static_cast<T>(4), [](const simd &x) { return mckl::log(x); },
+        [](T x) { return std::log(x); });
+    core_simd_math<T, W>(N, M, name + " log (exp)", -emax, emax, false,
+        static_cast<T>(4),
+        [](const simd &x) { return mckl::log(mckl::exp(x)); },
+        [](T x) { return std::log(std::exp(x)); });
+    core_simd_math<T, W>(N, M, name + " sin", -1000, 1000, false,
+        tol_sincos, [](const simd &x) { return mckl::sin(x); },
+        [](T x) { return std::sin(x); });
+    core_simd_math<T, W>(N, M, name + " cos", -1000, 1000, false,
+        tol_sincos, [](const simd &x) { return mckl::cos(x); },
+        [](T x) { return std::cos(x); });
+}
+
+template <mckl::MatrixLayout Layout, std::size_t W>
+inline void core_simd_range(std::size_t N, const std::string &name)
+{
+    using state_type = mckl::StateMatrix<Layout, double>;
+    using simd = mckl::SIMD<double, W>;
+
+    mckl::Particle<state_type> particle(N, 3);
+    mckl::RNG rng;
+    mckl::UniformRealDistribution<double> runif(-5, 5);
+    for (std::size_t i = 0; i != N; ++i) {
+        particle.state()(i, 0) = runif(rng);
+        particle.state()(i, 1) = runif(rng);
+        particle.state()(i, 2) = 0;
+    }
+
+    mckl::StopWatch watch;
+    watch.start();
+    mckl::simd_for_each<W>(particle.range(0, N),
+        [](const mckl::ParticleIndex<state_type> &idx, std::size_t n) {
+            const simd x = mckl::simd_load_state<W>(idx, 0, n);
+            const simd y = mckl::simd_load_state<W>(idx, 1, n);
+            const simd z = mckl::exp(-0.5 * x * x) * mckl::cos(y);
+            mckl::simd_store_state(idx, 2, z, n);
+        });
+    watch.stop();
+
+    double error = 0;
+    for (std::size_t i = 0; i != N; ++i) {
+        const double x = particle.state()(i, 0);
+        const double y = particle.state()(i, 1);
+        const double r = std::exp(-0.5 * x * x) * std::cos(y);
+        error = std::max(
+            error, core_simd_error(particle.state()(i, 2), r, false));
+    }
+
+    const double perf = mckl::StopWatch::has_cycles() ?
+        1.0 * watch.cycles() / N :
+        1e-6 * N / watch.seconds();
+
+    core_simd_output(name + "<" + std::to_string(W) + ">", error, perf,
+        error <= 8);
+}
+
+template <mckl::MatrixLayout Layout>
+inline void core_simd_range(std::size_t N, const std::string &name)
+{
+    core_simd_range<Layout, mckl::simd_width<double>()>(N, name);
+    core_simd_range<Layout, 3>(N, name);
+}
+
+inline void core_simd(std::size_t N, std::size_t M)
+{
+    std::cout << std::fixed << std::setprecision(3);
+
+    std::string perf;
+    if (mckl::StopWatch::has_cycles())
+        perf = "cpE";
+    else
+        perf = "ME/s";
+
+    std::cout << std::string(60, '=') << std::endl;
+    std::cout << std::setw(30) << std::left << "Function";
+    std::cout << std::setw(10) << std::right << "Error";
+    std::cout << std::setw(10) << std::right << perf;
+    std::cout << std::setw(10) << std::right << "Test";
+    std::cout << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+    core_simd_math<double, mckl::simd_width<double>()>(N, M, "double", 4);
+    core_simd_math<double, 3>(N, M, "double", 4);
+    core_simd_math<float, mckl::simd_width<float>()>(N, M, "float", 4);
+    core_simd_math<float, 3>(N, M, "float", 4);
+    std::cout << std::string(60, '-') << std::endl;
+    core_simd_range<mckl::RowMajor>(N + 3, "RowMajor");
+    core_simd_range<mckl::ColMajor>(N + 3, "ColMajor");
+    std::cout << std::string(60, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_CORE_SIMD_HPP
@@ -0,0 +1,153 @@
+//============================================================================
+// MCKL/example/core/include/core_state_matrix.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_CORE_STATE_MATRIX_HPP
+#define MCKL_EXAMPLE_CORE_STATE_MATRIX_HPP
+
+#include <mckl/algorithm/resample.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/core/weight.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/random/uniform_int_distribution.hpp>
+#include <mckl/smp/backend_std.hpp>
+
+template <typename S1, typename S2>
+inline bool core_state_matrix_check(const S1 &s1, const S2 &s2)
+{
+    if (s1.size() != s2.size() || s1.dim() != s2.dim()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i != s1.size(); ++i) {
+        for (std::size_t j = 0; j != s1.dim(); ++j) {
+            if (s1(i, j) != s2(i, j)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template <mckl::MatrixLayout Layout, typename Mem>
+inline void core_state_matrix(std::size_t N, std::size_t M,
+    const std::string &lname, const std::string &mname)
+{
+    using A = mckl::Allocator<double, Mem>;
+    using S = mckl::StateMatrix<Layout, double, 0, A>;
+    using V = mckl::StateMatrix<Layout, double>;
+
+    mckl::RNG rng;
+    mckl::U01Distribution<double> u01;
+    mckl::UniformIntDistribution<std::size_t> rsize(N / 2, N);
+    mckl::UniformIntDistribution<std::size_t> rdim(1, 16);
+    const mckl::SMPForEach<mckl::BackendSTD> for_each(16);
+
+    bool select = true;
+    bool touch = true;
+    for (std::size_t k = 0; k != M; ++k) {
+        const std::size_t n = rsize(rng);
+        const std::size_t d = rdim(rng);
+        S s(n, d);
+        V v(n, d);
+        for (std::size_t i = 0; i != n; ++i) {
+            for (std::size_t j = 0; j != d; ++j) {
+                v(i, j) = s(i, j) = u01(rng);
+            }
+        }
+
+        s.first_touch(for_each);
+        v.first_touch(for_each);
+        touch = touch && core_state_matrix_check(s, v);
+        s.advise(0, s.size());
+
+        for (std::size_t m : {n, n / 2, n * 2}) {
+            const std::size_t size = s.size();
+            mckl::UniformIntDistribution<std::size_t> ridx(0, size - 1);
+            mckl::Vector<std::size_t> rep(size, 0);
+            mckl::Vector<std::size_t> index(m);
+            for (std::size_t i = 0; i != m; ++i) {
+                ++rep[ridx(rng)];
+            }
+            mckl::resample_trans_rep_index(
+                size, m, rep.data(), index.data());
+            s.select(m, index.data());
+            v.select(m, index.data());
+            select = select && core_state_matrix_check(s, v);
+        }
+    }
+
+    mckl::Weight w1(N);
+    mckl::Vector<double> w(N);
+    for (auto &x : w) {
+        x = u01(rng);
+    }
+    w1.set(w.data());
+    mckl::Weight w2(w1);
+    w2.first_touch(for_each);
+    touch = touch && w1.ess() == w2.ess() &&
+        std::equal(w1.data(), w1.data() + N, w2.data());
+
+    std::cout << std::setw(20) << std::left << lname;
+    std::cout << std::setw(20) << std::left << mname;
+    std::cout << std::setw(15) << std::right << (select ? "Passed" : "Failed");
+    std::cout << std::setw(15) << std::right << (touch ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
+template <mckl::MatrixLayout Layout>
+inline void core_state_matrix(
+    std::size_t N, std::size_t M, const std::string &lname)
+{
+    constexpr std::size_t alignment = MCKL_ALIGNMENT;
+
+    core_state_matrix<Layout, mckl::MemoryMMAP<alignment>>(
+        N, M, lname, "MemoryMMAP");
+    core_state_matrix<Layout, mckl::MemoryHUGE<alignment>>(
+        N, M, lname, "MemoryHUGE");
+}
+
+inline void core_state_matrix(std::size_t N, std::size_t M)
+{
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << std::setw(20) << std::left << "Layout";
+    std::cout << std::setw(20) << std::left << "Memory";
+    std::cout << std::setw(15) << std::right << "select";
+    std::cout << std::setw(15) << std::right << "first_touch";
+    std::cout << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    core_state_matrix<mckl::RowMajor>(N, M, "RowMajor");
+    core_state_matrix<mckl::ColMajor>(N, M, "ColMajor");
+    std::cout << std::string(70, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_CORE_STATE_MATRIX_HPP
@@ -0,0 +1,378 @@
+//============================================================================
+// MCKL/example/math/include/math_special.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_MATH_SPECIAL_HPP
+#define MCKL_EXAMPLE_MATH_SPECIAL_HPP
+
+#include "math_common.hpp"
+
+// Reference digamma function in extended precision
+inline long double math_special_digamma_ref(long double x)
+{
+    if (x <= 0) {
+        const long double pi = 3.141592653589793238462643383279502884L;
+        return math_special_digamma_ref(1 - x) - pi / std::tan(pi * x);
+    }
+
+    long double r = 0;
+    while (x < 20) {
+        r -= 1 / x;
+        x += 1;
+    }
+    const long double c[] = {1.0L / 12, -1.0L / 120, 1.0L / 252, -1.0L / 240,
+        1.0L / 132, -691.0L / 32760, 1.0L / 12};
+    const long double x2 = 1 / (x * x);
+    long double s = 0;
+    for (std::size_t i = 7; i != 0; --i) {
+        s = s * x2 + c[i - 1];
+    }
+    s *= x2;
+
+    return r + std::log(x) - 0.5L / x - s;
+}
+
+template <typename T, typename U, typename Gen, typename Ref, typename Vec>
+inline void math_special(std::size_t N, std::size_t M, const std::string &name,
+    Gen &&gen, Ref &&ref, Vec &&vec, mckl::Vector<MathPerf> &perf)
+{
+    mckl::UniformIntDistribution<std::size_t> rsize(N / 2, N);
+    mckl::RNG_64 rng;
+
+    mckl::Vector<U> r1(N);
+    mckl::Vector<T> r2(N);
+
+    bool has_cycles = mckl::StopWatch::has_cycles();
+
+    T e1 = 0;
+    T e2 = 0;
+    double c1 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    double c2 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    for (std::size_t k = 0; k != 10; ++k) {
+        std::size_t n = 0;
+        mckl::StopWatch watch1;
+        mckl::StopWatch watch2;
+        for (std::size_t i = 0; i != M; ++i) {
+            std::size_t K = rsize(rng);
+            n += K;
+            gen(rng, K);
+
+            watch1.start();
+            ref(K, r1.data());
+            watch1.stop();
+
+            vec(K, r2.data());
+            watch2.start();
+            vec(K, r2.data());
+            watch2.stop();
+
+            math_error(K, r2.data(), r1.data(), e1, e2);
+        }
+        if (has_cycles) {
+            c1 = std::min(c1, 1.0 * watch1.cycles() / n);
+            c2 = std::min(c2, 1.0 * watch2.cycles() / n);
+        } else {
+            c1 = std::max(c1, n / watch1.seconds() * 1e-6);
+            c2 = std::max(c2, n / watch2.seconds() * 1e-6);
+        }
+    }
+
+    MathPerf result;
+    result.name = name;
+    result.e3 = static_cast<double>(e1);
+    result.e4 = static_cast<double>(e2);
+    result.c1 = c1;
+    result.c2 = c2;
+
+    perf.push_back(result);
+}
+
+template <typename T>
+inline void math_special_lgamma(std::size_t N, std::size_t M,
+    const std::string &name, mckl::Vector<MathPerf> &perf)
+{
+    mckl::UniformRealDistribution<T> unif(static_cast<T>(1e-3), 1000);
+    mckl::Vector<T> a(N);
+
+    math_special<T, long double>(N, M, name,
+        [&](mckl::RNG_64 &rng, std::size_t n) {
+            mckl::rand(rng, unif, n, a.data());
+        },
+        [&](std::size_t n, long double *r) {
+            for (std::size_t i = 0; i != n; ++i) {
+                r[i] = std::lgamma(static_cast<long double>(a[i]));
+            }
+        },
+        [&](std::size_t n, T *r) { mckl::lgamma(n, a.data(), r); }, perf);
+}
+
+template <typename T>
+inline void math_special_digamma(std::size_t N, std::size_t M,
+    const std::string &name, mckl::Vector<MathPerf> &perf)
+{
+    mckl::UniformRealDistribution<T> unif(static_cast<T>(1e-3), 1000);
+    mckl::Vector<T> a(N);
+
+    math_special<T, long double>(N, M, name,
+        [&](mckl::RNG_64 &rng, std::size_t n) {
+            mckl::rand(rng, unif, n, a.data());
+        },
+        [&](std::size_t n, long double *r) {
+            for (std::size_t i = 0; i != n; ++i) {
+                r[i] =
+                    math_special_digamma_ref(static_cast<long double>(a[i]));
+            }
+        },
+        [&](std::size_t n, T *r) { mckl::digamma(n, a.data(), r); }, perf);
+}
+
+// Reference incomplete Gamma functions in extended precision, for integer
+// and half integer a, summing only positive terms
+// P(a, x) = exp(-x) sum_{k >= 0} x^(a + k) / Gamma(a + k + 1)
+// Q(n, x) = exp(-x) sum_{k < n} x^k / k!
+// Q(n + 1/2, x) = erfc(sqrt(x)) + exp(-x) sum_{k < n} x^(k + 1/2) / (k + 1/2)!
+inline long double math_special_gammapq_ref(
+    long double a, long double x, bool lower)
+{
+    const long double eps = std::numeric_limits<long double>::epsilon();
+    const long double b = a - std::floor(a);
+
+    long double s = 0;
+    long double t = 0;
+    if (lower) {
+        t = std::exp(-x + a * std::log(x) - std::lgamma(a + 1));
+        for (long double k = a + 1; t > s * eps; k += 1) {
+            s += t;
+            t *= x / k;
+        }
+    } else {
+        s = b > 0 ? std::erfc(std::sqrt(x)) : 0;
+        t = std::exp(-x + b * std::log(x) - std::lgamma(b + 1));
+        for (long double k = b; k < a; k += 1) {
+            s += t;
+            t *= x / (k + 1);
+        }
+    }
+
+    return s;
+}
+
+// Reference regularized incomplete Beta function in extended precision, for
+// integer a and b
+// I_x(a, b) = sum_{a <= k < a + b} C(a + b - 1, k) x^k (1 - x)^(a + b - 1 - k)
+inline long double math_special_betai_ref(
+    long double a, long double b, long double x)
+{
+    const long double n = a + b - 1;
+    const long double lx = std::log(x);
+    const long double ly = std::log1p(-x);
+    const long double ln = std::lgamma(n + 1);
+
+    long double s = 0;
+    for (long double k = a; k <= n; k += 1) {
+        s += std::exp(ln - std::lgamma(k + 1) - std::lgamma(n - k + 1) +
+            k * lx + (n - k) * ly);
+    }
+
+    return s;
+}
+
+inline void math_special_gammap(std::size_t N, std::size_t M,
+    const std::string &name, bool lower, mckl::Vector<MathPerf> &perf)
+{
+    mckl::UniformIntDistribution<int> unifa(1, 400);
+    mckl::UniformRealDistribution<double> unifu(0, 1);
+    mckl::Vector<double> a(N);
+    mckl::Vector<double> x(N);
+
+    math_special<double, long double>(N, M, name,
+        [&](mckl::RNG_64 &rng, std::size_t n) {
+            mckl::rand(rng, unifu, n, x.data());
+            for (std::size_t i = 0; i != n; ++i) {
+                a[i] = 0.5 * unifa(rng);
+                x[i] *= 2 * a[i] + 10;
+            }
+        },
+        [&](std::size_t n, long double *r) {
+            for (std::size_t i = 0; i != n; ++i) {
+                r[i] = math_special_gammapq_ref(a[i], x[i], lower);
+            }
+        },
+        [&](std::size_t n, double *r) {
+            if (lower) {
+                mckl::gammap(n, a.data(), x.data(), r);
+            } else {
+                mckl::gammaq(n, a.data(), x.data(), r);
+            }
+        },
+        perf);
+}
+
+// The reference inverse is the x from which p is computed, within three
+// standard deviations of the mean
+inline void math_special_gammapinv(std::size_t N, std::size_t M,
+    const std::string &name, mckl::Vector<MathPerf> &perf)
+{
+    mckl::UniformIntDistribution<int> unifa(1, 400);
+    mckl::UniformRealDistribution<double> unifz(-3, 3);
+    mckl::Vector<double> a(N);
+    mckl::Vector<double> x(N);
+    mckl::Vector<double> p(N);
+
+    math_special<double, double>(N, M, name,
+        [&](mckl::RNG_64 &rng, std::size_t n) {
+            for (std::size_t i = 0; i != n; ++i) {
+                a[i] = 0.5 * unifa(rng);
+                x[i] = std::max(
+                    a[i] + unifz(rng) * std::sqrt(a[i]), 0.01 * a[i]);
+                p[i] = static_cast<double>(
+                    math_special_gammapq_ref(a[i], x[i], true));
+            }
+        },
+        [&](std::size_t n, double *r) { std::copy_n(x.data(), n, r); },
+        [&](std::size_t n, double *r) {
+            mckl::gammapinv(n, a.data(), p.data(), r);
+        },
+        perf);
+}
+
+inline void math_special_betai(std::size_t N, std::size_t M,
+    const std::string &name, mckl::Vector<MathPerf> &perf)
+{
+    mckl::UniformIntDistribution<int> unifab(1, 100);
+    mckl::UniformRealDistribution<double> unifx(0, 1);
+    mckl::Vector<double> a(N);
+    mckl::Vector<double> b(N);
+    mckl::Vector<double> x(N);
+
+    math_special<double, long double>(N, M, name,
+        [&](mckl::RNG_64 &rng, std::size_t n) {
+            mckl::rand(rng, unifx, n, x.data());
+            for (std::size_t i = 0; i != n; ++i) {
+                a[i] = unifab(rng);
+                b[i] = unifab(rng);
+            }
+        },
+        [&](std::size_t n, long double *r) {
+            for (std::size_t i = 0; i != n; ++i) {
+                r[i] = math_special_betai_ref(a[i], b[i], x[i]);
+            }
+        },
+        [&](std::size_t n, double *r) {
+            mckl::betai(n, a.data(), b.data(), x.data(), r);
+        },
+        perf);
+}
+
+// The reference inverse is the x from which p is computed, within three
+// standard deviations of the mean and away from the boundaries, where 1 - p
+// is not representable to full precision
+inline void math_special_betaiinv(std::size_t N, std::size_t M,
+    const std::string &name, mckl::Vector<MathPerf> &perf)
+{
+    mckl::UniformIntDistribution<int> unifab(1, 100);
+    mckl::UniformRealDistribution<double> unifz(-3, 3);
+    mckl::Vector<double> a(N);
+    mckl::Vector<double> b(N);
+    mckl::Vector<double> x(N);
+    mckl::Vector<double> p(N);
+
+    math_special<double, double>(N, M, name,
+        [&](mckl::RNG_64 &rng, std::size_t n) {
+            for (std::size_t i = 0; i != n; ++i) {
+                a[i] = unifab(rng);
+                b[i] = unifab(rng);
+                const double ab = a[i] + b[i];
+                const double mu = a[i] / ab;
+                const double sd = std::sqrt(mu * (1 - mu) / (ab + 1));
+                x[i] = std::min(std::max(mu + unifz(rng) * sd, 0.5 * mu),
+                    1 - 0.5 * (1 - mu));
+                p[i] = static_cast<double>(
+                    math_special_betai_ref(a[i], b[i], x[i]));
+            }
+        },
+        [&](std::size_t n, double *r) { std::copy_n(x.data(), n, r); },
+        [&](std::size_t n, double *r) {
+            mckl::betaiinv(n, a.data(), b.data(), p.data(), r);
+        },
+        perf);
+}
+
+inline void math_special(std::size_t N, std::size_t M)
+{
+    mckl::Vector<MathPerf> perf;
+
+    math_special_lgamma<float>(N, M, "lgammaf", perf);
+    math_special_lgamma<double>(N, M, "lgamma", perf);
+    math_special_digamma<float>(N, M, "digammaf", perf);
+    math_special_digamma<double>(N, M, "digamma", perf);
+    math_special_gammap(N, M, "gammap", true, perf);
+    math_special_gammap(N, M, "gammaq", false, perf);
+    math_special_gammapinv(N, M, "gammapinv", perf);
+    math_special_betai(N, M, "betai", perf);
+    math_special_betaiinv(N, M, "betaiinv", perf);
+
+    const int nwid = 10;
+    const int twid = 12;
+    const int ewid = 15;
+    const std::size_t lwid = nwid + twid * 2 + ewid * 2;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+
+    std::cout << std::setw(nwid) << std::left << "Function";
+    if (mckl::StopWatch::has_cycles()) {
+        std::cout << std::setw(twid) << std::right << "cpE (Ref)";
+        std::cout << std::setw(twid) << std::right << "cpE (VMF)";
+    } else {
+        std::cout << std::setw(twid) << std::right << "ME/s (Ref)";
+        std::cout << std::setw(twid) << std::right << "ME/s (VMF)";
+    }
+    std::cout << std::setw(ewid) << std::right << "Err.Abs";
+    std::cout << std::setw(ewid) << std::right << math_error();
+    std::cout << std::endl;
+
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    for (std::size_t i = 0; i != perf.size(); ++i) {
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << std::setw(nwid) << std::left << perf[i].name;
+        std::cout << std::setw(twid) << std::right << perf[i].c1;
+        std::cout << std::setw(twid) << std::right << perf[i].c2;
+        std::cout.unsetf(std::ios_base::floatfield);
+        std::cout << std::setprecision(2);
+        std::cout << std::setw(ewid) << std::right << perf[i].e3;
+        std::cout << std::setw(ewid) << std::right << perf[i].e4;
+        std::cout << std::endl;
+    }
+
+    std::cout << std::string(lwid, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_MATH_SPECIAL_HPP
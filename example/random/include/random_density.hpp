@@ -0,0 +1,450 @@
+//============================================================================
+// MCKL/example/random/include/random_density.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_DENSITY_HPP
+#define MCKL_EXAMPLE_RANDOM_DENSITY_HPP
+
+#include <mckl/random.hpp>
+#include "random_common.hpp"
+
+#define MCKL_EXAMPLE_RANDOM_DENSITY_FUNCTION_1(name, func, p1)                \
+    [&](std::size_t n, const double *x, double *r, const double *v,           \
+        bool array) {                                                         \
+        if (v == nullptr) {                                                   \
+            mckl::name##_##func(n, x, dist.param(), r);                       \
+        } else if (array) {                                                   \
+            mckl::Vector<double> a(n);                                        \
+            mckl::mul(n, dist.p1(), v, a.data());                             \
+            mckl::name##_##func(n, x, a.data(), r);                           \
+        } else {                                                              \
+            for (std::size_t i = 0; i != n; ++i) {                            \
+                mckl::name##_##func(1, x + i, dist.p1() * v[i], r + i);       \
+            }                                                                 \
+        }                                                                     \
+    }
+
+#define MCKL_EXAMPLE_RANDOM_DENSITY_FUNCTION_2(name, func, p1, p2)            \
+    [&](std::size_t n, const double *x, double *r, const double *v,           \
+        bool array) {                                                         \
+        if (v == nullptr) {                                                   \
+            mckl::name##_##func(n, x, dist.param(), r);                       \
+        } else if (array) {                                                   \
+            mckl::Vector<double> a(n);                                        \
+            mckl::Vector<double> b(n);                                        \
+            mckl::mul(n, dist.p1(), v, a.data());                             \
+            mckl::mul(n, dist.p2(), v, b.data());                             \
+            mckl::name##_##func(n, x, a.data(), b.data(), r);                 \
+        } else {                                                              \
+            for (std::size_t i = 0; i != n; ++i) {                            \
+                mckl::name##_##func(                                          \
+                    1, x + i, dist.p1() * v[i], dist.p2() * v[i], r + i);     \
+            }                                                                 \
+        }                                                                     \
+    }
+
+#define MCKL_EXAMPLE_RANDOM_DENSITY_1(Name, name, p1, a1)                     \
+    {                                                                         \
+        mckl::Name##Distribution<double> dist(a1);                            \
+        random_density(N, M, #Name "(" #a1 ")",                               \
+            MCKL_EXAMPLE_RANDOM_DENSITY_FUNCTION_1(name, logpdf, p1),         \
+            MCKL_EXAMPLE_RANDOM_DENSITY_FUNCTION_1(name, cdf, p1),            \
+            MCKL_EXAMPLE_RANDOM_DENSITY_FUNCTION_1(name, quantile, p1),       \
+            [&](double x) { return random_density_##name##_cdf(x, a1); },     \
+            [&](mckl::RNG_64 &rng, std::size_t n, double *r) {                \
+                mckl::rand(rng, dist, n, r);                                  \
+            });                                                               \
+    }
+
+#define MCKL_EXAMPLE_RANDOM_DENSITY_2(Name, name, p1, p2, a1, a2)             \
+    {                                                                         \
+        mckl::Name##Distribution<double> dist(a1, a2);                        \
+        random_density(N, M, #Name "(" #a1 ", " #a2 ")",                      \
+            MCKL_EXAMPLE_RANDOM_DENSITY_FUNCTION_2(name, logpdf, p1, p2),     \
+            MCKL_EXAMPLE_RANDOM_DENSITY_FUNCTION_2(name, cdf, p1, p2),        \
+            MCKL_EXAMPLE_RANDOM_DENSITY_FUNCTION_2(name, quantile, p1, p2),   \
+            [&](double x) { return random_density_##name##_cdf(x, a1, a2); }, \
+            [&](mckl::RNG_64 &rng, std::size_t n, double *r) {                \
+                mckl::rand(rng, dist, n, r);                                  \
+            });                                                               \
+    }
+
+// Regularized incomplete Gamma function for a multiple of 1/2, in closed
+// form with P(a + 1, x) = P(a, x) - x^a e^{-x} / Gamma(a + 1)
+inline double random_density_gammap(double a, double x)
+{
+    if (x <= 0)
+        return 0;
+
+    double c = a - std::floor(a) > 0 ? 0.5 : 1;
+    double p = c < 1 ? std::erf(std::sqrt(x)) : -std::expm1(-x);
+    for (; c < a; c += 1)
+        p -= std::exp(c * std::log(x) - x - std::lgamma(c + 1));
+
+    return p;
+}
+
+// Regularized incomplete Beta function for a and b multiples of 1/2, in
+// closed form with
+// I_x(a + 1, b) = I_x(a, b) - x^a (1 - x)^b / (a B(a, b))
+// I_x(a, b + 1) = I_x(a, b) + x^a (1 - x)^b / (b B(a, b))
+inline double random_density_betai(double a, double b, double x)
+{
+    if (x <= 0)
+        return 0;
+    if (x >= 1)
+        return 1;
+
+    const double pi = 3.141592653589793238462643383279502884;
+    const double lx = std::log(x);
+    const double ly = std::log1p(-x);
+    double c = a - std::floor(a) > 0 ? 0.5 : 1;
+    double d = b - std::floor(b) > 0 ? 0.5 : 1;
+    double p = 0;
+    if (c < 1 && d < 1)
+        p = 2 / pi * std::asin(std::sqrt(x));
+    else if (c < 1)
+        p = std::sqrt(x);
+    else if (d < 1)
+        p = -std::expm1(0.5 * ly);
+    else
+        p = x;
+    auto t = [&]() {
+        return std::exp(c * lx + d * ly - std::lgamma(c) - std::lgamma(d) +
+            std::lgamma(c + d));
+    };
+    for (; c < a; c += 1)
+        p -= t() / c;
+    for (; d < b; d += 1)
+        p += t() / d;
+
+    return p;
+}
+
+// Reference CDF of each distribution
+inline double random_density_arcsine_cdf(double x, double a, double b)
+{
+    const double pi = 3.141592653589793238462643383279502884;
+
+    return 2 / pi * std::asin(std::sqrt((x - a) / (b - a)));
+}
+
+inline double random_density_beta_cdf(double x, double a, double b)
+{
+    return random_density_betai(a, b, x);
+}
+
+inline double random_density_cauchy_cdf(double x, double a, double b)
+{
+    const double pi = 3.141592653589793238462643383279502884;
+
+    return 0.5 + std::atan((x - a) / b) / pi;
+}
+
+inline double random_density_chi_squared_cdf(double x, double n)
+{
+    return random_density_gammap(0.5 * n, 0.5 * x);
+}
+
+inline double random_density_exponential_cdf(double x, double lambda)
+{
+    return -std::expm1(-lambda * x);
+}
+
+inline double random_density_extreme_value_cdf(double x, double a, double b)
+{
+    return std::exp(-std::exp((a - x) / b));
+}
+
+inline double random_density_fisher_f_cdf(double x, double m, double n)
+{
+    return random_density_betai(0.5 * m, 0.5 * n, m * x / (m * x + n));
+}
+
+inline double random_density_gamma_cdf(double x, double alpha, double beta)
+{
+    return random_density_gammap(alpha, x / beta);
+}
+
+inline double random_density_laplace_cdf(double x, double a, double b)
+{
+    return x < a ? 0.5 * std::exp((x - a) / b) :
+                   1 - 0.5 * std::exp((a - x) / b);
+}
+
+inline double random_density_levy_cdf(double x, double a, double b)
+{
+    return std::erfc(std::sqrt(0.5 * b / (x - a)));
+}
+
+inline double random_density_logistic_cdf(double x, double a, double b)
+{
+    return 1 / (1 + std::exp((a - x) / b));
+}
+
+inline double random_density_lognormal_cdf(double x, double m, double s)
+{
+    return 0.5 * std::erfc((m - std::log(x)) / (s * std::sqrt(2.0)));
+}
+
+inline double random_density_normal_cdf(double x, double mean, double stddev)
+{
+    return 0.5 * std::erfc((mean - x) / (stddev * std::sqrt(2.0)));
+}
+
+inline double random_density_pareto_cdf(double x, double a, double b)
+{
+    return 1 - std::pow(b / x, a);
+}
+
+inline double random_density_rayleigh_cdf(double x, double sigma)
+{
+    return -std::expm1(-0.5 * x * x / (sigma * sigma));
+}
+
+inline double random_density_student_t_cdf(double x, double n)
+{
+    const double p = 0.5 * random_density_betai(0.5 * n, 0.5, n / (n + x * x));
+
+    return x > 0 ? 1 - p : p;
+}
+
+inline double random_density_uniform_real_cdf(double x, double a, double b)
+{
+    return (x - a) / (b - a);
+}
+
+inline double random_density_weibull_cdf(double x, double a, double b)
+{
+    return -std::expm1(-std::pow(x / b, a));
+}
+
+inline double random_density_error(std::size_t n, const double *r1,
+    const double *r2, bool relative = false)
+{
+    double e = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        double d = std::abs(r1[i] - r2[i]);
+        if (relative)
+            d /= std::max(std::abs(r1[i]), std::abs(r2[i]));
+        if (std::isfinite(r1[i]) || std::isfinite(r2[i]))
+            e = std::max(e, d);
+    }
+
+    return e;
+}
+
+template <typename LogPDF, typename CDF, typename Quantile,
+    typename Reference, typename Rand>
+inline void random_density(std::size_t N, std::size_t M,
+    const std::string &name, LogPDF &&logpdf, CDF &&cdf, Quantile &&quantile,
+    Reference &&reference, Rand &&rand)
+{
+    mckl::UniformIntDistribution<std::size_t> rsize(N / 2, N);
+    mckl::UniformRealDistribution<double> unifu(0.001, 0.999);
+    mckl::UniformRealDistribution<double> unifv(0.5, 2);
+    mckl::RNG_64 rng;
+
+    mckl::Vector<double> u(N);
+    mckl::Vector<double> v(N);
+    mckl::Vector<double> x(N);
+    mckl::Vector<double> h(N);
+    mckl::Vector<double> r1(N);
+    mckl::Vector<double> r2(N);
+    mckl::Vector<double> r3(N);
+
+    // Round trip of the quantile and the CDF
+    double e1 = 0;
+    // Density against the numerical derivative of the quantile
+    double e2 = 0;
+    // Parameters for each element against the same parameters one by one
+    double e3 = 0;
+    for (std::size_t i = 0; i != M; ++i) {
+        std::size_t K = rsize(rng);
+        mckl::rand(rng, unifu, K, u.data());
+        mckl::rand(rng, unifv, K, v.data());
+
+        quantile(K, u.data(), x.data(), nullptr, false);
+        cdf(K, x.data(), r1.data(), nullptr, false);
+        e1 = std::max(e1, random_density_error(K, u.data(), r1.data()));
+
+        for (std::size_t j = 0; j != K; ++j)
+            h[j] = 1e-5 * std::min(u[j], 1 - u[j]);
+        mckl::add(K, u.data(), h.data(), r1.data());
+        mckl::sub(K, u.data(), h.data(), r2.data());
+        quantile(K, r1.data(), r1.data(), nullptr, false);
+        quantile(K, r2.data(), r2.data(), nullptr, false);
+        for (std::size_t j = 0; j != K; ++j)
+            r1[j] = 2 * h[j] / (r1[j] - r2[j]);
+        logpdf(K, x.data(), r2.data(), nullptr, false);
+        mckl::exp(K, r2.data(), r2.data());
+        e2 = std::max(e2, random_density_error(K, r1.data(), r2.data(), true));
+
+        logpdf(K, x.data(), r1.data(), v.data(), true);
+        logpdf(K, x.data(), r2.data(), v.data(), false);
+        e3 = std::max(e3, random_density_error(K, r1.data(), r2.data(), true));
+        cdf(K, x.data(), r1.data(), v.data(), true);
+        cdf(K, x.data(), r2.data(), v.data(), false);
+        e3 = std::max(e3, random_density_error(K, r1.data(), r2.data(), true));
+        quantile(K, u.data(), r1.data(), v.data(), true);
+        quantile(K, u.data(), r2.data(), v.data(), false);
+        e3 = std::max(e3, random_density_error(K, r1.data(), r2.data(), true));
+    }
+
+    // CDF and quantile against the reference CDF on a grid of probabilities
+    double e4 = 0;
+    const std::size_t L = 99;
+    for (std::size_t j = 0; j != L; ++j)
+        u[j] = (j + 1.0) / (L + 1);
+    quantile(L, u.data(), x.data(), nullptr, false);
+    cdf(L, x.data(), r1.data(), nullptr, false);
+    for (std::size_t j = 0; j != L; ++j) {
+        const double c = reference(x[j]);
+        e4 = std::max(e4, std::abs(c - u[j]));
+        e4 = std::max(e4, std::abs(c - r1[j]));
+    }
+
+    // Kolmogorov-Smirnov statistic of the CDF of samples, scaled by sqrt(N)
+    double e5 = 0;
+    rand(rng, N, x.data());
+    cdf(N, x.data(), r1.data(), nullptr, false);
+    std::sort(r1.begin(), r1.end());
+    for (std::size_t j = 0; j != N; ++j) {
+        e5 = std::max(e5, (j + 1.0) / N - r1[j]);
+        e5 = std::max(e5, r1[j] - 1.0 * j / N);
+    }
+    e5 *= std::sqrt(static_cast<double>(N));
+
+    bool has_cycles = mckl::StopWatch::has_cycles();
+    double c1 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    double c2 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    double c3 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    for (std::size_t k = 0; k != 10; ++k) {
+        std::size_t n = 0;
+        mckl::StopWatch watch1;
+        mckl::StopWatch watch2;
+        mckl::StopWatch watch3;
+        for (std::size_t i = 0; i != M; ++i) {
+            std::size_t K = rsize(rng);
+            n += K;
+            mckl::rand(rng, unifu, K, u.data());
+
+            watch3.start();
+            quantile(K, u.data(), x.data(), nullptr, false);
+            watch3.stop();
+
+            watch1.start();
+            logpdf(K, x.data(), r1.data(), nullptr, false);
+            watch1.stop();
+
+            watch2.start();
+            cdf(K, x.data(), r2.data(), nullptr, false);
+            watch2.stop();
+        }
+        if (has_cycles) {
+            c1 = std::min(c1, 1.0 * watch1.cycles() / n);
+            c2 = std::min(c2, 1.0 * watch2.cycles() / n);
+            c3 = std::min(c3, 1.0 * watch3.cycles() / n);
+        } else {
+            c1 = std::max(c1, n / watch1.seconds() * 1e-6);
+            c2 = std::max(c2, n / watch2.seconds() * 1e-6);
+            c3 = std::max(c3, n / watch3.seconds() * 1e-6);
+        }
+    }
+
+    // The Kolmogorov-Smirnov bound is the 0.999 quantile of its limiting
+    // distribution
+    const bool pass =
+        e1 < 1e-10 && e2 < 1e-4 && e3 < 1e-10 && e4 < 1e-10 && e5 < 1.95;
+
+    std::cout << std::setw(30) << std::left << name;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(12) << std::right << c1;
+    std::cout << std::setw(12) << std::right << c2;
+    std::cout << std::setw(12) << std::right << c3;
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setw(12) << std::right << e1;
+    std::cout << std::setw(12) << std::right << e2;
+    std::cout << std::setw(12) << std::right << e3;
+    std::cout << std::setw(12) << std::right << e4;
+    std::cout << std::setw(12) << std::right << e5;
+    std::cout << std::setw(15) << std::right << random_pass(pass);
+    std::cout << std::endl;
+}
+
+inline void random_density(std::size_t N, std::size_t M)
+{
+    const std::size_t lwid = 30 + 12 * 8 + 15;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(30) << std::left << "Distribution";
+    if (mckl::StopWatch::has_cycles()) {
+        std::cout << std::setw(12) << std::right << "cpE (PDF)";
+        std::cout << std::setw(12) << std::right << "cpE (CDF)";
+        std::cout << std::setw(12) << std::right << "cpE (Inv)";
+    } else {
+        std::cout << std::setw(12) << std::right << "ME/s (PDF)";
+        std::cout << std::setw(12) << std::right << "ME/s (CDF)";
+        std::cout << std::setw(12) << std::right << "ME/s (Inv)";
+    }
+    std::cout << std::setw(12) << std::right << "Err (Inv)";
+    std::cout << std::setw(12) << std::right << "Err (PDF)";
+    std::cout << std::setw(12) << std::right << "Err (Par)";
+    std::cout << std::setw(12) << std::right << "Err (Ref)";
+    std::cout << std::setw(12) << std::right << "KS";
+    std::cout << std::setw(15) << std::right << "Deterministics";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Arcsine, arcsine, a, b, 0.5, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Beta, beta, alpha, beta, 0.5, 0.5)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Beta, beta, alpha, beta, 2, 3)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Cauchy, cauchy, a, b, 1, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_1(ChiSquared, chi_squared, n, 3)
+    MCKL_EXAMPLE_RANDOM_DENSITY_1(Exponential, exponential, lambda, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(ExtremeValue, extreme_value, a, b, 1, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(FisherF, fisher_f, m, n, 3, 5)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Gamma, gamma, alpha, beta, 0.5, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Gamma, gamma, alpha, beta, 3, 0.5)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Laplace, laplace, a, b, 1, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Levy, levy, a, b, 1, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Logistic, logistic, a, b, 1, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Lognormal, lognormal, m, s, 0.5, 1.5)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Normal, normal, mean, stddev, 1, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Pareto, pareto, a, b, 2, 3)
+    MCKL_EXAMPLE_RANDOM_DENSITY_1(Rayleigh, rayleigh, sigma, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_1(StudentT, student_t, n, 3)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(UniformReal, uniform_real, a, b, -1, 2)
+    MCKL_EXAMPLE_RANDOM_DENSITY_2(Weibull, weibull, a, b, 1.5, 2)
+
+    std::cout << std::string(lwid, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_DENSITY_HPP
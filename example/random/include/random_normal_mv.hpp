@@ -36,14 +36,45 @@
 #include <mckl/random/normal_mv_distribution.hpp>
 #include "random_distribution.hpp"
 
+template <typename DistributionType, typename RealType>
+inline void random_normal_mv_param(DistributionType &dist,
+    const RealType *mean, const RealType *chol, bool scalar_mean,
+    bool scalar_chol)
+{
+    using param_type = typename DistributionType::param_type;
+
+    if (scalar_mean && scalar_chol)
+        dist.param(param_type(2, mean[0], chol[0]));
+    else if (scalar_mean && !scalar_chol)
+        dist.param(param_type(2, mean[0], chol));
+    else if (!scalar_mean && scalar_chol)
+        dist.param(param_type(2, mean, chol[0]));
+    else
+        dist.param(param_type(2, mean, chol));
+}
+
+template <typename RealType, mckl::MatrixLayout Layout>
+inline bool random_normal_mv_near(const mckl::Matrix<RealType, Layout> &r1,
+    const mckl::Matrix<RealType, Layout> &r2)
+{
+    const RealType eps = std::numeric_limits<RealType>::epsilon() * 100;
+    for (std::size_t i = 0; i != r1.nrow(); ++i) {
+        for (std::size_t j = 0; j != r1.ncol(); ++j) {
+            const RealType a = r1(i, j);
+            const RealType b = r2(i, j);
+            if (std::abs(a - b) > eps * (1 + std::abs(a)))
+                return false;
+        }
+    }
+
+    return true;
+}
+
 template <typename RealType>
 inline void random_normal_mv(std::size_t N, std::size_t M,
     const RealType *mean, const RealType *chol, bool scalar_mean,
     bool scalar_chol)
 {
-    using param_type =
-        typename mckl::NormalMVDistribution<RealType>::param_type;
-
     MCKLRNGType rng;
     MCKLRNGType rng1;
     MCKLRNGType rng2;
@@ -53,19 +84,17 @@ inline void random_normal_mv(std::size_t N, std::size_t M,
 
     mckl::UniformIntDistribution<std::size_t> rsize(N / 2, N);
     mckl::NormalMVDistribution<RealType> dist;
-    if (scalar_mean && scalar_chol)
-        dist.param(param_type(2, mean[0], chol[0]));
-    else if (scalar_mean && !scalar_chol)
-        dist.param(param_type(2, mean[0], chol));
-    else if (!scalar_mean && scalar_chol)
-        dist.param(param_type(2, mean, chol[0]));
-    else
-        dist.param(param_type(2, mean, chol));
+    mckl::NormalMVDistribution<RealType, 2> distf;
+    random_normal_mv_param(dist, mean, chol, scalar_mean, scalar_chol);
+    random_normal_mv_param(distf, mean, chol, scalar_mean, scalar_chol);
 
     bool pass = true;
 
     mckl::Matrix<RealType, mckl::RowMajor> r1;
     mckl::Matrix<RealType, mckl::RowMajor> r2;
+    mckl::Matrix<RealType, mckl::RowMajor> rf;
+    mckl::Matrix<RealType, mckl::ColMajor> s1;
+    mckl::Matrix<RealType, mckl::ColMajor> s2;
 #if MCKL_HAS_MKL
     mckl::Matrix<RealType, mckl::RowMajor> r3;
 #endif
@@ -90,11 +119,25 @@ inline void random_normal_mv(std::size_t N, std::size_t M,
         ssb >> dist;
         mckl::rand(rng2, dist, K, r2.data());
         pass = pass && r1 == r2;
+
+        MCKLRNGType rngf1(rng);
+        MCKLRNGType rngf2(rng);
+        mckl::rand(rngf1, dist, K, r1.data());
+        mckl::rand(rngf2, distf, K, r2.data());
+        pass = pass && random_normal_mv_near(r1, r2);
+
+        s1.resize(K, 2);
+        s2.resize(K, 2);
+        mckl::rand(rngf1, dist, mckl::ColMajor, K, s1.data(), K);
+        mckl::rand(rngf2, distf, mckl::ColMajor, K, s2.data(), K);
+        pass = pass && random_normal_mv_near(s1, s2);
     }
 
     bool has_cycles = mckl::StopWatch::has_cycles();
     double c1 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
     double c2 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    double cf = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    double cc = has_cycles ? std::numeric_limits<double>::max() : 0.0;
 #if MCKL_HAS_MKL
     double c3 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
 #endif
@@ -102,6 +145,8 @@ inline void random_normal_mv(std::size_t N, std::size_t M,
         std::size_t num = 0;
         mckl::StopWatch watch1;
         mckl::StopWatch watch2;
+        mckl::StopWatch watchf;
+        mckl::StopWatch watchc;
 #if MCKL_HAS_MKL
         mckl::StopWatch watch3;
 #endif
@@ -110,6 +155,8 @@ inline void random_normal_mv(std::size_t N, std::size_t M,
             num += K * 2;
             r1.resize(K, 2);
             r2.resize(K, 2);
+            rf.resize(K, 2);
+            s1.resize(K, 2);
 #if MCKL_HAS_MKL
             r3.resize(K, 2);
 #endif
@@ -124,6 +171,14 @@ inline void random_normal_mv(std::size_t N, std::size_t M,
             mckl::rand(rng, dist, K, r2.data());
             watch2.stop();
 
+            watchf.start();
+            mckl::rand(rng, distf, K, rf.data());
+            watchf.stop();
+
+            watchc.start();
+            mckl::rand(rng, distf, mckl::ColMajor, K, s1.data(), K);
+            watchc.stop();
+
 #if MCKL_HAS_MKL
             watch3.start();
             mckl::rand(rng_mkl, dist, K, r3.data());
@@ -138,12 +193,16 @@ inline void random_normal_mv(std::size_t N, std::size_t M,
         if (has_cycles) {
             c1 = std::min(c1, 1.0 * watch1.cycles() / num);
             c2 = std::min(c2, 1.0 * watch2.cycles() / num);
+            cf = std::min(cf, 1.0 * watchf.cycles() / num);
+            cc = std::min(cc, 1.0 * watchc.cycles() / num);
 #if MCKL_HAS_MKL
             c3 = std::min(c3, 1.0 * watch3.cycles() / num);
 #endif
         } else {
             c1 = std::max(c1, num / watch1.seconds() * 1e-6);
             c2 = std::max(c2, num / watch2.seconds() * 1e-6);
+            cf = std::max(cf, num / watchf.seconds() * 1e-6);
+            cc = std::max(cc, num / watchc.seconds() * 1e-6);
 #if MCKL_HAS_MKL
             c3 = std::max(c3, num / watch3.seconds() * 1e-6);
 #endif
@@ -160,6 +219,8 @@ inline void random_normal_mv(std::size_t N, std::size_t M,
     std::cout << std::setw(40) << std::left << ss.str();
     std::cout << std::setw(12) << std::right << c1;
     std::cout << std::setw(12) << std::right << c2;
+    std::cout << std::setw(12) << std::right << cf;
+    std::cout << std::setw(12) << std::right << cc;
 #if MCKL_HAS_MKL
     std::cout << std::setw(12) << std::right << c3;
 #endif
@@ -202,19 +263,23 @@ inline void random_normal_mv(std::size_t N, std::size_t M)
     txt << "V1\tV2\tDistribution\tImplementation\n";
     txt.close();
 
-    constexpr std::size_t lwid = 40 + 12 * (2 + MCKL_HAS_MKL) + 15;
+    constexpr std::size_t lwid = 40 + 12 * (4 + MCKL_HAS_MKL) + 15;
 
     std::cout << std::string(lwid, '=') << std::endl;
     std::cout << std::setw(40) << std::left << "Distribution";
     if (mckl::StopWatch::has_cycles()) {
         std::cout << std::setw(12) << std::right << "cpE (S)";
         std::cout << std::setw(12) << std::right << "cpE (B)";
+        std::cout << std::setw(12) << std::right << "cpE (F)";
+        std::cout << std::setw(12) << std::right << "cpE (C)";
 #if MCKL_HAS_MKL
         std::cout << std::setw(12) << std::right << "cpE (V)";
 #endif
     } else {
         std::cout << std::setw(12) << std::right << "ME/s (S)";
         std::cout << std::setw(12) << std::right << "ME/s (B)";
+        std::cout << std::setw(12) << std::right << "ME/s (F)";
+        std::cout << std::setw(12) << std::right << "ME/s (C)";
 #if MCKL_HAS_MKL
         std::cout << std::setw(12) << std::right << "ME/s (V)";
 #endif
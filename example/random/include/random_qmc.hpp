@@ -0,0 +1,381 @@
+//============================================================================
+// MCKL/example/random/include/random_qmc.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_QMC_HPP
+#define MCKL_EXAMPLE_RANDOM_QMC_HPP
+
+#include <mckl/algorithm/resample.hpp>
+#include <mckl/random/halton.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/sobol.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/random/uniform_int_distribution.hpp>
+#include "random_common.hpp"
+
+inline std::string random_qmc_scramble(mckl::QMCScramble scramble)
+{
+    switch (scramble) {
+        case mckl::QMCScramble::None:
+            return "None";
+        case mckl::QMCScramble::LMS:
+            return "LMS";
+        case mckl::QMCScramble::Owen:
+            return "Owen";
+    }
+
+    return std::string();
+}
+
+// The first eight points of the first four dimensions
+inline bool random_qmc_kat(mckl::Sobol &)
+{
+    static const std::uint32_t kat[32] = {0x00000000, 0x00000000,
+        0x00000000, 0x00000000, 0x80000000, 0x80000000, 0x80000000,
+        0x80000000, 0xC0000000, 0x40000000, 0x40000000, 0x40000000,
+        0x40000000, 0xC0000000, 0xC0000000, 0xC0000000, 0x60000000,
+        0x60000000, 0xA0000000, 0xE0000000, 0xE0000000, 0xE0000000,
+        0x20000000, 0x60000000, 0xA0000000, 0x20000000, 0xE0000000,
+        0xA0000000, 0x20000000, 0xA0000000, 0x60000000, 0x20000000};
+
+    mckl::Sobol rng(4);
+    std::uint32_t r[32];
+    rng(32, r);
+    bool pass = std::equal(r, r + 32, kat);
+
+    // The last two points of the sequence
+    const std::uint64_t last = (std::uint64_t(1) << 32) - 1;
+    rng.seek(last - 1);
+    rng(8, r);
+    rng.seek(last);
+    rng(4, r + 8);
+    pass = pass && std::equal(r + 4, r + 8, r + 8);
+
+    return pass;
+}
+
+// Radical inverse of the first four bases
+inline bool random_qmc_kat(mckl::Halton &)
+{
+    static const std::uint32_t base[4] = {2, 3, 5, 7};
+
+    mckl::Halton rng(4);
+    bool pass = true;
+    for (std::uint32_t i = 0; i != 1000; ++i) {
+        for (std::size_t d = 0; d != 4; ++d) {
+            long double x = 0;
+            long double f = 1.0L / base[d];
+            for (std::uint32_t j = i; j != 0; j /= base[d], f /= base[d])
+                x += f * (j % base[d]);
+            const long double y =
+                std::ldexp(static_cast<long double>(rng()), -32);
+            pass = pass && std::abs(x - y) < std::ldexp(1.0L, -26);
+        }
+    }
+
+    return pass;
+}
+
+template <typename RNGType>
+inline bool random_qmc_kat(RNGType &)
+{
+    return true;
+}
+
+template <typename ResultType>
+inline std::size_t random_qmc_base(
+    const mckl::SobolGenerator<ResultType> &, std::size_t)
+{
+    return 2;
+}
+
+template <typename ResultType>
+inline std::size_t random_qmc_base(
+    const mckl::HaltonGenerator<ResultType> &gen, std::size_t d)
+{
+    return gen.base()[d];
+}
+
+// Bound of the truncation error of the fixed point representation
+template <typename ResultType>
+inline std::size_t random_qmc_slack(
+    const mckl::SobolGenerator<ResultType> &, std::size_t)
+{
+    return 0;
+}
+
+template <typename ResultType>
+inline std::size_t random_qmc_slack(
+    const mckl::HaltonGenerator<ResultType> &gen, std::size_t d)
+{
+    return gen.base()[d] * std::numeric_limits<ResultType>::digits;
+}
+
+// Each coordinate of the first b^m points falls in each of the b^m intervals
+// of length b^{-m}, up to the truncation of the fixed point representation.
+// The number of intervals is limited such that the truncation error is
+// negligible relative to the length of the intervals
+template <typename RNGType>
+inline bool random_qmc_strata(std::size_t N, const RNGType &rng)
+{
+    using result_type = typename RNGType::result_type;
+
+    RNGType eng(rng);
+    eng.seek(0);
+    const std::size_t dim = eng.dim();
+    mckl::Vector<result_type> r(N * dim);
+    eng(N * dim, r.data());
+
+    bool pass = true;
+    mckl::Vector<std::size_t> count;
+    for (std::size_t d = 0; d != dim; ++d) {
+        const std::size_t b = random_qmc_base(eng.generator(), d);
+        const std::size_t s = random_qmc_slack(eng.generator(), d);
+        const std::size_t M = std::min(
+            N, std::size_t(1) << std::numeric_limits<result_type>::digits / 4);
+        std::size_t n = 1;
+        while (n * b <= M)
+            n *= b;
+        const long double h =
+            std::ldexp(1.0L, -std::numeric_limits<result_type>::digits);
+        count.assign(n, 0);
+        for (std::size_t i = 0; i != n; ++i) {
+            const long double x = (r[i * dim + d] + s * 1.0L) * h * n;
+            count[std::min(static_cast<std::size_t>(x), n - 1)]++;
+        }
+        for (std::size_t c : count)
+            pass = pass && c == 1;
+    }
+
+    return pass;
+}
+
+// Integrate f(x) = prod_d (1 + (x_d - 1/2)) on [0, 1]^dim, which equals one
+template <typename RNGType>
+inline double random_qmc_integrate(std::size_t N, RNGType &rng)
+{
+    const std::size_t dim = 8;
+    mckl::Vector<double> r(N * dim);
+    mckl::u01_co_distribution(rng, N * dim, r.data());
+
+    double sum = 0;
+    for (std::size_t i = 0; i != N; ++i) {
+        double f = 1;
+        for (std::size_t d = 0; d != dim; ++d)
+            f *= 0.5 + r[i * dim + d];
+        sum += f;
+    }
+
+    return std::abs(sum / N - 1);
+}
+
+template <typename RNGType>
+inline void random_qmc(
+    std::size_t N, const std::string &name, mckl::QMCScramble scramble)
+{
+    using result_type = typename RNGType::result_type;
+
+    const std::size_t dim = 8;
+    const std::uint64_t seed = 101;
+
+    RNGType rng(dim, scramble, seed);
+    mckl::Vector<result_type> r1(N * dim);
+    mckl::Vector<result_type> r2(N * dim);
+
+    bool has_cycles = mckl::StopWatch::has_cycles();
+    double c1 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    double c2 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    for (std::size_t k = 0; k != 10; ++k) {
+        mckl::StopWatch watch1;
+        mckl::StopWatch watch2;
+
+        rng.seek(0);
+        watch1.start();
+        for (std::size_t i = 0; i != N * dim; ++i)
+            r1[i] = rng();
+        watch1.stop();
+
+        rng.seek(0);
+        watch2.start();
+        rng(N * dim, r2.data());
+        watch2.stop();
+
+        if (has_cycles) {
+            const double bytes = sizeof(result_type) * N * dim;
+            c1 = std::min(c1, watch1.cycles() / bytes);
+            c2 = std::min(c2, watch2.cycles() / bytes);
+        }
+    }
+    bool pass_batch = r1 == r2;
+
+    // seek and discard
+    bool pass_seek = true;
+    mckl::UniformIntDistribution<std::size_t> runif(0, N - 1);
+    mckl::RNG_64 rand;
+    for (std::size_t k = 0; k != 100; ++k) {
+        const std::size_t i = runif(rand);
+        const std::size_t j = runif(rand) % dim;
+        RNGType eng(dim, scramble, seed);
+        eng.seek(i);
+        pass_seek = pass_seek && eng.index() == i;
+        pass_seek = pass_seek && eng() == r1[i * dim];
+        eng.seek(0);
+        eng.discard(i * dim + j);
+        pass_seek = pass_seek && eng() == r1[i * dim + j];
+    }
+
+    // partition of dimensions
+    bool pass_offset = true;
+    for (std::size_t offset = 0; offset != dim; ++offset) {
+        RNGType eng(dim - offset, scramble, seed, offset);
+        for (std::size_t i = 0; i != N; ++i)
+            for (std::size_t d = offset; d != dim; ++d)
+                pass_offset = pass_offset && eng() == r1[i * dim + d];
+    }
+
+    // serialization
+    bool pass_io = true;
+    std::stringstream ss;
+    rng.seek(0);
+    rng.discard(N * dim / 2 + 3);
+    ss << rng;
+    RNGType eng;
+    ss >> eng;
+    pass_io = pass_io && eng == rng;
+    for (std::size_t i = 0; i != N; ++i)
+        pass_io = pass_io && eng() == rng();
+
+    bool pass_strata = random_qmc_strata(N, rng) && random_qmc_kat(rng);
+
+    // normal by the inverse CDF
+    mckl::Vector<double> z(N * dim);
+    rng.seek(0);
+    mckl::normal_distribution(rng, N * dim, z.data(), 0.0, 1.0);
+    double mean = 0;
+    double var = 0;
+    for (std::size_t i = 0; i != N * dim; ++i) {
+        mean += z[i];
+        var += z[i] * z[i];
+    }
+    mean /= N * dim;
+    var /= N * dim;
+    bool pass_normal = std::abs(mean) < 1e-2 && std::abs(var - 1) < 1e-2;
+    for (std::size_t i = 0; i != N * dim; ++i)
+        pass_normal = pass_normal && std::isfinite(z[i]);
+
+    // resampling
+    bool pass_resample = true;
+    mckl::Vector<double> w(N);
+    mckl::Vector<std::size_t> rep(N);
+    mckl::u01_distribution(rand, N, w.data());
+    mckl::mul(N, 1 / std::accumulate(w.begin(), w.end(), 0.0), w.data(),
+        w.data());
+    RNGType ursng(1, scramble, seed);
+    mckl::ResampleStratified resample_stratified;
+    resample_stratified(N, N, ursng, w.data(), rep.data());
+    pass_resample = pass_resample &&
+        std::accumulate(rep.begin(), rep.end(), std::size_t()) == N;
+    mckl::ResampleSystematic resample_systematic;
+    resample_systematic(N, N, ursng, w.data(), rep.data());
+    pass_resample = pass_resample &&
+        std::accumulate(rep.begin(), rep.end(), std::size_t()) == N;
+
+    // integration error against pseudo random numbers
+    rng.seek(0);
+    double eq = random_qmc_integrate(N, rng);
+    double er = random_qmc_integrate(N, rand);
+
+    std::cout << std::setw(15) << std::left << name;
+    std::cout << std::setw(10) << std::left << random_qmc_scramble(scramble);
+    std::cout << std::setw(10) << std::right << std::fixed
+              << std::setprecision(2) << c1;
+    std::cout << std::setw(10) << std::right << std::fixed
+              << std::setprecision(2) << c2;
+    std::cout << std::setw(12) << std::right << std::scientific
+              << std::setprecision(2) << eq;
+    std::cout << std::setw(12) << std::right << std::scientific
+              << std::setprecision(2) << er;
+    std::cout << std::setw(10) << std::right
+              << random_pass(pass_batch && pass_seek && pass_offset);
+    std::cout << std::setw(10) << std::right << random_pass(pass_io);
+    std::cout << std::setw(10) << std::right << random_pass(pass_strata);
+    std::cout << std::setw(10) << std::right
+              << random_pass(pass_normal && pass_resample);
+    std::cout << std::endl;
+}
+
+template <typename ResultType>
+inline bool random_qmc_owen(const mckl::SobolGenerator<ResultType> &)
+{
+    return true;
+}
+
+template <typename ResultType>
+inline bool random_qmc_owen(const mckl::HaltonGenerator<ResultType> &)
+{
+    return false;
+}
+
+template <typename RNGType>
+inline void random_qmc(std::size_t N, const std::string &name)
+{
+    random_qmc<RNGType>(N, name, mckl::QMCScrambleNone);
+    random_qmc<RNGType>(N, name, mckl::QMCScrambleLMS);
+    if (random_qmc_owen(RNGType().generator())) {
+        random_qmc<RNGType>(N, name, mckl::QMCScrambleOwen);
+    }
+}
+
+inline void random_qmc(std::size_t N)
+{
+    const int twid = 15 + 10 + 10 * 2 + 12 * 2 + 10 * 4;
+
+    std::cout << std::string(twid, '=') << std::endl;
+    std::cout << std::setw(15) << std::left << "Engine";
+    std::cout << std::setw(10) << std::left << "Scramble";
+    std::cout << std::setw(10) << std::right << "cpB (S)";
+    std::cout << std::setw(10) << std::right << "cpB (B)";
+    std::cout << std::setw(12) << std::right << "Error (Q)";
+    std::cout << std::setw(12) << std::right << "Error (R)";
+    std::cout << std::setw(10) << std::right << "Seek";
+    std::cout << std::setw(10) << std::right << "I/O";
+    std::cout << std::setw(10) << std::right << "Strata";
+    std::cout << std::setw(10) << std::right << "Dist";
+    std::cout << std::endl;
+    std::cout << std::string(twid, '-') << std::endl;
+    random_qmc<mckl::Sobol>(N, "Sobol");
+    random_qmc<mckl::Sobol_64>(N, "Sobol_64");
+    random_qmc<mckl::Halton>(N, "Halton");
+    random_qmc<mckl::Halton_64>(N, "Halton_64");
+    std::cout << std::string(twid, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_QMC_HPP
@@ -60,6 +60,14 @@
 #define MCKL_EXAMPLE_RANDOM_RDRAND_RNG 0
 #endif
 
+#ifndef MCKL_EXAMPLE_RANDOM_XOSHIRO_RNG
+#define MCKL_EXAMPLE_RANDOM_XOSHIRO_RNG 0
+#endif
+
+#ifndef MCKL_EXAMPLE_RANDOM_PCG_RNG
+#define MCKL_EXAMPLE_RANDOM_PCG_RNG 0
+#endif
+
 #include <mckl/random/u01_distribution.hpp>
 #include <mckl/random/uniform_bits_distribution.hpp>
 #include <mckl/random/uniform_int_distribution.hpp>
@@ -221,6 +229,79 @@ inline bool random_rng_k(const mckl::Threefish1024Engine<ResultType> &rng)
 
 #endif // MCKL_EXAMPLE_RANDOM_THREEFRY_RNG
 
+#if MCKL_EXAMPLE_RANDOM_XOSHIRO_RNG || MCKL_EXAMPLE_RANDOM_PCG_RNG
+
+template <typename Generator, typename Generator1, std::size_t N>
+inline bool random_rng_k(const typename Generator1::state_type &s,
+    const std::array<std::uint64_t, N> &k)
+{
+    constexpr std::size_t K = Generator::size() / sizeof(std::uint64_t);
+
+    // The single stream generator against the reference output
+    mckl::MultiStreamEngine<std::uint64_t, Generator1> rng1;
+    rng1.state(s);
+    std::array<std::uint64_t, N> r1;
+    mckl::rand(rng1, N, r1.data());
+    if (r1 != k)
+        return false;
+
+    // Each stream against the single stream generator jumped ahead
+    mckl::MultiStreamEngine<std::uint64_t, Generator> rng;
+    mckl::Vector<std::uint64_t> r(K * N);
+    mckl::rand(rng, K * N, r.data());
+    rng1.seed(1);
+    for (std::size_t i = 0; i != K; ++i) {
+        mckl::MultiStreamEngine<std::uint64_t, Generator1> tmp(rng1);
+        for (std::size_t j = 0; j != N; ++j)
+            if (r[j * K + i] != tmp())
+                return false;
+        rng1.jump();
+    }
+
+    // The first stream of the jumped generator
+    rng.seed(1);
+    rng.jump();
+    mckl::rand(rng, K, r.data());
+
+    return r.front() == rng1();
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_XOSHIRO_RNG || MCKL_EXAMPLE_RANDOM_PCG_RNG
+
+#if MCKL_EXAMPLE_RANDOM_XOSHIRO_RNG
+
+template <typename ResultType, std::size_t K>
+inline bool random_rng_k(const mckl::Xoshiro256PPEngine<ResultType, K> &)
+{
+    // Reference output of xoshiro256++ from the state {1, 2, 3, 4}
+    const std::array<std::uint64_t, 4> k = {{UINT64_C(41943041),
+        UINT64_C(58720359), UINT64_C(3588806011781223),
+        UINT64_C(3591011842654386)}};
+
+    return random_rng_k<mckl::Xoshiro256PPGenerator<K>,
+        mckl::Xoshiro256PPGenerator<1>>({{1, 2, 3, 4}}, k);
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_XOSHIRO_RNG
+
+#if MCKL_EXAMPLE_RANDOM_PCG_RNG
+
+template <typename ResultType, std::size_t K>
+inline bool random_rng_k(const mckl::PCG64Engine<ResultType, K> &)
+{
+    // Reference output of pcg64 seeded with (42, 54)
+    const std::array<std::uint64_t, 4> k = {{UINT64_C(0x86B1DA1D72062B68),
+        UINT64_C(0x1304AA46C9853D39), UINT64_C(0xA3670E9E0DD50358),
+        UINT64_C(0xF9090E529A7DAE00)}};
+
+    return random_rng_k<mckl::PCG64Generator<K>, mckl::PCG64Generator<1>>(
+        {{UINT64_C(0xD3F6C45A41E54320), UINT64_C(0xDE2BCE05BE013BE3),
+            UINT64_C(0x6D), 0}},
+        k);
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_PCG_RNG
+
 class RandomRNGPerf
 {
   public:
@@ -327,6 +408,20 @@ inline bool random_rng_d(std::size_t N, std::size_t M)
         pass = pass && (r1 == r2 || rng != rng);
     }
 
+    // A long discard, which some engines compute by jumping ahead
+    const std::size_t L = 1 << 20;
+    r1.resize(L);
+    rng1 = rng;
+    rng2 = rng;
+    rng1.discard(static_cast<unsigned>(L));
+    mckl::rand(rng2, L, r1.data());
+    typename RNGType::result_type next = rng1();
+    bool find = false;
+    for (std::size_t j = 0; j != 2; ++j) {
+        find = find || rng2() == next;
+    }
+    pass = pass && (find || rng != rng);
+
     return pass;
 }
 
@@ -0,0 +1,173 @@
+//============================================================================
+// MCKL/example/random/include/random_test_runner.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_TEST_RUNNER_HPP
+#define MCKL_EXAMPLE_RANDOM_TEST_RUNNER_HPP
+
+#include <mckl/random/rng.hpp>
+#include <mckl/random/test.hpp>
+#include <mckl/random/uniform_int_distribution.hpp>
+#include "random_common.hpp"
+
+// The concurrent sets of occurred cells against std::set
+template <typename SetType>
+inline bool random_test_runner_set(std::size_t n, std::size_t k)
+{
+    mckl::RNG rng;
+    mckl::UniformIntDistribution<std::size_t> runif(0, k - 1);
+    SetType occurs(k, n);
+    std::set<std::size_t> ref;
+    bool pass = true;
+    for (std::size_t i = 0; i != n; ++i) {
+        const std::size_t u = runif(rng);
+        const bool found = ref.count(u) != 0;
+        ref.insert(u);
+        pass = pass && occurs.insert(u) == found;
+    }
+
+    return pass;
+}
+
+// The collision test with the tuples generated by multiple streams
+template <std::size_t D, std::size_t T>
+inline bool random_test_runner_collision(std::size_t N, std::size_t k)
+{
+    mckl::Vector<mckl::RNG> rs(k);
+    for (auto &rng : rs)
+        rng.seed(mckl::Seed<mckl::RNG>::instance().get());
+    mckl::Vector<mckl::RNG> rp(rs);
+    mckl::U01Distribution<double> u01;
+
+    mckl::CollisionTest<D, T> test(N);
+    std::size_t s = test.template operator()<mckl::BackendSEQ>(
+        k, rs.data(), u01);
+    std::size_t p = test(k, rp.data(), u01);
+
+    return s == p;
+}
+
+template <typename TestType>
+inline void random_test_runner(std::size_t M, const TestType &test,
+    const std::string &name, int nwid, int swid, int twid)
+{
+    mckl::Vector<mckl::RNG> rs(M);
+    for (auto &rng : rs)
+        rng.seed(mckl::Seed<mckl::RNG>::instance().get());
+
+    mckl::RandomTestRunner<mckl::RNG, mckl::U01Distribution<double>,
+        mckl::BackendSEQ>
+        runner_seq(rs.begin(), rs.end());
+    mckl::RandomTestRunner<mckl::RNG> runner_smp(rs.begin(), rs.end());
+
+    mckl::StopWatch watch_seq;
+    watch_seq.start();
+    auto result_seq = runner_seq(test);
+    watch_seq.stop();
+
+    mckl::StopWatch watch_smp;
+    watch_smp.start();
+    auto result_smp = runner_smp(test);
+    watch_smp.stop();
+
+    bool pass = result_seq.stat() == result_smp.stat();
+    pass = pass && result_seq.pvalue_sum() == result_smp.pvalue_sum();
+
+    std::cout << std::setw(nwid) << std::left << name;
+    std::cout << std::setw(swid) << std::right << std::fixed
+              << std::setprecision(0) << result_smp.pass(1e-2) * 100 << '%';
+    std::cout << std::setw(swid) << std::right << std::fixed
+              << std::setprecision(4) << result_smp.pvalue_sum();
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << std::setprecision(2) << watch_seq.seconds();
+    std::cout << std::setw(twid) << std::right << std::fixed
+              << std::setprecision(2) << watch_smp.seconds();
+    std::cout << std::setw(twid) << std::right << random_pass(pass);
+    std::cout << std::endl;
+}
+
+inline void random_test_runner(std::size_t N, std::size_t M)
+{
+    const int nwid = 30;
+    const int swid = 10;
+    const int twid = 10;
+    const std::size_t lwid = nwid + swid * 2 + 1 + twid * 3;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(nwid) << std::left << "Test";
+    std::cout << std::setw(swid + 1) << std::right << "1%";
+    std::cout << std::setw(swid) << std::right << "p (Sum)";
+    std::cout << std::setw(twid) << std::right << "SEQ (s)";
+    std::cout << std::setw(twid) << std::right << "SMP (s)";
+    std::cout << std::setw(twid) << std::right << "Same";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    random_test_runner(M, mckl::BirthdaySpacingsTest<2, 40>(N),
+        "BirthdaySpacings<2, 40>", nwid, swid, twid);
+    random_test_runner(M, mckl::CollisionTest<2, 20>(N),
+        "Collision<2, 20>", nwid, swid, twid);
+    random_test_runner(M, mckl::CollisionTest<2, 40>(N),
+        "Collision<2, 40>", nwid, swid, twid);
+    random_test_runner(M, mckl::CouponCollectorTest<8>(N),
+        "CouponCollector<8>", nwid, swid, twid);
+    random_test_runner(M, mckl::GapTest<>(N, 0, 0.125),
+        "Gap<0, 2^-3>", nwid, swid, twid);
+    random_test_runner(M, mckl::MaximumOfTTest<1024, 8>(N),
+        "MaximumOfT<2^10, 2^3>", nwid, swid, twid);
+    random_test_runner(M, mckl::PermutationTest<5>(N),
+        "Permutation<5>", nwid, swid, twid);
+    random_test_runner(M, mckl::PokerTest<16, 16>(N),
+        "Poker<2^4, 2^4>", nwid, swid, twid);
+    random_test_runner(M, mckl::RunTest<false, true>(N),
+        "Run<false, true>", nwid, swid, twid);
+    random_test_runner(M, mckl::SerialTest<64, 2, true>(N),
+        "Serial<2^6, 2, true>", nwid, swid, twid);
+    std::cout << std::string(lwid, '-') << std::endl;
+
+    bool pass_set =
+        random_test_runner_set<mckl::internal::CollisionBitmap>(N, 1 << 20);
+    pass_set = pass_set &&
+        random_test_runner_set<mckl::internal::CollisionHashSet>(N, N * 4);
+    bool pass_collision = random_test_runner_collision<2, 20>(N, 16);
+    pass_collision =
+        pass_collision && random_test_runner_collision<2, 40>(N, 16);
+
+    std::cout << std::setw(nwid) << std::left << "Concurrent set";
+    std::cout << std::setw(lwid - nwid) << std::right << random_pass(pass_set);
+    std::cout << std::endl;
+    std::cout << std::setw(nwid) << std::left << "Collision with 16 streams";
+    std::cout << std::setw(lwid - nwid) << std::right
+              << random_pass(pass_collision);
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_TEST_RUNNER_HPP
@@ -33,20 +33,52 @@
 #define MCKL_EXAMPLE_RANDOM_TESTU01_HPP
 
 #include <mckl/random/testu01.hpp>
+#include <mckl/random/u01_distribution.hpp>
 #include "random_rng_u01.hpp"
+#include <thread>
+
+template <typename RNGType>
+inline void random_testu01_reset(const std::string &name, bool parallel)
+{
+    mckl::TestU01 &testu01 = mckl::TestU01::instance();
+    if (name == "STD") {
+        testu01.reset<RNGType, std::uniform_real_distribution<double>>(
+            name, parallel);
+    } else if (name == "U01") {
+        testu01.reset<RNGType, mckl::U01Distribution<double>>(name, parallel);
+    } else if (name == "U01CC") {
+        testu01.reset<RNGType, mckl::U01CCDistribution<double>>(
+            name, parallel);
+    } else if (name == "U01CO") {
+        testu01.reset<RNGType, mckl::U01CODistribution<double>>(
+            name, parallel);
+    } else if (name == "U01OC") {
+        testu01.reset<RNGType, mckl::U01OCDistribution<double>>(
+            name, parallel);
+    } else if (name == "U01OO") {
+        testu01.reset<RNGType, mckl::U01OODistribution<double>>(
+            name, parallel);
+    }
+}
 
 template <typename Battery>
-inline void random_testu01(const std::string &name, double (*u01)(),
-    Battery battery, mckl::Vector<int> &rep)
+inline void random_testu01(const std::string &name,
+    void (*reset)(const std::string &, bool), Battery battery, int ntests,
+    bool parallel, std::size_t np, mckl::Vector<int> &rep)
 {
     mckl::TestU01 &testu01 = mckl::TestU01::instance();
-    testu01.reset(name, u01);
-    rep.size() == 0 ? testu01(battery, 1) :
-                      testu01(battery, rep.begin(), rep.end(), 2);
+    reset(name, parallel);
+    if (np > 1 && rep.size() == 0) {
+        testu01.parallel(battery, ntests, np);
+    } else {
+        rep.size() == 0 ? testu01(battery, 1) :
+                          testu01(battery, rep.begin(), rep.end(), 2);
+    }
 }
 
 template <typename Battery>
-inline void random_testu01(Battery battery, int argc, char **argv)
+inline void random_testu01(Battery battery, int ntests, int argc, char **argv,
+    void (*reset)(const std::string &, bool))
 {
     std::string basename(*argv);
     --argc;
@@ -62,6 +94,7 @@ inline void random_testu01(Battery battery, int argc, char **argv)
     bool redirect = true;
     bool parallel = false;
     bool all = true;
+    std::size_t np = 1;
     mckl::Vector<int> rep;
     while (argc > 0) {
         std::string arg(*argv);
@@ -89,6 +122,8 @@ inline void random_testu01(Battery battery, int argc, char **argv)
             redirect = false;
         } else if (arg.find("parallel") != std::string::npos) {
             parallel = true;
+        } else if (arg.find("process") != std::string::npos) {
+            np = std::max(2U, std::thread::hardware_concurrency());
         } else {
             rep.push_back(std::atoi(arg.c_str()));
         }
@@ -129,33 +164,18 @@ inline void random_testu01(Battery battery, int argc, char **argv)
         ::swrite_Basic = FALSE;
 
     random_rng_load_seed(basename);
-    if (parallel) {
-        if (STD)
-            random_testu01("STD", random_rng_std_mt, battery, rep);
-        if (U01)
-            random_testu01("U01", random_rng_u01_mt, battery, rep);
-        if (U01CC)
-            random_testu01("U01CC", random_rng_u01cc_mt, battery, rep);
-        if (U01CO)
-            random_testu01("U01CO", random_rng_u01co_mt, battery, rep);
-        if (U01OC)
-            random_testu01("U01OC", random_rng_u01oc_mt, battery, rep);
-        if (U01OO)
-            random_testu01("U01OO", random_rng_u01oo_mt, battery, rep);
-    } else {
-        if (STD)
-            random_testu01("STD", random_rng_std, battery, rep);
-        if (U01)
-            random_testu01("U01", random_rng_u01, battery, rep);
-        if (U01CC)
-            random_testu01("U01CC", random_rng_u01cc, battery, rep);
-        if (U01CO)
-            random_testu01("U01CO", random_rng_u01co, battery, rep);
-        if (U01OC)
-            random_testu01("U01OC", random_rng_u01oc, battery, rep);
-        if (U01OO)
-            random_testu01("U01OO", random_rng_u01oo, battery, rep);
-    }
+    if (STD)
+        random_testu01("STD", reset, battery, ntests, parallel, np, rep);
+    if (U01)
+        random_testu01("U01", reset, battery, ntests, parallel, np, rep);
+    if (U01CC)
+        random_testu01("U01CC", reset, battery, ntests, parallel, np, rep);
+    if (U01CO)
+        random_testu01("U01CO", reset, battery, ntests, parallel, np, rep);
+    if (U01OC)
+        random_testu01("U01OC", reset, battery, ntests, parallel, np, rep);
+    if (U01OO)
+        random_testu01("U01OO", reset, battery, ntests, parallel, np, rep);
     random_rng_store_seed(basename);
 
     if (redirect)
@@ -32,6 +32,9 @@
 #ifndef MCKL_EXAMPLE_RANDOM_TESTU01_BIGCRUSH_HPP
 #define MCKL_EXAMPLE_RANDOM_TESTU01_BIGCRUSH_HPP
 
-void random_testu01_bigcrush(int, char **);
+#include <string>
+
+void random_testu01_bigcrush(
+    int, char **, void (*)(const std::string &, bool));
 
 #endif // MCKL_EXAMPLE_RANDOM_TESTU01_BIGCRUSH_HPP
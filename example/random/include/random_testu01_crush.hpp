@@ -32,6 +32,9 @@
 #ifndef MCKL_EXAMPLE_RANDOM_TESTU01_CRUSH_HPP
 #define MCKL_EXAMPLE_RANDOM_TESTU01_CRUSH_HPP
 
-void random_testu01_crush(int, char **);
+#include <string>
+
+void random_testu01_crush(
+    int, char **, void (*)(const std::string &, bool));
 
 #endif // MCKL_EXAMPLE_RANDOM_TESTU01_CRUSH_HPP
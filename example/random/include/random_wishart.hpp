@@ -0,0 +1,241 @@
+//============================================================================
+// MCKL/example/random/include/random_wishart.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_RANDOM_WISHART_HPP
+#define MCKL_EXAMPLE_RANDOM_WISHART_HPP
+
+#include <mckl/random/wishart_distribution.hpp>
+#include "random_distribution.hpp"
+
+template <typename RealType>
+inline bool random_wishart_near(
+    const mckl::Vector<RealType> &r1, const mckl::Vector<RealType> &r2)
+{
+    const RealType eps = std::numeric_limits<RealType>::epsilon() * 100;
+    for (std::size_t i = 0; i != r1.size(); ++i) {
+        const RealType a = r1[i];
+        const RealType b = r2[i];
+        if (std::abs(a - b) > eps * (1 + std::abs(a)))
+            return false;
+    }
+
+    return true;
+}
+
+// Check the sample mean of L L^T against df * Sigma for Wishart, and
+// Sigma / (df - dim - 1) for inverse Wishart
+template <typename RealType>
+inline bool random_wishart_mean(std::size_t n, const RealType *r,
+    std::size_t dim, RealType df, const RealType *chol, bool inverse)
+{
+    const std::size_t p = dim * (dim + 1) / 2;
+    mckl::Vector<double> sigma(dim * dim);
+    mckl::Vector<double> mean(dim * dim, 0);
+    for (std::size_t i = 0; i != dim; ++i) {
+        for (std::size_t j = 0; j != dim; ++j) {
+            const RealType *li = chol + i * (i + 1) / 2;
+            const RealType *lj = chol + j * (j + 1) / 2;
+            double s = 0;
+            for (std::size_t k = 0; k <= std::min(i, j); ++k)
+                s += static_cast<double>(li[k]) * lj[k];
+            sigma[i * dim + j] = inverse ? s / (df - dim - 1) : s * df;
+        }
+    }
+    for (std::size_t l = 0; l != n; ++l, r += p) {
+        for (std::size_t i = 0; i != dim; ++i) {
+            for (std::size_t j = 0; j != dim; ++j) {
+                const RealType *li = r + i * (i + 1) / 2;
+                const RealType *lj = r + j * (j + 1) / 2;
+                double s = 0;
+                for (std::size_t k = 0; k <= std::min(i, j); ++k)
+                    s += static_cast<double>(li[k]) * lj[k];
+                mean[i * dim + j] += s / n;
+            }
+        }
+    }
+
+    double scale = 0;
+    double error = 0;
+    for (std::size_t i = 0; i != dim * dim; ++i) {
+        scale = std::max(scale, std::abs(sigma[i]));
+        error = std::max(error, std::abs(mean[i] - sigma[i]));
+    }
+
+    return error < 0.05 * scale;
+}
+
+template <template <typename, std::size_t> class DistributionType,
+    typename RealType>
+inline void random_wishart(std::size_t N, std::size_t M, const char *name,
+    RealType df, const RealType *chol, bool inverse)
+{
+    MCKLRNGType rng;
+    MCKLRNGType rng1;
+    MCKLRNGType rng2;
+
+    constexpr std::size_t dim = 3;
+    constexpr std::size_t p = dim * (dim + 1) / 2;
+
+    mckl::UniformIntDistribution<std::size_t> rsize(N / 2, N);
+    DistributionType<RealType, 0> dist(dim, df, chol);
+    DistributionType<RealType, dim> distf(dim, df, chol);
+
+    bool pass = true;
+
+    mckl::Vector<RealType> r1;
+    mckl::Vector<RealType> r2;
+    mckl::Vector<RealType> rf;
+    for (std::size_t i = 0; i != M; ++i) {
+        std::size_t K = rsize(rng);
+        r1.resize(K * p);
+        r2.resize(K * p);
+
+        std::stringstream ss1;
+        ss1.precision(20);
+        ss1 << dist;
+        for (std::size_t j = 0; j != K; ++j)
+            dist(rng1, r1.data() + j * p);
+        ss1 >> dist;
+        for (std::size_t j = 0; j != K; ++j)
+            dist(rng2, r2.data() + j * p);
+        pass = pass && r1 == r2;
+
+        std::stringstream ssb;
+        ssb.precision(20);
+        ssb << dist;
+        mckl::rand(rng1, dist, K, r1.data());
+        ssb >> dist;
+        mckl::rand(rng2, dist, K, r2.data());
+        pass = pass && r1 == r2;
+
+        MCKLRNGType rngf1(rng);
+        MCKLRNGType rngf2(rng);
+        mckl::rand(rngf1, dist, K, r1.data());
+        mckl::rand(rngf2, distf, K, r2.data());
+        pass = pass && random_wishart_near(r1, r2);
+        pass = pass &&
+            random_wishart_mean(K, r1.data(), dim, df, chol, inverse);
+    }
+
+    bool has_cycles = mckl::StopWatch::has_cycles();
+    double c1 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    double c2 = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    double cf = has_cycles ? std::numeric_limits<double>::max() : 0.0;
+    for (std::size_t k = 0; k != 10; ++k) {
+        std::size_t num = 0;
+        mckl::StopWatch watch1;
+        mckl::StopWatch watch2;
+        mckl::StopWatch watchf;
+        for (std::size_t i = 0; i != M; ++i) {
+            std::size_t K = rsize(rng);
+            num += K;
+            r1.resize(K * p);
+            r2.resize(K * p);
+            rf.resize(K * p);
+
+            watch1.start();
+            RealType *r = r1.data();
+            for (std::size_t j = 0; j != K; ++j, r += p)
+                dist(rng, r);
+            watch1.stop();
+
+            watch2.start();
+            mckl::rand(rng, dist, K, r2.data());
+            watch2.stop();
+
+            watchf.start();
+            mckl::rand(rng, distf, K, rf.data());
+            watchf.stop();
+
+            pass = pass && r1 != r2;
+        }
+        if (has_cycles) {
+            c1 = std::min(c1, 1.0 * watch1.cycles() / num);
+            c2 = std::min(c2, 1.0 * watch2.cycles() / num);
+            cf = std::min(cf, 1.0 * watchf.cycles() / num);
+        } else {
+            c1 = std::max(c1, num / watch1.seconds() * 1e-6);
+            c2 = std::max(c2, num / watch2.seconds() * 1e-6);
+            cf = std::max(cf, num / watchf.seconds() * 1e-6);
+        }
+    }
+
+    std::stringstream ss;
+    ss << name << '<' << random_typename<RealType>() << ">(" << df << ')';
+
+    std::cout << std::setw(40) << std::left << ss.str();
+    std::cout << std::setw(12) << std::right << c1;
+    std::cout << std::setw(12) << std::right << c2;
+    std::cout << std::setw(12) << std::right << cf;
+    std::cout << std::setw(15) << std::right << random_pass(pass);
+    std::cout << std::endl;
+}
+
+template <typename RealType>
+inline void random_wishart(std::size_t N, std::size_t M)
+{
+    std::array<RealType, 6> chol = {{1, 0.5, 2, -0.3, 0.4, 1.5}};
+
+    random_wishart<mckl::WishartDistribution>(
+        N, M, "Wishart", static_cast<RealType>(4.5), chol.data(), false);
+    random_wishart<mckl::WishartDistribution>(
+        N, M, "Wishart", static_cast<RealType>(10), chol.data(), false);
+    random_wishart<mckl::InverseWishartDistribution>(N, M, "InverseWishart",
+        static_cast<RealType>(7.5), chol.data(), true);
+    random_wishart<mckl::InverseWishartDistribution>(N, M, "InverseWishart",
+        static_cast<RealType>(12), chol.data(), true);
+}
+
+inline void random_wishart(std::size_t N, std::size_t M)
+{
+    constexpr std::size_t lwid = 40 + 12 * 3 + 15;
+
+    std::cout << std::string(lwid, '=') << std::endl;
+    std::cout << std::setw(40) << std::left << "Distribution";
+    if (mckl::StopWatch::has_cycles()) {
+        std::cout << std::setw(12) << std::right << "cpS (S)";
+        std::cout << std::setw(12) << std::right << "cpS (B)";
+        std::cout << std::setw(12) << std::right << "cpS (F)";
+    } else {
+        std::cout << std::setw(12) << std::right << "MS/s (S)";
+        std::cout << std::setw(12) << std::right << "MS/s (B)";
+        std::cout << std::setw(12) << std::right << "MS/s (F)";
+    }
+    std::cout << std::setw(15) << std::right << "Deterministics";
+    std::cout << std::endl;
+    std::cout << std::string(lwid, '-') << std::endl;
+    random_wishart<float>(N, M);
+    std::cout << std::string(lwid, '-') << std::endl;
+    random_wishart<double>(N, M);
+    std::cout << std::string(lwid, '-') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_RANDOM_WISHART_HPP
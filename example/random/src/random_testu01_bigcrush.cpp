@@ -32,7 +32,8 @@
 #include "random_testu01_bigcrush.hpp"
 #include "random_testu01.hpp"
 
-void random_testu01_bigcrush(int argc, char **argv)
+void random_testu01_bigcrush(
+    int argc, char **argv, void (*reset)(const std::string &, bool))
 {
-    random_testu01(::bbattery_RepeatBigCrush, argc, argv);
+    random_testu01(::bbattery_RepeatBigCrush, 106, argc, argv, reset);
 }
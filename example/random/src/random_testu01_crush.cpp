@@ -32,7 +32,8 @@
 #include "random_testu01_crush.hpp"
 #include "random_testu01.hpp"
 
-void random_testu01_crush(int argc, char **argv)
+void random_testu01_crush(
+    int argc, char **argv, void (*reset)(const std::string &, bool))
 {
-    random_testu01(::bbattery_RepeatCrush, argc, argv);
+    random_testu01(::bbattery_RepeatCrush, 96, argc, argv, reset);
 }
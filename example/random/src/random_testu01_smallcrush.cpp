@@ -32,7 +32,8 @@
 #include "random_testu01_smallcrush.hpp"
 #include "random_testu01.hpp"
 
-void random_testu01_smallcrush(int argc, char **argv)
+void random_testu01_smallcrush(
+    int argc, char **argv, void (*reset)(const std::string &, bool))
 {
-    random_testu01(::bbattery_RepeatSmallCrush, argc, argv);
+    random_testu01(::bbattery_RepeatSmallCrush, 10, argc, argv, reset);
 }
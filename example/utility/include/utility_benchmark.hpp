@@ -0,0 +1,202 @@
+//============================================================================
+// MCKL/example/utility/include/utility_benchmark.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_UTILITY_BENCHMARK_HPP
+#define MCKL_EXAMPLE_UTILITY_BENCHMARK_HPP
+
+#include <mckl/algorithm/resample.hpp>
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/core/state_matrix.hpp>
+#include <mckl/math/vmf.hpp>
+#include <mckl/random/exponential_distribution.hpp>
+#include <mckl/random/gamma_distribution.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/pcg.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/threefry.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/random/xoshiro.hpp>
+#include <mckl/utility/benchmark.hpp>
+
+template <typename RNGType>
+inline void utility_benchmark_rng(
+    mckl::Benchmark &benchmark, std::size_t N, const std::string &name)
+{
+    using result_type = typename RNGType::result_type;
+
+    RNGType rng;
+    mckl::Vector<result_type> r(N);
+    benchmark.run("RNG " + name, N, N * sizeof(result_type),
+        [&]() { mckl::rand(rng, N, r.data()); });
+}
+
+template <typename DistributionType>
+inline void utility_benchmark_distribution(mckl::Benchmark &benchmark,
+    std::size_t N, const std::string &name, DistributionType dist)
+{
+    using result_type = typename DistributionType::result_type;
+
+    mckl::RNG rng;
+    mckl::Vector<result_type> r(N);
+    benchmark.run("Distribution " + name, N, N * sizeof(result_type),
+        [&]() { mckl::rand(rng, dist, N, r.data()); });
+}
+
+template <typename Func>
+inline void utility_benchmark_vmf(mckl::Benchmark &benchmark, std::size_t N,
+    const std::string &name, double a, double b, Func &&f)
+{
+    mckl::RNG rng;
+    mckl::UniformRealDistribution<double> unif(a, b);
+    mckl::Vector<double> x(N);
+    mckl::Vector<double> r(N);
+    mckl::rand(rng, unif, N, x.data());
+    benchmark.run("VMF " + name, N, N * sizeof(double) * 2,
+        [&]() { f(N, x.data(), r.data()); });
+}
+
+template <typename ResampleType>
+inline void utility_benchmark_resample(
+    mckl::Benchmark &benchmark, std::size_t N, const std::string &name)
+{
+    mckl::RNG rng;
+    mckl::U01Distribution<double> u01;
+    mckl::Vector<double> w(N);
+    mckl::Vector<std::size_t> rep(N);
+    mckl::rand(rng, u01, N, w.data());
+    const double sum = std::accumulate(w.begin(), w.end(), 0.0);
+    mckl::mul(N, 1 / sum, w.data(), w.data());
+    ResampleType resample;
+    benchmark.run("Resample " + name, N,
+        N * (sizeof(double) + sizeof(std::size_t)),
+        [&]() { resample(N, N, rng, w.data(), rep.data()); });
+}
+
+template <mckl::MatrixLayout Layout>
+class UtilityBenchmarkState : public mckl::StateMatrix<Layout, double>
+{
+  public:
+    using mckl::StateMatrix<Layout, double>::StateMatrix;
+}; // class UtilityBenchmarkState
+
+template <mckl::MatrixLayout Layout>
+inline void utility_benchmark_smc(mckl::Benchmark &benchmark, std::size_t N,
+    std::size_t dim, const std::string &name)
+{
+    using T = UtilityBenchmarkState<Layout>;
+
+    mckl::SMCSampler<T> sampler(N, dim);
+    sampler.resample_threshold(0.5);
+    sampler.resample(mckl::Systematic);
+    sampler.mutation([](std::size_t, mckl::Particle<T> &particle) {
+        const std::size_t n = particle.size();
+        const std::size_t d = particle.state().dim();
+        mckl::NormalDistribution<double> normal(0, 1);
+        mckl::Vector<double> z(n * d);
+        mckl::Vector<double> w(n);
+        mckl::rand(particle.rng(), normal, n * d, z.data());
+        double *s = particle.state().data();
+        mckl::add(n * d, s, z.data(), s);
+        for (std::size_t i = 0; i != n; ++i) {
+            w[i] = -0.5 * particle.state()(i, 0) * particle.state()(i, 0);
+        }
+        particle.weight().add_log(w.data());
+    });
+    sampler.mutation_estimator(mckl::SMCEstimator<T>(dim,
+        [](std::size_t, std::size_t d, mckl::Particle<T> &particle,
+            double *r) {
+            std::copy_n(particle.state().data(), particle.size() * d, r);
+        },
+        Layout));
+    benchmark.run("SMC " + name, N, N * dim * sizeof(double),
+        [&]() { sampler.iterate(); });
+}
+
+inline int utility_benchmark(std::size_t N, std::size_t R,
+    const std::string &output, const std::string &baseline)
+{
+    mckl::Benchmark benchmark(R, 1);
+
+    utility_benchmark_rng<std::mt19937>(benchmark, N, "mt19937");
+    utility_benchmark_rng<std::mt19937_64>(benchmark, N, "mt19937_64");
+    utility_benchmark_rng<mckl::Threefry4x64>(benchmark, N, "Threefry4x64");
+    utility_benchmark_rng<mckl::Xoshiro256PP>(benchmark, N, "Xoshiro256PP");
+    utility_benchmark_rng<mckl::PCG64>(benchmark, N, "PCG64");
+    utility_benchmark_rng<mckl::RNG>(benchmark, N, "RNG");
+
+    utility_benchmark_distribution(
+        benchmark, N, "U01", mckl::U01Distribution<double>());
+    utility_benchmark_distribution(
+        benchmark, N, "Normal(0, 1)", mckl::NormalDistribution<double>(0, 1));
+    utility_benchmark_distribution(benchmark, N, "Exponential(1)",
+        mckl::ExponentialDistribution<double>(1));
+    utility_benchmark_distribution(
+        benchmark, N, "Gamma(2, 1)", mckl::GammaDistribution<double>(2, 1));
+
+    utility_benchmark_vmf(benchmark, N, "exp", -700, 700,
+        [](std::size_t n, const double *a, double *y) { mckl::exp(n, a, y); });
+    utility_benchmark_vmf(benchmark, N, "log", 0, 1e10,
+        [](std::size_t n, const double *a, double *y) { mckl::log(n, a, y); });
+    utility_benchmark_vmf(benchmark, N, "sqrt", 0, 1e10,
+        [](std::size_t n, const double *a, double *y) {
+            mckl::sqrt(n, a, y);
+        });
+    utility_benchmark_vmf(benchmark, N, "sin", -1e3, 1e3,
+        [](std::size_t n, const double *a, double *y) { mckl::sin(n, a, y); });
+
+    utility_benchmark_resample<mckl::ResampleMultinomial>(
+        benchmark, N, "Multinomial");
+    utility_benchmark_resample<mckl::ResampleStratified>(
+        benchmark, N, "Stratified");
+    utility_benchmark_resample<mckl::ResampleSystematic>(
+        benchmark, N, "Systematic");
+    utility_benchmark_resample<mckl::ResampleResidual>(
+        benchmark, N, "Residual");
+
+    utility_benchmark_smc<mckl::RowMajor>(benchmark, N, 4, "RowMajor");
+    utility_benchmark_smc<mckl::ColMajor>(benchmark, N, 4, "ColMajor");
+
+    std::cout << benchmark;
+
+    if (!output.empty()) {
+        benchmark.write_json(output);
+    }
+
+    if (!baseline.empty()) {
+        const std::size_t regressed = mckl::benchmark_compare(
+            mckl::benchmark_read_json(baseline), benchmark.result());
+        return regressed == 0 ? 0 : 1;
+    }
+
+    return 0;
+}
+
+#endif // MCKL_EXAMPLE_UTILITY_BENCHMARK_HPP
@@ -0,0 +1,264 @@
+//============================================================================
+// MCKL/example/utility/include/utility_covariance.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_UTILITY_COVARIANCE_HPP
+#define MCKL_EXAMPLE_UTILITY_COVARIANCE_HPP
+
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/utility/covariance.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+template <typename>
+inline std::string utility_covariance_backend_name();
+
+template <>
+inline std::string utility_covariance_backend_name<mckl::BackendSEQ>()
+{
+    return "SEQ";
+}
+
+template <>
+inline std::string utility_covariance_backend_name<mckl::BackendSTD>()
+{
+    return "STD";
+}
+
+template <>
+inline std::string utility_covariance_backend_name<mckl::BackendOMP>()
+{
+    return "OMP";
+}
+
+#if MCKL_HAS_TBB
+template <>
+inline std::string utility_covariance_backend_name<mckl::BackendTBB>()
+{
+    return "TBB";
+}
+#endif
+
+// Two-pass covariance in long double
+inline void utility_covariance_exact(mckl::MatrixLayout layout, std::size_t n,
+    std::size_t p, const double *x, const double *w, double *mu, double *cov)
+{
+    const std::size_t rs = layout == mckl::RowMajor ? p : 1;
+    const std::size_t cs = layout == mckl::RowMajor ? 1 : n;
+
+    long double sw = 0;
+    long double sw2 = 0;
+    mckl::Vector<long double> mean(p, 0);
+    for (std::size_t i = 0; i != n; ++i) {
+        const long double wi = w == nullptr ? 1 : w[i];
+        sw += wi;
+        sw2 += wi * wi;
+        for (std::size_t j = 0; j != p; ++j) {
+            mean[j] += wi * x[i * rs + j * cs];
+        }
+    }
+    for (std::size_t j = 0; j != p; ++j) {
+        mean[j] /= sw;
+        mu[j] = static_cast<double>(mean[j]);
+    }
+
+    mckl::Vector<long double> c(p * p, 0);
+    mckl::Vector<long double> d(p);
+    for (std::size_t i = 0; i != n; ++i) {
+        const long double wi = w == nullptr ? 1 : w[i];
+        for (std::size_t j = 0; j != p; ++j) {
+            d[j] = x[i * rs + j * cs] - mean[j];
+        }
+        for (std::size_t j = 0; j != p; ++j) {
+            for (std::size_t k = 0; k != p; ++k) {
+                c[j * p + k] += wi * d[j] * d[k];
+            }
+        }
+    }
+    for (std::size_t j = 0; j != p * p; ++j) {
+        cov[j] = static_cast<double>(c[j] / (sw - sw2 / sw));
+    }
+}
+
+inline double utility_covariance_error(
+    std::size_t n, const double *r1, const double *r2)
+{
+    double e = 0;
+    double s = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        e += (r1[i] - r2[i]) * (r1[i] - r2[i]);
+        s += r2[i] * r2[i];
+    }
+
+    return std::sqrt(e / s);
+}
+
+template <typename Cov>
+inline bool utility_covariance_test(Cov &&covariance,
+    const std::string &method, const std::string &backend,
+    mckl::MatrixLayout layout, std::size_t n, std::size_t p, const double *x,
+    const double *w, const double *exact_mean, const double *exact,
+    double tolerance)
+{
+    mckl::Vector<double> mean(p);
+    mckl::Vector<double> cov(p * p);
+    mckl::StopWatch watch;
+    watch.start();
+    covariance(layout, n, p, x, w, mean.data(), cov.data());
+    watch.stop();
+
+    // Mean only
+    mckl::Vector<double> mean_only(p);
+    covariance(layout, n, p, x, w, mean_only.data(), nullptr);
+
+    const double error = std::max(
+        {utility_covariance_error(p * p, cov.data(), exact),
+            utility_covariance_error(p, mean.data(), exact_mean),
+            utility_covariance_error(p, mean_only.data(), exact_mean)});
+    const bool passed = error < tolerance;
+    std::cout << std::setw(10) << std::left
+              << (layout == mckl::RowMajor ? "Row" : "Col") << std::setw(10)
+              << std::left << (w == nullptr ? "No" : "Yes") << std::setw(20)
+              << std::left << method << std::setw(10) << std::left << backend
+              << std::setw(10) << std::right << std::scientific
+              << std::setprecision(2) << error << std::setw(10)
+              << std::right << std::fixed << watch.milliseconds()
+              << std::setw(10) << std::right
+              << (passed ? "Passed" : "Failed") << std::endl;
+
+    return passed;
+}
+
+template <typename Backend>
+inline bool utility_covariance_smp(mckl::MatrixLayout layout, std::size_t n,
+    std::size_t p, const double *x, const double *w, const double *exact_mean,
+    const double *exact, double tolerance)
+{
+    const std::string backend = utility_covariance_backend_name<Backend>();
+
+    bool passed = true;
+    passed = utility_covariance_test(
+                 mckl::CovarianceSMP<double, Backend>(mckl::CovarianceOnePass),
+                 "CovarianceSMP (1)", backend, layout, n, p, x, w, exact_mean,
+                 exact, tolerance) &&
+        passed;
+    passed = utility_covariance_test(
+                 mckl::CovarianceSMP<double, Backend>(mckl::CovarianceTwoPass),
+                 "CovarianceSMP (2)", backend, layout, n, p, x, w, exact_mean,
+                 exact, tolerance) &&
+        passed;
+
+    return passed;
+}
+
+inline bool utility_covariance(mckl::MatrixLayout layout, std::size_t n,
+    std::size_t p, const double *x, const double *w)
+{
+    const double tolerance = 1e-10;
+
+    mckl::Vector<double> exact_mean(p);
+    mckl::Vector<double> exact(p * p);
+    utility_covariance_exact(
+        layout, n, p, x, w, exact_mean.data(), exact.data());
+
+    bool passed = true;
+    utility_covariance_test(mckl::Covariance<double>(), "Covariance", "",
+        layout, n, p, x, w, exact_mean.data(), exact.data(), 1.0);
+    passed = utility_covariance_smp<mckl::BackendSEQ>(
+                 layout, n, p, x, w, exact_mean.data(), exact.data(),
+                 tolerance) &&
+        passed;
+    passed = utility_covariance_smp<mckl::BackendSTD>(
+                 layout, n, p, x, w, exact_mean.data(), exact.data(),
+                 tolerance) &&
+        passed;
+    passed = utility_covariance_smp<mckl::BackendOMP>(
+                 layout, n, p, x, w, exact_mean.data(), exact.data(),
+                 tolerance) &&
+        passed;
+#if MCKL_HAS_TBB
+    passed = utility_covariance_smp<mckl::BackendTBB>(
+                 layout, n, p, x, w, exact_mean.data(), exact.data(),
+                 tolerance) &&
+        passed;
+#endif
+
+    return passed;
+}
+
+inline void utility_covariance(std::size_t n, std::size_t p)
+{
+    mckl::RNG rng;
+    mckl::NormalDistribution<double> normal;
+
+    // Samples with a large offset and correlated components
+    mckl::Vector<double> x(n * p);
+    mckl::Vector<double> y(n * p);
+    mckl::Vector<double> w(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        double z = 0;
+        for (std::size_t j = 0; j != p; ++j) {
+            z = 0.5 * z + normal(rng);
+            x[i * p + j] = 1e4 + z;
+            y[j * n + i] = x[i * p + j];
+        }
+    }
+    mckl::u01_distribution(rng, n, w.data());
+
+    std::cout << std::string(90, '=') << std::endl;
+    std::cout << std::setw(10) << std::left << "Layout" << std::setw(10)
+              << std::left << "Weight" << std::setw(20) << std::left
+              << "Method" << std::setw(10) << std::left << "Backend"
+              << std::setw(10) << std::right << "Error" << std::setw(10)
+              << std::right << "Time (ms)" << std::setw(10) << std::right
+              << "Test" << std::endl;
+
+    bool passed = true;
+    std::cout << std::string(90, '-') << std::endl;
+    passed = utility_covariance(mckl::RowMajor, n, p, x.data(), nullptr) &&
+        passed;
+    std::cout << std::string(90, '-') << std::endl;
+    passed = utility_covariance(mckl::RowMajor, n, p, x.data(), w.data()) &&
+        passed;
+    std::cout << std::string(90, '-') << std::endl;
+    passed = utility_covariance(mckl::ColMajor, n, p, y.data(), nullptr) &&
+        passed;
+    std::cout << std::string(90, '-') << std::endl;
+    passed = utility_covariance(mckl::ColMajor, n, p, y.data(), w.data()) &&
+        passed;
+
+    std::cout << std::string(90, '-') << std::endl;
+    std::cout << std::setw(80) << std::left << "Test result" << std::setw(10)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+    std::cout << std::string(90, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_UTILITY_COVARIANCE_HPP
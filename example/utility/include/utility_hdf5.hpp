@@ -268,6 +268,80 @@ inline void utility_hdf5_matrix(std::size_t N, std::size_t M)
     std::cout << std::endl;
 }
 
+template <mckl::MatrixLayout Layout1, typename T1, typename T2>
+inline void utility_hdf5_writer(std::size_t N, std::size_t M)
+{
+    mckl::RNG rng;
+    mckl::UniformIntDistribution<std::size_t> rsize(0, N);
+    mckl::UniformIntDistribution<std::size_t> rcol(1, 100);
+    mckl::U01Distribution<T1> u01;
+
+    const std::string filename("utility_hdf5.h5");
+    const std::string dataname("group/data");
+    mckl::StopWatch watch1;
+    mckl::StopWatch watch2;
+    bool passed = true;
+    std::size_t n = 0;
+    for (std::size_t k = 0; k != M / 10; ++k) {
+        const std::size_t ncol = rcol(rng);
+        mckl::Matrix<T1, mckl::RowMajor> m1(0, ncol);
+        mckl::Vector<mckl::Matrix<T1, Layout1>> chunks;
+        for (std::size_t i = 0; i != 10; ++i) {
+            const std::size_t nrow = rsize(rng);
+            mckl::Matrix<T1, Layout1> m(nrow, ncol);
+            mckl::rand(rng, u01, nrow * ncol, m.data());
+            for (std::size_t r = 0; r != nrow; ++r)
+                m1.push_back_row(m.row_begin(r));
+            chunks.push_back(std::move(m));
+        }
+        n += m1.nrow() * m1.ncol();
+
+        watch1.start();
+        mckl::HDF5Writer writer(filename, false, 1024, k % 2, 1 << 16);
+        for (const auto &m : chunks)
+            writer.append(dataname, m);
+        writer.close();
+        watch1.stop();
+        passed = passed && writer.good();
+        if (!passed)
+            break;
+
+        mckl::Matrix<T2, mckl::RowMajor> m2;
+        mckl::HDF5File h5file(filename, true, true);
+        watch2.start();
+        mckl::hdf5load(h5file, dataname, &m2);
+        watch2.stop();
+
+        passed = passed && m1.nrow() == m2.nrow() && m1.ncol() == m2.ncol();
+        if (!passed)
+            break;
+
+        for (std::size_t i = 0; i != m1.nrow(); ++i)
+            for (std::size_t j = 0; j != m1.ncol(); ++j)
+                passed = passed &&
+                    static_cast<float>(m1(i, j)) ==
+                        static_cast<float>(m2(i, j));
+        if (!passed)
+            break;
+    }
+
+    const std::string n1("Writer<" + utility_hdf5_typename<T1>() + ", " +
+        utility_hdf5_layoutname<Layout1>() + ">");
+    const std::string n2("Matrix<" + utility_hdf5_typename<T2>() + ", " +
+        utility_hdf5_layoutname<mckl::RowMajor>() + ">");
+    const std::size_t bytes1 = n * sizeof(T1);
+    const std::size_t bytes2 = n * sizeof(T2);
+
+    std::cout << std::setw(30) << std::left << n1;
+    std::cout << std::setw(30) << std::left << n2;
+    std::cout << std::setw(10) << std::right
+              << 1e-6 * bytes1 / watch1.seconds();
+    std::cout << std::setw(10) << std::right
+              << 1e-6 * bytes2 / watch2.seconds();
+    std::cout << std::setw(15) << std::right << (passed ? "Passed" : "Failed");
+    std::cout << std::endl;
+}
+
 inline void utility_hdf5(std::size_t N, std::size_t M)
 {
     std::cout << std::string(95, '=') << std::endl;
@@ -307,6 +381,13 @@ inline void utility_hdf5(std::size_t N, std::size_t M)
     utility_hdf5_matrix<mckl::ColMajor, mckl::ColMajor, double, double>(N, M);
 
     std::cout << std::string(95, '-') << std::endl;
+
+    utility_hdf5_writer<mckl::RowMajor, float, float>(N, M);
+    utility_hdf5_writer<mckl::RowMajor, double, double>(N, M);
+    utility_hdf5_writer<mckl::ColMajor, float, float>(N, M);
+    utility_hdf5_writer<mckl::ColMajor, double, double>(N, M);
+
+    std::cout << std::string(95, '-') << std::endl;
 }
 
 #endif // MCKL_EXAMPLE_UTILITY_HDF5_HPP
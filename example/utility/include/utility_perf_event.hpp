@@ -0,0 +1,166 @@
+//============================================================================
+// MCKL/example/utility/include/utility_perf_event.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_EXAMPLE_UTILITY_PERF_EVENT_HPP
+#define MCKL_EXAMPLE_UTILITY_PERF_EVENT_HPP
+
+#include <mckl/math/vmf.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/utility/perf_event.hpp>
+
+inline void utility_perf_event_print(
+    const std::string &name, const mckl::StopWatchPerf &watch)
+{
+    std::cout << std::setw(40) << std::left << name;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(10) << std::right << watch.milliseconds();
+    if (watch.has(mckl::PerfEvent::Instructions) && watch.has_cycles()) {
+        std::cout << std::setw(10) << std::right << watch.ipc();
+    } else {
+        std::cout << std::setw(10) << std::right << '-';
+    }
+    if (watch.has(mckl::PerfEvent::CacheMisses) &&
+        watch.has(mckl::PerfEvent::CacheReferences)) {
+        std::cout << std::setw(10) << std::right << watch.cache_miss_rate();
+    } else {
+        std::cout << std::setw(10) << std::right << '-';
+    }
+    if (watch.has(mckl::PerfEvent::BranchMisses) &&
+        watch.has(mckl::PerfEvent::BranchInstructions)) {
+        std::cout << std::setw(10) << std::right << watch.branch_miss_rate();
+    } else {
+        std::cout << std::setw(10) << std::right << '-';
+    }
+    std::cout << std::endl;
+}
+
+inline bool utility_perf_event_check(const std::string &name, bool passed)
+{
+    std::cout << std::setw(60) << std::left << name << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+
+    return passed;
+}
+
+inline void utility_perf_event(std::size_t N)
+{
+    mckl::RNG rng;
+    mckl::U01Distribution<double> u01;
+    mckl::Vector<double> x(N);
+    mckl::Vector<double> y(N);
+
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << std::setw(40) << std::left << "Kernel";
+    std::cout << std::setw(10) << std::right << "Time (ms)";
+    std::cout << std::setw(10) << std::right << "IPC";
+    std::cout << std::setw(10) << std::right << "Cache";
+    std::cout << std::setw(10) << std::right << "Branch";
+    std::cout << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    mckl::StopWatchPerf watch_u01;
+    watch_u01.start();
+    mckl::rand(rng, u01, N, x.data());
+    watch_u01.stop();
+    utility_perf_event_print("U01Distribution<double>", watch_u01);
+
+    mckl::StopWatchPerf watch_exp;
+    watch_exp.start();
+    mckl::exp(N, x.data(), y.data());
+    watch_exp.stop();
+    utility_perf_event_print("exp", watch_exp);
+
+    mckl::StopWatchPerf watch_gather;
+    mckl::Vector<std::size_t> idx(N);
+    for (std::size_t i = 0; i != N; ++i) {
+        idx[i] = static_cast<std::size_t>(x[i] * N);
+    }
+    watch_gather.start();
+    for (std::size_t i = 0; i != N; ++i) {
+        y[i] = x[idx[i]];
+    }
+    watch_gather.stop();
+    utility_perf_event_print("Random gather", watch_gather);
+
+    std::cout << std::string(80, '-') << std::endl;
+
+    // Software events are available to unprivileged processes on Linux,
+    // hardware events may not be available in virtual machines
+    mckl::StopWatchPerf watch_sw({mckl::PerfEvent::TaskClock,
+        mckl::PerfEvent::PageFaults, mckl::PerfEvent::ContextSwitches});
+    const std::size_t M = 1 << 24;
+    watch_sw.start();
+    double *p = static_cast<double *>(std::malloc(sizeof(double) * M));
+    for (std::size_t i = 0; i < M; i += 512) {
+        p[i] = static_cast<double>(i);
+    }
+    watch_sw.stop();
+    std::free(p);
+    const std::uint64_t faults = watch_sw.count(mckl::PerfEvent::PageFaults);
+    const std::uint64_t task = watch_sw.count(mckl::PerfEvent::TaskClock);
+
+    bool passed = true;
+    passed = utility_perf_event_check("Elapsed time",
+                 watch_u01.nanoseconds() > 0 &&
+                     watch_exp.nanoseconds() > 0) &&
+        passed;
+    passed = utility_perf_event_check("Page faults",
+                 !watch_sw.has(mckl::PerfEvent::PageFaults) ||
+                     faults >= (M * sizeof(double)) / (1 << 21)) &&
+        passed;
+    passed = utility_perf_event_check("Task clock",
+                 !watch_sw.has(mckl::PerfEvent::TaskClock) ||
+                     (task > 0 && task < 2 * watch_sw.nanoseconds() + 1e6)) &&
+        passed;
+
+    const std::uint64_t first = watch_u01.count(mckl::PerfEvent::Cycles);
+    watch_u01.start();
+    mckl::rand(rng, u01, N, x.data());
+    watch_u01.stop();
+    passed = utility_perf_event_check("Accumulation",
+                 watch_u01.count(mckl::PerfEvent::Cycles) >= first) &&
+        passed;
+    watch_u01.reset();
+    passed = utility_perf_event_check("Reset",
+                 watch_u01.count(mckl::PerfEvent::Cycles) == 0 &&
+                     watch_u01.nanoseconds() == 0) &&
+        passed;
+
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << watch_sw;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::setw(60) << std::left << "Test result" << std::setw(20)
+              << std::right << (passed ? "Passed" : "Failed") << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+}
+
+#endif // MCKL_EXAMPLE_UTILITY_PERF_EVENT_HPP
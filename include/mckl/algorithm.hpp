@@ -33,9 +33,15 @@
 #define MCKL_ALGORITHM_HPP
 
 #include <mckl/internal/config.h>
+#include <mckl/algorithm/ensemble.hpp>
 #include <mckl/algorithm/mcmc.hpp>
+#include <mckl/algorithm/mh.hpp>
 #include <mckl/algorithm/pmcmc.hpp>
 #include <mckl/algorithm/resample.hpp>
 #include <mckl/algorithm/smc.hpp>
 
+#if MCKL_HAS_HDF5
+#include <mckl/algorithm/hdf5.hpp>
+#endif
+
 #endif // MCKL_ALGORITHM_HPP
@@ -0,0 +1,206 @@
+//============================================================================
+// MCKL/include/mckl/algorithm/ensemble.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_ALGORITHM_ENSEMBLE_HPP
+#define MCKL_ALGORITHM_ENSEMBLE_HPP
+
+#include <mckl/internal/common.hpp>
+#include <mckl/smp.hpp>
+#include <atomic>
+
+namespace mckl {
+
+namespace internal {
+
+template <typename S>
+inline auto ensemble_clone(const S &sampler, int) -> decltype(sampler.clone())
+{
+    return sampler.clone();
+}
+
+template <typename S>
+inline S ensemble_clone(const S &sampler, long)
+{
+    return sampler;
+}
+
+} // namespace internal
+
+/// \brief An ensemble of independent samplers
+/// \ingroup Algorithm
+///
+/// \tparam S The sampler type, such as SMCSampler or MCMCSampler
+/// \tparam Backend The SMP backend used to schedule the samplers
+///
+/// \details
+/// The samplers are the units of parallel work. Each worker of the backend
+/// repeatedly claims the next `grainsize()` samplers not yet claimed and
+/// iterates them to completion. Thus the load is balanced even if the
+/// samplers have different sizes or costs, and the results do not depend on
+/// the number of workers or the order in which the samplers are claimed.
+///
+/// The evaluation objects of the samplers are usually sequential, such as
+/// those derived from SMCSamplerEvalSEQ. If they use BackendTBB, the nested
+/// loops over particles are split into tasks that idle workers can steal,
+/// such that a few large samplers still occupy the whole pool. Nested loops
+/// of other backends run sequentially within a worker when the backend does
+/// not support nesting, and shall be avoided otherwise.
+///
+/// All SMCSampler objects in the same thread share the workspace of
+/// ResampleEval, and clones created by the ensemble are seeded by the same
+/// Seed singleton as other RNG engines, such that the streams are distinct.
+template <typename S, typename Backend = BackendSMP>
+class Ensemble
+{
+  public:
+    using sampler_type = S;
+    using size_type = std::size_t;
+    using iterator = typename Vector<S>::iterator;
+    using const_iterator = typename Vector<S>::const_iterator;
+
+    /// \brief Construct an empty ensemble
+    explicit Ensemble(std::size_t grainsize = 1)
+        : grainsize_(std::max<std::size_t>(grainsize, 1))
+    {
+    }
+
+    /// \brief Construct an ensemble of clones of a sampler
+    ///
+    /// \details
+    /// If the sampler has a member function `clone()`, such as SMCSampler, it
+    /// is used to create the samplers with new RNG streams. Otherwise the
+    /// sampler is copied.
+    Ensemble(std::size_t n, const S &sampler, std::size_t grainsize = 1)
+        : grainsize_(std::max<std::size_t>(grainsize, 1))
+    {
+        sampler_.reserve(n);
+        for (std::size_t i = 0; i != n; ++i) {
+            sampler_.push_back(internal::ensemble_clone(sampler, 0));
+        }
+    }
+
+    /// \brief The number of samplers
+    size_type size() const { return sampler_.size(); }
+
+    /// \brief If the ensemble is empty
+    bool empty() const { return sampler_.empty(); }
+
+    /// \brief Reserve space for a number of samplers
+    void reserve(std::size_t n) { sampler_.reserve(n); }
+
+    /// \brief Remove all samplers
+    void clear() { sampler_.clear(); }
+
+    /// \brief Add a sampler
+    void push_back(const S &sampler) { sampler_.push_back(sampler); }
+
+    /// \brief Add a sampler
+    void push_back(S &&sampler) { sampler_.push_back(std::move(sampler)); }
+
+    /// \brief Construct a sampler in place
+    template <typename... Args>
+    void emplace_back(Args &&... args)
+    {
+        sampler_.emplace_back(std::forward<Args>(args)...);
+    }
+
+    /// \brief Read and write access to a sampler
+    S &operator[](std::size_t i) { return sampler_[i]; }
+
+    /// \brief Read only access to a sampler
+    const S &operator[](std::size_t i) const { return sampler_[i]; }
+
+    iterator begin() { return sampler_.begin(); }
+
+    iterator end() { return sampler_.end(); }
+
+    const_iterator begin() const { return sampler_.begin(); }
+
+    const_iterator end() const { return sampler_.end(); }
+
+    /// \brief The number of samplers claimed by a worker at a time
+    std::size_t grainsize() const { return grainsize_; }
+
+    /// \brief Set the number of samplers claimed by a worker at a time
+    void grainsize(std::size_t n) { grainsize_ = std::max<std::size_t>(n, 1); }
+
+    /// \brief Iterate all samplers
+    void iterate(std::size_t n = 1)
+    {
+        for_each([n](std::size_t, S &sampler) { sampler.iterate(n); });
+    }
+
+    /// \brief Apply a function to all samplers in parallel
+    ///
+    /// \param f A callable object, invoked as `f(i, sampler)` for the i-th
+    /// sampler. Invocations on different samplers may be concurrent.
+    template <typename Func>
+    void for_each(Func &&f)
+    {
+        for_each_dispatch(sampler_, grainsize_, std::forward<Func>(f));
+    }
+
+    /// \brief Apply a function to all samplers in parallel
+    template <typename Func>
+    void for_each(Func &&f) const
+    {
+        for_each_dispatch(sampler_, grainsize_, std::forward<Func>(f));
+    }
+
+  private:
+    std::size_t grainsize_;
+    Vector<S> sampler_;
+
+    template <typename V, typename Func>
+    static void for_each_dispatch(V &sampler, std::size_t G, Func &&f)
+    {
+        const std::size_t N = sampler.size();
+        std::atomic<std::size_t> next(0);
+
+        // The sub-ranges only determine the number of workers, each of which
+        // claims samplers until none is left
+        smp_for<Backend>(N,
+            [&sampler, &f, &next, N, G](std::size_t, std::size_t) {
+                std::size_t ibegin = 0;
+                while ((ibegin = next.fetch_add(G)) < N) {
+                    const std::size_t iend = std::min(N, ibegin + G);
+                    for (std::size_t i = ibegin; i != iend; ++i) {
+                        f(i, sampler[i]);
+                    }
+                }
+            },
+            G);
+    }
+}; // class Ensemble
+
+} // namespace mckl
+
+#endif // MCKL_ALGORITHM_ENSEMBLE_HPP
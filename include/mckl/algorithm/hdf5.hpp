@@ -0,0 +1,226 @@
+//============================================================================
+// MCKL/include/mckl/algorithm/hdf5.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_ALGORITHM_HDF5_HPP
+#define MCKL_ALGORITHM_HDF5_HPP
+
+#include <mckl/internal/common.hpp>
+#include <mckl/algorithm/mcmc.hpp>
+#include <mckl/algorithm/resample.hpp>
+#include <mckl/algorithm/smc.hpp>
+#include <mckl/utility/hdf5.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+template <typename State>
+inline auto hdf5_sink_state(HDF5Writer &writer, const std::string &name,
+    const State &state, int) -> decltype(writer.append(name, state))
+{
+    writer.append(name, state);
+}
+
+template <typename State>
+inline void hdf5_sink_state(HDF5Writer &, const std::string &, const State &,
+    long)
+{
+    runtime_assert(false,
+        "**hdf5_sink_state** snapshot of a state type not supported by "
+        "HDF5Writer");
+}
+
+inline std::string hdf5_sink_name(
+    const std::string &group, const std::string &name)
+{
+    return group.empty() ? name : group + "/" + name;
+}
+
+} // namespace internal
+
+/// \brief Append the resampling index of the last iteration
+/// \ingroup HDF5
+///
+/// \details
+/// The index is appended as a single column, such that the data set
+/// contains the indices of all iterations concatenated. The sample sizes are
+/// needed to split it, for example the `size` data set written by
+/// SMCSamplerHDF5.
+template <typename IntType>
+inline void hdf5append(HDF5Writer &writer, const std::string &name,
+    const ResampleIndex<IntType> &index)
+{
+    if (index.num_iter() == 0) {
+        return;
+    }
+
+    const std::size_t iter = index.num_iter() - 1;
+    Vector<IntType> idx(index.index_matrix_nrow(iter));
+    index.read_index_matrix(ColMajor, idx.data(), iter, iter);
+    writer.append(name, idx.size(), 1, idx.data());
+}
+
+/// \brief Stream the histories of SMCSampler into an HDF5Writer
+/// \ingroup SMC
+///
+/// \details
+/// An object of this class shall be added to a sampler through
+/// `SMCSampler::callback`. At the end of each iteration, the following data
+/// sets within `group` are appended,
+/// - `size`: The sample size
+/// - `ess`: The value of ESS
+/// - `estimate`: The row of the summary matrix
+/// - `state`: The state of the particle system if `snapshot` is true. It is
+///   only supported if the state type can be appended by HDF5Writer, for
+///   example StateMatrix.
+/// - `weight`: The normalized weights if `snapshot` is true.
+///
+/// If `discard` is true, the estimates are removed from the sampler after
+/// they are streamed, such that they no longer occupy memory.
+template <typename T, typename U = double>
+class SMCSamplerHDF5
+{
+  public:
+    SMCSamplerHDF5(HDF5Writer &writer, const std::string &group = "",
+        bool discard = false, bool snapshot = false)
+        : writer_(&writer)
+        , group_(group)
+        , discard_(discard)
+        , snapshot_(snapshot)
+    {
+    }
+
+    void operator()(std::size_t iter, SMCSampler<T, U> &sampler)
+    {
+        writer_->append(name("size"),
+            static_cast<std::size_t>(sampler.size_history(iter)));
+        writer_->append(name("ess"), sampler.ess_history(iter));
+
+        estimate_.resize(sampler.estimate_dim());
+        if (!estimate_.empty()) {
+            sampler.read_estimate(discard_ ? 0 : iter, estimate_.data());
+            writer_->append(name("estimate"), estimate_);
+        }
+        if (discard_) {
+            sampler.clear_estimate();
+        }
+
+        if (snapshot_) {
+            internal::hdf5_sink_state(
+                *writer_, name("state"), sampler.particle().state(), 0);
+            writer_->append(name("weight"),
+                static_cast<std::size_t>(sampler.size()), 1,
+                sampler.particle().weight().data());
+        }
+    }
+
+  private:
+    HDF5Writer *writer_;
+    std::string group_;
+    bool discard_;
+    bool snapshot_;
+    Vector<U> estimate_;
+
+    std::string name(const std::string &n) const
+    {
+        return internal::hdf5_sink_name(group_, n);
+    }
+}; // class SMCSamplerHDF5
+
+/// \brief Stream the histories of MCMCSampler into an HDF5Writer
+/// \ingroup MCMC
+///
+/// \details
+/// An object of this class shall be added to a sampler through
+/// `MCMCSampler::callback`. At the end of each iteration, the following data
+/// sets within `group` are appended,
+/// - `accept`: The accept counts of all mutation steps
+/// - `estimate`: The row of the summary matrix
+/// - `state`: The state if `snapshot` is true. It is only supported if the
+///   state type can be appended by HDF5Writer.
+///
+/// If `discard` is true, the estimates are removed from the sampler after
+/// they are streamed.
+template <typename T, typename U = double>
+class MCMCSamplerHDF5
+{
+  public:
+    MCMCSamplerHDF5(HDF5Writer &writer, const std::string &group = "",
+        bool discard = false, bool snapshot = false)
+        : writer_(&writer)
+        , group_(group)
+        , discard_(discard)
+        , snapshot_(snapshot)
+    {
+    }
+
+    void operator()(std::size_t iter, MCMCSampler<T, U> &sampler)
+    {
+        accept_.resize(sampler.accept_history_size());
+        if (!accept_.empty()) {
+            for (std::size_t i = 0; i != accept_.size(); ++i) {
+                accept_[i] = sampler.accept_history(i, iter);
+            }
+            writer_->append(name("accept"), accept_);
+        }
+
+        estimate_.resize(sampler.estimate_dim());
+        if (!estimate_.empty()) {
+            sampler.read_estimate(discard_ ? 0 : iter, estimate_.data());
+            writer_->append(name("estimate"), estimate_);
+        }
+        if (discard_) {
+            sampler.clear_estimate();
+        }
+
+        if (snapshot_) {
+            internal::hdf5_sink_state(
+                *writer_, name("state"), sampler.state(), 0);
+        }
+    }
+
+  private:
+    HDF5Writer *writer_;
+    std::string group_;
+    bool discard_;
+    bool snapshot_;
+    Vector<std::size_t> accept_;
+    Vector<U> estimate_;
+
+    std::string name(const std::string &n) const
+    {
+        return internal::hdf5_sink_name(group_, n);
+    }
+}; // class MCMCSamplerHDF5
+
+} // namespace mckl
+
+#endif // MCKL_ALGORITHM_HDF5_HPP
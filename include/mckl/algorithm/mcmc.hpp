@@ -172,6 +172,15 @@ class MCMCSampler : public Sampler<MCMCSampler<T, U>>
             accept_history_[i].begin(), accept_history_[i].end(), first);
     }
 
+    /// \brief The accept count of a given mutation step and iteration
+    std::size_t accept_history(std::size_t i, std::size_t iter) const
+    {
+        return accept_history_.at(i).at(iter);
+    }
+
+    /// \brief The number of mutation steps with accept count history
+    std::size_t accept_history_size() const { return accept_history_.size(); }
+
     /// \brief Read all accept count history into a matrix
     template <typename OutputIter>
     OutputIter read_accept_history(MatrixLayout layout, OutputIter first) const
@@ -195,6 +204,62 @@ class MCMCSampler : public Sampler<MCMCSampler<T, U>>
         return first;
     }
 
+    /// \brief Save the sampler to a checkpoint
+    ///
+    /// \details
+    /// The state, histories and estimates are saved. Evaluation objects,
+    /// estimators and callbacks are not.
+    void save(CheckpointWriter &writer) const
+    {
+        writer.write_text("MCMCSampler");
+        this->save_estimate(writer);
+        checkpoint_save(writer, state_);
+        writer.write(static_cast<std::uint64_t>(iter_));
+        writer.write(static_cast<std::uint64_t>(accept_history_.size()));
+        for (auto &a : accept_history_) {
+            checkpoint_save(writer, a);
+        }
+    }
+
+    /// \brief Save the sampler to a checkpoint file
+    bool save(const std::string &filename) const
+    {
+        CheckpointWriter writer(filename);
+        save(writer);
+
+        return writer.commit();
+    }
+
+    /// \brief Load the sampler from a checkpoint
+    ///
+    /// \details
+    /// The sampler shall have the same estimators as the one saved.
+    void load(CheckpointReader &reader)
+    {
+        runtime_assert(reader.read_text() == "MCMCSampler",
+            "**MCMCSampler::load** checkpoint not saved by MCMCSampler");
+        this->load_estimate(reader);
+        checkpoint_load(reader, state_);
+        iter_ = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        accept_history_.resize(
+            static_cast<std::size_t>(reader.read<std::uint64_t>()));
+        for (auto &a : accept_history_) {
+            checkpoint_load(reader, a);
+        }
+    }
+
+    /// \brief Load the sampler from a checkpoint file
+    bool load(const std::string &filename)
+    {
+        CheckpointReader reader(filename);
+        if (!reader.good()) {
+            return false;
+        }
+        load(reader);
+
+        return true;
+    }
+
   private:
     state_type state_;
     std::size_t iter_;
@@ -212,6 +277,7 @@ class MCMCSampler : public Sampler<MCMCSampler<T, U>>
         }
 
         ++iter_;
+        this->do_callback(iter_ - 1);
     }
 }; // class MCMCSampler
 
@@ -0,0 +1,201 @@
+//============================================================================
+// MCKL/include/mckl/algorithm/mh.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_ALGORITHM_MH_HPP
+#define MCKL_ALGORITHM_MH_HPP
+
+#include <mckl/internal/common.hpp>
+#include <mckl/algorithm/mcmc.hpp>
+#include <mckl/random/normal_distribution.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/seed.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/utility/covariance.hpp>
+
+namespace mckl {
+
+/// \brief Adaptive random walk Metropolis mutation
+/// \ingroup MH
+///
+/// \details
+/// The proposal is the mixture of Roberts and Rosenthal (2009),
+/// \f[
+///   Q_n(x,\cdot) = (1 - \beta)N(x, s\Sigma_n) + \beta N(x, \sigma^2I/d),
+/// \f]
+/// where \f$\Sigma_n\f$ is the covariance matrix of the chain history and
+/// \f$s = 2.38^2/d\f$ by default. Before `adapt_begin()` samples are
+/// accumulated, only the second component is used. The covariance matrix and
+/// its Cholesky factor are maintained by an OnlineCovariance object, such
+/// that each iteration, including the adaptation, costs \f$O(d^2)\f$
+/// operations, besides the evaluation of the target density.
+///
+/// The object can be used as an evaluation object of MCMCSampler<T>, where
+/// the state type `T` provides a member function `data()` that returns a
+/// pointer to `dim()` elements of type `RealType`, for example
+/// `std::array<RealType, Dim>` or `Vector<RealType>`.
+template <typename RealType = double, typename RNGType = RNG>
+class MHAdaptiveMutation
+{
+  public:
+    using result_type = RealType;
+    using rng_type = RNGType;
+    using log_target_type =
+        std::function<result_type(std::size_t, const result_type *)>;
+
+    /// \brief Construct an adaptive mutation
+    ///
+    /// \param dim The dimension of the state
+    /// \param log_target The log target density, called as
+    /// `log_target(dim, x)`, up to a normalizing constant
+    /// \param adapt_begin The number of samples accumulated before the
+    /// adaptive component is used. If it is zero, then `2 * dim` is used.
+    /// \param beta The probability of the non-adaptive component
+    /// \param sd The standard deviation \f$\sigma\f$ of the non-adaptive
+    /// component
+    template <typename LogTarget>
+    MHAdaptiveMutation(std::size_t dim, LogTarget &&log_target,
+        std::size_t adapt_begin = 0, result_type beta = 0.05,
+        result_type sd = 0.1)
+        : dim_(dim)
+        , adapt_begin_(adapt_begin == 0 ? 2 * dim : adapt_begin)
+        , adapt_(true)
+        , beta_(beta)
+        , sd_(sd / std::sqrt(static_cast<result_type>(dim)))
+        , scale_(static_cast<result_type>(2.38 * 2.38) /
+              static_cast<result_type>(dim))
+        , lp_(0)
+        , lp_valid_(false)
+        , log_target_(std::forward<LogTarget>(log_target))
+        , rng_(Seed<rng_type>::instance().get())
+        , cov_(dim)
+        , x_(dim)
+        , y_(dim)
+        , z_(dim)
+    {
+        runtime_assert(dim > 0,
+            "**MHAdaptiveMutation::MHAdaptiveMutation** zero dimension");
+        runtime_assert(beta >= 0 && beta <= 1,
+            "**MHAdaptiveMutation::MHAdaptiveMutation** mixture probability "
+            "not in [0, 1]");
+    }
+
+    /// \brief The dimension of the state
+    std::size_t dim() const { return dim_; }
+
+    /// \brief The number of samples accumulated before the adaptive
+    /// component is used
+    std::size_t adapt_begin() const { return adapt_begin_; }
+
+    /// \brief If the covariance matrix is updated by new samples
+    bool adapt() const { return adapt_; }
+
+    /// \brief Start or stop the adaptation
+    ///
+    /// \details
+    /// Once the adaptation is stopped, the proposal is fixed and the chain
+    /// is a Markov chain again.
+    void adapt(bool flag) { adapt_ = flag; }
+
+    /// \brief The scale \f$s\f$ of the adaptive component
+    result_type scale() const { return scale_; }
+
+    /// \brief Set the scale \f$s\f$ of the adaptive component
+    void scale(result_type s) { scale_ = s; }
+
+    /// \brief Read and write access to the RNG
+    rng_type &rng() { return rng_; }
+
+    /// \brief Read only access to the covariance accumulator
+    const OnlineCovariance<result_type> &covariance() const { return cov_; }
+
+    /// \brief Clear the chain history
+    void reset()
+    {
+        cov_.clear();
+        lp_valid_ = false;
+    }
+
+    template <typename T>
+    std::size_t operator()(std::size_t, T &state)
+    {
+        result_type *x = state.data();
+
+        if (!lp_valid_ || !std::equal(x, x + dim_, x_.begin())) {
+            std::copy_n(x, dim_, x_.begin());
+            lp_ = log_target_(dim_, x);
+            lp_valid_ = true;
+        }
+
+        if (adapt_) {
+            cov_.add(x);
+        }
+
+        U01Distribution<result_type> u01;
+        normal_distribution(rng_, dim_, z_.data(), const_zero<result_type>(),
+            const_one<result_type>());
+        if (cov_.size() < adapt_begin_ || u01(rng_) < beta_) {
+            mul(dim_, sd_, z_.data(), y_.data());
+        } else {
+            cov_.mulchol(z_.data(), y_.data(), scale_);
+        }
+        add(dim_, x, y_.data(), y_.data());
+        const result_type lp = log_target_(dim_, y_.data());
+
+        if (std::log(u01(rng_)) < lp - lp_) {
+            std::copy_n(y_.data(), dim_, x);
+            std::swap(x_, y_);
+            lp_ = lp;
+            return 1;
+        }
+
+        return 0;
+    }
+
+  private:
+    std::size_t dim_;
+    std::size_t adapt_begin_;
+    bool adapt_;
+    result_type beta_;
+    result_type sd_;
+    result_type scale_;
+    result_type lp_;
+    bool lp_valid_;
+    log_target_type log_target_;
+    rng_type rng_;
+    OnlineCovariance<result_type> cov_;
+    Vector<result_type> x_;
+    Vector<result_type> y_;
+    Vector<result_type> z_;
+}; // class MHAdaptiveMutation
+
+} // namespace mckl
+
+#endif // MCKL_ALGORITHM_MH_HPP
@@ -35,6 +35,7 @@
 #include <mckl/internal/common.hpp>
 #include <mckl/core/particle.hpp>
 #include <mckl/random/u01_distribution.hpp>
+#include <mckl/smp.hpp>
 
 namespace mckl {
 
@@ -465,6 +466,44 @@ inline OutputIter resample_trans_rep_index(
     return index;
 }
 
+namespace internal {
+
+// Workspace shared by all resampling in the same thread, such that many small
+// samplers do not allocate memory on every resampling. Each Slot shall be
+// used at most once during a resampling. The shared buffer is bounded by
+// 64KB, and larger workspaces are allocated for the call only, such that a
+// large resampling does not pin its memory in the thread.
+template <typename T, int Slot>
+class ResampleWorkspace
+{
+  public:
+    explicit ResampleWorkspace(std::size_t n)
+    {
+        static thread_local Vector<T> workspace;
+
+        if (n > max_size()) {
+            local_.resize(n);
+            data_ = local_.data();
+            return;
+        }
+
+        if (workspace.size() < n) {
+            workspace.resize(n);
+        }
+        data_ = workspace.data();
+    }
+
+    T *data() const { return data_; }
+
+    static constexpr std::size_t max_size() { return 65536 / sizeof(T); }
+
+  private:
+    Vector<T> local_;
+    T *data_;
+}; // class ResampleWorkspace
+
+} // namespace internal
+
 /// \brief SMCSampler<T>::eval_type subtype
 /// \ingroup Resample
 template <typename T>
@@ -499,11 +538,14 @@ class ResampleEval
         using size_type = typename Particle<T>::size_type;
 
         const std::size_t N = static_cast<std::size_t>(particle.size());
-        Vector<size_type> rep(N);
-        Vector<size_type> idx(N);
-        eval_(N, N, particle.rng(), particle.weight().data(), rep.data());
-        resample_trans_rep_index(N, N, rep.data(), idx.data());
-        particle.select(particle.size(), idx.data());
+        internal::ResampleWorkspace<size_type, 0> rep_workspace(N);
+        internal::ResampleWorkspace<size_type, 1> idx_workspace(N);
+        size_type *const rep = rep_workspace.data();
+        size_type *const idx = idx_workspace.data();
+        std::fill_n(rep, N, const_zero<size_type>());
+        eval_(N, N, particle.rng(), particle.weight().data(), rep);
+        resample_trans_rep_index(N, N, rep, idx);
+        particle.select(particle.size(), idx);
     }
 
   private:
@@ -540,9 +582,10 @@ class ResampleAlgorithm
     {
         using real_type = typename std::iterator_traits<InputIter>::value_type;
 
-        Vector<real_type> u01(M);
-        u01seq_(rng, M, u01.data());
-        resample_trans_u01_rep(N, M, weight, u01.data(), replication);
+        internal::ResampleWorkspace<real_type, 2> u01_workspace(M);
+        real_type *const u01 = u01_workspace.data();
+        u01seq_(rng, M, u01);
+        resample_trans_u01_rep(N, M, weight, u01, replication);
     }
 
     template <typename RNGType, typename InputIter, typename OutputIter>
@@ -552,14 +595,16 @@ class ResampleAlgorithm
         using real_type = typename std::iterator_traits<InputIter>::value_type;
         using rep_type = typename std::iterator_traits<OutputIter>::value_type;
 
-        Vector<real_type> resid(N);
-        Vector<rep_type> integ(N);
-        std::size_t R =
-            resample_trans_residual(N, M, weight, resid.data(), integ.data());
+        internal::ResampleWorkspace<real_type, 3> resid_workspace(N);
+        internal::ResampleWorkspace<rep_type, 4> integ_workspace(N);
+        real_type *const resid = resid_workspace.data();
+        rep_type *const integ = integ_workspace.data();
+        std::size_t R = resample_trans_residual(N, M, weight, resid, integ);
 
-        Vector<real_type> u01(R);
-        u01seq_(rng, R, u01.data());
-        resample_trans_u01_rep(N, R, resid.data(), u01.data(), replication);
+        internal::ResampleWorkspace<real_type, 2> u01_workspace(R);
+        real_type *const u01 = u01_workspace.data();
+        u01seq_(rng, R, u01);
+        resample_trans_u01_rep(N, R, resid, u01, replication);
         for (std::size_t i = 0; i != N; ++i, ++replication) {
             *replication += integ[i];
         }
@@ -831,6 +876,235 @@ class ResampleIndex
     }
 }; // class ResampleIndex
 
+/// \brief Record and trace resampling index with pruning of dead lineages
+/// \ingroup Resample
+///
+/// \details
+/// This class provides the same trace back of ancestors as ResampleIndex, for
+/// the particles of the last iteration. Instead of storing all resampling
+/// indices, it stores the ancestry tree of the surviving particles only. A
+/// node is removed as soon as none of the current particles descend from it,
+/// following the path storage algorithm of Jacob, Murray and Rubenthaler
+/// (2015). Iterations without resampling are recorded by a single flag. The
+/// expected memory cost is \f$O(T + N\log N)\f$, where \f$T\f$ is the number
+/// of iterations and \f$N\f$ is the sample size, instead of \f$O(TN)\f$.
+template <typename IntType = std::size_t>
+class ResampleGenealogy
+{
+  public:
+    using index_type = IntType;
+
+    ResampleGenealogy() : num_iter_(0), size_(0) {}
+
+    /// \brief Number of iterations recorded
+    std::size_t num_iter() const { return num_iter_; }
+
+    /// \brief The sample size of the last iteration
+    std::size_t size() const { return size_; }
+
+    /// \brief The number of nodes of the ancestry tree currently in use
+    std::size_t num_nodes() const { return node_.size() - free_.size(); }
+
+    /// \brief Reset history
+    void reset()
+    {
+        num_iter_ = 0;
+        size_ = 0;
+        node_.clear();
+        free_.clear();
+        leaf_.clear();
+        iter_.clear();
+    }
+
+    /// \brief Release memory
+    void clear()
+    {
+        reset();
+        node_.shrink_to_fit();
+        free_.shrink_to_fit();
+        leaf_.shrink_to_fit();
+        iter_.shrink_to_fit();
+        slot_.clear();
+        slot_.shrink_to_fit();
+    }
+
+    /// \brief Append an identity resampling index
+    void push_back(std::size_t N)
+    {
+        runtime_assert(num_iter_ == 0 || N == size_,
+            "**ResampleGenealogy::push_back** identity resampling index with "
+            "a different sample size");
+
+        ++num_iter_;
+        size_ = N;
+    }
+
+    /// \brief Append a resampling index
+    template <typename InputIter>
+    void push_back(std::size_t N, InputIter first)
+    {
+        Vector<std::size_t> leaf(N);
+        slot_.resize(num_iter_ == 0 ? 0 : size_);
+        std::fill(slot_.begin(), slot_.end(), npos());
+        for (std::size_t i = 0; i != N; ++i, ++first) {
+            const std::size_t p = static_cast<std::size_t>(*first);
+            runtime_assert(num_iter_ == 0 || p < size_,
+                "**ResampleGenealogy::push_back** parent index out of range");
+            if (p >= slot_.size()) {
+                slot_.resize(p + 1, npos());
+            }
+            if (slot_[p] == npos()) {
+                const std::size_t parent = leaf_.empty() ? npos() : leaf_[p];
+                slot_[p] = insert(static_cast<index_type>(p), parent);
+                if (parent != npos()) {
+                    ++node_[parent].count;
+                }
+            }
+            ++node_[slot_[p]].count;
+            leaf[i] = slot_[p];
+        }
+        for (auto l : leaf_) {
+            release(l);
+        }
+        leaf_.swap(leaf);
+        iter_.push_back(num_iter_);
+        ++num_iter_;
+        size_ = N;
+    }
+
+    /// \brief Get the index of the ancestor of a particle of the last
+    /// iteration at a given iteration
+    index_type index(std::size_t id, std::size_t iter = 0) const
+    {
+        runtime_assert(iter < num_iter() && id < size(),
+            "**ResampleGenealogy::index** index out of range");
+
+        index_type idx = static_cast<index_type>(id);
+        std::size_t node = leaf_.empty() ? npos() : leaf_[id];
+        std::size_t k = iter_.size();
+        for (std::size_t t = num_iter_; t != iter; --t) {
+            if (k != 0 && iter_[k - 1] == t - 1) {
+                idx = node_[node].index;
+                node = node_[node].parent;
+                --k;
+            }
+        }
+
+        return idx;
+    }
+
+    std::size_t index_matrix_nrow() const { return size(); }
+
+    std::size_t index_matrix_ncol(std::size_t iter = 0) const
+    {
+        runtime_assert(iter < num_iter(),
+            "**ResampleGenealogy::index_matrix_ncol** iteration number out of "
+            "range");
+
+        return num_iter_ - iter;
+    }
+
+    /// \brief Get the resampling index matrix
+    template <typename Backend = BackendSMP>
+    Vector<index_type> index_matrix(
+        MatrixLayout layout, std::size_t iter = 0) const
+    {
+        Vector<index_type> idxmat(
+            index_matrix_nrow() * index_matrix_ncol(iter));
+        read_index_matrix<Backend>(layout, idxmat.begin(), iter);
+
+        return idxmat;
+    }
+
+    /// \brief Read the resampling index matrix into an random access iterator
+    ///
+    /// \details
+    /// The matrix, say \f$M\f$ is assume to be \f$N\f$ by \f$R\f$, where
+    /// \f$R\f$ is the number of iterations between `iter` and the last one,
+    /// inclusive; and \f$N\f$ is the sample size of the last iteration. The
+    /// output is equivalent to set \f$M_{i,j}\f$ to `index(i, iter + j)`. The
+    /// paths of the particles are traced back in parallel using the SMP
+    /// backend `Backend`.
+    template <typename Backend = BackendSMP, typename RandomIter>
+    RandomIter read_index_matrix(
+        MatrixLayout layout, RandomIter first, std::size_t iter = 0) const
+    {
+        using difference_type =
+            typename std::iterator_traits<RandomIter>::difference_type;
+
+        const std::size_t N = index_matrix_nrow();
+        const std::size_t R = index_matrix_ncol(iter);
+        const std::size_t rs = layout == RowMajor ? R : 1;
+        const std::size_t cs = layout == RowMajor ? 1 : N;
+
+        smp_for<Backend>(N, [&](std::size_t ibegin, std::size_t iend) {
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                index_type idx = static_cast<index_type>(i);
+                std::size_t node = leaf_.empty() ? npos() : leaf_[i];
+                std::size_t k = iter_.size();
+                for (std::size_t t = num_iter_; t != iter; --t) {
+                    if (k != 0 && iter_[k - 1] == t - 1) {
+                        idx = node_[node].index;
+                        node = node_[node].parent;
+                        --k;
+                    }
+                    first[static_cast<difference_type>(
+                        i * rs + (t - 1 - iter) * cs)] = idx;
+                }
+            }
+        });
+
+        return first + static_cast<difference_type>(N * R);
+    }
+
+  private:
+    class node_type
+    {
+      public:
+        std::size_t parent;
+        std::size_t count;
+        index_type index;
+    }; // class node_type
+
+    std::size_t num_iter_;
+    std::size_t size_;
+    Vector<node_type> node_;
+    Vector<std::size_t> free_;
+    Vector<std::size_t> leaf_;
+    Vector<std::size_t> iter_;
+    Vector<std::size_t> slot_;
+
+    static constexpr std::size_t npos()
+    {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    std::size_t insert(index_type index, std::size_t parent)
+    {
+        std::size_t n = 0;
+        if (free_.empty()) {
+            n = node_.size();
+            node_.emplace_back();
+        } else {
+            n = free_.back();
+            free_.pop_back();
+        }
+        node_[n].parent = parent;
+        node_[n].count = 0;
+        node_[n].index = index;
+
+        return n;
+    }
+
+    void release(std::size_t n)
+    {
+        while (n != npos() && --node_[n].count == 0) {
+            free_.push_back(n);
+            n = node_[n].parent;
+        }
+    }
+}; // class ResampleGenealogy
+
 } // namespace mckl
 
 #endif // MCKL_ALGORITHM_RESAMPLE_HPP
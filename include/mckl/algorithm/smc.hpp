@@ -38,6 +38,10 @@
 #include <mckl/core/particle.hpp>
 #include <mckl/core/sampler.hpp>
 #include <mckl/core/state_matrix.hpp>
+#include <mckl/utility/stop_watch.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 MCKL_PUSH_CLANG_WARNING("-Wpadded")
 
@@ -135,6 +139,282 @@ class SMCEstimator
     }
 }; // class SMCEstimator
 
+/// \brief Timing of the evaluation of a range of particles
+/// \ingroup SMC
+class SMCProfileRange
+{
+  public:
+    /// \brief The step, 0 for selection, 1 for resampling, 2 for mutation
+    std::size_t step;
+
+    /// \brief If the range is evaluated by an estimator
+    bool estimator;
+
+    /// \brief The index of the thread, in the order of first appearance in
+    /// the iteration
+    std::size_t thread;
+
+    std::size_t ibegin;
+    std::size_t iend;
+    double ns;
+}; // class SMCProfileRange
+
+/// \brief Profile of an iteration of SMCSampler
+/// \ingroup SMC
+///
+/// \details
+/// All times are wall times in nanoseconds. The steps are indexed by 0 for
+/// selection, 1 for resampling and 2 for mutation.
+class SMCProfileRecord
+{
+  public:
+    /// \brief The iteration number
+    std::size_t iter;
+
+    /// \brief The sample size before resampling
+    std::size_t size;
+
+    /// \brief The ESS before resampling
+    double ess;
+
+    /// \brief If resampling was performed
+    bool resampled;
+
+    /// \brief The number of particles copied by `Particle::select`
+    std::size_t moved;
+
+    /// \brief The number of bytes of states copied by `Particle::select`,
+    /// zero if unknown for the state type
+    std::size_t bytes;
+
+    /// \brief The number of accepted moves reported by `smc_profile_accept`
+    std::size_t accepted;
+
+    /// \brief The number of proposed moves reported by `smc_profile_accept`
+    std::size_t proposed;
+
+    /// \brief The time of the iteration, excluding callbacks
+    double ns;
+
+    /// \brief The time of each step, including its estimators
+    std::array<double, 3> step_ns;
+
+    /// \brief The time of each evaluation object of each step
+    std::array<Vector<double>, 3> eval_ns;
+
+    /// \brief The time of each estimator of each step
+    std::array<Vector<double>, 3> estimator_ns;
+
+    /// \brief The time of each range evaluated by SMP backends
+    Vector<SMCProfileRange> range;
+
+    /// \brief The acceptance rate, zero if no moves were reported
+    double acceptance() const
+    {
+        return proposed == 0 ? 0 : static_cast<double>(accepted) / proposed;
+    }
+
+    /// \brief The ratio of the maximum to the mean of the total range time
+    /// per thread in a step, one if perfectly balanced
+    double imbalance(std::size_t step) const
+    {
+        Vector<double> t;
+        for (const auto &r : range) {
+            if (r.step == step && !r.estimator) {
+                if (t.size() <= r.thread) {
+                    t.resize(r.thread + 1, 0);
+                }
+                t[r.thread] += r.ns;
+            }
+        }
+        const double sum = std::accumulate(t.begin(), t.end(), 0.0);
+
+        return sum > 0 ? *std::max_element(t.begin(), t.end()) * t.size() / sum
+                       : 1;
+    }
+}; // class SMCProfileRecord
+
+/// \brief Opt-in profiling of SMCSampler iterations
+/// \ingroup SMC
+///
+/// \details
+/// When enabled, each iteration produces an SMCProfileRecord, which is
+/// passed to the callback if one is set, and stored in a ring buffer that
+/// keeps the most recent `capacity()` records. The profiling handler is
+/// attached to the particle system of the sampler only, so the cost to the
+/// SMP backends and `Particle::select` is a null pointer test for particle
+/// systems not being profiled, and other samplers are not affected. Ranges
+/// evaluated in parallel are recorded under a lock owned by the iteration,
+/// and the counters are atomic.
+class SMCProfile
+{
+  public:
+    using callback_type = std::function<void(const SMCProfileRecord &)>;
+
+    SMCProfile() : enabled_(false), capacity_(0), head_(0) {}
+
+    /// \brief If profiling is enabled
+    bool enabled() const { return enabled_; }
+
+    /// \brief Enable profiling, keeping at most `capacity` records
+    void enable(std::size_t capacity = 1024)
+    {
+        enabled_ = true;
+        if (capacity != capacity_) {
+            clear();
+            capacity_ = capacity;
+        }
+    }
+
+    /// \brief Disable profiling, the records are kept
+    void disable() { enabled_ = false; }
+
+    /// \brief Set a callback invoked with each new record
+    void callback(const callback_type &cb) { callback_ = cb; }
+
+    /// \brief The maximum number of records kept
+    std::size_t capacity() const { return capacity_; }
+
+    /// \brief The number of records kept
+    std::size_t size() const { return record_.size(); }
+
+    /// \brief The `i`-th record kept, from the oldest to the newest
+    const SMCProfileRecord &operator[](std::size_t i) const
+    {
+        return record_[(head_ + i) % record_.size()];
+    }
+
+    /// \brief The newest record
+    const SMCProfileRecord &back() const
+    {
+        runtime_assert(size() != 0, "**SMCProfile::back** no records");
+
+        return operator[](size() - 1);
+    }
+
+    /// \brief Remove all records
+    void clear()
+    {
+        record_.clear();
+        head_ = 0;
+    }
+
+    /// \brief Add a new record
+    void insert(SMCProfileRecord &&record)
+    {
+        if (callback_) {
+            callback_(record);
+        }
+        if (capacity_ == 0) {
+            return;
+        }
+        if (record_.size() < capacity_) {
+            record_.push_back(std::move(record));
+        } else {
+            record_[head_] = std::move(record);
+            head_ = (head_ + 1) % capacity_;
+        }
+    }
+
+  private:
+    bool enabled_;
+    std::size_t capacity_;
+    std::size_t head_;
+    Vector<SMCProfileRecord> record_;
+    callback_type callback_;
+}; // class SMCProfile
+
+/// \brief Report accepted moves of a mutation to the profile of the
+/// SMCSampler iterating the particle system
+/// \ingroup SMC
+///
+/// \details
+/// It can be called from any thread during an iteration. It has no effect if
+/// the sampler is not being profiled.
+template <typename T>
+inline void smc_profile_accept(
+    const Particle<T> &particle, std::size_t accepted, std::size_t proposed)
+{
+    internal::ParticleProfilerHandler *handler = particle.profiler();
+    if (handler != nullptr) {
+        handler->accept(accepted, proposed);
+    }
+}
+
+namespace internal {
+
+MCKL_PUSH_CLANG_WARNING("-Wweak-vtables")
+class SMCProfileHandler : public ParticleProfilerHandler
+{
+  public:
+    SMCProfileHandler(SMCProfileRecord &record)
+        : record_(record)
+        , step_(0)
+        , estimator_(false)
+        , moved_(0)
+        , bytes_(0)
+        , accepted_(0)
+        , proposed_(0)
+    {
+    }
+
+    void step(std::size_t s, bool estimator)
+    {
+        step_ = s;
+        estimator_ = estimator;
+    }
+
+    /// \brief Add the counters to the record
+    void merge()
+    {
+        record_.moved += moved_.exchange(0);
+        record_.bytes += bytes_.exchange(0);
+        record_.accepted += accepted_.exchange(0);
+        record_.proposed += proposed_.exchange(0);
+    }
+
+    void range(std::size_t ibegin, std::size_t iend, double ns) override
+    {
+        const std::thread::id id = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t t = 0;
+        while (t != thread_.size() && thread_[t] != id) {
+            ++t;
+        }
+        if (t == thread_.size()) {
+            thread_.push_back(id);
+        }
+        record_.range.push_back(
+            SMCProfileRange{step_, estimator_, t, ibegin, iend, ns});
+    }
+
+    void select(std::size_t moved, std::size_t bytes) override
+    {
+        moved_.fetch_add(moved, std::memory_order_relaxed);
+        bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void accept(std::size_t accepted, std::size_t proposed) override
+    {
+        accepted_.fetch_add(accepted, std::memory_order_relaxed);
+        proposed_.fetch_add(proposed, std::memory_order_relaxed);
+    }
+
+  private:
+    SMCProfileRecord &record_;
+    std::size_t step_;
+    bool estimator_;
+    std::atomic<std::size_t> moved_;
+    std::atomic<std::size_t> bytes_;
+    std::atomic<std::size_t> accepted_;
+    std::atomic<std::size_t> proposed_;
+    std::mutex mutex_;
+    Vector<std::thread::id> thread_;
+}; // class SMCProfileHandler
+MCKL_POP_CLANG_WARNING
+
+} // namespace internal
+
 template <typename, typename = double>
 class SMCSampler;
 
@@ -348,6 +628,30 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
         return this->estimator(2, k);
     }
 
+    /// \brief Type of callable objects that evaluate the estimators of a step
+    using for_each_type = std::function<void(
+        std::size_t, const std::function<void(std::size_t, std::size_t)> &)>;
+
+    /// \brief Set how the estimators of each step are evaluated
+    ///
+    /// \param for_each A callable object, invoked as `for_each(n, f)`, where
+    /// `n` is the number of estimators of the step, and `f(ibegin, iend)`
+    /// evaluates the estimators in the range `[ibegin, iend)` and may be
+    /// called concurrently for disjoint ranges, such as SMPForEach. If it is
+    /// empty, which is the default, the estimators are evaluated one after
+    /// another.
+    ///
+    /// \details
+    /// Each estimator still writes its results into its own EstimateMatrix
+    /// as if evaluated sequentially. Evaluating many cheap estimators
+    /// concurrently avoids paying the parallel overhead of each of them in
+    /// turn. The evaluation objects of the estimators of the same step shall
+    /// not modify the particle system.
+    void estimator_for_each(const for_each_type &for_each)
+    {
+        estimator_for_each_ = for_each;
+    }
+
     /// \brief Iterate the sampler
     void iterate(std::size_t n = 1)
     {
@@ -359,6 +663,17 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
         }
     }
 
+    /// \brief Read and write access to the profile
+    ///
+    /// \details
+    /// Profiling is disabled by default. Use `profile().enable()` to record
+    /// the timing of each step, evaluation object, estimator and range of
+    /// particles of each subsequent iteration.
+    SMCProfile &profile() { return profile_; }
+
+    /// \brief Read only access to the profile
+    const SMCProfile &profile() const { return profile_; }
+
     /// \brief Read and write access to the Particle<T> object
     Particle<T> &particle() { return particle_; }
 
@@ -379,15 +694,87 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
         return std::copy(ess_history_.begin(), ess_history_.end(), first);
     }
 
+    /// \brief The sample size of a given iteration
+    size_type size_history(std::size_t iter) const
+    {
+        return size_history_.at(iter);
+    }
+
+    /// \brief The value of ESS of a given iteration
+    double ess_history(std::size_t iter) const
+    {
+        return ess_history_.at(iter);
+    }
+
+    /// \brief Save the sampler to a checkpoint
+    ///
+    /// \details
+    /// The particle system, histories and estimates are saved. Evaluation
+    /// objects, estimators and callbacks are not.
+    void save(CheckpointWriter &writer) const
+    {
+        writer.write_text("SMCSampler");
+        this->save_estimate(writer);
+        checkpoint_save(writer, particle_);
+        writer.write(static_cast<std::uint64_t>(iter_));
+        writer.write(resample_threshold_);
+        checkpoint_save(writer, size_history_);
+        checkpoint_save(writer, ess_history_);
+    }
+
+    /// \brief Save the sampler to a checkpoint file
+    bool save(const std::string &filename) const
+    {
+        CheckpointWriter writer(filename);
+        save(writer);
+
+        return writer.commit();
+    }
+
+    /// \brief Load the sampler from a checkpoint
+    ///
+    /// \details
+    /// The sampler shall have the same estimators as the one saved.
+    void load(CheckpointReader &reader)
+    {
+        runtime_assert(reader.read_text() == "SMCSampler",
+            "**SMCSampler::load** checkpoint not saved by SMCSampler");
+        this->load_estimate(reader);
+        checkpoint_load(reader, particle_);
+        iter_ = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        resample_threshold_ = reader.read<double>();
+        checkpoint_load(reader, size_history_);
+        checkpoint_load(reader, ess_history_);
+    }
+
+    /// \brief Load the sampler from a checkpoint file
+    bool load(const std::string &filename)
+    {
+        CheckpointReader reader(filename);
+        if (!reader.good()) {
+            return false;
+        }
+        load(reader);
+
+        return true;
+    }
+
   private:
     Particle<T> particle_;
     std::size_t iter_;
     double resample_threshold_;
     Vector<size_type> size_history_;
     Vector<double> ess_history_;
+    SMCProfile profile_;
+    for_each_type estimator_for_each_;
 
     void do_iterate()
     {
+        if (profile_.enabled()) {
+            do_iterate_profile();
+            return;
+        }
+
         do_eval(0);
         do_estimate(0);
 
@@ -403,6 +790,7 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
         do_estimate(2);
 
         ++iter_;
+        this->do_callback(iter_ - 1);
     }
 
     void do_eval(std::size_t step)
@@ -414,9 +802,101 @@ class SMCSampler : public Sampler<SMCSampler<T, U>>
 
     void do_estimate(std::size_t step)
     {
-        for (auto &est : this->estimator(step)) {
-            est.estimate(iter_, particle_);
+        Vector<estimator_type> &estimator = this->estimator(step);
+        if (!estimator_for_each_ || estimator.size() < 2) {
+            for (auto &est : estimator) {
+                est.estimate(iter_, particle_);
+            }
+            return;
+        }
+
+        estimator_for_each_(estimator.size(),
+            [this, &estimator](std::size_t ibegin, std::size_t iend) {
+                for (std::size_t i = ibegin; i != iend; ++i) {
+                    estimator[i].estimate(iter_, particle_);
+                }
+            });
+    }
+
+    void do_iterate_profile()
+    {
+        SMCProfileRecord record;
+        record.iter = iter_;
+        record.size = 0;
+        record.ess = 0;
+        record.resampled = false;
+        record.moved = 0;
+        record.bytes = 0;
+        record.accepted = 0;
+        record.proposed = 0;
+        record.ns = 0;
+        record.step_ns.fill(0);
+
+        internal::SMCProfileHandler handler(record);
+        StopWatch watch;
+        {
+            internal::ParticleProfilerGuard<T> guard(particle_, &handler);
+            watch.start();
+
+            do_step_profile(0, handler, record);
+
+            record.size = static_cast<std::size_t>(size());
+            record.ess = particle_.weight().ess();
+            size_history_.push_back(size());
+            ess_history_.push_back(record.ess);
+
+            record.resampled = record.ess < size() * resample_threshold_;
+            do_step_profile(1, handler, record);
+
+            do_step_profile(2, handler, record);
+
+            watch.stop();
+        }
+        handler.merge();
+        record.ns = watch.nanoseconds();
+
+        ++iter_;
+        this->do_callback(iter_ - 1);
+
+        profile_.insert(std::move(record));
+    }
+
+    void do_step_profile(std::size_t step,
+        internal::SMCProfileHandler &handler, SMCProfileRecord &record)
+    {
+        StopWatch watch_step;
+        watch_step.start();
+        if (step != 1 || record.resampled) {
+            handler.step(step, false);
+            for (auto &eval : this->eval(step)) {
+                StopWatch watch;
+                watch.start();
+                eval(iter_, particle_);
+                watch.stop();
+                record.eval_ns[step].push_back(watch.nanoseconds());
+            }
+        }
+        handler.step(step, true);
+        Vector<estimator_type> &estimator = this->estimator(step);
+        Vector<double> &estimator_ns = record.estimator_ns[step];
+        estimator_ns.resize(estimator.size());
+        auto estimate = [this, &estimator, &estimator_ns](
+                            std::size_t ibegin, std::size_t iend) {
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                StopWatch watch;
+                watch.start();
+                estimator[i].estimate(iter_, particle_);
+                watch.stop();
+                estimator_ns[i] = watch.nanoseconds();
+            }
+        };
+        if (!estimator_for_each_ || estimator.size() < 2) {
+            estimate(0, estimator.size());
+        } else {
+            estimator_for_each_(estimator.size(), estimate);
         }
+        watch_step.stop();
+        record.step_ns[step] = watch_step.nanoseconds();
     }
 }; // class SMCSampler
 
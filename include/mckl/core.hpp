@@ -33,12 +33,14 @@
 #define MCKL_CORE_HPP
 
 #include <mckl/internal/config.h>
+#include <mckl/core/checkpoint.hpp>
 #include <mckl/core/estimate_matrix.hpp>
 #include <mckl/core/estimator.hpp>
 #include <mckl/core/matrix.hpp>
 #include <mckl/core/memory.hpp>
 #include <mckl/core/particle.hpp>
 #include <mckl/core/sampler.hpp>
+#include <mckl/core/simd.hpp>
 #include <mckl/core/state_matrix.hpp>
 #include <mckl/core/weight.hpp>
 
@@ -0,0 +1,784 @@
+//============================================================================
+// MCKL/include/mckl/core/checkpoint.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_CORE_CHECKPOINT_HPP
+#define MCKL_CORE_CHECKPOINT_HPP
+
+#include <mckl/internal/common.hpp>
+#include <mckl/core/matrix.hpp>
+#include <mckl/core/particle.hpp>
+#include <mckl/core/weight.hpp>
+#include <mckl/random/rng_set.hpp>
+#include <csignal>
+#include <cstdio>
+#include <sstream>
+
+#if MCKL_HAS_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+extern "C" inline void mckl_checkpoint_signal_handler(int);
+
+namespace mckl {
+
+namespace internal {
+
+/// \brief Header of a checkpoint file, occupying one alignment unit
+class CheckpointHeader
+{
+  public:
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t size_bytes;
+    std::uint32_t alignment;
+    std::uint64_t reserved[5];
+}; // class CheckpointHeader
+
+/// \brief Header of a record, immediately followed by its payload
+class CheckpointRecord
+{
+  public:
+    std::uint64_t bytes;
+    std::uint64_t count;
+    std::uint32_t value_size;
+    std::uint32_t kind;
+    std::uint64_t reserved[5];
+}; // class CheckpointRecord
+
+static_assert(sizeof(CheckpointHeader) == 64,
+    "**CheckpointHeader** size is not 64 bytes");
+
+static_assert(sizeof(CheckpointRecord) == 64,
+    "**CheckpointRecord** size is not 64 bytes");
+
+inline volatile std::sig_atomic_t &checkpoint_flag()
+{
+    static volatile std::sig_atomic_t flag = 0;
+
+    return flag;
+}
+
+} // namespace internal
+
+/// \brief Binary checkpoint file writer
+/// \ingroup Checkpoint
+///
+/// \details
+/// A checkpoint file is a fixed size header followed by a sequence of
+/// records. Each record is a fixed size header followed by the payload, either
+/// an array of trivially copyable values in native binary format, or a text
+/// produced by the output stream operator. All headers and payloads start at
+/// offsets that are multiples of `alignment()`, such that a file mapped into
+/// memory provides properly aligned arrays. The data is written into a
+/// temporary file, which replaces the destination only after `commit()`
+/// succeeds. Thus an existing checkpoint is never left in an incomplete
+/// state.
+class CheckpointWriter
+{
+  public:
+    /// \brief Open a checkpoint file for writing
+    explicit CheckpointWriter(const std::string &filename)
+        : filename_(filename)
+        , tmpname_(filename + ".tmp")
+        , os_(tmpname_, std::ios_base::binary | std::ios_base::trunc)
+        , offset_(0)
+        , committed_(false)
+    {
+        internal::CheckpointHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "MCKLCKPT", sizeof(header.magic));
+        header.version = version();
+        header.byte_order = 0x01020304;
+        header.size_bytes = sizeof(std::size_t);
+        header.alignment = alignment();
+        write_bytes(&header, sizeof(header));
+    }
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    /// \brief Remove the temporary file if it is not committed
+    ~CheckpointWriter()
+    {
+        if (!committed_) {
+            os_.close();
+            std::remove(tmpname_.c_str());
+        }
+    }
+
+    /// \brief The version of the format written
+    static constexpr std::uint32_t version() { return 1; }
+
+    /// \brief The alignment of records within the file
+    static constexpr std::uint32_t alignment() { return 64; }
+
+    /// \brief If no error has occurred so far
+    bool good() const { return static_cast<bool>(os_); }
+
+    /// \brief Write an array of trivially copyable values as a record
+    template <typename T>
+    void write(std::size_t n, const T *first)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "**CheckpointWriter::write** used with T not trivially copyable");
+
+        record(n * sizeof(T), n, sizeof(T), 0);
+        write_bytes(first, n * sizeof(T));
+        pad();
+    }
+
+    /// \brief Write a trivially copyable value as a record
+    template <typename T>
+    void write(const T &value)
+    {
+        write(1, &value);
+    }
+
+    /// \brief Write a text record
+    void write_text(const std::string &str)
+    {
+        record(str.size(), str.size(), 1, 1);
+        write_bytes(str.data(), str.size());
+        pad();
+    }
+
+    /// \brief Flush the data and replace the destination file
+    bool commit()
+    {
+        if (committed_) {
+            return true;
+        }
+
+        os_.close();
+        if (!os_) {
+            return false;
+        }
+        committed_ =
+            std::rename(tmpname_.c_str(), filename_.c_str()) == 0;
+
+        return committed_;
+    }
+
+  private:
+    std::string filename_;
+    std::string tmpname_;
+    std::ofstream os_;
+    std::size_t offset_;
+    bool committed_;
+
+    void record(std::size_t bytes, std::size_t count, std::size_t value_size,
+        std::uint32_t kind)
+    {
+        internal::CheckpointRecord rec;
+        std::memset(&rec, 0, sizeof(rec));
+        rec.bytes = bytes;
+        rec.count = count;
+        rec.value_size = static_cast<std::uint32_t>(value_size);
+        rec.kind = kind;
+        write_bytes(&rec, sizeof(rec));
+    }
+
+    void write_bytes(const void *ptr, std::size_t n)
+    {
+        os_.write(static_cast<const char *>(ptr),
+            static_cast<std::streamsize>(n));
+        offset_ += n;
+    }
+
+    void pad()
+    {
+        static const char zero[alignment()] = {0};
+        const std::size_t r = offset_ % alignment();
+        if (r != 0) {
+            write_bytes(zero, alignment() - r);
+        }
+    }
+}; // class CheckpointWriter
+
+/// \brief Binary checkpoint file reader
+/// \ingroup Checkpoint
+///
+/// \details
+/// On POSIX systems the file is mapped into memory. Records are read in the
+/// order they were written. The method `view()` returns a pointer to the
+/// payload within the mapped memory, which is valid during the life time of
+/// the reader. Pages are brought into memory only when they are accessed.
+/// Objects that own their storage, such as Matrix, are restored with a
+/// single copy from the mapped pages, without an intermediate buffer. On
+/// other systems, the whole file is read into memory.
+///
+/// A file with an invalid header is not `good()`. A record that is truncated
+/// or does not match what is requested throws `std::runtime_error`, even if
+/// runtime assertions are disabled.
+class CheckpointReader
+{
+  public:
+    /// \brief Open a checkpoint file for reading
+    explicit CheckpointReader(const std::string &filename)
+        : data_(nullptr), size_(0), offset_(0), map_(false), version_(0)
+    {
+#if MCKL_HAS_POSIX
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct ::stat st;
+            if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                const std::size_t n = static_cast<std::size_t>(st.st_size);
+                void *ptr =
+                    ::mmap(nullptr, n, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (ptr != MAP_FAILED) {
+                    data_ = static_cast<const char *>(ptr);
+                    size_ = n;
+                    map_ = true;
+                }
+            }
+            ::close(fd);
+        }
+#else
+        std::ifstream is(filename, std::ios_base::binary);
+        if (is) {
+            is.seekg(0, std::ios_base::end);
+            buffer_.resize(static_cast<std::size_t>(is.tellg()));
+            is.seekg(0, std::ios_base::beg);
+            is.read(buffer_.data(),
+                static_cast<std::streamsize>(buffer_.size()));
+            if (is) {
+                data_ = buffer_.data();
+                size_ = buffer_.size();
+            }
+        }
+#endif
+
+        internal::CheckpointHeader header;
+        if (data_ == nullptr || size_ < sizeof(header)) {
+            release();
+            return;
+        }
+        std::memcpy(&header, data_, sizeof(header));
+        if (std::memcmp(header.magic, "MCKLCKPT", sizeof(header.magic)) != 0 ||
+            header.version > CheckpointWriter::version() ||
+            header.byte_order != 0x01020304 ||
+            header.size_bytes != sizeof(std::size_t) ||
+            header.alignment != CheckpointWriter::alignment()) {
+            release();
+            return;
+        }
+        version_ = header.version;
+        offset_ = sizeof(header);
+    }
+
+    CheckpointReader(const CheckpointReader &) = delete;
+    CheckpointReader &operator=(const CheckpointReader &) = delete;
+
+    ~CheckpointReader() { release(); }
+
+    /// \brief The version of the format of the file
+    std::uint32_t version() const { return version_; }
+
+    /// \brief If the file is a valid checkpoint
+    bool good() const { return data_ != nullptr; }
+
+    /// \brief If all records have been read
+    bool eof() const { return offset_ >= size_; }
+
+    /// \brief The number of values of the next record
+    std::size_t count() const
+    {
+        return static_cast<std::size_t>(peek().count);
+    }
+
+    /// \brief Return a pointer to the payload of the next array record
+    template <typename T>
+    const T *view(std::size_t n)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "**CheckpointReader::view** used with T not trivially copyable");
+
+        const internal::CheckpointRecord rec = peek();
+        runtime_assert<std::runtime_error>(rec.kind == 0 &&
+                rec.value_size == sizeof(T) && rec.count == n,
+            "**CheckpointReader::view** record does not match the type or "
+            "size requested");
+
+        return reinterpret_cast<const T *>(next(rec));
+    }
+
+    /// \brief Read the next array record
+    template <typename T>
+    void read(std::size_t n, T *first)
+    {
+        const T *src = view<T>(n);
+        if (n != 0) {
+            std::memcpy(static_cast<void *>(first), src, n * sizeof(T));
+        }
+    }
+
+    /// \brief Read the next record of a single value
+    template <typename T>
+    T read()
+    {
+        T value;
+        read(1, &value);
+
+        return value;
+    }
+
+    /// \brief Read the next text record
+    std::string read_text()
+    {
+        const internal::CheckpointRecord rec = peek();
+        runtime_assert<std::runtime_error>(rec.kind == 1,
+            "**CheckpointReader::read_text** record is not a text");
+
+        const char *src = next(rec);
+
+        return std::string(src, src + rec.bytes);
+    }
+
+  private:
+    const char *data_;
+    std::size_t size_;
+    std::size_t offset_;
+    bool map_;
+    std::uint32_t version_;
+    Vector<char> buffer_;
+
+    void release()
+    {
+#if MCKL_HAS_POSIX
+        if (map_) {
+            ::munmap(const_cast<char *>(data_), size_);
+        }
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        map_ = false;
+    }
+
+    internal::CheckpointRecord peek() const
+    {
+        internal::CheckpointRecord rec;
+        runtime_assert<std::runtime_error>(good() && offset_ <= size_ &&
+                sizeof(rec) <= size_ - offset_,
+            "**CheckpointReader** read beyond the end of the file");
+        std::memcpy(&rec, data_ + offset_, sizeof(rec));
+
+        const std::uint64_t avail = size_ - offset_ - sizeof(rec);
+        runtime_assert<std::runtime_error>(rec.bytes <= avail,
+            "**CheckpointReader** record truncated");
+        const bool valid = rec.kind == 0 ?
+            rec.value_size != 0 && rec.bytes % rec.value_size == 0 &&
+                rec.bytes / rec.value_size == rec.count :
+            rec.kind == 1 && rec.value_size == 1 && rec.bytes == rec.count;
+        runtime_assert<std::runtime_error>(
+            valid, "**CheckpointReader** invalid record header");
+
+        return rec;
+    }
+
+    const char *next(const internal::CheckpointRecord &rec)
+    {
+        const std::size_t a = CheckpointWriter::alignment();
+        const char *ptr = data_ + offset_ + sizeof(rec);
+        offset_ += sizeof(rec) + static_cast<std::size_t>(rec.bytes);
+        offset_ = (offset_ + a - 1) / a * a;
+
+        return ptr;
+    }
+}; // class CheckpointReader
+
+namespace internal {
+
+template <typename T, MatrixLayout Layout, typename Alloc>
+std::true_type checkpoint_is_matrix(const Matrix<T, Layout, Alloc> *);
+
+std::false_type checkpoint_is_matrix(...);
+
+template <typename T>
+using CheckpointIsMatrix =
+    decltype(checkpoint_is_matrix(static_cast<const T *>(nullptr)));
+
+template <typename T>
+inline void checkpoint_save_value(
+    CheckpointWriter &writer, const T &value, std::true_type)
+{
+    writer.write(value);
+}
+
+template <typename T>
+inline void checkpoint_save_value(
+    CheckpointWriter &writer, const T &value, std::false_type)
+{
+    std::stringstream ss;
+    ss.precision(std::numeric_limits<long double>::max_digits10);
+    ss << value;
+    writer.write_text(ss.str());
+}
+
+template <typename T, MatrixLayout Layout, typename Alloc>
+inline void checkpoint_save_matrix(
+    CheckpointWriter &writer, const Matrix<T, Layout, Alloc> &mat)
+{
+    const std::uint64_t dims[] = {
+        mat.nrow(), mat.ncol(), static_cast<std::uint64_t>(Layout)};
+    writer.write(3, dims);
+    writer.write(mat.nrow() * mat.ncol(), mat.data());
+}
+
+template <typename T>
+inline void checkpoint_save_dispatch(
+    CheckpointWriter &writer, const T &value, std::true_type)
+{
+    checkpoint_save_matrix(writer, value);
+}
+
+template <typename T>
+inline void checkpoint_save_dispatch(
+    CheckpointWriter &writer, const T &value, std::false_type)
+{
+    checkpoint_save_value(writer, value, std::is_trivially_copyable<T>());
+}
+
+template <typename T>
+inline void checkpoint_load_value(
+    CheckpointReader &reader, T &value, std::true_type)
+{
+    value = reader.read<T>();
+}
+
+template <typename T>
+inline void checkpoint_load_value(
+    CheckpointReader &reader, T &value, std::false_type)
+{
+    std::stringstream ss(reader.read_text());
+    ss >> value;
+    runtime_assert(static_cast<bool>(ss),
+        "**checkpoint_load** failed to read a value from text");
+}
+
+template <typename T, MatrixLayout Layout, typename Alloc>
+inline void checkpoint_load_matrix(
+    CheckpointReader &reader, Matrix<T, Layout, Alloc> &mat)
+{
+    std::uint64_t dims[3];
+    reader.read(3, dims);
+    runtime_assert<std::runtime_error>(
+        dims[2] == static_cast<std::uint64_t>(Layout),
+        "**checkpoint_load** Matrix with a different layout");
+
+    const std::uint64_t nmax = std::numeric_limits<std::size_t>::max();
+    runtime_assert<std::runtime_error>(dims[0] <= nmax && dims[1] <= nmax &&
+            (dims[1] == 0 || dims[0] <= nmax / dims[1]),
+        "**checkpoint_load** Matrix size overflow");
+    const std::size_t nrow = static_cast<std::size_t>(dims[0]);
+    const std::size_t ncol = static_cast<std::size_t>(dims[1]);
+    runtime_assert<std::runtime_error>(reader.count() == nrow * ncol,
+        "**checkpoint_load** Matrix size does not match the record");
+    mat.resize(nrow, ncol);
+    reader.read(nrow * ncol, mat.data());
+}
+
+template <typename T>
+inline void checkpoint_load_dispatch(
+    CheckpointReader &reader, T &value, std::true_type)
+{
+    checkpoint_load_matrix(reader, value);
+}
+
+template <typename T>
+inline void checkpoint_load_dispatch(
+    CheckpointReader &reader, T &value, std::false_type)
+{
+    checkpoint_load_value(reader, value, std::is_trivially_copyable<T>());
+}
+
+template <typename RNGSetType>
+inline void checkpoint_save_rng_set(CheckpointWriter &writer, std::size_t n,
+    const RNGSetType &rng_set, std::true_type)
+{
+    writer.write(n, n == 0 ? nullptr : &rng_set[0]);
+}
+
+template <typename RNGSetType>
+inline void checkpoint_save_rng_set(CheckpointWriter &writer, std::size_t n,
+    const RNGSetType &rng_set, std::false_type)
+{
+    std::stringstream ss;
+    for (std::size_t i = 0; i != n; ++i) {
+        ss << rng_set[i] << '\n';
+    }
+    writer.write_text(ss.str());
+}
+
+template <typename RNGSetType>
+inline void checkpoint_load_rng_set(CheckpointReader &reader, std::size_t n,
+    RNGSetType &rng_set, std::true_type)
+{
+    reader.read(n, n == 0 ? nullptr : &rng_set[0]);
+}
+
+template <typename RNGSetType>
+inline void checkpoint_load_rng_set(CheckpointReader &reader, std::size_t n,
+    RNGSetType &rng_set, std::false_type)
+{
+    std::stringstream ss(reader.read_text());
+    for (std::size_t i = 0; i != n; ++i) {
+        ss >> rng_set[i];
+    }
+    runtime_assert(static_cast<bool>(ss),
+        "**checkpoint_load** failed to read RNG engines from text");
+}
+
+} // namespace internal
+
+/// \brief Save a value to a checkpoint
+/// \ingroup Checkpoint
+///
+/// \details
+/// Matrix objects, including StateMatrix, and trivially copyable values are
+/// saved in binary format. Other types are saved as text using the output
+/// stream operator, for example RNG engines. Users can provide overloads for
+/// their own types, which will be found by argument dependent lookup.
+template <typename T>
+inline void checkpoint_save(CheckpointWriter &writer, const T &value)
+{
+    internal::checkpoint_save_dispatch(
+        writer, value, internal::CheckpointIsMatrix<T>());
+}
+
+/// \brief Load a value from a checkpoint
+/// \ingroup Checkpoint
+template <typename T>
+inline void checkpoint_load(CheckpointReader &reader, T &value)
+{
+    internal::checkpoint_load_dispatch(
+        reader, value, internal::CheckpointIsMatrix<T>());
+}
+
+/// \brief Save a vector of trivially copyable values to a checkpoint
+/// \ingroup Checkpoint
+template <typename T, typename Alloc>
+inline void checkpoint_save(
+    CheckpointWriter &writer, const std::vector<T, Alloc> &vec)
+{
+    writer.write(vec.size(), vec.data());
+}
+
+/// \brief Load a vector of trivially copyable values from a checkpoint
+/// \ingroup Checkpoint
+template <typename T, typename Alloc>
+inline void checkpoint_load(
+    CheckpointReader &reader, std::vector<T, Alloc> &vec)
+{
+    vec.resize(reader.count());
+    reader.read(vec.size(), vec.data());
+}
+
+/// \brief Save a Weight object to a checkpoint
+/// \ingroup Checkpoint
+inline void checkpoint_save(CheckpointWriter &writer, const Weight &weight)
+{
+    writer.write(weight.ess());
+    writer.write(weight.size(), weight.data());
+}
+
+/// \brief Load a Weight object from a checkpoint
+/// \ingroup Checkpoint
+inline void checkpoint_load(CheckpointReader &reader, Weight &weight)
+{
+    const double ess = reader.read<double>();
+    weight.resize(reader.count());
+    weight.set_exact(ess, reader.view<double>(weight.size()));
+}
+
+/// \brief Save a RNGSetScalar object to a checkpoint
+/// \ingroup Checkpoint
+template <typename RNGType>
+inline void checkpoint_save(
+    CheckpointWriter &writer, const RNGSetScalar<RNGType> &rng_set)
+{
+    checkpoint_save(writer, rng_set[0]);
+}
+
+/// \brief Load a RNGSetScalar object from a checkpoint
+/// \ingroup Checkpoint
+template <typename RNGType>
+inline void checkpoint_load(
+    CheckpointReader &reader, RNGSetScalar<RNGType> &rng_set)
+{
+    checkpoint_load(reader, rng_set[0]);
+}
+
+/// \brief Save a RNGSetVector object to a checkpoint
+/// \ingroup Checkpoint
+///
+/// \details
+/// Trivially copyable RNG engines are saved as one array record, others as
+/// one text record.
+template <typename RNGType>
+inline void checkpoint_save(
+    CheckpointWriter &writer, const RNGSetVector<RNGType> &rng_set)
+{
+    const std::size_t n = rng_set.size();
+    writer.write(static_cast<std::uint64_t>(n));
+    internal::checkpoint_save_rng_set(
+        writer, n, rng_set, std::is_trivially_copyable<RNGType>());
+}
+
+/// \brief Load a RNGSetVector object from a checkpoint
+/// \ingroup Checkpoint
+template <typename RNGType>
+inline void checkpoint_load(
+    CheckpointReader &reader, RNGSetVector<RNGType> &rng_set)
+{
+    const std::uint64_t m = reader.read<std::uint64_t>();
+    runtime_assert<std::runtime_error>(m <= reader.count(),
+        "**checkpoint_load** RNGSetVector size does not match the record");
+    const std::size_t n = static_cast<std::size_t>(m);
+    rng_set.resize(n);
+    internal::checkpoint_load_rng_set(
+        reader, n, rng_set, std::is_trivially_copyable<RNGType>());
+}
+
+#if MCKL_HAS_TBB
+
+/// \brief Save a RNGSetTBBEnumerable object to a checkpoint
+/// \ingroup Checkpoint
+///
+/// \details
+/// Thread-local engines are not associated with particles and cannot be
+/// restored deterministically. Nothing is saved and the set is reset when it
+/// is loaded.
+template <typename RNGType, typename Alloc, ::tbb::ets_key_usage_type Key>
+inline void checkpoint_save(CheckpointWriter &writer,
+    const RNGSetTBBEnumerable<RNGType, Alloc, Key> &)
+{
+    writer.write(static_cast<std::uint64_t>(0));
+}
+
+/// \brief Load a RNGSetTBBEnumerable object from a checkpoint
+/// \ingroup Checkpoint
+template <typename RNGType, typename Alloc, ::tbb::ets_key_usage_type Key>
+inline void checkpoint_load(CheckpointReader &reader,
+    RNGSetTBBEnumerable<RNGType, Alloc, Key> &rng_set)
+{
+    reader.read<std::uint64_t>();
+    rng_set.reset();
+}
+
+#endif // MCKL_HAS_TBB
+
+/// \brief Save a Particle object to a checkpoint
+/// \ingroup Checkpoint
+template <typename T>
+inline void checkpoint_save(
+    CheckpointWriter &writer, const Particle<T> &particle)
+{
+    checkpoint_save(writer, particle.state());
+    checkpoint_save(writer, particle.weight());
+    checkpoint_save(writer, particle.rng_set());
+    checkpoint_save(writer, particle.rng());
+}
+
+/// \brief Load a Particle object from a checkpoint
+/// \ingroup Checkpoint
+template <typename T>
+inline void checkpoint_load(CheckpointReader &reader, Particle<T> &particle)
+{
+    checkpoint_load(reader, particle.state());
+    checkpoint_load(reader, particle.weight());
+    checkpoint_load(reader, particle.rng_set());
+    checkpoint_load(reader, particle.rng());
+}
+
+/// \brief Request a checkpoint at the end of the current iteration
+/// \ingroup Checkpoint
+///
+/// \details
+/// This function only sets a flag of type `volatile std::sig_atomic_t` and is
+/// safe to be called within a signal handler. The request is served by
+/// SamplerCheckpoint.
+inline void checkpoint_request() { internal::checkpoint_flag() = 1; }
+
+/// \brief Install a signal handler that calls `checkpoint_request()`
+/// \ingroup Checkpoint
+inline bool checkpoint_signal(int signum)
+{
+    return std::signal(signum, mckl_checkpoint_signal_handler) != SIG_ERR;
+}
+
+/// \brief Sampler callback that saves checkpoints periodically or on request
+/// \ingroup Checkpoint
+///
+/// \details
+/// An object of this class shall be added to a sampler through its
+/// `callback` method. At the end of an iteration, a checkpoint is saved by
+/// `sampler.save(filename)` if the number of iterations performed is a
+/// multiple of `period` (zero for never), or if `checkpoint_request()` has
+/// been called, for example from a signal handler installed by
+/// `checkpoint_signal()`. All I/O happens in the normal flow of the sampler,
+/// never within the signal handler.
+template <typename SamplerType>
+class SamplerCheckpoint
+{
+  public:
+    SamplerCheckpoint(const std::string &filename, std::size_t period = 0)
+        : filename_(filename), period_(period)
+    {
+    }
+
+    void operator()(std::size_t iter, SamplerType &sampler)
+    {
+        const bool requested = internal::checkpoint_flag() != 0;
+        if (requested || (period_ != 0 && (iter + 1) % period_ == 0)) {
+            internal::checkpoint_flag() = 0;
+            const bool saved = sampler.save(filename_);
+            runtime_assert(saved,
+                "**SamplerCheckpoint** failed to save a checkpoint", true);
+        }
+    }
+
+  private:
+    std::string filename_;
+    std::size_t period_;
+}; // class SamplerCheckpoint
+
+} // namespace mckl
+
+extern "C" inline void mckl_checkpoint_signal_handler(int)
+{
+    ::mckl::checkpoint_request();
+}
+
+#endif // MCKL_CORE_CHECKPOINT_HPP
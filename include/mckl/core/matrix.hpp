@@ -38,6 +38,235 @@
 
 namespace mckl {
 
+namespace internal {
+
+template <typename T>
+inline constexpr std::size_t matrix_transpose_block()
+{
+    return sizeof(T) <= 8 ? 64 : (sizeof(T) <= 16 ? 16 : 8);
+}
+
+// Transpose a K by K block, dst[j * ldd + i] = src[i * lds + j]
+template <typename T, std::size_t = sizeof(T),
+    bool = std::is_trivially_copyable<T>::value>
+class MatrixTransposeKernel
+{
+  public:
+    static constexpr std::size_t size() { return 1; }
+
+    static void eval(const T *src, std::size_t, T *dst, std::size_t)
+    {
+        *dst = *src;
+    }
+}; // class MatrixTransposeKernel
+
+MCKL_PUSH_GCC_WARNING("-Wignored-attributes")
+
+#if MCKL_USE_AVX2
+
+template <typename T>
+class MatrixTransposeKernel<T, 4, true>
+{
+  public:
+    static constexpr std::size_t size() { return 8; }
+
+    static void eval(const T *src, std::size_t lds, T *dst, std::size_t ldd)
+    {
+        std::array<__m256i, 8> s;
+        for (std::size_t k = 0; k != 8; ++k) {
+            s[k] = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(src + k * lds));
+        }
+        transpose8x32_si256<0, 1, 2, 3, 4, 5, 6, 7>(s);
+        for (std::size_t k = 0; k != 8; ++k) {
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(dst + k * ldd), s[k]);
+        }
+    }
+}; // class MatrixTransposeKernel
+
+template <typename T>
+class MatrixTransposeKernel<T, 8, true>
+{
+  public:
+    static constexpr std::size_t size() { return 4; }
+
+    static void eval(const T *src, std::size_t lds, T *dst, std::size_t ldd)
+    {
+        std::array<__m256i, 4> s;
+        for (std::size_t k = 0; k != 4; ++k) {
+            s[k] = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(src + k * lds));
+        }
+        transpose4x64_si256<0, 1, 2, 3>(s);
+        for (std::size_t k = 0; k != 4; ++k) {
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(dst + k * ldd), s[k]);
+        }
+    }
+}; // class MatrixTransposeKernel
+
+#elif MCKL_USE_SSE2
+
+template <typename T>
+class MatrixTransposeKernel<T, 4, true>
+{
+  public:
+    static constexpr std::size_t size() { return 4; }
+
+    static void eval(const T *src, std::size_t lds, T *dst, std::size_t ldd)
+    {
+        std::array<__m128i, 4> s;
+        for (std::size_t k = 0; k != 4; ++k) {
+            s[k] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(src + k * lds));
+        }
+        transpose4x32_si128<0, 1, 2, 3>(s);
+        for (std::size_t k = 0; k != 4; ++k) {
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(dst + k * ldd), s[k]);
+        }
+    }
+}; // class MatrixTransposeKernel
+
+template <typename T>
+class MatrixTransposeKernel<T, 8, true>
+{
+  public:
+    static constexpr std::size_t size() { return 2; }
+
+    static void eval(const T *src, std::size_t lds, T *dst, std::size_t ldd)
+    {
+        std::array<__m128i, 2> s;
+        for (std::size_t k = 0; k != 2; ++k) {
+            s[k] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(src + k * lds));
+        }
+        transpose2x64_si128<0, 1>(s);
+        for (std::size_t k = 0; k != 2; ++k) {
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i *>(dst + k * ldd), s[k]);
+        }
+    }
+}; // class MatrixTransposeKernel
+
+#endif // MCKL_USE_AVX2
+
+MCKL_POP_GCC_WARNING
+
+// Transpose a tile, the destination is written row by row
+template <typename T>
+inline void matrix_transpose_tile(std::size_t m, std::size_t n, const T *src,
+    std::size_t lds, T *dst, std::size_t ldd)
+{
+    using kernel = MatrixTransposeKernel<T>;
+
+    constexpr std::size_t K = kernel::size();
+    const std::size_t mk = m / K * K;
+    const std::size_t nk = n / K * K;
+    for (std::size_t j = 0; j != nk; j += K) {
+        for (std::size_t i = 0; i != mk; i += K) {
+            kernel::eval(src + i * lds + j, lds, dst + j * ldd + i, ldd);
+        }
+        for (std::size_t k = j; k != j + K; ++k) {
+            for (std::size_t i = mk; i != m; ++i) {
+                dst[k * ldd + i] = src[i * lds + k];
+            }
+        }
+    }
+    for (std::size_t j = nk; j != n; ++j) {
+        for (std::size_t i = 0; i != m; ++i) {
+            dst[j * ldd + i] = src[i * lds + j];
+        }
+    }
+}
+
+// Transpose the m by n row major matrix src with leading dimension lds into
+// the n by m row major matrix dst with leading dimension ldd
+//
+// The tiles are visited in the order of the destination, such that its rows
+// are completed one band at a time. A plain loop writing the destination
+// contiguously is faster if either dimension is smaller than a tile, or, for
+// 8-byte elements, if the cache lines and pages of a source column fit in the
+// L2 cache and TLB, and the source rows do not map to a few cache sets
+template <typename T>
+inline void matrix_transpose(std::size_t m, std::size_t n, const T *src,
+    std::size_t lds, T *dst, std::size_t ldd)
+{
+    constexpr std::size_t B = matrix_transpose_block<T>();
+
+    const bool thin = m < B || n < B;
+    const bool cached =
+        sizeof(T) == 8 && m <= 1024 && lds * sizeof(T) % 256 != 0;
+    if (thin || cached) {
+        for (std::size_t j = 0; j != n; ++j) {
+            for (std::size_t i = 0; i != m; ++i) {
+                dst[j * ldd + i] = src[i * lds + j];
+            }
+        }
+        return;
+    }
+
+    for (std::size_t j = 0; j < n; j += B) {
+        const std::size_t q = std::min(B, n - j);
+        for (std::size_t i = 0; i < m; i += B) {
+            const std::size_t p = std::min(B, m - i);
+            matrix_transpose_tile(
+                p, q, src + i * lds + j, lds, dst + j * ldd + i, ldd);
+        }
+    }
+}
+
+// Transpose the m by n row major matrix data into an n by m row major matrix
+// in place
+template <typename T>
+inline void matrix_transpose_inplace(std::size_t m, std::size_t n, T *data)
+{
+    if (m < 2 || n < 2) {
+        return;
+    }
+
+    if (m == n) {
+        constexpr std::size_t B = matrix_transpose_block<T>();
+        for (std::size_t ib = 0; ib < n; ib += B) {
+            const std::size_t ie = std::min(ib + B, n);
+            for (std::size_t jb = ib; jb < n; jb += B) {
+                const std::size_t je = std::min(jb + B, n);
+                for (std::size_t i = ib; i != ie; ++i) {
+                    for (std::size_t j = std::max(jb, i + 1); j < je; ++j) {
+                        std::swap(data[i * n + j], data[j * n + i]);
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // Follow the cycles of the permutation, the element at position k of the
+    // result comes from position (k % m) * n + k / m of the original
+    const std::size_t N = m * n - 1;
+    std::vector<bool> done(N);
+    for (std::size_t s = 1; s != N; ++s) {
+        if (done[s]) {
+            continue;
+        }
+        T tmp(std::move(data[s]));
+        std::size_t k = s;
+        while (true) {
+            done[k] = true;
+            const std::size_t p = (k % m) * n + k / m;
+            if (p == s) {
+                data[k] = std::move(tmp);
+                break;
+            }
+            data[k] = std::move(data[p]);
+            k = p;
+        }
+    }
+}
+
+} // namespace internal
+
 /// \brief Matrix container
 /// \ingroup Core
 ///
@@ -143,22 +372,98 @@ class Matrix
     explicit operator transpose_type() const
     {
         transpose_type mat(nrow_, ncol_);
+        relayout(mat);
 
-        if (Layout == RowMajor) {
-            for (size_type i = 0; i != nrow_; ++i) {
-                for (size_type j = 0; j != ncol_; ++j) {
-                    mat(i, j) = operator()(i, j);
-                }
-            }
+        return mat;
+    }
+
+    /// \brief Convert to a matrix with a different storage layout
+    ///
+    /// \details
+    /// The matrix is transposed in tiles, using SIMD instructions for
+    /// trivially copyable types of 4 or 8 bytes. Thin matrices, and matrices
+    /// of 8-byte elements whose columns fit in the L2 cache, are copied by a
+    /// plain loop instead, which was measured to be faster
+    void relayout(transpose_type &mat) const
+    {
+        relayout(mat, [](size_type N, auto &&f) {
+            f(static_cast<size_type>(0), N);
+        });
+    }
+
+    /// \brief Convert to a matrix with a different storage layout
+    ///
+    /// \param mat The result, resized if its dimensions are different
+    /// \param for_each A callable object, invoked as `for_each(N, f)`, where
+    /// `f(ibegin, iend)` converts the blocks in the range `[ibegin, iend)`
+    /// and may be called concurrently for disjoint ranges, such as smp_for
+    /// (see also smp_relayout)
+    template <typename ForEach>
+    void relayout(transpose_type &mat, ForEach &&for_each) const
+    {
+        if (mat.nrow() != nrow_ || mat.ncol() != ncol_) {
+            mat = transpose_type(nrow_, ncol_);
         }
-        if (Layout == ColMajor) {
-            for (size_type j = 0; j != ncol_; ++j) {
-                for (size_type i = 0; i != nrow_; ++i) {
-                    mat(i, j) = operator()(i, j);
-                }
+        if (empty()) {
+            return;
+        }
+
+        const size_type m = Layout == RowMajor ? nrow_ : ncol_;
+        const size_type n = Layout == RowMajor ? ncol_ : nrow_;
+        const size_type b = internal::matrix_transpose_block<T>();
+        const T *src = data();
+        T *dst = mat.data();
+        if (m >= n) {
+            for_each((m + b - 1) / b, [=](size_type ibegin, size_type iend) {
+                const size_type i = ibegin * b;
+                const size_type k = std::min(iend * b, m);
+                internal::matrix_transpose(
+                    k - i, n, src + i * n, n, dst + i, m);
+            });
+        } else {
+            for_each((n + b - 1) / b, [=](size_type jbegin, size_type jend) {
+                const size_type j = jbegin * b;
+                const size_type k = std::min(jend * b, n);
+                internal::matrix_transpose(
+                    m, k - j, src + j, n, dst + j * m, m);
+            });
+        }
+    }
+
+    /// \brief Convert to a matrix with a different storage layout in-place
+    ///
+    /// \details
+    /// The storage is moved into the result, and this matrix is left empty. A
+    /// square matrix is transposed in-place in tiles. Otherwise the matrix is
+    /// converted by relayout() into new storage, which is released on return.
+    /// Only if the allocation fails, the storage is transposed in-place by
+    /// following the cycles of the permutation, which requires only one bit
+    /// of additional memory per element but is several times slower.
+    transpose_type relayout_inplace()
+    {
+        transpose_type mat;
+        if (nrow_ != ncol_) {
+            try {
+                mat = transpose_type(nrow_, ncol_);
+            } catch (const std::bad_alloc &) {
+                // Fall back to the in-place transpose
             }
         }
 
+        if (mat.nrow() == nrow_ && mat.ncol() == ncol_) {
+            relayout(mat);
+            Vector<T, Alloc>().swap(data_);
+        } else {
+            internal::matrix_transpose_inplace(
+                Layout == RowMajor ? nrow_ : ncol_,
+                Layout == RowMajor ? ncol_ : nrow_, data());
+            mat.data_.swap(data_);
+            mat.nrow_ = nrow_;
+            mat.ncol_ = ncol_;
+        }
+        nrow_ = 0;
+        ncol_ = 0;
+
         return mat;
     }
 
@@ -591,6 +896,9 @@ class Matrix
     }
 
   private:
+    template <typename, MatrixLayout, typename>
+    friend class Matrix;
+
     std::size_t nrow_;
     std::size_t ncol_;
 
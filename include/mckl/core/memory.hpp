@@ -42,7 +42,10 @@
 #include <vector>
 
 #if MCKL_HAS_POSIX
+#include <fcntl.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 #if MCKL_HAS_JEMALLOC
@@ -220,6 +223,234 @@ class MemorySYS
     }
 }; // class MemorySYS
 
+/// \brief Memory allocation using memory-mapped temporary files
+/// \ingroup Core
+///
+/// \tparam Alignment The alignment of the allocated memory
+///
+/// \details
+/// Each allocation is backed by an unlinked temporary file mapped with
+/// `MAP_SHARED`. Under memory pressure, the kernel writes the pages back to
+/// the file instead of failing the allocation, such that objects larger than
+/// the physical memory can be used at the cost of disk I/O. The file is
+/// created in the directory given by the environment variable
+/// `MCKL_MMAP_DIR`, or `TMPDIR` if it is not set, or `/tmp` otherwise.
+///
+/// Each allocation creates a file and occupies at least two pages. It is
+/// intended for large out-of-core storage, such as the `StateMatrix` of a
+/// large particle system, and not as a general purpose allocator.
+template <std::size_t Alignment>
+class MemoryMMAP
+{
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+        "**MemoryMMAP** used with Alignment other than a power of two "
+        "positive integer");
+
+    static_assert(Alignment >= sizeof(void *),
+        "**MemoryMMAP** used with Alignment less than sizeof(void *)");
+
+  public:
+    static constexpr std::size_t alignment() { return Alignment; }
+
+    static void *allocate(std::size_t n, const void * = nullptr) noexcept
+    {
+        const std::size_t h = header_size();
+        const std::size_t m = h + internal::alignment_round<Alignment>(n);
+
+        if (m < n) {
+            return nullptr;
+        }
+
+        const int fd = open_file();
+        if (fd == -1) {
+            return nullptr;
+        }
+
+        void *ptr = MAP_FAILED;
+        if (::ftruncate(fd, static_cast<::off_t>(m)) == 0) {
+            ptr = ::mmap(
+                nullptr, m, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+
+        if (ptr == MAP_FAILED) {
+            return nullptr;
+        }
+        std::memcpy(ptr, &m, sizeof(std::size_t));
+
+        return static_cast<char *>(ptr) + h;
+    }
+
+    static void deallocate(void *ptr, std::size_t = 0) noexcept
+    {
+        if (ptr != nullptr) {
+            char *base = static_cast<char *>(ptr) - header_size();
+            std::size_t m = 0;
+            std::memcpy(&m, base, sizeof(std::size_t));
+            ::munmap(base, m);
+        }
+    }
+
+  private:
+    // The mapping size is stored in front of the returned pointer since the
+    // size passed to deallocate is not always in bytes
+    static std::size_t header_size() noexcept
+    {
+        const std::size_t page =
+            static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+        return page > Alignment ? page : Alignment;
+    }
+
+    static int open_file() noexcept
+    {
+        const char *dir = std::getenv("MCKL_MMAP_DIR");
+        if (dir == nullptr || *dir == '\0') {
+            dir = std::getenv("TMPDIR");
+        }
+        if (dir == nullptr || *dir == '\0') {
+            dir = "/tmp";
+        }
+
+        const char *suffix = "/mckl_mmap_XXXXXX";
+        const std::size_t n = std::strlen(dir);
+        const std::size_t m = std::strlen(suffix);
+        char name[4096];
+        if (n + m >= sizeof(name)) {
+            return -1;
+        }
+        std::memcpy(name, dir, n);
+        std::memcpy(name + n, suffix, m + 1);
+
+        const int fd = ::mkstemp(name);
+        if (fd != -1) {
+            ::unlink(name);
+        }
+
+        return fd;
+    }
+}; // class MemoryMMAP
+
+/// \brief Memory allocation using huge pages
+/// \ingroup Core
+///
+/// \tparam Alignment The alignment of the allocated memory
+///
+/// \details
+/// Memory is obtained directly with anonymous `mmap`. Allocations of at least
+/// the size of a huge page (2MB) are first attempted with explicit huge pages
+/// (`MAP_HUGETLB`), which succeeds only if the system has a reserved huge page
+/// pool. Otherwise, the mapping is aligned to the huge page size and advised
+/// for transparent huge pages (`MADV_HUGEPAGE`). Smaller allocations use
+/// normal pages. In all cases the pages are not touched before they are
+/// returned, such that they are placed on the NUMA node of the thread that
+/// first writes them.
+///
+/// Each allocation occupies at least two pages. It is intended for large
+/// arrays, such as the `StateMatrix` of a large particle system, and not as a
+/// general purpose allocator.
+template <std::size_t Alignment>
+class MemoryHUGE
+{
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+        "**MemoryHUGE** used with Alignment other than a power of two "
+        "positive integer");
+
+    static_assert(Alignment >= sizeof(void *),
+        "**MemoryHUGE** used with Alignment less than sizeof(void *)");
+
+  public:
+    static constexpr std::size_t alignment() { return Alignment; }
+
+    /// \brief The size of huge pages assumed by this policy
+    static constexpr std::size_t huge_page_size() { return 1U << 21; }
+
+    static void *allocate(std::size_t n, const void * = nullptr) noexcept
+    {
+        const std::size_t h = header_size();
+        const std::size_t l = h + internal::alignment_round<Alignment>(n);
+        const std::size_t m = l < huge_page_size() ?
+            l :
+            (l + huge_page_size() - 1) & ~(huge_page_size() - 1);
+
+        if (l < n || m < l) {
+            return nullptr;
+        }
+
+        char *ptr = m < huge_page_size() ? map(m) : map_huge(m);
+        if (ptr == nullptr) {
+            return nullptr;
+        }
+        std::memcpy(ptr, &m, sizeof(std::size_t));
+
+        return ptr + h;
+    }
+
+    static void deallocate(void *ptr, std::size_t = 0) noexcept
+    {
+        if (ptr != nullptr) {
+            char *base = static_cast<char *>(ptr) - header_size();
+            std::size_t m = 0;
+            std::memcpy(&m, base, sizeof(std::size_t));
+            ::munmap(base, m);
+        }
+    }
+
+  private:
+    static std::size_t header_size() noexcept
+    {
+        const std::size_t page =
+            static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+        return page > Alignment ? page : Alignment;
+    }
+
+    static char *map(std::size_t m) noexcept
+    {
+        void *ptr = ::mmap(nullptr, m, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        return ptr == MAP_FAILED ? nullptr : static_cast<char *>(ptr);
+    }
+
+    static char *map_huge(std::size_t m) noexcept
+    {
+#ifdef MAP_HUGETLB
+        void *ptr = ::mmap(nullptr, m, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr != MAP_FAILED) {
+            return static_cast<char *>(ptr);
+        }
+#endif
+
+        // Over-allocate and trim such that the mapping is aligned to huge
+        // pages
+        const std::size_t huge = huge_page_size();
+        if (m + huge < m) {
+            return nullptr;
+        }
+        char *ptr0 = map(m + huge);
+        if (ptr0 == nullptr) {
+            return nullptr;
+        }
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr0);
+        const std::uintptr_t aligned = (address + huge - 1) & ~(huge - 1);
+        const std::size_t head = static_cast<std::size_t>(aligned - address);
+        char *ptr1 = ptr0 + head;
+        if (head != 0) {
+            ::munmap(ptr0, head);
+        }
+        if (huge - head != 0) {
+            ::munmap(ptr1 + m, huge - head);
+        }
+#ifdef MADV_HUGEPAGE
+        ::madvise(ptr1, m, MADV_HUGEPAGE);
+#endif
+
+        return ptr1;
+    }
+}; // class MemoryHUGE
+
 #endif // MCKL_HAS_POSIX
 
 #if MCKL_HAS_JEMALLOC
@@ -294,6 +525,48 @@ class MemoryTBB
 
 #endif // MCKL_HAS_TBB
 
+namespace internal {
+
+template <typename Mem>
+class MemoryIsMMAP : public std::false_type
+{
+}; // class MemoryIsMMAP
+
+#if MCKL_HAS_POSIX
+template <std::size_t Alignment>
+class MemoryIsMMAP<MemoryMMAP<Alignment>> : public std::true_type
+{
+}; // class MemoryIsMMAP
+#endif
+
+/// \brief Advise the system that a region will be accessed sequentially
+///
+/// \details
+/// The region is extended to page boundaries. It has no effect other than
+/// performance, and does nothing if the system does not support it.
+inline void memory_advise_sequential(const void *ptr, std::size_t n) noexcept
+{
+#if MCKL_HAS_POSIX
+    if (ptr == nullptr || n == 0) {
+        return;
+    }
+
+    const std::uintptr_t page =
+        static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr);
+    const std::uintptr_t first = address & ~(page - 1);
+    const std::size_t len = static_cast<std::size_t>(address - first) + n;
+    void *addr = reinterpret_cast<void *>(first);
+    ::posix_madvise(addr, len, POSIX_MADV_SEQUENTIAL);
+    ::posix_madvise(addr, len, POSIX_MADV_WILLNEED);
+#else
+    static_cast<void>(ptr);
+    static_cast<void>(n);
+#endif
+}
+
+} // namespace internal
+
 /// \brief Default memory allocation policy
 /// \ingroup Core
 ///
@@ -429,6 +702,20 @@ inline constexpr bool operator!=(
     return !std::is_same<Mem1, Mem2>::value;
 }
 
+namespace internal {
+
+template <typename Alloc>
+class AllocatorIsMMAP : public std::false_type
+{
+}; // class AllocatorIsMMAP
+
+template <typename T, typename Mem>
+class AllocatorIsMMAP<Allocator<T, Mem>> : public MemoryIsMMAP<Mem>
+{
+}; // class AllocatorIsMMAP
+
+} // namespace internal
+
 /// \brief std::vector with Allocator as the default allocator
 /// \ingroup Core
 template <typename T, typename Alloc = Allocator<T>>
@@ -44,6 +44,96 @@ namespace mckl {
 template <typename>
 class Particle;
 
+namespace internal {
+
+MCKL_PUSH_CLANG_WARNING("-Wweak-vtables")
+/// \brief Receiver of profiling events of a particle system
+///
+/// \details
+/// Events of a parallel evaluation are delivered by the threads that
+/// performed it, so handlers shall be thread-safe.
+class ParticleProfilerHandler
+{
+  public:
+    virtual ~ParticleProfilerHandler() = default;
+
+    /// \brief An evaluation of the range `[ibegin, iend)` took `ns`
+    /// nanoseconds, called by the thread that performed it
+    virtual void range(std::size_t ibegin, std::size_t iend, double ns) = 0;
+
+    /// \brief `moved` particles, of `bytes` bytes in total, were copied by
+    /// `Particle::select`
+    virtual void select(std::size_t moved, std::size_t bytes) = 0;
+
+    /// \brief `accepted` out of `proposed` moves were accepted
+    virtual void accept(std::size_t accepted, std::size_t proposed) = 0;
+}; // class ParticleProfilerHandler
+MCKL_POP_CLANG_WARNING
+
+/// \brief Profiling handler attached to a particle system
+///
+/// \details
+/// The handler is not propagated when the particle system is copied, such
+/// that a copy made during a profiled iteration does not report to the
+/// profile of the original.
+class ParticleProfilerPtr
+{
+  public:
+    ParticleProfilerPtr() : handler_(nullptr) {}
+
+    ParticleProfilerPtr(const ParticleProfilerPtr &) : handler_(nullptr) {}
+
+    ParticleProfilerPtr &operator=(const ParticleProfilerPtr &)
+    {
+        return *this;
+    }
+
+    ParticleProfilerHandler *get() const { return handler_; }
+
+    void reset(ParticleProfilerHandler *handler) { handler_ = handler; }
+
+  private:
+    ParticleProfilerHandler *handler_;
+}; // class ParticleProfilerPtr
+
+/// \brief Attach a handler to a particle system for the lifetime of the
+/// guard
+template <typename T>
+class ParticleProfilerGuard
+{
+  public:
+    ParticleProfilerGuard(
+        Particle<T> &particle, ParticleProfilerHandler *handler)
+        : particle_(particle), handler_(particle.profiler())
+    {
+        particle_.profiler(handler);
+    }
+
+    ParticleProfilerGuard(const ParticleProfilerGuard &) = delete;
+    ParticleProfilerGuard &operator=(const ParticleProfilerGuard &) = delete;
+
+    ~ParticleProfilerGuard() { particle_.profiler(handler_); }
+
+  private:
+    Particle<T> &particle_;
+    ParticleProfilerHandler *handler_;
+}; // class ParticleProfilerGuard
+
+template <typename S>
+inline auto particle_select_bytes(const S &state, int)
+    -> decltype(state.dim() * sizeof(typename S::value_type))
+{
+    return state.dim() * sizeof(typename S::value_type);
+}
+
+template <typename S>
+inline std::size_t particle_select_bytes(const S &, long)
+{
+    return 0;
+}
+
+} // namespace internal
+
 /// \brief A thin wrapper over a complete Particle
 /// \ingroup Core
 template <typename T>
@@ -324,6 +414,9 @@ class Particle
     template <typename InputIter>
     void select(size_type n, InputIter index)
     {
+        if (profiler_.get() != nullptr) {
+            profile_select(n, index);
+        }
         state_.select(n, index);
         weight_.resize(static_cast<SizeType<weight_type>>(n));
         weight_.set_equal();
@@ -366,6 +459,19 @@ class Particle
     /// \brief Get the (sequential) RNG used stream for resampling
     const rng_type &rng() const { return rng_; }
 
+    /// \brief The profiling handler, or `nullptr` if the particle system is
+    /// not being profiled
+    internal::ParticleProfilerHandler *profiler() const
+    {
+        return profiler_.get();
+    }
+
+    /// \brief Set the profiling handler, `nullptr` to disable profiling
+    void profiler(internal::ParticleProfilerHandler *handler)
+    {
+        profiler_.reset(handler);
+    }
+
     /// \brief Get a ParticleIndex<T> object for the i-th particle
     ParticleIndex<T> at(size_type i)
     {
@@ -417,6 +523,26 @@ class Particle
     weight_type weight_;
     rng_set_type rng_set_;
     rng_type rng_;
+    internal::ParticleProfilerPtr profiler_;
+
+    template <typename InputIter>
+    void profile_select(size_type n, InputIter index) const
+    {
+        if (internal::is_nullptr(index)) {
+            return;
+        }
+
+        const std::size_t N = static_cast<std::size_t>(n);
+        const std::size_t M = std::min(N, static_cast<std::size_t>(size()));
+        std::size_t moved = N - M;
+        for (std::size_t i = 0; i != M; ++i, ++index) {
+            if (static_cast<std::size_t>(*index) != i) {
+                ++moved;
+            }
+        }
+        const std::size_t bytes = internal::particle_select_bytes(state_, 0);
+        profiler_.get()->select(moved, moved * bytes);
+    }
 }; // class Particle
 
 template <typename T>
@@ -33,6 +33,7 @@
 #define MCKL_CORE_SAMPLER_HPP
 
 #include <mckl/internal/common.hpp>
+#include <mckl/core/checkpoint.hpp>
 #include <mckl/core/matrix.hpp>
 
 namespace mckl {
@@ -48,6 +49,7 @@ class Sampler
   public:
     using eval_type = typename SamplerTrait<Derived>::eval_type;
     using estimator_type = typename SamplerTrait<Derived>::estimator_type;
+    using callback_type = std::function<void(std::size_t, Derived &)>;
 
     /// \brief Reserve space for *additional* iterations
     void reserve(std::size_t n)
@@ -68,10 +70,21 @@ class Sampler
         for (auto &est : estimator_) {
             est.clear();
         }
+        callback_.clear();
     }
 
     /// \brief Clear all estimator histories
-    void clear()
+    void clear() { clear_estimate(); }
+
+    /// \brief Clear the estimates stored in all estimators
+    ///
+    /// \details
+    /// Unlike `clear()` of the derived samplers, other histories and the
+    /// iteration count are not affected. This is useful when the estimates are
+    /// streamed elsewhere, such as by a callback, and need not to be kept in
+    /// memory. After this call, `summary()` only contains the rows stored by
+    /// all estimators.
+    void clear_estimate()
     {
         for (auto &est : estimator_) {
             for (auto &e : est) {
@@ -80,20 +93,111 @@ class Sampler
         }
     }
 
+    /// \brief The total dimension of all estimators
+    std::size_t estimate_dim() const
+    {
+        std::size_t d = 0;
+        for (auto &est : estimator_) {
+            for (auto &e : est) {
+                d += e.dim();
+            }
+        }
+
+        return d;
+    }
+
+    /// \brief Read the `i`-th estimates of all estimators, which is the `i`-th
+    /// row of the summary matrix
+    template <typename OutputIter>
+    OutputIter read_estimate(std::size_t i, OutputIter first) const
+    {
+        for (auto &est : estimator_) {
+            for (auto &e : est) {
+                first = std::copy(e.row_begin(i), e.row_end(i), first);
+            }
+        }
+
+        return first;
+    }
+
+    /// \brief Save the histories of all estimators to a checkpoint
+    void save_estimate(CheckpointWriter &writer) const
+    {
+        writer.write(static_cast<std::uint64_t>(estimator_.size()));
+        for (auto &est : estimator_) {
+            writer.write(static_cast<std::uint64_t>(est.size()));
+            for (auto &e : est) {
+                checkpoint_save(writer,
+                    static_cast<const typename estimator_type::matrix_type &>(
+                        e));
+            }
+        }
+    }
+
+    /// \brief Load the histories of all estimators from a checkpoint
+    ///
+    /// \details
+    /// The estimators shall be added in the same order as when the checkpoint
+    /// was saved, since only the histories, not the evaluation objects, are
+    /// saved.
+    void load_estimate(CheckpointReader &reader)
+    {
+        runtime_assert(reader.read<std::uint64_t>() == estimator_.size(),
+            "**Sampler::load_estimate** different number of steps");
+        for (auto &est : estimator_) {
+            runtime_assert(reader.read<std::uint64_t>() == est.size(),
+                "**Sampler::load_estimate** different number of estimators");
+            for (auto &e : est) {
+                const std::size_t dim = e.dim();
+                checkpoint_load(reader,
+                    static_cast<typename estimator_type::matrix_type &>(e));
+                runtime_assert(e.dim() == dim,
+                    "**Sampler::load_estimate** estimator with a different "
+                    "dimension");
+            }
+        }
+    }
+
+    /// \brief Add a callback invoked at the end of each iteration
+    ///
+    /// \details
+    /// The callback is invoked as `callback(iter, sampler)`, after all
+    /// evaluation objects and estimators of the iteration `iter`. The sampler
+    /// has already advanced its iteration count, such that a checkpoint saved
+    /// by the callback resumes with the iteration `iter + 1`.
+    template <typename Callback>
+    std::size_t callback(Callback &&callback,
+        std::enable_if_t<!std::is_integral<Callback>::value> * = nullptr)
+    {
+        callback_.push_back(std::forward<Callback>(callback));
+
+        return callback_.size() - 1;
+    }
+
+    callback_type &callback(std::size_t k) { return callback_.at(k); }
+
+    const callback_type &callback(std::size_t k) const
+    {
+        return callback_.at(k);
+    }
+
     /// \brief Return a combined matrix of all estimates
+    ///
+    /// \details
+    /// The number of rows is the number of iterations, or the least number of
+    /// estimates stored by any estimator if it is smaller, such as after
+    /// `clear_estimate()`.
     template <typename T, MatrixLayout Layout>
     Matrix<T, Layout> summary() const
     {
-        const std::size_t nrow =
-            static_cast<const Derived *>(this)->num_iter();
-
-        std::size_t ncol = 0;
+        std::size_t nrow = static_cast<const Derived *>(this)->num_iter();
         for (auto &est : estimator_) {
             for (auto &e : est) {
-                ncol += e.dim();
+                nrow = std::min(nrow, e.num_iter());
             }
         }
 
+        const std::size_t ncol = estimate_dim();
         Matrix<T, Layout> mat(nrow, ncol);
         if (nrow * ncol == 0) {
             return mat;
@@ -101,19 +205,14 @@ class Sampler
 
         if (Layout == RowMajor) {
             for (std::size_t i = 0; i != nrow; ++i) {
-                T *first = mat.row_data(i);
-                for (auto &est : estimator_) {
-                    for (auto &e : est) {
-                        first = std::copy(e.row_begin(i), e.row_end(i), first);
-                    }
-                }
+                read_estimate(i, mat.row_data(i));
             }
         } else {
             T *first = mat.col_data(0);
             for (auto &est : estimator_) {
                 for (auto &e : est) {
                     for (std::size_t j = 0; j != e.dim(); ++j) {
-                        first = std::copy(e.col_begin(j), e.col_end(j), first);
+                        first = std::copy_n(e.col_begin(j), nrow, first);
                     }
                 }
             }
@@ -217,10 +316,18 @@ class Sampler
         return estimator_.at(step).at(k);
     }
 
+    void do_callback(std::size_t iter)
+    {
+        for (auto &callback : callback_) {
+            callback(iter, *static_cast<Derived *>(this));
+        }
+    }
+
   private:
     std::size_t num_iter_;
     Vector<Vector<eval_type>> eval_;
     Vector<Vector<estimator_type>> estimator_;
+    Vector<callback_type> callback_;
 }; // class Sampler
 
 } // namespace mckl
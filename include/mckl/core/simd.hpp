@@ -0,0 +1,126 @@
+//============================================================================
+// MCKL/include/mckl/core/simd.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_CORE_SIMD_HPP
+#define MCKL_CORE_SIMD_HPP
+
+#include <mckl/internal/common.hpp>
+#include <mckl/core/particle.hpp>
+#include <mckl/math/simd.hpp>
+
+MCKL_PUSH_GCC_WARNING("-Wignored-attributes")
+
+namespace mckl {
+
+/// \brief Call `f(idx, n)` for each block of `W` particles in a range
+/// \ingroup Core
+///
+/// \details
+/// `idx` is the first particle of the block, and `n == W` except for the
+/// last block, which has the `n < W` remaining particles
+template <std::size_t W, typename T, typename Func>
+inline void simd_for_each(const ParticleRange<T> &range, Func &&f)
+{
+    using size_type = typename Particle<T>::size_type;
+
+    Particle<T> *pptr = range.particle_ptr();
+    const size_type iend = range.iend();
+    size_type i = range.ibegin();
+    for (; iend - i >= W; i += W) {
+        f(ParticleIndex<T>(i, pptr), W);
+    }
+    if (i != iend) {
+        f(ParticleIndex<T>(i, pptr), static_cast<std::size_t>(iend - i));
+    }
+}
+
+/// \brief Call `f(idx, n)` for each block of particles of the native SIMD
+/// width of `T::value_type`
+/// \ingroup Core
+template <typename T, typename Func>
+inline void simd_for_each(const ParticleRange<T> &range, Func &&f)
+{
+    simd_for_each<simd_width<typename T::value_type>()>(
+        range, std::forward<Func>(f));
+}
+
+/// \brief Load the `j`-th variable of `n` particles starting at `idx`
+/// \ingroup Core
+template <std::size_t W, typename T>
+inline SIMD<typename T::value_type, W> simd_load_state(
+    const ParticleIndex<T> &idx, std::size_t j, std::size_t n = W)
+{
+    using V = typename T::value_type;
+
+    const T &s = idx.state();
+    const std::size_t stride = s.col_stride();
+    const V *p = s.col_data(j) + idx.i() * stride;
+
+    return stride == 1 ?
+        SIMD<V, W>::load(p, n) :
+        SIMD<V, W>::gather(p, static_cast<std::ptrdiff_t>(stride), n);
+}
+
+/// \brief Load the `j`-th variable of `n` particles starting at `idx`, with
+/// the native SIMD width
+/// \ingroup Core
+template <typename T>
+inline SIMD<typename T::value_type> simd_load_state(
+    const ParticleIndex<T> &idx, std::size_t j,
+    std::size_t n = simd_width<typename T::value_type>())
+{
+    return simd_load_state<simd_width<typename T::value_type>()>(idx, j, n);
+}
+
+/// \brief Store the `j`-th variable of `n` particles starting at `idx`
+/// \ingroup Core
+template <std::size_t W, typename T>
+inline void simd_store_state(const ParticleIndex<T> &idx, std::size_t j,
+    const SIMD<typename T::value_type, W> &a, std::size_t n = W)
+{
+    using V = typename T::value_type;
+
+    T &s = idx.state();
+    const std::size_t stride = s.col_stride();
+    V *p = s.col_data(j) + idx.i() * stride;
+
+    if (stride == 1) {
+        a.store(p, n);
+    } else {
+        a.scatter(p, static_cast<std::ptrdiff_t>(stride), n);
+    }
+}
+
+} // namespace mckl
+
+MCKL_POP_GCC_WARNING
+
+#endif // MCKL_CORE_SIMD_HPP
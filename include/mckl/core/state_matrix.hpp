@@ -44,25 +44,35 @@ namespace mckl {
 /// \tparam Layout The storage layout, either RowMajor or ColMajor
 /// \tparam Dim The initial dimension of the samples
 /// \tparam T The value type of the samples
+/// \tparam Alloc The allocator type of the underlying Matrix
 ///
 /// \details
 /// Let \f$X\f$ be \f$D\f$-vector of samples of type `T`. A collection of
 /// \f$N\f$ samples is stored as an \f$N\f$ by \f$D\f$ matrix. The value of the
 /// template parameter `Dim` only specifies the initial value of \f$D\f$.
-template <MatrixLayout Layout, typename T, std::size_t Dim = 0>
-class StateMatrix : public Matrix<T, Layout>
+///
+/// If `Alloc` uses the MemoryMMAP policy, the samples are stored out-of-core.
+/// Each range of samples is advised for sequential access before it is
+/// passed to `eval_range` by the SMP backends, and select() processes the
+/// samples in the order of their parents such that the original matrix is
+/// read sequentially.
+template <MatrixLayout Layout, typename T, std::size_t Dim = 0,
+    typename Alloc = Allocator<T>>
+class StateMatrix : public Matrix<T, Layout, Alloc>
 {
     using layout_dispatch = std::integral_constant<MatrixLayout, Layout>;
     using row_major = std::integral_constant<MatrixLayout, RowMajor>;
     using col_major = std::integral_constant<MatrixLayout, ColMajor>;
 
   public:
-    using matrix_type = Matrix<T, Layout>;
+    using matrix_type = Matrix<T, Layout, Alloc>;
     using value_type = typename matrix_type::value_type;
     using size_type = typename matrix_type::size_type;
     using difference_type = typename matrix_type::difference_type;
     using reference = typename matrix_type::reference;
     using pointer = typename matrix_type::pointer;
+    using relayout_type = StateMatrix<Layout == RowMajor ? ColMajor : RowMajor,
+        T, Dim, Alloc>;
 
     /// \brief ParticleIndex base class
     template <typename S>
@@ -196,6 +206,62 @@ class StateMatrix : public Matrix<T, Layout>
         select_dispatch(n, index, layout_dispatch());
     }
 
+    /// \brief Reallocate the storage and copy samples with a parallel loop
+    ///
+    /// \param for_each A callable object, invoked as `for_each(N, f)`, which
+    /// shall call `f(ibegin, iend)` for disjoint sub-ranges of \f$[0, N)\f$
+    /// that cover the whole range, such as a wrapper of `smp_for`
+    ///
+    /// \details
+    /// The new storage is not written before samples in the range
+    /// `[ibegin, iend)` are copied into it by `f`. On NUMA systems with a
+    /// first-touch policy, the pages are placed on the nodes of the threads
+    /// that will later process the same ranges, provided that `for_each` uses
+    /// the same partitioning as the SMP backend.
+    template <typename ForEach>
+    void first_touch(ForEach &&for_each)
+    {
+        matrix_type tmp;
+        tmp.resize(size(), dim());
+        const StateMatrix *src = this;
+        matrix_type *dst = &tmp;
+        for_each(size(), [src, dst](size_type ibegin, size_type iend) {
+            src->first_touch_dispatch(ibegin, iend, *dst, layout_dispatch());
+        });
+        matrix_type::operator=(std::move(tmp));
+    }
+
+    /// \brief Advise that samples in the range `[ibegin, iend)` will be
+    /// accessed sequentially
+    ///
+    /// \details
+    /// This function does nothing unless the storage is allocated with the
+    /// MemoryMMAP policy
+    void advise(size_type ibegin, size_type iend) const
+    {
+        if (ibegin < iend) {
+            advise_dispatch(ibegin, iend, layout_dispatch(),
+                internal::AllocatorIsMMAP<Alloc>());
+        }
+    }
+
+    /// \brief Convert to the other storage layout in-place
+    ///
+    /// \details
+    /// The storage is moved into the result, and this object is left empty.
+    /// For example, samples kept in column major order for vectorized
+    /// `eval_range` can be converted to row major order for output, without
+    /// keeping two copies of the samples (see `Matrix::relayout_inplace`).
+    /// To keep this object, use `Matrix::relayout` or smp_relayout instead.
+    relayout_type relayout_inplace()
+    {
+        relayout_type state;
+        static_cast<typename relayout_type::matrix_type &>(state) =
+            matrix_type::relayout_inplace();
+
+        return state;
+    }
+
     /// \brief Duplicate a sample
     ///
     /// \param src The index of sample to be duplicated
@@ -227,12 +293,31 @@ class StateMatrix : public Matrix<T, Layout>
             resize(n);
         }
 
+        select_row(n, index, internal::AllocatorIsMMAP<Alloc>());
+
+        if (n < size()) {
+            resize(n);
+        }
+    }
+
+    template <typename InputIter>
+    void select_row(size_type n, InputIter index, std::false_type)
+    {
         for (size_type dst = 0; dst != n; ++dst, ++index) {
             duplicate(static_cast<size_type>(*index), dst);
         }
+    }
 
-        if (n < size()) {
-            resize(n);
+    template <typename InputIter>
+    void select_row(size_type n, InputIter index, std::true_type)
+    {
+        Vector<size_type> parent;
+        Vector<size_type> order;
+        select_order(n, index, parent, order);
+        internal::memory_advise_sequential(
+            this->data(), sizeof(T) * size() * dim());
+        for (size_type k = 0; k != n; ++k) {
+            duplicate(parent[order[k]], order[k]);
         }
     }
 
@@ -244,27 +329,104 @@ class StateMatrix : public Matrix<T, Layout>
             return;
         }
 
-        InputIter idx = index;
         if (n == size()) {
-            for (size_type j = 0; j != dim(); ++j) {
-                idx = index;
-                const value_type *src = this->col_data(j);
-                value_type *dst = this->col_data(j);
-                for (size_type i = 0; i != n; ++i, ++idx) {
-                    dst[i] = src[*idx];
-                }
-            }
+            select_col(n, index, *this, internal::AllocatorIsMMAP<Alloc>());
         } else {
-            Matrix<T, ColMajor> tmp(n, dim());
-            for (size_type j = 0; j != dim(); ++j) {
-                idx = index;
-                const value_type *src = this->col_data(j);
-                value_type *dst = tmp.col_data(j);
-                for (size_type i = 0; i != n; ++i, ++idx) {
-                    dst[i] = src[*idx];
-                }
+            matrix_type tmp(n, dim());
+            select_col(n, index, tmp, internal::AllocatorIsMMAP<Alloc>());
+            matrix_type::operator=(std::move(tmp));
+        }
+    }
+
+    template <typename InputIter>
+    void select_col(
+        size_type n, InputIter index, matrix_type &tmp, std::false_type)
+    {
+        InputIter idx = index;
+        for (size_type j = 0; j != dim(); ++j) {
+            idx = index;
+            const value_type *src = this->col_data(j);
+            value_type *dst = tmp.col_data(j);
+            for (size_type i = 0; i != n; ++i, ++idx) {
+                dst[i] = src[*idx];
+            }
+        }
+    }
+
+    template <typename InputIter>
+    void select_col(
+        size_type n, InputIter index, matrix_type &tmp, std::true_type)
+    {
+        Vector<size_type> parent;
+        Vector<size_type> order;
+        select_order(n, index, parent, order);
+        for (size_type j = 0; j != dim(); ++j) {
+            const value_type *src = this->col_data(j);
+            value_type *dst = tmp.col_data(j);
+            internal::memory_advise_sequential(src, sizeof(T) * size());
+            for (size_type k = 0; k != n; ++k) {
+                const size_type i = order[k];
+                dst[i] = src[parent[i]];
             }
-            Matrix<T, ColMajor>::operator=(std::move(tmp));
+        }
+    }
+
+    // Sort the destinations by their parents with a counting sort
+    template <typename InputIter>
+    void select_order(size_type n, InputIter index, Vector<size_type> &parent,
+        Vector<size_type> &order) const
+    {
+        parent.resize(n);
+        order.resize(n);
+        Vector<size_type> count(size() + 1, 0);
+        for (size_type i = 0; i != n; ++i, ++index) {
+            parent[i] = static_cast<size_type>(*index);
+            ++count[parent[i] + 1];
+        }
+        for (size_type i = 1; i < count.size(); ++i) {
+            count[i] += count[i - 1];
+        }
+        for (size_type i = 0; i != n; ++i) {
+            order[count[parent[i]]++] = i;
+        }
+    }
+
+    void first_touch_dispatch(size_type ibegin, size_type iend,
+        matrix_type &tmp, row_major) const
+    {
+        std::copy(this->row_data(ibegin), this->row_data(ibegin) +
+                (iend - ibegin) * dim(),
+            tmp.row_data(ibegin));
+    }
+
+    void first_touch_dispatch(size_type ibegin, size_type iend,
+        matrix_type &tmp, col_major) const
+    {
+        for (size_type j = 0; j != dim(); ++j) {
+            std::copy(this->col_data(j) + ibegin, this->col_data(j) + iend,
+                tmp.col_data(j) + ibegin);
+        }
+    }
+
+    template <typename LayoutDispatch>
+    void advise_dispatch(
+        size_type, size_type, LayoutDispatch, std::false_type) const
+    {
+    }
+
+    void advise_dispatch(
+        size_type ibegin, size_type iend, row_major, std::true_type) const
+    {
+        internal::memory_advise_sequential(
+            this->row_data(ibegin), sizeof(T) * (iend - ibegin) * dim());
+    }
+
+    void advise_dispatch(
+        size_type ibegin, size_type iend, col_major, std::true_type) const
+    {
+        for (size_type j = 0; j != dim(); ++j) {
+            internal::memory_advise_sequential(
+                this->col_data(j) + ibegin, sizeof(T) * (iend - ibegin));
         }
     }
 
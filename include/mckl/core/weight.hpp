@@ -60,6 +60,29 @@ class Weight
     /// \brief Shrink to fit
     void shrink_to_fit() { data_.shrink_to_fit(); }
 
+    /// \brief Reallocate the storage and copy the weights with a parallel
+    /// loop
+    ///
+    /// \param for_each A callable object, invoked as `for_each(N, f)`, which
+    /// shall call `f(ibegin, iend)` for disjoint sub-ranges of \f$[0, N)\f$
+    /// that cover the whole range, such as a wrapper of `smp_for`
+    ///
+    /// \details
+    /// The new storage is not written before it is passed to `f`. On NUMA
+    /// systems with a first-touch policy, its pages are placed on the nodes
+    /// of the threads that write them.
+    template <typename ForEach>
+    void first_touch(ForEach &&for_each)
+    {
+        Vector<double> data(size());
+        const double *src = data_.data();
+        double *dst = data.data();
+        for_each(size(), [src, dst](size_type ibegin, size_type iend) {
+            std::copy(src + ibegin, src + iend, dst + ibegin);
+        });
+        data_ = std::move(data);
+    }
+
     /// \brief Return the ESS of the particle system
     double ess() const { return ess_; }
 
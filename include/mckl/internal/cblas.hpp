@@ -266,8 +266,10 @@ inline void cblas_sgemv(const CBLAS_LAYOUT layout, const CBLAS_TRANSPOSE trans,
     const MCKL_BLAS_INT incy)
 {
     const char transf = cblas_trans(layout, trans);
+    const MCKL_BLAS_INT mf = layout == CblasRowMajor ? n : m;
+    const MCKL_BLAS_INT nf = layout == CblasRowMajor ? m : n;
     MCKL_BLAS_NAME(sgemv)
-    (&transf, &m, &n, &alpha, a, &lda, x, &incx, &beta, y, &incy);
+    (&transf, &mf, &nf, &alpha, a, &lda, x, &incx, &beta, y, &incy);
 }
 
 inline void cblas_dgemv(const CBLAS_LAYOUT layout, const CBLAS_TRANSPOSE trans,
@@ -277,8 +279,10 @@ inline void cblas_dgemv(const CBLAS_LAYOUT layout, const CBLAS_TRANSPOSE trans,
     const MCKL_BLAS_INT incy)
 {
     const char transf = cblas_trans(layout, trans);
+    const MCKL_BLAS_INT mf = layout == CblasRowMajor ? n : m;
+    const MCKL_BLAS_INT nf = layout == CblasRowMajor ? m : n;
     MCKL_BLAS_NAME(dgemv)
-    (&transf, &m, &n, &alpha, a, &lda, x, &incx, &beta, y, &incy);
+    (&transf, &mf, &nf, &alpha, a, &lda, x, &incx, &beta, y, &incy);
 }
 
 inline void cblas_stpmv(const CBLAS_LAYOUT layout, const CBLAS_UPLO uplo,
@@ -326,8 +330,10 @@ inline void cblas_strmm(const CBLAS_LAYOUT layout, const CBLAS_SIDE side,
     const char uplof = cblas_uplo(layout, uplo);
     const char transf = cblas_trans(CblasColMajor, trans);
     const char diagf = cblas_diag(diag);
+    const MCKL_BLAS_INT mf = layout == CblasRowMajor ? n : m;
+    const MCKL_BLAS_INT nf = layout == CblasRowMajor ? m : n;
     MCKL_BLAS_NAME(strmm)
-    (&sidef, &uplof, &transf, &diagf, &m, &n, &alpha, a, &lda, b, &ldb);
+    (&sidef, &uplof, &transf, &diagf, &mf, &nf, &alpha, a, &lda, b, &ldb);
 }
 
 inline void cblas_dtrmm(const CBLAS_LAYOUT layout, const CBLAS_SIDE side,
@@ -340,8 +346,10 @@ inline void cblas_dtrmm(const CBLAS_LAYOUT layout, const CBLAS_SIDE side,
     const char uplof = cblas_uplo(layout, uplo);
     const char transf = cblas_trans(CblasColMajor, trans);
     const char diagf = cblas_diag(diag);
+    const MCKL_BLAS_INT mf = layout == CblasRowMajor ? n : m;
+    const MCKL_BLAS_INT nf = layout == CblasRowMajor ? m : n;
     MCKL_BLAS_NAME(dtrmm)
-    (&sidef, &uplof, &transf, &diagf, &m, &n, &alpha, a, &lda, b, &ldb);
+    (&sidef, &uplof, &transf, &diagf, &mf, &nf, &alpha, a, &lda, b, &ldb);
 }
 
 inline void cblas_ssyrk(const CBLAS_LAYOUT layout, const CBLAS_UPLO uplo,
@@ -100,6 +100,14 @@
 #define MCKL_HAS_POSIX 0
 #endif
 
+#ifndef MCKL_HAS_PERF_EVENT
+#if defined(__linux__) && !defined(MCKL_OPENCL)
+#define MCKL_HAS_PERF_EVENT 1
+#else
+#define MCKL_HAS_PERF_EVENT 0
+#endif
+#endif
+
 // Optional libraries
 
 #ifndef MCKL_USE_ASM_LIBRARY
@@ -114,6 +122,10 @@
 #define MCKL_USE_ASM_VMF 0
 #endif
 
+#ifndef MCKL_USE_ASM_VMF512
+#define MCKL_USE_ASM_VMF512 0
+#endif
+
 #ifndef MCKL_HAS_OMP
 #ifdef _OPENMP
 #define MCKL_HAS_OMP 1
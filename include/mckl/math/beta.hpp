@@ -127,6 +127,34 @@ inline double betai_approx(double a, double b, double x)
     return ans > 0 ? 1 - ans : -ans;
 }
 
+inline double betaiinv_init(double a, double b, double y)
+{
+    double x = 0;
+    if (a >= 1 && b >= 1) {
+        double z = (y < 0.5) ? y : 1 - y;
+        double t = std::sqrt(-2 * std::log(z));
+        x = (2.30753 + t * 0.27061) / (1 + t * (0.99229 + t * 0.04481)) - t;
+        if (y < 0.5) {
+            x = -x;
+        }
+        double al = (x * x - 3) / 6;
+        double h = 2 / (1 / (2 * a - 1) + 1 / (2 * b - 1));
+        double w = (x * std::sqrt(al + h) / h) -
+            (1 / (2 * b - 1) - 1 / (2 * a - 1)) * (al + 5 / 6 - 2 / (3 * h));
+        x = a / (a + b * std::exp(2 * w));
+    } else {
+        double lna = std::log(a / (a + b));
+        double lnb = std::log(b / (a + b));
+        double t = std::exp(a * lna) / a;
+        double u = std::exp(b * lnb) / b;
+        double w = t + u;
+        x = y < t / w ? std::pow(a * w * y, 1 / a) :
+                        1 - std::pow(b * w * (1 - y), 1 / b);
+    }
+
+    return x;
+}
+
 } // namespace internal
 
 /// \brief Regularized incomplete Beta function
@@ -171,30 +199,12 @@ inline double betaiinv(double a, double b, double y)
     double eps = 1e-8;
     double a1 = a - 1;
     double b1 = b - 1;
-    double x = 0;
-    if (a >= 1 && b >= 1) {
-        double z = (y < 0.5) ? y : 1 - y;
-        double t = std::sqrt(-2 * std::log(z));
-        x = (2.30753 + t * 0.27061) / (1 + t * (0.99229 + t * 0.04481)) - t;
-        if (y < 0.5) {
-            x = -x;
-        }
-        double al = (x * x - 3) / 6;
-        double h = 2 / (1 / (2 * a - 1) + 1 / (2 * b - 1));
-        double w = (x * std::sqrt(al + h) / h) -
-            (1 / (2 * b - 1) - 1 / (2 * a - 1)) * (al + 5 / 6 - 2 / (3 * h));
-        x = a / (a + b * std::exp(2 * w));
-    } else {
-        double lna = std::log(a / (a + b));
-        double lnb = std::log(b / (a + b));
-        double t = std::exp(a * lna) / a;
-        double u = std::exp(b * lnb) / b;
-        double w = t + u;
-        x = y < t / w ? std::pow(a * w * y, 1 / a) :
-                        1 - std::pow(b * w * (1 - y), 1 / b);
-    }
+    double x = internal::betaiinv_init(a, b, y);
     double afac = -std::lgamma(a) - std::lgamma(b) + std::lgamma(a + b);
-    for (int i = 0; i != 10; ++i) {
+
+    // The steps are halved towards the boundaries, and a poor initial value
+    // for skewed distributions can take a few dozen steps to recover
+    for (int i = 0; i != 100; ++i) {
         if (!(x > 0 || x < 0)) {
             return x;
         }
@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace mckl {
 
@@ -129,8 +130,132 @@ inline double gammap_gcf(double a, double x)
     return std::exp(-x + a * std::log(x) - std::lgamma(a)) * h;
 }
 
+// lgamma(2 + t) = (1 - gamma) * t + sum_{k > 1} (-1)^k (zeta(k) - 1) t^k / k
+static constexpr std::size_t lgamma_series_n = 31;
+
+static constexpr double lgamma_series_c[] = {0.42278433509846713,
+    0.3224670334241132, -0.0673523010531981, 0.020580808427784546,
+    -0.007385551028673986, 0.0028905103307415234, -0.001192753911703261,
+    0.0005096695247430425, -0.00022315475845357939, 9.945751278180853e-05,
+    -4.492623673813314e-05, 2.050721277567069e-05, -9.439488275268397e-06,
+    4.374866789907488e-06, -2.039215753801366e-06, 9.55141213040742e-07,
+    -4.492469198764566e-07, 2.1207184805554665e-07, -1.0043224823968099e-07,
+    4.7698101693639804e-08, -2.2711094608943164e-08, 1.0838659214896955e-08,
+    -5.183475041970047e-09, 2.4836745438024785e-09, -1.1921401405860912e-09,
+    5.731367241678862e-10, -2.7595228851242334e-10, 1.330476437424449e-10,
+    -6.4229645638381e-11, 3.1044247747322276e-11, -1.5021384080754142e-11};
+
+// digamma(2 + t) = (1 - gamma) + sum_{k > 1} (-1)^k (zeta(k) - 1) t^(k - 1)
+static constexpr std::size_t digamma_series_n = 33;
+
+static constexpr double digamma_series_c[] = {0.42278433509846713,
+    0.6449340668482264, -0.2020569031595943, 0.08232323371113819,
+    -0.03692775514336993, 0.01734306198444914, -0.008349277381922827,
+    0.00407735619794434, -0.0020083928260822143, 0.0009945751278180853,
+    -0.0004941886041194645, 0.0002460865533080483, -0.00012271334757848915,
+    6.124813505870483e-05, -3.058823630702049e-05, 1.528225940865187e-05,
+    -7.637197637899763e-06, 3.81729326499984e-06, -1.908212716553939e-06,
+    9.539620338727962e-07, -4.769329867878064e-07, 2.38450502727733e-07,
+    -1.1921992596531106e-07, 5.960818905125948e-08, -2.980350351465228e-08,
+    1.4901554828365043e-08, -7.45071178983543e-09, 3.725334024788457e-09,
+    -1.862659723513049e-09, 9.313274324196682e-10, -4.656629065033784e-10,
+    2.3283118336765053e-10, -1.164155017270052e-10};
+
+// Stirling series of lgamma(x) - (x - 1/2) log(x) + x - log(2 pi) / 2 in
+// powers of 1 / x^2, after a leading factor 1 / x
+static constexpr std::size_t lgamma_stirling_n = 8;
+
+static constexpr double lgamma_stirling_c[] = {1.0 / 12, -1.0 / 360,
+    1.0 / 1260, -1.0 / 1680, 1.0 / 1188, -691.0 / 360360, 1.0 / 156,
+    -3617.0 / 122400};
+
+// Asymptotic series of log(x) - 1 / (2 x) - digamma(x) in powers of 1 / x^2,
+// after a leading factor 1 / x^2
+static constexpr std::size_t digamma_asymptotic_n = 8;
+
+static constexpr double digamma_asymptotic_c[] = {1.0 / 12, -1.0 / 120,
+    1.0 / 252, -1.0 / 240, 1.0 / 132, -691.0 / 32760, 1.0 / 12,
+    -3617.0 / 8160};
+
+// Arguments not smaller than this are evaluated with asymptotic series,
+// smaller ones are shifted to 2 + t with t in [-0.6, 0.4)
+static constexpr double gamma_asymptotic_min = 10;
+
+inline double gamma_horner(double x, std::size_t n, const double *c)
+{
+    double r = c[n - 1];
+    for (std::size_t k = n - 1; k != 0; --k) {
+        r = r * x + c[k - 1];
+    }
+
+    return r;
+}
+
+inline double gammapinv_init(double a, double y)
+{
+    double x = 0;
+    if (a > 1) {
+        double z = y < 0.5 ? y : 1 - y;
+        double t = std::sqrt(-2 * std::log(z));
+        x = (2.30753 + t * 0.27061) / (1 + t * (0.99229 + t * 0.04481)) - t;
+        if (y < 0.5) {
+            x = -x;
+        }
+        x = std::max(
+            1e-3, a * std::pow(1 - 1 / (9 * a) - x / (3 * std::sqrt(a)), 3));
+    } else {
+        double t = 1 - a * (0.253 + a * 0.12);
+        x = y < t ? std::pow(y / t, 1 / a) :
+                    1 - std::log(1 - (y - t) / (1 - t));
+    }
+
+    return x;
+}
+
 } // namespace internal
 
+/// \brief Digamma function
+/// \ingroup Special
+inline double digamma(double x)
+{
+    if (std::isnan(x)) {
+        return x;
+    }
+    if (x <= 0) {
+        if (!(std::floor(x) < x)) {
+            return const_nan<double>();
+        }
+        return digamma(1 - x) -
+            const_pi<double>() / std::tan(const_pi<double>() * x);
+    }
+    if (!(x < const_inf<double>())) {
+        return x;
+    }
+
+    if (x < internal::gamma_asymptotic_min) {
+        const double f = std::floor(x + 0.6);
+        const double m = f - 2;
+        double r = internal::gamma_horner(x - f, internal::digamma_series_n,
+            internal::digamma_series_c);
+        for (double j = 1; j <= m; ++j) {
+            r += 1 / (x - j);
+        }
+        if (m < 0) {
+            r -= 1 / x;
+        }
+        if (m < -1) {
+            r -= 1 / (x + 1);
+        }
+        return r;
+    }
+
+    const double r = 1 / (x * x);
+
+    return std::log(x) - 0.5 / x -
+        r * internal::gamma_horner(r, internal::digamma_asymptotic_n,
+                internal::digamma_asymptotic_c);
+}
+
 /// \brief Regularized lower incomplete Gamma function
 /// \ingroup Special
 inline double gammap(double a, double x)
@@ -150,6 +275,25 @@ inline double gammap(double a, double x)
     return 1 - internal::gammap_gcf(a, x);
 }
 
+/// \brief Regularized upper incomplete Gamma function
+/// \ingroup Special
+inline double gammaq(double a, double x)
+{
+    if (x < 0 || a <= 0) {
+        return const_nan<double>();
+    }
+    if (!(x > 0 || x < 0)) {
+        return 1;
+    }
+    if (a > 100) {
+        return internal::gammap_approx(a, x, false);
+    }
+    if (x < a + 1) {
+        return 1 - internal::gammap_gser(a, x);
+    }
+    return internal::gammap_gcf(a, x);
+}
+
 /// \brief Inverse regularized lower incomplete Gamma function
 /// \ingroup Special
 inline double gammapinv(double a, double y)
@@ -169,24 +313,12 @@ inline double gammapinv(double a, double y)
     const double a1 = a - 1;
     const double gln = std::lgamma(a);
 
-    double x = 0;
+    double x = internal::gammapinv_init(a, y);
     double lna1 = 0;
     double afrac = 0;
     if (a > 1) {
         lna1 = std::log(a1);
         afrac = std::exp(a1 * (lna1 - 1) - gln);
-        double z = y < 0.5 ? y : 1 - y;
-        double t = std::sqrt(-2 * std::log(z));
-        x = (2.30753 + t * 0.27061) / (1 + t * (0.99229 + t * 0.04481)) - t;
-        if (y < 0.5) {
-            x = -x;
-        }
-        x = std::max(
-            1e-3, a * std::pow(1 - 1 / (9 * a) - x / (3 * std::sqrt(a)), 3));
-    } else {
-        double t = 1 - a * (0.253 + a * 0.12);
-        x = y < t ? std::pow(y / t, 1 / a) :
-                    1 - std::log(1 - (y - t) / (1 - t));
     }
 
     for (int i = 0; i != 12; ++i) {
@@ -0,0 +1,2510 @@
+//============================================================================
+// MCKL/include/mckl/math/simd.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_MATH_SIMD_HPP
+#define MCKL_MATH_SIMD_HPP
+
+#include <mckl/internal/config.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+MCKL_PUSH_GCC_WARNING("-Wignored-attributes")
+
+namespace mckl {
+
+namespace internal {
+
+template <typename T>
+using SIMDBitsType =
+    std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+
+template <typename T>
+inline T simd_bits(SIMDBitsType<T> u)
+{
+    T x;
+    std::memcpy(&x, &u, sizeof(T));
+
+    return x;
+}
+
+// Element-wise operations on arrays, used for widths without native support
+template <typename T, std::size_t W>
+class SIMDOpsArray
+{
+  public:
+    using type = std::array<T, W>;
+    using mask_type = std::array<bool, W>;
+
+    static type set1(T a)
+    {
+        type r;
+        r.fill(a);
+
+        return r;
+    }
+
+    static type loadu(const T *p)
+    {
+        type r;
+        std::copy_n(p, W, r.data());
+
+        return r;
+    }
+
+    static type loadn(const T *p, std::size_t n)
+    {
+        type r;
+        r.fill(0);
+        std::copy_n(p, n, r.data());
+
+        return r;
+    }
+
+    static void storeu(T *p, const type &a) { std::copy_n(a.data(), W, p); }
+
+    static void storen(T *p, std::size_t n, const type &a)
+    {
+        std::copy_n(a.data(), n, p);
+    }
+
+    static type gather(const T *p, std::ptrdiff_t stride, std::size_t n)
+    {
+        type r;
+        r.fill(0);
+        for (std::size_t i = 0; i != n; ++i) {
+            r[i] = p[static_cast<std::ptrdiff_t>(i) * stride];
+        }
+
+        return r;
+    }
+
+    static type gather(const T *p, const std::int32_t *index, std::size_t n)
+    {
+        type r;
+        r.fill(0);
+        for (std::size_t i = 0; i != n; ++i) {
+            r[i] = p[index[i]];
+        }
+
+        return r;
+    }
+
+    static void scatter(
+        T *p, std::ptrdiff_t stride, std::size_t n, const type &a)
+    {
+        for (std::size_t i = 0; i != n; ++i) {
+            p[static_cast<std::ptrdiff_t>(i) * stride] = a[i];
+        }
+    }
+
+    static type add(const type &a, const type &b)
+    {
+        return map(a, b, [](T x, T y) { return x + y; });
+    }
+
+    static type sub(const type &a, const type &b)
+    {
+        return map(a, b, [](T x, T y) { return x - y; });
+    }
+
+    static type mul(const type &a, const type &b)
+    {
+        return map(a, b, [](T x, T y) { return x * y; });
+    }
+
+    static type div(const type &a, const type &b)
+    {
+        return map(a, b, [](T x, T y) { return x / y; });
+    }
+
+    static type fmadd(const type &a, const type &b, const type &c)
+    {
+        type r;
+        for (std::size_t i = 0; i != W; ++i) {
+#if MCKL_USE_FMA
+            r[i] = std::fma(a[i], b[i], c[i]);
+#else
+            r[i] = a[i] * b[i] + c[i];
+#endif
+        }
+
+        return r;
+    }
+
+    static type fnmadd(const type &a, const type &b, const type &c)
+    {
+        type r;
+        for (std::size_t i = 0; i != W; ++i) {
+#if MCKL_USE_FMA
+            r[i] = std::fma(-a[i], b[i], c[i]);
+#else
+            r[i] = c[i] - a[i] * b[i];
+#endif
+        }
+
+        return r;
+    }
+
+    static type min(const type &a, const type &b)
+    {
+        return map(a, b, [](T x, T y) { return x < y ? x : y; });
+    }
+
+    static type max(const type &a, const type &b)
+    {
+        return map(a, b, [](T x, T y) { return x > y ? x : y; });
+    }
+
+    static type sqrt(const type &a)
+    {
+        return map(a, [](T x) { return std::sqrt(x); });
+    }
+
+    static type round(const type &a)
+    {
+        return map(a, [](T x) { return std::rint(x); });
+    }
+
+    static type floor(const type &a)
+    {
+        return map(a, [](T x) { return std::floor(x); });
+    }
+
+    static type ceil(const type &a)
+    {
+        return map(a, [](T x) { return std::ceil(x); });
+    }
+
+    static type trunc(const type &a)
+    {
+        return map(a, [](T x) { return std::trunc(x); });
+    }
+
+    static type bit_and(const type &a, const type &b)
+    {
+        return map_bits(a, b, [](U x, U y) { return x & y; });
+    }
+
+    static type bit_or(const type &a, const type &b)
+    {
+        return map_bits(a, b, [](U x, U y) { return x | y; });
+    }
+
+    static type bit_xor(const type &a, const type &b)
+    {
+        return map_bits(a, b, [](U x, U y) { return x ^ y; });
+    }
+
+    static type bit_andnot(const type &a, const type &b)
+    {
+        return map_bits(a, b, [](U x, U y) { return ~x & y; });
+    }
+
+    template <int N>
+    static type slli(const type &a)
+    {
+        return map_bits(a, a, [](U x, U) { return static_cast<U>(x << N); });
+    }
+
+    template <int N>
+    static type srli(const type &a)
+    {
+        return map_bits(a, a, [](U x, U) { return static_cast<U>(x >> N); });
+    }
+
+    static mask_type cmpeq(const type &a, const type &b)
+    {
+        return cmp(a, b, [](T x, T y) { return x == y; });
+    }
+
+    static mask_type cmpneq(const type &a, const type &b)
+    {
+        return cmp(a, b, [](T x, T y) { return !(x == y); });
+    }
+
+    static mask_type cmplt(const type &a, const type &b)
+    {
+        return cmp(a, b, [](T x, T y) { return x < y; });
+    }
+
+    static mask_type cmple(const type &a, const type &b)
+    {
+        return cmp(a, b, [](T x, T y) { return x <= y; });
+    }
+
+    static mask_type cmpgt(const type &a, const type &b)
+    {
+        return cmp(a, b, [](T x, T y) { return x > y; });
+    }
+
+    static mask_type cmpge(const type &a, const type &b)
+    {
+        return cmp(a, b, [](T x, T y) { return x >= y; });
+    }
+
+    static mask_type mask_and(const mask_type &a, const mask_type &b)
+    {
+        mask_type r;
+        for (std::size_t i = 0; i != W; ++i) {
+            r[i] = a[i] && b[i];
+        }
+
+        return r;
+    }
+
+    static mask_type mask_or(const mask_type &a, const mask_type &b)
+    {
+        mask_type r;
+        for (std::size_t i = 0; i != W; ++i) {
+            r[i] = a[i] || b[i];
+        }
+
+        return r;
+    }
+
+    static mask_type mask_xor(const mask_type &a, const mask_type &b)
+    {
+        mask_type r;
+        for (std::size_t i = 0; i != W; ++i) {
+            r[i] = a[i] != b[i];
+        }
+
+        return r;
+    }
+
+    static mask_type mask_not(const mask_type &a)
+    {
+        mask_type r;
+        for (std::size_t i = 0; i != W; ++i) {
+            r[i] = !a[i];
+        }
+
+        return r;
+    }
+
+    static bool any(const mask_type &a)
+    {
+        return std::any_of(a.begin(), a.end(), [](bool x) { return x; });
+    }
+
+    static bool all(const mask_type &a)
+    {
+        return std::all_of(a.begin(), a.end(), [](bool x) { return x; });
+    }
+
+    static type blend(const mask_type &m, const type &a, const type &b)
+    {
+        type r;
+        for (std::size_t i = 0; i != W; ++i) {
+            r[i] = m[i] ? b[i] : a[i];
+        }
+
+        return r;
+    }
+
+  private:
+    using U = SIMDBitsType<T>;
+
+    template <typename Func>
+    static type map(const type &a, Func &&f)
+    {
+        type r;
+        for (std::size_t i = 0; i != W; ++i) {
+            r[i] = f(a[i]);
+        }
+
+        return r;
+    }
+
+    template <typename Func>
+    static type map(const type &a, const type &b, Func &&f)
+    {
+        type r;
+        for (std::size_t i = 0; i != W; ++i) {
+            r[i] = f(a[i], b[i]);
+        }
+
+        return r;
+    }
+
+    template <typename Func>
+    static type map_bits(const type &a, const type &b, Func &&f)
+    {
+        type r;
+        for (std::size_t i = 0; i != W; ++i) {
+            U x;
+            U y;
+            std::memcpy(&x, &a[i], sizeof(T));
+            std::memcpy(&y, &b[i], sizeof(T));
+            const U z = f(x, y);
+            std::memcpy(&r[i], &z, sizeof(T));
+        }
+
+        return r;
+    }
+
+    template <typename Func>
+    static mask_type cmp(const type &a, const type &b, Func &&f)
+    {
+        mask_type r;
+        for (std::size_t i = 0; i != W; ++i) {
+            r[i] = f(a[i], b[i]);
+        }
+
+        return r;
+    }
+}; // class SIMDOpsArray
+
+template <typename T, std::size_t W>
+class SIMDOps : public SIMDOpsArray<T, W>
+{
+}; // class SIMDOps
+
+// Partial loads and stores, and gathers, through a temporary array
+template <typename T, std::size_t W, typename Ops, typename V>
+class SIMDOpsMemory
+{
+  public:
+    using type = V;
+
+    static type loadn(const T *p, std::size_t n)
+    {
+        alignas(32) std::array<T, W> r;
+        r.fill(0);
+        std::copy_n(p, n, r.data());
+
+        return Ops::loadu(r.data());
+    }
+
+    static void storen(T *p, std::size_t n, const type &a)
+    {
+        alignas(32) std::array<T, W> r;
+        Ops::storeu(r.data(), a);
+        std::copy_n(r.data(), n, p);
+    }
+
+    static type gather(const T *p, std::ptrdiff_t stride, std::size_t n)
+    {
+        return Ops::loadu(SIMDOpsArray<T, W>::gather(p, stride, n).data());
+    }
+
+    static type gather(const T *p, const std::int32_t *index, std::size_t n)
+    {
+        return Ops::loadu(SIMDOpsArray<T, W>::gather(p, index, n).data());
+    }
+
+    static void scatter(
+        T *p, std::ptrdiff_t stride, std::size_t n, const type &a)
+    {
+        alignas(32) std::array<T, W> r;
+        Ops::storeu(r.data(), a);
+        SIMDOpsArray<T, W>::scatter(p, stride, n, r);
+    }
+}; // class SIMDOpsMemory
+
+template <typename T, std::size_t W>
+inline std::array<std::int32_t, W> simd_stride_index(std::ptrdiff_t stride)
+{
+    std::array<std::int32_t, W> index;
+    for (std::size_t i = 0; i != W; ++i) {
+        index[i] = static_cast<std::int32_t>(static_cast<std::ptrdiff_t>(i) *
+            static_cast<std::ptrdiff_t>(stride));
+    }
+
+    return index;
+}
+
+#if MCKL_USE_SSE2
+
+template <>
+class SIMDOps<double, 2>
+    : public SIMDOpsMemory<double, 2, SIMDOps<double, 2>, __m128d>
+{
+  public:
+    using type = __m128d;
+    using mask_type = __m128d;
+
+    static type set1(double a) { return _mm_set1_pd(a); }
+
+    static type loadu(const double *p) { return _mm_loadu_pd(p); }
+
+    static void storeu(double *p, const type &a) { _mm_storeu_pd(p, a); }
+
+    static type add(const type &a, const type &b) { return _mm_add_pd(a, b); }
+
+    static type sub(const type &a, const type &b) { return _mm_sub_pd(a, b); }
+
+    static type mul(const type &a, const type &b) { return _mm_mul_pd(a, b); }
+
+    static type div(const type &a, const type &b) { return _mm_div_pd(a, b); }
+
+    static type fmadd(const type &a, const type &b, const type &c)
+    {
+#if MCKL_USE_FMA
+        return _mm_fmadd_pd(a, b, c);
+#else
+        return _mm_add_pd(_mm_mul_pd(a, b), c);
+#endif
+    }
+
+    static type fnmadd(const type &a, const type &b, const type &c)
+    {
+#if MCKL_USE_FMA
+        return _mm_fnmadd_pd(a, b, c);
+#else
+        return _mm_sub_pd(c, _mm_mul_pd(a, b));
+#endif
+    }
+
+    static type min(const type &a, const type &b) { return _mm_min_pd(a, b); }
+
+    static type max(const type &a, const type &b) { return _mm_max_pd(a, b); }
+
+    static type sqrt(const type &a) { return _mm_sqrt_pd(a); }
+
+#if MCKL_USE_SSE4_1
+    static type round(const type &a)
+    {
+        return _mm_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    static type floor(const type &a)
+    {
+        return _mm_round_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type ceil(const type &a)
+    {
+        return _mm_round_pd(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type trunc(const type &a)
+    {
+        return _mm_round_pd(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    }
+#else  // MCKL_USE_SSE4_1
+    static type round(const type &a)
+    {
+        const type s = _mm_set1_pd(-0.0);
+        const type m = _mm_set1_pd(4503599627370496.0); // 2^52
+        const type b = _mm_andnot_pd(s, a);
+        const type r = _mm_or_pd(_mm_sub_pd(_mm_add_pd(b, m), m),
+            _mm_and_pd(a, s));
+
+        return blend(_mm_cmpge_pd(b, m), r, a);
+    }
+
+    static type floor(const type &a)
+    {
+        const type r = round(a);
+
+        return _mm_sub_pd(
+            r, _mm_and_pd(_mm_cmpgt_pd(r, a), _mm_set1_pd(1.0)));
+    }
+
+    static type ceil(const type &a)
+    {
+        const type s = _mm_set1_pd(-0.0);
+
+        return _mm_xor_pd(floor(_mm_xor_pd(a, s)), s);
+    }
+
+    static type trunc(const type &a)
+    {
+        const type s = _mm_set1_pd(-0.0);
+
+        return _mm_or_pd(floor(_mm_andnot_pd(s, a)), _mm_and_pd(a, s));
+    }
+#endif // MCKL_USE_SSE4_1
+
+    static type bit_and(const type &a, const type &b)
+    {
+        return _mm_and_pd(a, b);
+    }
+
+    static type bit_or(const type &a, const type &b)
+    {
+        return _mm_or_pd(a, b);
+    }
+
+    static type bit_xor(const type &a, const type &b)
+    {
+        return _mm_xor_pd(a, b);
+    }
+
+    static type bit_andnot(const type &a, const type &b)
+    {
+        return _mm_andnot_pd(a, b);
+    }
+
+    template <int N>
+    static type slli(const type &a)
+    {
+        return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(a), N));
+    }
+
+    template <int N>
+    static type srli(const type &a)
+    {
+        return _mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(a), N));
+    }
+
+    static mask_type cmpeq(const type &a, const type &b)
+    {
+        return _mm_cmpeq_pd(a, b);
+    }
+
+    static mask_type cmpneq(const type &a, const type &b)
+    {
+        return _mm_cmpneq_pd(a, b);
+    }
+
+    static mask_type cmplt(const type &a, const type &b)
+    {
+        return _mm_cmplt_pd(a, b);
+    }
+
+    static mask_type cmple(const type &a, const type &b)
+    {
+        return _mm_cmple_pd(a, b);
+    }
+
+    static mask_type cmpgt(const type &a, const type &b)
+    {
+        return _mm_cmpgt_pd(a, b);
+    }
+
+    static mask_type cmpge(const type &a, const type &b)
+    {
+        return _mm_cmpge_pd(a, b);
+    }
+
+    static mask_type mask_and(const mask_type &a, const mask_type &b)
+    {
+        return _mm_and_pd(a, b);
+    }
+
+    static mask_type mask_or(const mask_type &a, const mask_type &b)
+    {
+        return _mm_or_pd(a, b);
+    }
+
+    static mask_type mask_xor(const mask_type &a, const mask_type &b)
+    {
+        return _mm_xor_pd(a, b);
+    }
+
+    static mask_type mask_not(const mask_type &a)
+    {
+        return _mm_xor_pd(a, _mm_castsi128_pd(_mm_set1_epi32(-1)));
+    }
+
+    static bool any(const mask_type &a) { return _mm_movemask_pd(a) != 0; }
+
+    static bool all(const mask_type &a) { return _mm_movemask_pd(a) == 0x3; }
+
+    static type blend(const mask_type &m, const type &a, const type &b)
+    {
+#if MCKL_USE_SSE4_1
+        return _mm_blendv_pd(a, b, m);
+#else
+        return _mm_or_pd(_mm_and_pd(m, b), _mm_andnot_pd(m, a));
+#endif
+    }
+}; // class SIMDOps
+
+template <>
+class SIMDOps<float, 4>
+    : public SIMDOpsMemory<float, 4, SIMDOps<float, 4>, __m128>
+{
+  public:
+    using type = __m128;
+    using mask_type = __m128;
+
+    static type set1(float a) { return _mm_set1_ps(a); }
+
+    static type loadu(const float *p) { return _mm_loadu_ps(p); }
+
+    static void storeu(float *p, const type &a) { _mm_storeu_ps(p, a); }
+
+    static type add(const type &a, const type &b) { return _mm_add_ps(a, b); }
+
+    static type sub(const type &a, const type &b) { return _mm_sub_ps(a, b); }
+
+    static type mul(const type &a, const type &b) { return _mm_mul_ps(a, b); }
+
+    static type div(const type &a, const type &b) { return _mm_div_ps(a, b); }
+
+    static type fmadd(const type &a, const type &b, const type &c)
+    {
+#if MCKL_USE_FMA
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+    }
+
+    static type fnmadd(const type &a, const type &b, const type &c)
+    {
+#if MCKL_USE_FMA
+        return _mm_fnmadd_ps(a, b, c);
+#else
+        return _mm_sub_ps(c, _mm_mul_ps(a, b));
+#endif
+    }
+
+    static type min(const type &a, const type &b) { return _mm_min_ps(a, b); }
+
+    static type max(const type &a, const type &b) { return _mm_max_ps(a, b); }
+
+    static type sqrt(const type &a) { return _mm_sqrt_ps(a); }
+
+#if MCKL_USE_SSE4_1
+    static type round(const type &a)
+    {
+        return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    static type floor(const type &a)
+    {
+        return _mm_round_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type ceil(const type &a)
+    {
+        return _mm_round_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type trunc(const type &a)
+    {
+        return _mm_round_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    }
+#else  // MCKL_USE_SSE4_1
+    static type round(const type &a)
+    {
+        const type s = _mm_set1_ps(-0.0f);
+        const type m = _mm_set1_ps(8388608.0f); // 2^23
+        const type b = _mm_andnot_ps(s, a);
+        const type r = _mm_or_ps(_mm_sub_ps(_mm_add_ps(b, m), m),
+            _mm_and_ps(a, s));
+
+        return blend(_mm_cmpge_ps(b, m), r, a);
+    }
+
+    static type floor(const type &a)
+    {
+        const type r = round(a);
+
+        return _mm_sub_ps(
+            r, _mm_and_ps(_mm_cmpgt_ps(r, a), _mm_set1_ps(1.0f)));
+    }
+
+    static type ceil(const type &a)
+    {
+        const type s = _mm_set1_ps(-0.0f);
+
+        return _mm_xor_ps(floor(_mm_xor_ps(a, s)), s);
+    }
+
+    static type trunc(const type &a)
+    {
+        const type s = _mm_set1_ps(-0.0f);
+
+        return _mm_or_ps(floor(_mm_andnot_ps(s, a)), _mm_and_ps(a, s));
+    }
+#endif // MCKL_USE_SSE4_1
+
+    static type bit_and(const type &a, const type &b)
+    {
+        return _mm_and_ps(a, b);
+    }
+
+    static type bit_or(const type &a, const type &b)
+    {
+        return _mm_or_ps(a, b);
+    }
+
+    static type bit_xor(const type &a, const type &b)
+    {
+        return _mm_xor_ps(a, b);
+    }
+
+    static type bit_andnot(const type &a, const type &b)
+    {
+        return _mm_andnot_ps(a, b);
+    }
+
+    template <int N>
+    static type slli(const type &a)
+    {
+        return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(a), N));
+    }
+
+    template <int N>
+    static type srli(const type &a)
+    {
+        return _mm_castsi128_ps(_mm_srli_epi32(_mm_castps_si128(a), N));
+    }
+
+    static mask_type cmpeq(const type &a, const type &b)
+    {
+        return _mm_cmpeq_ps(a, b);
+    }
+
+    static mask_type cmpneq(const type &a, const type &b)
+    {
+        return _mm_cmpneq_ps(a, b);
+    }
+
+    static mask_type cmplt(const type &a, const type &b)
+    {
+        return _mm_cmplt_ps(a, b);
+    }
+
+    static mask_type cmple(const type &a, const type &b)
+    {
+        return _mm_cmple_ps(a, b);
+    }
+
+    static mask_type cmpgt(const type &a, const type &b)
+    {
+        return _mm_cmpgt_ps(a, b);
+    }
+
+    static mask_type cmpge(const type &a, const type &b)
+    {
+        return _mm_cmpge_ps(a, b);
+    }
+
+    static mask_type mask_and(const mask_type &a, const mask_type &b)
+    {
+        return _mm_and_ps(a, b);
+    }
+
+    static mask_type mask_or(const mask_type &a, const mask_type &b)
+    {
+        return _mm_or_ps(a, b);
+    }
+
+    static mask_type mask_xor(const mask_type &a, const mask_type &b)
+    {
+        return _mm_xor_ps(a, b);
+    }
+
+    static mask_type mask_not(const mask_type &a)
+    {
+        return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+    }
+
+    static bool any(const mask_type &a) { return _mm_movemask_ps(a) != 0; }
+
+    static bool all(const mask_type &a) { return _mm_movemask_ps(a) == 0xF; }
+
+    static type blend(const mask_type &m, const type &a, const type &b)
+    {
+#if MCKL_USE_SSE4_1
+        return _mm_blendv_ps(a, b, m);
+#else
+        return _mm_or_ps(_mm_and_ps(m, b), _mm_andnot_ps(m, a));
+#endif
+    }
+}; // class SIMDOps
+
+#endif // MCKL_USE_SSE2
+
+#if MCKL_USE_AVX2
+
+template <>
+class SIMDOps<double, 4>
+    : public SIMDOpsMemory<double, 4, SIMDOps<double, 4>, __m256d>
+{
+  public:
+    using type = __m256d;
+    using mask_type = __m256d;
+
+    static type set1(double a) { return _mm256_set1_pd(a); }
+
+    static type loadu(const double *p) { return _mm256_loadu_pd(p); }
+
+    static type loadn(const double *p, std::size_t n)
+    {
+        return _mm256_maskload_pd(p, mask(n));
+    }
+
+    static void storeu(double *p, const type &a) { _mm256_storeu_pd(p, a); }
+
+    static void storen(double *p, std::size_t n, const type &a)
+    {
+        _mm256_maskstore_pd(p, mask(n), a);
+    }
+
+    static type gather(const double *p, std::ptrdiff_t stride, std::size_t n)
+    {
+        const std::array<std::int32_t, 4> index =
+            simd_stride_index<double, 4>(stride);
+
+        return gather(p, index.data(), n);
+    }
+
+    static type gather(
+        const double *p, const std::int32_t *index, std::size_t n)
+    {
+        if (n == 4) {
+            return _mm256_i32gather_pd(p,
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(index)), 8);
+        }
+
+        std::array<std::int32_t, 4> idx = {{0, 0, 0, 0}};
+        std::copy_n(index, n, idx.data());
+
+        return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), p,
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(idx.data())),
+            _mm256_castsi256_pd(mask(n)), 8);
+    }
+
+    static type add(const type &a, const type &b)
+    {
+        return _mm256_add_pd(a, b);
+    }
+
+    static type sub(const type &a, const type &b)
+    {
+        return _mm256_sub_pd(a, b);
+    }
+
+    static type mul(const type &a, const type &b)
+    {
+        return _mm256_mul_pd(a, b);
+    }
+
+    static type div(const type &a, const type &b)
+    {
+        return _mm256_div_pd(a, b);
+    }
+
+    static type fmadd(const type &a, const type &b, const type &c)
+    {
+#if MCKL_USE_FMA
+        return _mm256_fmadd_pd(a, b, c);
+#else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+    }
+
+    static type fnmadd(const type &a, const type &b, const type &c)
+    {
+#if MCKL_USE_FMA
+        return _mm256_fnmadd_pd(a, b, c);
+#else
+        return _mm256_sub_pd(c, _mm256_mul_pd(a, b));
+#endif
+    }
+
+    static type min(const type &a, const type &b)
+    {
+        return _mm256_min_pd(a, b);
+    }
+
+    static type max(const type &a, const type &b)
+    {
+        return _mm256_max_pd(a, b);
+    }
+
+    static type sqrt(const type &a) { return _mm256_sqrt_pd(a); }
+
+    static type round(const type &a)
+    {
+        return _mm256_round_pd(
+            a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    static type floor(const type &a)
+    {
+        return _mm256_round_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type ceil(const type &a)
+    {
+        return _mm256_round_pd(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type trunc(const type &a)
+    {
+        return _mm256_round_pd(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    }
+
+    static type bit_and(const type &a, const type &b)
+    {
+        return _mm256_and_pd(a, b);
+    }
+
+    static type bit_or(const type &a, const type &b)
+    {
+        return _mm256_or_pd(a, b);
+    }
+
+    static type bit_xor(const type &a, const type &b)
+    {
+        return _mm256_xor_pd(a, b);
+    }
+
+    static type bit_andnot(const type &a, const type &b)
+    {
+        return _mm256_andnot_pd(a, b);
+    }
+
+    template <int N>
+    static type slli(const type &a)
+    {
+        return _mm256_castsi256_pd(
+            _mm256_slli_epi64(_mm256_castpd_si256(a), N));
+    }
+
+    template <int N>
+    static type srli(const type &a)
+    {
+        return _mm256_castsi256_pd(
+            _mm256_srli_epi64(_mm256_castpd_si256(a), N));
+    }
+
+    static mask_type cmpeq(const type &a, const type &b)
+    {
+        return _mm256_cmp_pd(a, b, _CMP_EQ_OQ);
+    }
+
+    static mask_type cmpneq(const type &a, const type &b)
+    {
+        return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ);
+    }
+
+    static mask_type cmplt(const type &a, const type &b)
+    {
+        return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+    }
+
+    static mask_type cmple(const type &a, const type &b)
+    {
+        return _mm256_cmp_pd(a, b, _CMP_LE_OQ);
+    }
+
+    static mask_type cmpgt(const type &a, const type &b)
+    {
+        return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+    }
+
+    static mask_type cmpge(const type &a, const type &b)
+    {
+        return _mm256_cmp_pd(a, b, _CMP_GE_OQ);
+    }
+
+    static mask_type mask_and(const mask_type &a, const mask_type &b)
+    {
+        return _mm256_and_pd(a, b);
+    }
+
+    static mask_type mask_or(const mask_type &a, const mask_type &b)
+    {
+        return _mm256_or_pd(a, b);
+    }
+
+    static mask_type mask_xor(const mask_type &a, const mask_type &b)
+    {
+        return _mm256_xor_pd(a, b);
+    }
+
+    static mask_type mask_not(const mask_type &a)
+    {
+        return _mm256_xor_pd(a, _mm256_castsi256_pd(_mm256_set1_epi32(-1)));
+    }
+
+    static bool any(const mask_type &a) { return _mm256_movemask_pd(a) != 0; }
+
+    static bool all(const mask_type &a)
+    {
+        return _mm256_movemask_pd(a) == 0xF;
+    }
+
+    static type blend(const mask_type &m, const type &a, const type &b)
+    {
+        return _mm256_blendv_pd(a, b, m);
+    }
+
+  private:
+    static __m256i mask(std::size_t n)
+    {
+        return _mm256_cmpgt_epi64(
+            _mm256_set1_epi64x(static_cast<MCKL_INT64>(n)),
+            _mm256_set_epi64x(3, 2, 1, 0));
+    }
+}; // class SIMDOps
+
+template <>
+class SIMDOps<float, 8>
+    : public SIMDOpsMemory<float, 8, SIMDOps<float, 8>, __m256>
+{
+  public:
+    using type = __m256;
+    using mask_type = __m256;
+
+    static type set1(float a) { return _mm256_set1_ps(a); }
+
+    static type loadu(const float *p) { return _mm256_loadu_ps(p); }
+
+    static type loadn(const float *p, std::size_t n)
+    {
+        return _mm256_maskload_ps(p, mask(n));
+    }
+
+    static void storeu(float *p, const type &a) { _mm256_storeu_ps(p, a); }
+
+    static void storen(float *p, std::size_t n, const type &a)
+    {
+        _mm256_maskstore_ps(p, mask(n), a);
+    }
+
+    static type gather(const float *p, std::ptrdiff_t stride, std::size_t n)
+    {
+        const std::array<std::int32_t, 8> index =
+            simd_stride_index<float, 8>(stride);
+
+        return gather(p, index.data(), n);
+    }
+
+    static type gather(
+        const float *p, const std::int32_t *index, std::size_t n)
+    {
+        if (n == 8) {
+            return _mm256_i32gather_ps(p,
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(index)),
+                4);
+        }
+
+        std::array<std::int32_t, 8> idx = {{0, 0, 0, 0, 0, 0, 0, 0}};
+        std::copy_n(index, n, idx.data());
+
+        return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), p,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(idx.data())),
+            _mm256_castsi256_ps(mask(n)), 4);
+    }
+
+    static type add(const type &a, const type &b)
+    {
+        return _mm256_add_ps(a, b);
+    }
+
+    static type sub(const type &a, const type &b)
+    {
+        return _mm256_sub_ps(a, b);
+    }
+
+    static type mul(const type &a, const type &b)
+    {
+        return _mm256_mul_ps(a, b);
+    }
+
+    static type div(const type &a, const type &b)
+    {
+        return _mm256_div_ps(a, b);
+    }
+
+    static type fmadd(const type &a, const type &b, const type &c)
+    {
+#if MCKL_USE_FMA
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+
+    static type fnmadd(const type &a, const type &b, const type &c)
+    {
+#if MCKL_USE_FMA
+        return _mm256_fnmadd_ps(a, b, c);
+#else
+        return _mm256_sub_ps(c, _mm256_mul_ps(a, b));
+#endif
+    }
+
+    static type min(const type &a, const type &b)
+    {
+        return _mm256_min_ps(a, b);
+    }
+
+    static type max(const type &a, const type &b)
+    {
+        return _mm256_max_ps(a, b);
+    }
+
+    static type sqrt(const type &a) { return _mm256_sqrt_ps(a); }
+
+    static type round(const type &a)
+    {
+        return _mm256_round_ps(
+            a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    static type floor(const type &a)
+    {
+        return _mm256_round_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type ceil(const type &a)
+    {
+        return _mm256_round_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type trunc(const type &a)
+    {
+        return _mm256_round_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    }
+
+    static type bit_and(const type &a, const type &b)
+    {
+        return _mm256_and_ps(a, b);
+    }
+
+    static type bit_or(const type &a, const type &b)
+    {
+        return _mm256_or_ps(a, b);
+    }
+
+    static type bit_xor(const type &a, const type &b)
+    {
+        return _mm256_xor_ps(a, b);
+    }
+
+    static type bit_andnot(const type &a, const type &b)
+    {
+        return _mm256_andnot_ps(a, b);
+    }
+
+    template <int N>
+    static type slli(const type &a)
+    {
+        return _mm256_castsi256_ps(
+            _mm256_slli_epi32(_mm256_castps_si256(a), N));
+    }
+
+    template <int N>
+    static type srli(const type &a)
+    {
+        return _mm256_castsi256_ps(
+            _mm256_srli_epi32(_mm256_castps_si256(a), N));
+    }
+
+    static mask_type cmpeq(const type &a, const type &b)
+    {
+        return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+    }
+
+    static mask_type cmpneq(const type &a, const type &b)
+    {
+        return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ);
+    }
+
+    static mask_type cmplt(const type &a, const type &b)
+    {
+        return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+    }
+
+    static mask_type cmple(const type &a, const type &b)
+    {
+        return _mm256_cmp_ps(a, b, _CMP_LE_OQ);
+    }
+
+    static mask_type cmpgt(const type &a, const type &b)
+    {
+        return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+    }
+
+    static mask_type cmpge(const type &a, const type &b)
+    {
+        return _mm256_cmp_ps(a, b, _CMP_GE_OQ);
+    }
+
+    static mask_type mask_and(const mask_type &a, const mask_type &b)
+    {
+        return _mm256_and_ps(a, b);
+    }
+
+    static mask_type mask_or(const mask_type &a, const mask_type &b)
+    {
+        return _mm256_or_ps(a, b);
+    }
+
+    static mask_type mask_xor(const mask_type &a, const mask_type &b)
+    {
+        return _mm256_xor_ps(a, b);
+    }
+
+    static mask_type mask_not(const mask_type &a)
+    {
+        return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+    }
+
+    static bool any(const mask_type &a) { return _mm256_movemask_ps(a) != 0; }
+
+    static bool all(const mask_type &a)
+    {
+        return _mm256_movemask_ps(a) == 0xFF;
+    }
+
+    static type blend(const mask_type &m, const type &a, const type &b)
+    {
+        return _mm256_blendv_ps(a, b, m);
+    }
+
+  private:
+    static __m256i mask(std::size_t n)
+    {
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(n)),
+            _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    }
+}; // class SIMDOps
+
+#endif // MCKL_USE_AVX2
+
+#if MCKL_USE_AVX512
+
+template <>
+class SIMDOps<double, 8>
+    : public SIMDOpsMemory<double, 8, SIMDOps<double, 8>, __m512d>
+{
+  public:
+    using type = __m512d;
+    using mask_type = __mmask8;
+
+    static type set1(double a) { return _mm512_set1_pd(a); }
+
+    static type loadu(const double *p) { return _mm512_loadu_pd(p); }
+
+    static type loadn(const double *p, std::size_t n)
+    {
+        return _mm512_maskz_loadu_pd(mask(n), p);
+    }
+
+    static void storeu(double *p, const type &a) { _mm512_storeu_pd(p, a); }
+
+    static void storen(double *p, std::size_t n, const type &a)
+    {
+        _mm512_mask_storeu_pd(p, mask(n), a);
+    }
+
+    static type gather(const double *p, std::ptrdiff_t stride, std::size_t n)
+    {
+        const std::array<std::int32_t, 8> index =
+            simd_stride_index<double, 8>(stride);
+
+        return gather(p, index.data(), n);
+    }
+
+    static type gather(
+        const double *p, const std::int32_t *index, std::size_t n)
+    {
+        std::array<std::int32_t, 8> padded = {{0, 0, 0, 0, 0, 0, 0, 0}};
+        std::copy_n(index, n, padded.data());
+        const __m256i idx = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(padded.data()));
+
+        return _mm512_mask_i32gather_pd(
+            _mm512_setzero_pd(), mask(n), idx, p, 8);
+    }
+
+    static void scatter(
+        double *p, std::ptrdiff_t stride, std::size_t n, const type &a)
+    {
+        const std::array<std::int32_t, 8> index =
+            simd_stride_index<double, 8>(stride);
+        const __m256i idx = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(index.data()));
+        _mm512_mask_i32scatter_pd(p, mask(n), idx, a, 8);
+    }
+
+    static type add(const type &a, const type &b)
+    {
+        return _mm512_add_pd(a, b);
+    }
+
+    static type sub(const type &a, const type &b)
+    {
+        return _mm512_sub_pd(a, b);
+    }
+
+    static type mul(const type &a, const type &b)
+    {
+        return _mm512_mul_pd(a, b);
+    }
+
+    static type div(const type &a, const type &b)
+    {
+        return _mm512_div_pd(a, b);
+    }
+
+    static type fmadd(const type &a, const type &b, const type &c)
+    {
+        return _mm512_fmadd_pd(a, b, c);
+    }
+
+    static type fnmadd(const type &a, const type &b, const type &c)
+    {
+        return _mm512_fnmadd_pd(a, b, c);
+    }
+
+    static type min(const type &a, const type &b)
+    {
+        return _mm512_min_pd(a, b);
+    }
+
+    static type max(const type &a, const type &b)
+    {
+        return _mm512_max_pd(a, b);
+    }
+
+    static type sqrt(const type &a) { return _mm512_sqrt_pd(a); }
+
+    static type round(const type &a)
+    {
+        return _mm512_roundscale_pd(
+            a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    static type floor(const type &a)
+    {
+        return _mm512_roundscale_pd(
+            a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type ceil(const type &a)
+    {
+        return _mm512_roundscale_pd(
+            a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type trunc(const type &a)
+    {
+        return _mm512_roundscale_pd(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    }
+
+    static type bit_and(const type &a, const type &b)
+    {
+        return _mm512_castsi512_pd(
+            _mm512_and_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+
+    static type bit_or(const type &a, const type &b)
+    {
+        return _mm512_castsi512_pd(
+            _mm512_or_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+
+    static type bit_xor(const type &a, const type &b)
+    {
+        return _mm512_castsi512_pd(
+            _mm512_xor_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+
+    static type bit_andnot(const type &a, const type &b)
+    {
+        return _mm512_castsi512_pd(_mm512_andnot_si512(
+            _mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+
+    template <int N>
+    static type slli(const type &a)
+    {
+        return _mm512_castsi512_pd(
+            _mm512_slli_epi64(_mm512_castpd_si512(a), N));
+    }
+
+    template <int N>
+    static type srli(const type &a)
+    {
+        return _mm512_castsi512_pd(
+            _mm512_srli_epi64(_mm512_castpd_si512(a), N));
+    }
+
+    static mask_type cmpeq(const type &a, const type &b)
+    {
+        return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+    }
+
+    static mask_type cmpneq(const type &a, const type &b)
+    {
+        return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ);
+    }
+
+    static mask_type cmplt(const type &a, const type &b)
+    {
+        return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+    }
+
+    static mask_type cmple(const type &a, const type &b)
+    {
+        return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);
+    }
+
+    static mask_type cmpgt(const type &a, const type &b)
+    {
+        return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+    }
+
+    static mask_type cmpge(const type &a, const type &b)
+    {
+        return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ);
+    }
+
+    static mask_type mask_and(mask_type a, mask_type b)
+    {
+        return static_cast<mask_type>(a & b);
+    }
+
+    static mask_type mask_or(mask_type a, mask_type b)
+    {
+        return static_cast<mask_type>(a | b);
+    }
+
+    static mask_type mask_xor(mask_type a, mask_type b)
+    {
+        return static_cast<mask_type>(a ^ b);
+    }
+
+    static mask_type mask_not(mask_type a)
+    {
+        return static_cast<mask_type>(~a);
+    }
+
+    static bool any(mask_type a) { return a != 0; }
+
+    static bool all(mask_type a) { return a == 0xFF; }
+
+    static type blend(mask_type m, const type &a, const type &b)
+    {
+        return _mm512_mask_blend_pd(m, a, b);
+    }
+
+  private:
+    static mask_type mask(std::size_t n)
+    {
+        return static_cast<mask_type>(n >= 8 ? 0xFF : (1U << n) - 1);
+    }
+}; // class SIMDOps
+
+template <>
+class SIMDOps<float, 16>
+    : public SIMDOpsMemory<float, 16, SIMDOps<float, 16>, __m512>
+{
+  public:
+    using type = __m512;
+    using mask_type = __mmask16;
+
+    static type set1(float a) { return _mm512_set1_ps(a); }
+
+    static type loadu(const float *p) { return _mm512_loadu_ps(p); }
+
+    static type loadn(const float *p, std::size_t n)
+    {
+        return _mm512_maskz_loadu_ps(mask(n), p);
+    }
+
+    static void storeu(float *p, const type &a) { _mm512_storeu_ps(p, a); }
+
+    static void storen(float *p, std::size_t n, const type &a)
+    {
+        _mm512_mask_storeu_ps(p, mask(n), a);
+    }
+
+    static type gather(const float *p, std::ptrdiff_t stride, std::size_t n)
+    {
+        const std::array<std::int32_t, 16> index =
+            simd_stride_index<float, 16>(stride);
+
+        return gather(p, index.data(), n);
+    }
+
+    static type gather(
+        const float *p, const std::int32_t *index, std::size_t n)
+    {
+        const __m512i idx = _mm512_maskz_loadu_epi32(mask(n), index);
+
+        return _mm512_mask_i32gather_ps(
+            _mm512_setzero_ps(), mask(n), idx, p, 4);
+    }
+
+    static void scatter(
+        float *p, std::ptrdiff_t stride, std::size_t n, const type &a)
+    {
+        const std::array<std::int32_t, 16> index =
+            simd_stride_index<float, 16>(stride);
+        const __m512i idx = _mm512_loadu_si512(index.data());
+        _mm512_mask_i32scatter_ps(p, mask(n), idx, a, 4);
+    }
+
+    static type add(const type &a, const type &b)
+    {
+        return _mm512_add_ps(a, b);
+    }
+
+    static type sub(const type &a, const type &b)
+    {
+        return _mm512_sub_ps(a, b);
+    }
+
+    static type mul(const type &a, const type &b)
+    {
+        return _mm512_mul_ps(a, b);
+    }
+
+    static type div(const type &a, const type &b)
+    {
+        return _mm512_div_ps(a, b);
+    }
+
+    static type fmadd(const type &a, const type &b, const type &c)
+    {
+        return _mm512_fmadd_ps(a, b, c);
+    }
+
+    static type fnmadd(const type &a, const type &b, const type &c)
+    {
+        return _mm512_fnmadd_ps(a, b, c);
+    }
+
+    static type min(const type &a, const type &b)
+    {
+        return _mm512_min_ps(a, b);
+    }
+
+    static type max(const type &a, const type &b)
+    {
+        return _mm512_max_ps(a, b);
+    }
+
+    static type sqrt(const type &a) { return _mm512_sqrt_ps(a); }
+
+    static type round(const type &a)
+    {
+        return _mm512_roundscale_ps(
+            a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    static type floor(const type &a)
+    {
+        return _mm512_roundscale_ps(
+            a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type ceil(const type &a)
+    {
+        return _mm512_roundscale_ps(
+            a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    }
+
+    static type trunc(const type &a)
+    {
+        return _mm512_roundscale_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    }
+
+    static type bit_and(const type &a, const type &b)
+    {
+        return _mm512_castsi512_ps(
+            _mm512_and_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+
+    static type bit_or(const type &a, const type &b)
+    {
+        return _mm512_castsi512_ps(
+            _mm512_or_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+
+    static type bit_xor(const type &a, const type &b)
+    {
+        return _mm512_castsi512_ps(
+            _mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+
+    static type bit_andnot(const type &a, const type &b)
+    {
+        return _mm512_castsi512_ps(_mm512_andnot_si512(
+            _mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+
+    template <int N>
+    static type slli(const type &a)
+    {
+        return _mm512_castsi512_ps(
+            _mm512_slli_epi32(_mm512_castps_si512(a), N));
+    }
+
+    template <int N>
+    static type srli(const type &a)
+    {
+        return _mm512_castsi512_ps(
+            _mm512_srli_epi32(_mm512_castps_si512(a), N));
+    }
+
+    static mask_type cmpeq(const type &a, const type &b)
+    {
+        return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+    }
+
+    static mask_type cmpneq(const type &a, const type &b)
+    {
+        return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ);
+    }
+
+    static mask_type cmplt(const type &a, const type &b)
+    {
+        return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+    }
+
+    static mask_type cmple(const type &a, const type &b)
+    {
+        return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);
+    }
+
+    static mask_type cmpgt(const type &a, const type &b)
+    {
+        return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+    }
+
+    static mask_type cmpge(const type &a, const type &b)
+    {
+        return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ);
+    }
+
+    static mask_type mask_and(mask_type a, mask_type b)
+    {
+        return static_cast<mask_type>(a & b);
+    }
+
+    static mask_type mask_or(mask_type a, mask_type b)
+    {
+        return static_cast<mask_type>(a | b);
+    }
+
+    static mask_type mask_xor(mask_type a, mask_type b)
+    {
+        return static_cast<mask_type>(a ^ b);
+    }
+
+    static mask_type mask_not(mask_type a)
+    {
+        return static_cast<mask_type>(~a);
+    }
+
+    static bool any(mask_type a) { return a != 0; }
+
+    static bool all(mask_type a) { return a == 0xFFFF; }
+
+    static type blend(mask_type m, const type &a, const type &b)
+    {
+        return _mm512_mask_blend_ps(m, a, b);
+    }
+
+  private:
+    static mask_type mask(std::size_t n)
+    {
+        return static_cast<mask_type>(n >= 16 ? 0xFFFF : (1U << n) - 1);
+    }
+}; // class SIMDOps
+
+#endif // MCKL_USE_AVX512
+
+} // namespace internal
+
+/// \brief The native number of elements of type `T` in a SIMD register
+/// \ingroup Core
+template <typename T>
+inline constexpr std::size_t simd_width()
+{
+#if MCKL_USE_AVX512
+    return 64 / sizeof(T);
+#elif MCKL_USE_AVX2
+    return 32 / sizeof(T);
+#elif MCKL_USE_SSE2
+    return 16 / sizeof(T);
+#else
+    return 1;
+#endif
+}
+
+/// \brief Lane-wise mask of a SIMD vector
+/// \ingroup Core
+template <typename T, std::size_t W = simd_width<T>()>
+class SIMDMask
+{
+    using ops = internal::SIMDOps<T, W>;
+
+  public:
+    using data_type = typename ops::mask_type;
+
+    SIMDMask() = default;
+
+    explicit SIMDMask(const data_type &m) : m_(m) {}
+
+    static constexpr std::size_t size() { return W; }
+
+    const data_type &data() const { return m_; }
+
+    friend SIMDMask operator&(const SIMDMask &a, const SIMDMask &b)
+    {
+        return SIMDMask(ops::mask_and(a.m_, b.m_));
+    }
+
+    friend SIMDMask operator|(const SIMDMask &a, const SIMDMask &b)
+    {
+        return SIMDMask(ops::mask_or(a.m_, b.m_));
+    }
+
+    friend SIMDMask operator^(const SIMDMask &a, const SIMDMask &b)
+    {
+        return SIMDMask(ops::mask_xor(a.m_, b.m_));
+    }
+
+    friend SIMDMask operator~(const SIMDMask &a)
+    {
+        return SIMDMask(ops::mask_not(a.m_));
+    }
+
+  private:
+    data_type m_;
+}; // class SIMDMask
+
+/// \brief SIMD vector of `W` elements of type `T`
+/// \ingroup Core
+///
+/// \details
+/// Widths with native support, `simd_width<T>()` by default, are backed by
+/// SSE2, AVX2 or AVX-512 registers. Other widths are backed by arrays and
+/// element-wise loops. Kernels written in terms of this class compile for
+/// any of the instruction sets without change.
+template <typename T, std::size_t W = simd_width<T>()>
+class SIMD
+{
+    static_assert(std::is_same<T, float>::value ||
+            std::is_same<T, double>::value,
+        "**SIMD** used with T other than float or double");
+
+    static_assert(W != 0, "**SIMD** used with zero width");
+
+    using ops = internal::SIMDOps<T, W>;
+
+  public:
+    using value_type = T;
+    using mask_type = SIMDMask<T, W>;
+    using data_type = typename ops::type;
+
+    SIMD() = default;
+
+    /// \brief Broadcast a scalar to all elements
+    SIMD(T a) : v_(ops::set1(a)) {}
+
+    explicit SIMD(const data_type &v) : v_(v) {}
+
+    static constexpr std::size_t size() { return W; }
+
+    /// \brief Load `W` elements from `p`
+    static SIMD load(const T *p) { return SIMD(ops::loadu(p)); }
+
+    /// \brief Load the first `n <= W` elements from `p` and zero the rest
+    static SIMD load(const T *p, std::size_t n)
+    {
+        return SIMD(n == W ? ops::loadu(p) : ops::loadn(p, n));
+    }
+
+    /// \brief Load `p[i * stride]` for `i < n` and zero the rest
+    static SIMD gather(const T *p, std::ptrdiff_t stride, std::size_t n = W)
+    {
+        return SIMD(ops::gather(p, stride, n));
+    }
+
+    /// \brief Load `p[index[i]]` for `i < n` and zero the rest
+    static SIMD gather(
+        const T *p, const std::int32_t *index, std::size_t n = W)
+    {
+        return SIMD(ops::gather(p, index, n));
+    }
+
+    /// \brief Store `W` elements to `p`
+    void store(T *p) const { ops::storeu(p, v_); }
+
+    /// \brief Store the first `n <= W` elements to `p`
+    void store(T *p, std::size_t n) const
+    {
+        if (n == W) {
+            ops::storeu(p, v_);
+        } else {
+            ops::storen(p, n, v_);
+        }
+    }
+
+    /// \brief Store the first `n <= W` elements to `p[i * stride]`
+    void scatter(T *p, std::ptrdiff_t stride, std::size_t n = W) const
+    {
+        ops::scatter(p, stride, n, v_);
+    }
+
+    T operator[](std::size_t i) const
+    {
+        alignas(64) std::array<T, W> r;
+        ops::storeu(r.data(), v_);
+
+        return r[i];
+    }
+
+    const data_type &data() const { return v_; }
+
+    friend SIMD operator+(const SIMD &a, const SIMD &b)
+    {
+        return SIMD(ops::add(a.v_, b.v_));
+    }
+
+    friend SIMD operator-(const SIMD &a, const SIMD &b)
+    {
+        return SIMD(ops::sub(a.v_, b.v_));
+    }
+
+    friend SIMD operator*(const SIMD &a, const SIMD &b)
+    {
+        return SIMD(ops::mul(a.v_, b.v_));
+    }
+
+    friend SIMD operator/(const SIMD &a, const SIMD &b)
+    {
+        return SIMD(ops::div(a.v_, b.v_));
+    }
+
+    friend SIMD &operator+=(SIMD &a, const SIMD &b) { return a = a + b; }
+
+    friend SIMD &operator-=(SIMD &a, const SIMD &b) { return a = a - b; }
+
+    friend SIMD &operator*=(SIMD &a, const SIMD &b) { return a = a * b; }
+
+    friend SIMD &operator/=(SIMD &a, const SIMD &b) { return a = a / b; }
+
+    friend SIMD operator+(const SIMD &a) { return a; }
+
+    friend SIMD operator-(const SIMD &a)
+    {
+        return SIMD(ops::bit_xor(a.v_, ops::set1(static_cast<T>(-0.0))));
+    }
+
+    friend mask_type operator==(const SIMD &a, const SIMD &b)
+    {
+        return mask_type(ops::cmpeq(a.v_, b.v_));
+    }
+
+    friend mask_type operator!=(const SIMD &a, const SIMD &b)
+    {
+        return mask_type(ops::cmpneq(a.v_, b.v_));
+    }
+
+    friend mask_type operator<(const SIMD &a, const SIMD &b)
+    {
+        return mask_type(ops::cmplt(a.v_, b.v_));
+    }
+
+    friend mask_type operator<=(const SIMD &a, const SIMD &b)
+    {
+        return mask_type(ops::cmple(a.v_, b.v_));
+    }
+
+    friend mask_type operator>(const SIMD &a, const SIMD &b)
+    {
+        return mask_type(ops::cmpgt(a.v_, b.v_));
+    }
+
+    friend mask_type operator>=(const SIMD &a, const SIMD &b)
+    {
+        return mask_type(ops::cmpge(a.v_, b.v_));
+    }
+
+  private:
+    data_type v_;
+}; // class SIMD
+
+/// \brief If any element of the mask is set
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline bool any_of(const SIMDMask<T, W> &m)
+{
+    return internal::SIMDOps<T, W>::any(m.data());
+}
+
+/// \brief If all elements of the mask are set
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline bool all_of(const SIMDMask<T, W> &m)
+{
+    return internal::SIMDOps<T, W>::all(m.data());
+}
+
+/// \brief If no element of the mask is set
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline bool none_of(const SIMDMask<T, W> &m)
+{
+    return !internal::SIMDOps<T, W>::any(m.data());
+}
+
+/// \brief Element-wise `m ? a : b`
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> select(
+    const SIMDMask<T, W> &m, const SIMD<T, W> &a, const SIMD<T, W> &b)
+{
+    return SIMD<T, W>(internal::SIMDOps<T, W>::blend(m.data(), b.data(),
+        a.data()));
+}
+
+/// \brief Element-wise `a * b + c`, fused if FMA is available
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> fmadd(
+    const SIMD<T, W> &a, const SIMD<T, W> &b, const SIMD<T, W> &c)
+{
+    return SIMD<T, W>(
+        internal::SIMDOps<T, W>::fmadd(a.data(), b.data(), c.data()));
+}
+
+/// \brief Element-wise `c - a * b`, fused if FMA is available
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> fnmadd(
+    const SIMD<T, W> &a, const SIMD<T, W> &b, const SIMD<T, W> &c)
+{
+    return SIMD<T, W>(
+        internal::SIMDOps<T, W>::fnmadd(a.data(), b.data(), c.data()));
+}
+
+/// \brief Element-wise minimum
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> min(const SIMD<T, W> &a, const SIMD<T, W> &b)
+{
+    return SIMD<T, W>(internal::SIMDOps<T, W>::min(a.data(), b.data()));
+}
+
+/// \brief Element-wise maximum
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> max(const SIMD<T, W> &a, const SIMD<T, W> &b)
+{
+    return SIMD<T, W>(internal::SIMDOps<T, W>::max(a.data(), b.data()));
+}
+
+/// \brief Element-wise absolute value
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> abs(const SIMD<T, W> &a)
+{
+    using ops = internal::SIMDOps<T, W>;
+
+    return SIMD<T, W>(
+        ops::bit_andnot(ops::set1(static_cast<T>(-0.0)), a.data()));
+}
+
+/// \brief Element-wise square root
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> sqrt(const SIMD<T, W> &a)
+{
+    return SIMD<T, W>(internal::SIMDOps<T, W>::sqrt(a.data()));
+}
+
+/// \brief Element-wise rounding to the nearest integer
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> round(const SIMD<T, W> &a)
+{
+    return SIMD<T, W>(internal::SIMDOps<T, W>::round(a.data()));
+}
+
+/// \brief Element-wise rounding toward negative infinity
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> floor(const SIMD<T, W> &a)
+{
+    return SIMD<T, W>(internal::SIMDOps<T, W>::floor(a.data()));
+}
+
+/// \brief Element-wise rounding toward positive infinity
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> ceil(const SIMD<T, W> &a)
+{
+    return SIMD<T, W>(internal::SIMDOps<T, W>::ceil(a.data()));
+}
+
+/// \brief Element-wise rounding toward zero
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> trunc(const SIMD<T, W> &a)
+{
+    return SIMD<T, W>(internal::SIMDOps<T, W>::trunc(a.data()));
+}
+
+namespace internal {
+
+template <typename T>
+class SIMDMathConstants;
+
+// The same constants as the assembly library, `lib/asm/{exp,log,sincos}.asm`
+template <>
+class SIMDMathConstants<double>
+{
+  public:
+    static constexpr int shift = 52;
+
+    // exp(x) - 1 = x + x^2 * (c2 + x * (c3 + ... + x * c13))
+    static std::array<std::uint64_t, 12> exp_c()
+    {
+        return {{0x3FE0000000000000, 0x3FC5555555555555, 0x3FA5555555555555,
+            0x3F81111111111111, 0x3F56C16C16C16C17, 0x3F2A01A01A01A01A,
+            0x3EFA01A01A01A01A, 0x3EC71DE3A556C734, 0x3E927E4FB7789F5C,
+            0x3E5AE64567F544E4, 0x3E21EED8EFF8D898, 0x3DE6124613A86D09}};
+    }
+
+    static double exp_ln2hi() { return simd_bits<double>(0x3FE62E42FEE00000); }
+    static double exp_ln2lo() { return simd_bits<double>(0x3DEA39EF35793C76); }
+    static double exp_ln2inv()
+    {
+        return simd_bits<double>(0x3FF71547652B82FE);
+    }
+    static double exp_bias() { return simd_bits<double>(0x43300000000003FF); }
+    static double exp_min_a() { return simd_bits<double>(0xC086232BDD7ABCD2); }
+    static double exp_max_a() { return simd_bits<double>(0x40862B7D369A5AA7); }
+
+    // log(1 + f) * (f + 2) / f - 2 = x^2 * (c3 + x^2 * (c5 + ... c15))
+    static std::array<std::uint64_t, 7> log_c()
+    {
+        return {{0x3FE5555555555593, 0x3FD999999997FA04, 0x3FD2492494229359,
+            0x3FCC71C51D8E78AF, 0x3FC7466496CB03DE, 0x3FC39A09D078C69F,
+            0x3FC2F112DF3E5244}};
+    }
+
+    static double log_emask0()
+    {
+        return simd_bits<double>(0x4330000000000000);
+    }
+    static double log_emask1()
+    {
+        return simd_bits<double>(0x43300000000003FF);
+    }
+    static double log_fmask0()
+    {
+        return simd_bits<double>(0x000FFFFFFFFFFFFF);
+    }
+    static double log_fmask1()
+    {
+        return simd_bits<double>(0x3FE0000000000000);
+    }
+    static double log_ln2() { return simd_bits<double>(0x3FE62E42FEFA39EF); }
+    static double log_sqrt2() { return simd_bits<double>(0x3FF6A09E667F3BCD); }
+    static double log_sqrt2by2()
+    {
+        return simd_bits<double>(0x3FE6A09E667F3BCD);
+    }
+    static double log_min_a() { return simd_bits<double>(0x0010000000000000); }
+    static double log_max_a() { return simd_bits<double>(0x7FEFFFFFFFFFFFFF); }
+
+    // sin(x) = x + x^3 * (c3 + x^2 * (c5 + ... + x^2 * c13))
+    static std::array<std::uint64_t, 6> sin_c()
+    {
+        return {{0xBFC5555555555549, 0x3F8111111110F8A6, 0xBF2A01A019C161D5,
+            0x3EC71DE357B1FE7D, 0xBE5AE5E68A2B9CEB, 0x3DE5D93A5ACFD57C}};
+    }
+
+    // cos(x) = 1 - x^2 / 2 + x^4 * (c4 + x^2 * (c6 + ... + x^2 * c14))
+    static std::array<std::uint64_t, 6> cos_c()
+    {
+        return {{0x3FA555555555554C, 0xBF56C16C16C15177, 0x3EFA01A019CB1590,
+            0xBE927E4F809C52AD, 0x3E21EE9EBDB4B1C4, 0xBDA8FAE9BE8838D4}};
+    }
+
+    static double sin_dp1() { return simd_bits<double>(0x3FE921FB50000000); }
+    static double sin_dp2() { return simd_bits<double>(0x3E4110B460000000); }
+    static double sin_dp3() { return simd_bits<double>(0x3C81A62633145C07); }
+    static double sin_pi4inv()
+    {
+        return simd_bits<double>(0x3FF45F306DC9C883);
+    }
+    static double sin_max_a() { return simd_bits<double>(0x41D921FB5411E920); }
+}; // class SIMDMathConstants
+
+// exp and log use the same constants as the assembly library,
+// `lib/asm/{expf,logf}.asm`, sin and cos use the Cephes single precision
+// polynomials
+template <>
+class SIMDMathConstants<float>
+{
+  public:
+    static constexpr int shift = 23;
+
+    static std::array<std::uint32_t, 6> exp_c()
+    {
+        return {{0x3F000000, 0x3E2AAAAB, 0x3D2AAAAB, 0x3C088889, 0x3AB60B61,
+            0x39500D01}};
+    }
+
+    static float exp_ln2hi() { return simd_bits<float>(0x3F318000); }
+    static float exp_ln2lo() { return simd_bits<float>(0xB95E8083); }
+    static float exp_ln2inv() { return simd_bits<float>(0x3FB8AA3B); }
+    static float exp_bias() { return simd_bits<float>(0x4B00007F); }
+    static float exp_min_a() { return simd_bits<float>(0xC2AEAC4F); }
+    static float exp_max_a() { return simd_bits<float>(0x42B0C0A5); }
+
+    static std::array<std::uint32_t, 4> log_c()
+    {
+        return {{0x3F2AAAAA, 0x3ECCCE13, 0x3E91E9EE, 0x3E789E26}};
+    }
+
+    static float log_emask0() { return simd_bits<float>(0x4B000000); }
+    static float log_emask1() { return simd_bits<float>(0x4B00007F); }
+    static float log_fmask0() { return simd_bits<float>(0x007FFFFF); }
+    static float log_fmask1() { return simd_bits<float>(0x3F000000); }
+    static float log_ln2() { return simd_bits<float>(0x3F317218); }
+    static float log_sqrt2() { return simd_bits<float>(0x3FB504F3); }
+    static float log_sqrt2by2() { return simd_bits<float>(0x3F3504F3); }
+    static float log_min_a() { return simd_bits<float>(0x00800000); }
+    static float log_max_a() { return simd_bits<float>(0x7F7FFFFF); }
+
+    static std::array<std::uint32_t, 3> sin_c()
+    {
+        return {{0xBE2AAAA3, 0x3C08839E, 0xB94CA1F9}};
+    }
+
+    static std::array<std::uint32_t, 3> cos_c()
+    {
+        return {{0x3D2AAAA5, 0xBAB6061A, 0x37CCF5CE}};
+    }
+
+    static float sin_dp1() { return simd_bits<float>(0x3F490000); }
+    static float sin_dp2() { return simd_bits<float>(0x397DA000); }
+    static float sin_dp3() { return simd_bits<float>(0x33222169); }
+    static float sin_pi4inv() { return simd_bits<float>(0x3FA2F983); }
+    static float sin_max_a() { return simd_bits<float>(0x46000000); }
+}; // class SIMDMathConstants
+
+// c[0] + x * (c[1] + ... + x * c[K - 1])
+template <typename T, std::size_t W, std::size_t K>
+inline typename SIMDOps<T, W>::type simd_horner(
+    const typename SIMDOps<T, W>::type &x,
+    const std::array<SIMDBitsType<T>, K> &c)
+{
+    using ops = SIMDOps<T, W>;
+
+    typename ops::type r = ops::set1(simd_bits<T>(c[K - 1]));
+    for (std::size_t k = K - 1; k != 0; --k) {
+        r = ops::fmadd(r, x, ops::set1(simd_bits<T>(c[k - 1])));
+    }
+
+    return r;
+}
+
+// Widths without native support use the scalar functions for each element,
+// which are much faster than the polynomials on arrays
+template <typename T, std::size_t W>
+using SIMDOpsIsArray = std::is_base_of<SIMDOpsArray<T, W>, SIMDOps<T, W>>;
+
+template <typename T, std::size_t W>
+inline std::array<T, W> simd_exp(const std::array<T, W> &a, std::true_type)
+{
+    std::array<T, W> r;
+    for (std::size_t i = 0; i != W; ++i) {
+        r[i] = std::exp(a[i]);
+    }
+
+    return r;
+}
+
+template <typename T, std::size_t W>
+inline std::array<T, W> simd_log(const std::array<T, W> &a, std::true_type)
+{
+    std::array<T, W> r;
+    for (std::size_t i = 0; i != W; ++i) {
+        r[i] = std::log(a[i]);
+    }
+
+    return r;
+}
+
+template <typename T, std::size_t W>
+inline void simd_sincos_scalar(const typename SIMDOps<T, W>::type &a,
+    typename SIMDOps<T, W>::type &s, typename SIMDOps<T, W>::type &co)
+{
+    using ops = SIMDOps<T, W>;
+
+    std::array<T, W> x;
+    std::array<T, W> y;
+    std::array<T, W> z;
+    ops::storeu(x.data(), a);
+    for (std::size_t i = 0; i != W; ++i) {
+        y[i] = std::sin(x[i]);
+        z[i] = std::cos(x[i]);
+    }
+    s = ops::loadu(y.data());
+    co = ops::loadu(z.data());
+}
+
+template <typename T, std::size_t W>
+inline void simd_sincos(const std::array<T, W> &a, std::array<T, W> &s,
+    std::array<T, W> &co, std::true_type)
+{
+    simd_sincos_scalar<T, W>(a, s, co);
+}
+
+template <typename T, std::size_t W>
+inline typename SIMDOps<T, W>::type simd_exp(
+    const typename SIMDOps<T, W>::type &a, std::false_type)
+{
+    using ops = SIMDOps<T, W>;
+    using c = SIMDMathConstants<T>;
+    using V = typename ops::type;
+
+    // k = round(a / log(2))
+    const V k = ops::round(ops::mul(a, ops::set1(c::exp_ln2inv())));
+
+    // x = a - k * log(2)
+    V x = ops::fnmadd(k, ops::set1(c::exp_ln2hi()), a);
+    x = ops::fnmadd(k, ops::set1(c::exp_ln2lo()), x);
+
+    // exp(x) = R + 1
+    const V R =
+        ops::fmadd(ops::mul(x, x), simd_horner<T, W>(x, c::exp_c()), x);
+
+    // exp(a) = exp(x) * 2^k = R * 2^k + 2^k
+    const V p = ops::template slli<c::shift>(
+        ops::add(k, ops::set1(c::exp_bias())));
+    V y = ops::fmadd(R, p, p);
+
+    y = ops::blend(ops::cmplt(a, ops::set1(c::exp_min_a())), y,
+        ops::set1(static_cast<T>(0)));
+    y = ops::blend(ops::cmpgt(a, ops::set1(c::exp_max_a())), y,
+        ops::set1(std::numeric_limits<T>::infinity()));
+    y = ops::blend(ops::cmpneq(a, a), y, a);
+
+    return y;
+}
+
+template <typename T, std::size_t W>
+inline typename SIMDOps<T, W>::type simd_log(
+    const typename SIMDOps<T, W>::type &a, std::false_type)
+{
+    using ops = SIMDOps<T, W>;
+    using c = SIMDMathConstants<T>;
+    using V = typename ops::type;
+
+    const V zero = ops::set1(static_cast<T>(0));
+    const V one = ops::set1(static_cast<T>(1));
+    const V sqrt2by2 = ops::set1(c::log_sqrt2by2());
+
+    // a = 2^k * (1 + f), sqrt(2) / 2 <= 1 + f <= sqrt(2)
+    V k = zero;
+    V f = ops::sub(a, one);
+    const typename ops::mask_type m = ops::mask_or(ops::cmplt(a, sqrt2by2),
+        ops::cmpgt(a, ops::set1(c::log_sqrt2())));
+    if (ops::any(m)) {
+        V e = ops::sub(ops::bit_or(ops::template srli<c::shift>(a),
+                           ops::set1(c::log_emask0())),
+            ops::set1(c::log_emask1()));
+        V g = ops::bit_or(ops::bit_and(a, ops::set1(c::log_fmask0())),
+            ops::set1(c::log_fmask1()));
+        const typename ops::mask_type gt = ops::cmpgt(g, sqrt2by2);
+        e = ops::add(e, ops::blend(gt, zero, one));
+        g = ops::blend(gt, ops::add(g, g), g);
+        k = ops::blend(m, k, e);
+        f = ops::blend(m, f, ops::sub(g, one));
+    }
+
+    // log(1 + f) = f - x * (f - R), x = f / (f + 2)
+    const V x = ops::div(f, ops::add(f, ops::set1(static_cast<T>(2))));
+    const V x2 = ops::mul(x, x);
+    const V R = ops::mul(x2, simd_horner<T, W>(x2, c::log_c()));
+    V y = ops::fnmadd(x, ops::sub(f, R), f);
+
+    // log(a) = k * log(2) + log(1 + f)
+    y = ops::fmadd(k, ops::set1(c::log_ln2()), y);
+
+    y = ops::blend(ops::cmplt(a, ops::set1(c::log_min_a())), y,
+        ops::set1(-std::numeric_limits<T>::infinity()));
+    y = ops::blend(ops::cmpgt(a, ops::set1(c::log_max_a())), y,
+        ops::set1(std::numeric_limits<T>::infinity()));
+    y = ops::blend(ops::cmplt(a, zero), y,
+        ops::set1(std::numeric_limits<T>::quiet_NaN()));
+    y = ops::blend(ops::cmpneq(a, a), y, a);
+
+    return y;
+}
+
+// The reduction by multiples of pi / 4 in three parts is accurate up to
+// sin_max_a, about 1.7e9 for double and 8192 for float. Vectors with larger
+// elements use the scalar functions
+template <typename T, std::size_t W>
+inline void simd_sincos(const typename SIMDOps<T, W>::type &a,
+    typename SIMDOps<T, W>::type &s, typename SIMDOps<T, W>::type &co,
+    std::false_type)
+{
+    using ops = SIMDOps<T, W>;
+    using c = SIMDMathConstants<T>;
+    using V = typename ops::type;
+    using M = typename ops::mask_type;
+
+    const V sign = ops::set1(static_cast<T>(-0.0));
+    const V half = ops::set1(static_cast<T>(0.5));
+    const V one = ops::set1(static_cast<T>(1));
+
+    // b = abs(a)
+    const V b = ops::bit_andnot(sign, a);
+    if (ops::any(ops::cmpgt(b, ops::set1(c::sin_max_a())))) {
+        simd_sincos_scalar<T, W>(a, s, co);
+        return;
+    }
+
+    // n = trunc(4 * b / pi), h = floor((n + 1) / 2), k = 2 * h
+    const V n = ops::trunc(ops::mul(b, ops::set1(c::sin_pi4inv())));
+    const V h = ops::floor(ops::mul(ops::add(n, one), half));
+    const V k = ops::add(h, h);
+
+    // x = b - k * pi / 4
+    V x = ops::fnmadd(k, ops::set1(c::sin_dp1()), b);
+    x = ops::fnmadd(k, ops::set1(c::sin_dp2()), x);
+    x = ops::fnmadd(k, ops::set1(c::sin_dp3()), x);
+
+    const V x2 = ops::mul(x, x);
+    const V sp =
+        ops::fmadd(ops::mul(x2, x), simd_horner<T, W>(x2, c::sin_c()), x);
+    const V cp = ops::fmadd(ops::mul(x2, x2),
+        simd_horner<T, W>(x2, c::cos_c()), ops::fnmadd(half, x2, one));
+
+    // quadrant q = h mod 4
+    const V h2 = ops::floor(ops::mul(h, half));
+    const V q = ops::sub(h, ops::mul(ops::floor(ops::mul(h2, half)),
+                                ops::set1(static_cast<T>(4))));
+    const M swap = ops::cmpneq(ops::sub(h, ops::add(h2, h2)),
+        ops::set1(static_cast<T>(0)));
+    const M sneg = ops::cmpge(q, ops::set1(static_cast<T>(2)));
+    const M cneg = ops::mask_xor(swap, sneg);
+
+    s = ops::blend(swap, sp, cp);
+    s = ops::blend(sneg, s, ops::bit_xor(s, sign));
+    s = ops::bit_xor(s, ops::bit_and(a, sign));
+    co = ops::blend(swap, cp, sp);
+    co = ops::blend(cneg, co, ops::bit_xor(co, sign));
+
+    const M nan = ops::cmpneq(a, a);
+    s = ops::blend(nan, s, a);
+    co = ops::blend(nan, co, a);
+}
+
+} // namespace internal
+
+/// \brief Element-wise exponential
+/// \ingroup Core
+///
+/// \details
+/// The algorithm and accuracy are the same as `mckl::exp` with the assembly
+/// library. Widths without native support use `std::exp`
+template <typename T, std::size_t W>
+inline SIMD<T, W> exp(const SIMD<T, W> &a)
+{
+    return SIMD<T, W>(internal::simd_exp<T, W>(
+        a.data(), internal::SIMDOpsIsArray<T, W>()));
+}
+
+/// \brief Element-wise natural logarithm
+/// \ingroup Core
+///
+/// \details
+/// The algorithm and accuracy are the same as `mckl::log` with the assembly
+/// library. Widths without native support use `std::log`
+template <typename T, std::size_t W>
+inline SIMD<T, W> log(const SIMD<T, W> &a)
+{
+    return SIMD<T, W>(internal::simd_log<T, W>(
+        a.data(), internal::SIMDOpsIsArray<T, W>()));
+}
+
+/// \brief Element-wise sine and cosine
+/// \ingroup Core
+///
+/// \details
+/// For double precision and \f$|a| \le 1.7\times10^9\f$, the algorithm
+/// and accuracy are the same as `mckl::sincos` with the assembly library. For
+/// single precision, the Cephes polynomials are used for \f$|a| \le
+/// 8192\f$. Vectors with larger elements, and widths without native support,
+/// use `std::sin` and `std::cos`
+template <typename T, std::size_t W>
+inline void sincos(const SIMD<T, W> &a, SIMD<T, W> &s, SIMD<T, W> &c)
+{
+    typename SIMD<T, W>::data_type sv;
+    typename SIMD<T, W>::data_type cv;
+    internal::simd_sincos<T, W>(
+        a.data(), sv, cv, internal::SIMDOpsIsArray<T, W>());
+    s = SIMD<T, W>(sv);
+    c = SIMD<T, W>(cv);
+}
+
+/// \brief Element-wise sine
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> sin(const SIMD<T, W> &a)
+{
+    SIMD<T, W> s;
+    SIMD<T, W> c;
+    sincos(a, s, c);
+
+    return s;
+}
+
+/// \brief Element-wise cosine
+/// \ingroup Core
+template <typename T, std::size_t W>
+inline SIMD<T, W> cos(const SIMD<T, W> &a)
+{
+    SIMD<T, W> s;
+    SIMD<T, W> c;
+    sincos(a, s, c);
+
+    return c;
+}
+
+} // namespace mckl
+
+MCKL_POP_GCC_WARNING
+
+#endif // MCKL_MATH_SIMD_HPP
@@ -35,13 +35,18 @@
 #include <mckl/internal/config.h>
 
 #include <mckl/internal/assert.hpp>
+#include <mckl/math/beta.hpp>
 #include <mckl/math/constants.hpp>
 #include <mckl/math/erf.hpp>
+#include <mckl/math/gamma.hpp>
+#include <mckl/math/simd.hpp>
 
 #include <algorithm>
 #include <array>
 #include <cmath>
 #include <complex>
+#include <limits>
+#include <type_traits>
 
 #if MCKL_USE_MKL_VML
 
@@ -329,6 +334,12 @@ inline void modf(std::size_t n, const double *a, double *y, double *z)
 
 #if MCKL_USE_ASM_LIBRARY && MCKL_USE_ASM_VMF && MCKL_USE_FMA
 
+#if MCKL_USE_ASM_VMF512
+#define MCKL_MATH_VMF_ASM_VD(func) ::mckl_vd512_##func
+#else
+#define MCKL_MATH_VMF_ASM_VD(func) ::mckl_vd_##func
+#endif
+
 #define MCKL_DEFINE_MATH_VMF_ASM_1S(func)                                     \
     inline void func(std::size_t n, const float *a, float *y)                 \
     {                                                                         \
@@ -338,7 +349,7 @@ inline void modf(std::size_t n, const double *a, double *y, double *z)
 #define MCKL_DEFINE_MATH_VMF_ASM_1D(func)                                     \
     inline void func(std::size_t n, const double *a, double *y)               \
     {                                                                         \
-        ::mckl_vd_##func(n, a, y);                                            \
+        MCKL_MATH_VMF_ASM_VD(func)(n, a, y);                                  \
     }
 
 #define MCKL_DEFINE_MATH_VMF_ASM_2S(func)                                     \
@@ -380,7 +391,7 @@ MCKL_DEFINE_MATH_VMF_ASM_1D(sin)
 
 inline void sincos(std::size_t n, const double *a, double *y, double *z)
 {
-    ::mckl_vd_sincos(n, a, y, z);
+    MCKL_MATH_VMF_ASM_VD(sincos)(n, a, y, z);
 }
 
 MCKL_DEFINE_MATH_VMF_ASM_1D(tan)
@@ -1332,6 +1343,819 @@ MCKL_DEFINE_MATH_VMF_1(std::atanh, atanh)
 
 /// @} vHyperbolic
 
+namespace internal {
+
+template <typename T>
+using VMFSpecialSIMD = std::integral_constant<bool,
+    std::is_same<T, float>::value || std::is_same<T, double>::value>;
+
+static constexpr std::size_t vmf_special_block = 256;
+
+template <typename T>
+using VMFSpecialBuffer = std::array<T, vmf_special_block>;
+
+template <typename Func>
+inline void vmf_special(std::size_t n, Func &&f)
+{
+    for (std::size_t i = 0; i < n; i += vmf_special_block) {
+        f(i, std::min(vmf_special_block, n - i));
+    }
+}
+
+// A parameter of the special functions, either an array or a scalar shared by
+// all elements
+template <typename T>
+class VMFSpecialArg
+{
+  public:
+    VMFSpecialArg(const T *p) : p_(p), a_() {}
+
+    VMFSpecialArg(T a) : p_(nullptr), a_(a) {}
+
+    T operator[](std::size_t i) const { return p_ == nullptr ? a_ : p_[i]; }
+
+    // The elements i, ..., i + m - 1 in double precision, stored in buf
+    VMFSpecialArg<double> block(
+        std::size_t i, std::size_t m, double *buf) const
+    {
+        if (p_ == nullptr) {
+            return VMFSpecialArg<double>(static_cast<double>(a_));
+        }
+        std::copy_n(p_ + i, m, buf);
+
+        return VMFSpecialArg<double>(buf);
+    }
+
+    template <std::size_t W>
+    SIMD<T, W> load(std::size_t i, std::size_t m) const
+    {
+        return p_ == nullptr ? SIMD<T, W>(a_) : SIMD<T, W>::load(p_ + i, m);
+    }
+
+  private:
+    const T *p_;
+    T a_;
+}; // class VMFSpecialArg
+
+// Store the first m elements of r to y, after calling fix(j, r[j]) for each
+// lane if any of them is not in act. The inputs of the lanes are read before
+// y is written, so y may alias them
+template <typename T, std::size_t W, typename Fix>
+inline void vmf_special_store(std::size_t m, const SIMD<T, W> &r,
+    const SIMDMask<T, W> &act, T *y, Fix &&fix)
+{
+    if (m == W && all_of(act)) {
+        r.store(y);
+        return;
+    }
+
+    alignas(64) std::array<T, W> s;
+    r.store(s.data());
+    for (std::size_t j = 0; j != m; ++j) {
+        fix(j, s[j]);
+    }
+    std::copy_n(s.data(), m, y);
+}
+
+template <typename T, std::size_t W>
+inline SIMD<T, W> vmf_horner(
+    const SIMD<T, W> &x, std::size_t m, const double *c)
+{
+    SIMD<T, W> y(static_cast<T>(c[m - 1]));
+    for (std::size_t k = m - 1; k != 0; --k) {
+        y = fmadd(y, x, SIMD<T, W>(static_cast<T>(c[k - 1])));
+    }
+
+    return y;
+}
+
+template <typename T, std::size_t W>
+inline SIMDMask<T, W> vmf_gamma_valid(const SIMD<T, W> &x)
+{
+    return (x >= SIMD<T, W>(std::numeric_limits<T>::min())) &
+        (x <= SIMD<T, W>(std::numeric_limits<T>::max()));
+}
+
+template <typename T>
+inline bool vmf_gamma_valid(T x)
+{
+    return x >= std::numeric_limits<T>::min() &&
+        x <= std::numeric_limits<T>::max();
+}
+
+// lgamma(x) for positive normal x, and rubbish for other lanes
+template <typename T, std::size_t W>
+inline SIMD<T, W> vmf_lgamma_simd(const SIMD<T, W> &x)
+{
+    using simd = SIMD<T, W>;
+
+    const simd zero(static_cast<T>(0));
+    const simd one(static_cast<T>(1));
+    const simd half(static_cast<T>(0.5));
+    const simd xasy(static_cast<T>(gamma_asymptotic_min));
+    const SIMDMask<T, W> small = x < xasy;
+
+    // Reduce x < gamma_asymptotic_min to 2 + t, with u = x - 2 - t the number
+    // of recurrence steps
+    // lgamma(x) = lgamma(2 + t) + log((x - 1) ... (x - u)) for u >= 0
+    // lgamma(x) = lgamma(2 + t) - log(x ... (x - u - 1)) for u < 0
+    const simd f = floor(x + simd(static_cast<T>(0.6)));
+    const simd u = f - simd(static_cast<T>(2));
+    const simd t = x - f;
+    simd w(one);
+    for (std::size_t j = 1; j <= 8; ++j) {
+        const simd s(static_cast<T>(j));
+        w *= select(u < s, one, x - s);
+    }
+    const simd v =
+        select(u < -one, x + one, one) * select(u < zero, x, one);
+    w = ::mckl::log(select(small, w / v, x));
+    const simd r = vmf_horner(t, lgamma_series_n, lgamma_series_c) * t + w;
+
+    // Stirling series for x >= gamma_asymptotic_min
+    const simd z = one / x;
+    const simd s = (x - half) * w - x + simd(half * const_ln_pi_2<T>()) +
+        vmf_horner(z * z, lgamma_stirling_n, lgamma_stirling_c) * z;
+
+    return select(small, r, s);
+}
+
+// digamma(x) for positive normal x, and rubbish for other lanes
+template <typename T, std::size_t W>
+inline SIMD<T, W> vmf_digamma_simd(const SIMD<T, W> &x)
+{
+    using simd = SIMD<T, W>;
+
+    const simd zero(static_cast<T>(0));
+    const simd one(static_cast<T>(1));
+    const simd half(static_cast<T>(0.5));
+    const simd xasy(static_cast<T>(gamma_asymptotic_min));
+    const SIMDMask<T, W> small = x < xasy;
+
+    // digamma(x) = digamma(2 + t) + 1 / (x - 1) + ... + 1 / (x - u) for u >= 0
+    // digamma(x) = digamma(2 + t) - 1 / x - ... - 1 / (x - u - 1) for u < 0
+    // with the sum accumulated as a single fraction p / q
+    const simd f = floor(x + simd(static_cast<T>(0.6)));
+    const simd u = f - simd(static_cast<T>(2));
+    const simd t = x - f;
+    simd p(zero);
+    simd q(one);
+    for (std::size_t j = 1; j <= 8; ++j) {
+        const simd s(static_cast<T>(j));
+        const SIMDMask<T, W> k = u < s;
+        const simd d = x - s;
+        p = select(k, p, fmadd(p, d, q));
+        q = select(k, q, q * d);
+    }
+    const SIMDMask<T, W> k1 = u < zero;
+    const SIMDMask<T, W> k2 = u < -one;
+    const simd d = select(k1, x, one) * select(k2, x + one, one);
+    const simd e = select(k1, select(k2, x + one, one), zero) +
+        select(k2, x, zero);
+    p = fnmadd(e, q, p * d);
+    const simd r = vmf_horner(t, digamma_series_n, digamma_series_c) +
+        p / (q * d);
+
+    // Asymptotic series for x >= gamma_asymptotic_min
+    const simd z = one / (x * x);
+    const simd s = ::mckl::log(select(small, one, x)) - half / x -
+        z * vmf_horner(z, digamma_asymptotic_n, digamma_asymptotic_c);
+
+    return select(small, r, s);
+}
+
+template <typename T>
+inline void vmf_lgamma(std::size_t n, const T *a, T *y, std::true_type)
+{
+    constexpr std::size_t W = simd_width<T>();
+
+    for (std::size_t i = 0; i < n; i += W) {
+        const std::size_t m = std::min(W, n - i);
+        const SIMD<T, W> x = SIMD<T, W>::load(a + i, m);
+        vmf_special_store(m, vmf_lgamma_simd(x), vmf_gamma_valid(x), y + i,
+            [=](std::size_t j, T &r) {
+                if (!vmf_gamma_valid(a[i + j])) {
+                    r = std::lgamma(a[i + j]);
+                }
+            });
+    }
+}
+
+template <typename T>
+inline void vmf_lgamma(std::size_t n, const T *a, T *y, std::false_type)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        y[i] = std::lgamma(a[i]);
+    }
+}
+
+template <typename T>
+inline void vmf_digamma(std::size_t n, const T *a, T *y, std::true_type)
+{
+    constexpr std::size_t W = simd_width<T>();
+
+    for (std::size_t i = 0; i < n; i += W) {
+        const std::size_t m = std::min(W, n - i);
+        const SIMD<T, W> x = SIMD<T, W>::load(a + i, m);
+        vmf_special_store(m, vmf_digamma_simd(x), vmf_gamma_valid(x), y + i,
+            [=](std::size_t j, T &r) {
+                if (!vmf_gamma_valid(a[i + j])) {
+                    r = static_cast<T>(
+                        ::mckl::digamma(static_cast<double>(a[i + j])));
+                }
+            });
+    }
+}
+
+template <typename T>
+inline void vmf_digamma(std::size_t n, const T *a, T *y, std::false_type)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        y[i] = static_cast<T>(::mckl::digamma(static_cast<double>(a[i])));
+    }
+}
+
+// Gauss-Legendre quadrature of P(a, x) or Q(a, x) for large a, see
+// internal::gammap_approx
+template <typename T, std::size_t W>
+inline SIMD<T, W> vmf_gammap_approx_simd(const SIMD<T, W> &a,
+    const SIMD<T, W> &x, const SIMD<T, W> &gln, bool lower)
+{
+    using simd = SIMD<T, W>;
+
+    const simd zero(static_cast<T>(0));
+    const simd one(static_cast<T>(1));
+
+    const simd a1 = a - one;
+    const simd lna1 = ::mckl::log(a1);
+    const simd sqrta1 = sqrt(a1);
+    const SIMDMask<T, W> upper = x > a1;
+    const simd xu = select(upper,
+        max(fmadd(simd(static_cast<T>(11.5)), sqrta1, a1),
+            fmadd(simd(static_cast<T>(6)), sqrta1, x)),
+        max(zero,
+            min(fnmadd(simd(static_cast<T>(7.5)), sqrta1, a1),
+                fnmadd(simd(static_cast<T>(5)), sqrta1, x))));
+    const simd dx = xu - x;
+    simd sum(zero);
+    for (std::size_t i = 0; i != gammap_approx_n; ++i) {
+        const simd t = fmadd(dx, simd(static_cast<T>(gammap_approx_y[i])), x);
+        sum = fmadd(simd(static_cast<T>(gammap_approx_w[i])),
+            ::mckl::exp(a1 * (::mckl::log(t) - lna1) - (t - a1)), sum);
+    }
+    const simd r = sum * dx * ::mckl::exp(a1 * (lna1 - one) - gln);
+
+    return lower ? select(upper, one - r, -r) : select(upper, r, one + r);
+}
+
+// Regularized incomplete Gamma function of the lanes in act, using the series
+// of P(a, x) for x < a + 1 and the continued fraction of Q(a, x) otherwise,
+// and the quadrature for a > 100, with gln = lgamma(a)
+template <typename T, std::size_t W>
+inline SIMD<T, W> vmf_gammapq_simd(const SIMD<T, W> &a, const SIMD<T, W> &x,
+    const SIMD<T, W> &gln, const SIMDMask<T, W> &act, bool lower)
+{
+    using simd = SIMD<T, W>;
+
+    const T eps = std::numeric_limits<T>::epsilon();
+    const simd fpmin(std::numeric_limits<T>::min() / eps);
+    const simd zero(static_cast<T>(0));
+    const simd one(static_cast<T>(1));
+
+    const SIMDMask<T, W> large = a > simd(static_cast<T>(100));
+    const SIMDMask<T, W> lower_x = x < a + one;
+    const SIMDMask<T, W> app = act & large;
+    const SIMDMask<T, W> ser = act & ~large & lower_x;
+    const SIMDMask<T, W> cf = act & ~large & ~lower_x;
+
+    simd r(zero);
+    if (any_of(app)) {
+        r = vmf_gammap_approx_simd(a, x, gln, lower);
+    }
+    if (none_of(ser | cf)) {
+        return r;
+    }
+
+    // exp(-x + a * log(x) - lgamma(a))
+    const simd pf =
+        ::mckl::exp(a * ::mckl::log(select(act, x, one)) - x - gln);
+
+    // Two terms of the series for each division
+    if (any_of(ser)) {
+        const simd two(static_cast<T>(2));
+        simd ap(a);
+        simd del(one / a);
+        simd sum(del);
+        SIMDMask<T, W> m(ser);
+        for (int k = 0; k != 5000 && any_of(m); ++k) {
+            const simd a2 = ap + two;
+            const simd r = del * x / ((ap + one) * a2);
+            ap = a2;
+            del = r * x;
+            sum = select(m, sum + fmadd(r, a2, del), sum);
+            m = m & (abs(del) >= abs(sum) * simd(eps));
+        }
+        const simd p = sum * pf;
+        r = select(ser, lower ? p : one - p, r);
+    }
+
+    if (any_of(cf)) {
+        simd b(x + one - a);
+        simd c(one / fpmin);
+        simd d(one / b);
+        simd h(d);
+        simd k(zero);
+        SIMDMask<T, W> m(cf);
+        for (int i = 0; i != 10000 && any_of(m); ++i) {
+            k += one;
+            const simd an = k * (a - k);
+            b += simd(static_cast<T>(2));
+            d = fmadd(an, d, b);
+            d = select(abs(d) < fpmin, fpmin, d);
+            c = b + an / c;
+            c = select(abs(c) < fpmin, fpmin, c);
+            d = one / d;
+            const simd del = d * c;
+            h = select(m, h * del, h);
+            m = m & (abs(del - one) > simd(eps));
+        }
+        const simd q = h * pf;
+        r = select(cf, lower ? one - q : q, r);
+    }
+
+    return r;
+}
+
+// The scalar functions do not terminate for NaN arguments or infinite x
+template <typename T>
+inline T vmf_gammapq_scalar(T a, T x, bool lower)
+{
+    if (std::isnan(a) || std::isnan(x)) {
+        return const_nan<T>();
+    }
+    if (a > 0 && x > std::numeric_limits<T>::max()) {
+        return static_cast<T>(lower ? 1 : 0);
+    }
+
+    const double ad = static_cast<double>(a);
+    const double xd = static_cast<double>(x);
+
+    return static_cast<T>(
+        lower ? ::mckl::gammap(ad, xd) : ::mckl::gammaq(ad, xd));
+}
+
+template <typename T>
+inline T vmf_gammapinv_scalar(T a, T p)
+{
+    if (std::isnan(a) || std::isnan(p)) {
+        return const_nan<T>();
+    }
+
+    return static_cast<T>(
+        ::mckl::gammapinv(static_cast<double>(a), static_cast<double>(p)));
+}
+
+template <typename T>
+inline void vmf_gammapq(std::size_t n, VMFSpecialArg<T> a, const T *x, T *y,
+    bool lower, std::true_type)
+{
+    constexpr std::size_t W = simd_width<T>();
+
+    using simd = SIMD<T, W>;
+
+    const simd zero(static_cast<T>(0));
+    const simd xmax(std::numeric_limits<T>::max());
+    for (std::size_t i = 0; i < n; i += W) {
+        const std::size_t m = std::min(W, n - i);
+        const simd av = a.template load<W>(i, m);
+        const simd xv = simd::load(x + i, m);
+        const SIMDMask<T, W> act =
+            vmf_gamma_valid(av) & (xv > zero) & (xv <= xmax);
+        simd r(zero);
+        if (any_of(act)) {
+            r = vmf_gammapq_simd(av, xv, vmf_lgamma_simd(av), act, lower);
+        }
+        vmf_special_store(m, r, act, y + i, [=](std::size_t j, T &s) {
+            const T aj = a[i + j];
+            const T xj = x[i + j];
+            if (!(vmf_gamma_valid(aj) && xj > 0 &&
+                    xj <= std::numeric_limits<T>::max())) {
+                s = vmf_gammapq_scalar(aj, xj, lower);
+            }
+        });
+    }
+}
+
+template <typename T>
+inline void vmf_gammapq(std::size_t n, VMFSpecialArg<T> a, const T *x, T *y,
+    bool lower, std::false_type)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        y[i] = vmf_gammapq_scalar(a[i], x[i], lower);
+    }
+}
+
+// Single precision is computed in double precision, as the prefactors of
+// large arguments lose too many digits otherwise
+inline void vmf_gammapq(std::size_t n, VMFSpecialArg<float> a,
+    const float *x, float *y, bool lower, std::true_type)
+{
+    vmf_special(n, [=](std::size_t i, std::size_t m) {
+        VMFSpecialBuffer<double> ab;
+        VMFSpecialBuffer<double> xb;
+        std::copy_n(x + i, m, xb.data());
+        vmf_gammapq<double>(m, a.block(i, m, ab.data()), xb.data(),
+            xb.data(), lower, std::true_type());
+        std::copy_n(xb.data(), m, y + i);
+    });
+}
+
+// Rational approximation of the standard Normal quantile, see
+// internal::gammapinv_init
+template <typename T, std::size_t W>
+inline SIMD<T, W> vmf_special_norminv_simd(const SIMD<T, W> &p)
+{
+    using simd = SIMD<T, W>;
+
+    const simd one(static_cast<T>(1));
+    const simd half(static_cast<T>(0.5));
+
+    const simd z = min(p, one - p);
+    const simd t = sqrt(simd(static_cast<T>(-2)) * ::mckl::log(z));
+    const simd x = (simd(static_cast<T>(2.30753)) +
+                       t * simd(static_cast<T>(0.27061))) /
+            (one +
+                t *
+                    (simd(static_cast<T>(0.99229)) +
+                        t * simd(static_cast<T>(0.04481)))) -
+        t;
+
+    return select(p < half, -x, x);
+}
+
+// Initial value of gammapinv, see internal::gammapinv_init
+template <typename T, std::size_t W>
+inline SIMD<T, W> vmf_gammapinv_init_simd(
+    const SIMD<T, W> &a, const SIMD<T, W> &p)
+{
+    using simd = SIMD<T, W>;
+
+    const simd one(static_cast<T>(1));
+
+    const simd x = vmf_special_norminv_simd(p);
+    simd u = one - one / (simd(static_cast<T>(9)) * a) -
+        x / (simd(static_cast<T>(3)) * sqrt(a));
+    u = max(simd(static_cast<T>(1e-3)), a * u * u * u);
+
+    const simd s = one - a * (simd(static_cast<T>(0.253)) +
+                                 a * simd(static_cast<T>(0.12)));
+    const simd v = select(p < s, ::mckl::exp(::mckl::log(p / s) / a),
+        one - ::mckl::log(one - (p - s) / (one - s)));
+
+    return select(a > one, u, v);
+}
+
+template <typename T>
+inline void vmf_gammapinv(
+    std::size_t n, VMFSpecialArg<T> a, const T *p, T *y, std::true_type)
+{
+    constexpr std::size_t W = simd_width<T>();
+
+    using simd = SIMD<T, W>;
+
+    const simd eps(std::max(
+        static_cast<T>(1e-8), 4 * std::numeric_limits<T>::epsilon()));
+    const simd zero(static_cast<T>(0));
+    const simd half(static_cast<T>(0.5));
+    const simd one(static_cast<T>(1));
+    for (std::size_t i = 0; i < n; i += W) {
+        const std::size_t m = std::min(W, n - i);
+        const simd av = a.template load<W>(i, m);
+        const simd pv = simd::load(p + i, m);
+        const SIMDMask<T, W> valid =
+            vmf_gamma_valid(av) & (pv > zero) & (pv < one);
+        simd x(zero);
+        if (any_of(valid)) {
+            const simd gln = vmf_lgamma_simd(av);
+            const simd a1 = av - one;
+            const SIMDMask<T, W> large = av > one;
+            const simd lna1 = ::mckl::log(select(large, a1, one));
+            const simd afrac =
+                select(large, ::mckl::exp(a1 * (lna1 - one) - gln), one);
+            SIMDMask<T, W> act(valid);
+            x = vmf_gammapinv_init_simd(av, pv);
+            for (int k = 0; k != 12; ++k) {
+                x = select(x > zero, x, zero);
+                act = act & (x > zero);
+                if (none_of(act)) {
+                    break;
+                }
+
+                const simd err =
+                    vmf_gammapq_simd(av, x, gln, act, true) - pv;
+                const simd lx = ::mckl::log(select(act, x, one));
+                const simd e = select(
+                    large, a1 * (lx - lna1) - (x - a1), a1 * lx - x - gln);
+                const simd u = err / (afrac * ::mckl::exp(e));
+                const simd t =
+                    u / (one - half * min(one, u * (a1 / x - one)));
+                simd z = x - t;
+                z = select(z <= zero, half * (z + t), z);
+                x = select(act, z, x);
+                act = act & (abs(t) >= eps * z);
+            }
+        }
+        vmf_special_store(m, x, valid, y + i, [=](std::size_t j, T &s) {
+            const T aj = a[i + j];
+            const T pj = p[i + j];
+            if (!(vmf_gamma_valid(aj) && pj > 0 && pj < 1)) {
+                s = vmf_gammapinv_scalar(aj, pj);
+            }
+        });
+    }
+}
+
+template <typename T>
+inline void vmf_gammapinv(
+    std::size_t n, VMFSpecialArg<T> a, const T *p, T *y, std::false_type)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        y[i] = vmf_gammapinv_scalar(a[i], p[i]);
+    }
+}
+
+inline void vmf_gammapinv(std::size_t n, VMFSpecialArg<float> a,
+    const float *p, float *y, std::true_type)
+{
+    vmf_special(n, [=](std::size_t i, std::size_t m) {
+        VMFSpecialBuffer<double> ab;
+        VMFSpecialBuffer<double> pb;
+        std::copy_n(p + i, m, pb.data());
+        vmf_gammapinv<double>(m, a.block(i, m, ab.data()), pb.data(),
+            pb.data(), std::true_type());
+        std::copy_n(pb.data(), m, y + i);
+    });
+}
+
+// Regularized incomplete Beta function of the lanes in act, using the
+// continued fraction of I_x(a, b), or of I_{1 - x}(b, a) if x is above the
+// mean, with lbeta = lgamma(a + b) - lgamma(a) - lgamma(b)
+template <typename T, std::size_t W>
+inline SIMD<T, W> vmf_betai_simd(const SIMD<T, W> &a, const SIMD<T, W> &b,
+    const SIMD<T, W> &x, const SIMD<T, W> &lbeta, const SIMDMask<T, W> &act)
+{
+    using simd = SIMD<T, W>;
+
+    const T eps = std::numeric_limits<T>::epsilon();
+    const simd fpmin(std::numeric_limits<T>::min() / eps);
+    const simd one(static_cast<T>(1));
+    const simd two(static_cast<T>(2));
+    const simd half(static_cast<T>(0.5));
+
+    // exp(lbeta + a * log(x) + b * log(1 - x))
+    const simd xa = select(act, x, half);
+    const simd bt = ::mckl::exp(
+        lbeta + a * ::mckl::log(xa) + b * ::mckl::log(one - xa));
+
+    const SIMDMask<T, W> swap = ~(x < (a + one) / (a + b + two));
+    const simd as = select(swap, b, a);
+    const simd bs = select(swap, a, b);
+    const simd xs = select(swap, one - x, x);
+
+    const simd qab = as + bs;
+    const simd qap = as + one;
+    const simd qam = as - one;
+    simd c(one);
+    simd d = one - qab * xs / qap;
+    d = select(abs(d) < fpmin, fpmin, d);
+    d = one / d;
+    simd h(d);
+    simd k(static_cast<T>(0));
+    SIMDMask<T, W> m(act);
+    for (int i = 0; i != 10000 && any_of(m); ++i) {
+        k += one;
+        const simd k2 = two * k;
+        simd aa = k * (bs - k) * xs / ((qam + k2) * (as + k2));
+        d = fmadd(aa, d, one);
+        d = select(abs(d) < fpmin, fpmin, d);
+        c = one + aa / c;
+        c = select(abs(c) < fpmin, fpmin, c);
+        d = one / d;
+        h = select(m, h * d * c, h);
+        aa = -(as + k) * (qab + k) * xs / ((as + k2) * (qap + k2));
+        d = fmadd(aa, d, one);
+        d = select(abs(d) < fpmin, fpmin, d);
+        c = one + aa / c;
+        c = select(abs(c) < fpmin, fpmin, c);
+        d = one / d;
+        const simd del = d * c;
+        h = select(m, h * del, h);
+        m = m & (abs(del - one) > simd(eps));
+    }
+    const simd s = bt * h / as;
+
+    return select(swap, one - s, s);
+}
+
+// Lanes with a, b > 3000, or x on the boundary or out of the domain, are left
+// to the scalar function
+template <typename T, std::size_t W>
+inline SIMDMask<T, W> vmf_betai_valid(
+    const SIMD<T, W> &a, const SIMD<T, W> &b, const SIMD<T, W> &x)
+{
+    const SIMD<T, W> zero(static_cast<T>(0));
+    const SIMD<T, W> one(static_cast<T>(1));
+    const SIMD<T, W> amax(static_cast<T>(3000));
+
+    return vmf_gamma_valid(a) & vmf_gamma_valid(b) & (x > zero) &
+        (x < one) & ~((a > amax) & (b > amax));
+}
+
+template <typename T>
+inline bool vmf_betai_valid(T a, T b, T x)
+{
+    return vmf_gamma_valid(a) && vmf_gamma_valid(b) && x > 0 && x < 1 &&
+        !(a > 3000 && b > 3000);
+}
+
+// lgamma(a + b) - lgamma(a) - lgamma(b)
+template <typename T, std::size_t W>
+inline SIMD<T, W> vmf_lbeta_simd(const SIMD<T, W> &a, const SIMD<T, W> &b)
+{
+    return vmf_lgamma_simd(a + b) - vmf_lgamma_simd(a) - vmf_lgamma_simd(b);
+}
+
+template <typename T>
+inline void vmf_betai(std::size_t n, VMFSpecialArg<T> a, VMFSpecialArg<T> b,
+    const T *x, T *y, std::true_type)
+{
+    constexpr std::size_t W = simd_width<T>();
+
+    using simd = SIMD<T, W>;
+
+    for (std::size_t i = 0; i < n; i += W) {
+        const std::size_t m = std::min(W, n - i);
+        const simd av = a.template load<W>(i, m);
+        const simd bv = b.template load<W>(i, m);
+        const simd xv = simd::load(x + i, m);
+        const SIMDMask<T, W> act = vmf_betai_valid(av, bv, xv);
+        simd r(static_cast<T>(0));
+        if (any_of(act)) {
+            r = vmf_betai_simd(av, bv, xv, vmf_lbeta_simd(av, bv), act);
+        }
+        vmf_special_store(m, r, act, y + i, [=](std::size_t j, T &s) {
+            const T aj = a[i + j];
+            const T bj = b[i + j];
+            const T xj = x[i + j];
+            if (!vmf_betai_valid(aj, bj, xj)) {
+                s = static_cast<T>(::mckl::betai(static_cast<double>(aj),
+                    static_cast<double>(bj), static_cast<double>(xj)));
+            }
+        });
+    }
+}
+
+template <typename T>
+inline void vmf_betai(std::size_t n, VMFSpecialArg<T> a, VMFSpecialArg<T> b,
+    const T *x, T *y, std::false_type)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        y[i] = static_cast<T>(::mckl::betai(static_cast<double>(a[i]),
+            static_cast<double>(b[i]), static_cast<double>(x[i])));
+    }
+}
+
+inline void vmf_betai(std::size_t n, VMFSpecialArg<float> a,
+    VMFSpecialArg<float> b, const float *x, float *y, std::true_type)
+{
+    vmf_special(n, [=](std::size_t i, std::size_t m) {
+        VMFSpecialBuffer<double> ab;
+        VMFSpecialBuffer<double> bb;
+        VMFSpecialBuffer<double> xb;
+        std::copy_n(x + i, m, xb.data());
+        vmf_betai<double>(m, a.block(i, m, ab.data()),
+            b.block(i, m, bb.data()), xb.data(), xb.data(), std::true_type());
+        std::copy_n(xb.data(), m, y + i);
+    });
+}
+
+// Initial value of betaiinv, see internal::betaiinv_init
+template <typename T, std::size_t W>
+inline SIMD<T, W> vmf_betaiinv_init_simd(
+    const SIMD<T, W> &a, const SIMD<T, W> &b, const SIMD<T, W> &p)
+{
+    using simd = SIMD<T, W>;
+
+    const simd one(static_cast<T>(1));
+    const simd two(static_cast<T>(2));
+
+    const simd x = vmf_special_norminv_simd(p);
+    const simd al =
+        (x * x - simd(static_cast<T>(3))) / simd(static_cast<T>(6));
+    const simd ra = one / (two * a - one);
+    const simd rb = one / (two * b - one);
+    const simd h = two / (ra + rb);
+    const simd w = x * sqrt(al + h) / h -
+        (rb - ra) * (al - two / (simd(static_cast<T>(3)) * h));
+    const simd u = a / (a + b * ::mckl::exp(two * w));
+
+    const simd ab = a + b;
+    const simd s = ::mckl::exp(a * ::mckl::log(a / ab)) / a;
+    const simd r = ::mckl::exp(b * ::mckl::log(b / ab)) / b;
+    const simd sr = s + r;
+    const simd v = select(p < s / sr,
+        ::mckl::exp(::mckl::log(a * sr * p) / a),
+        one - ::mckl::exp(::mckl::log(b * sr * (one - p)) / b));
+
+    return select((a >= one) & (b >= one), u, v);
+}
+
+template <typename T>
+inline void vmf_betaiinv(std::size_t n, VMFSpecialArg<T> a,
+    VMFSpecialArg<T> b, const T *p, T *y, std::true_type)
+{
+    constexpr std::size_t W = simd_width<T>();
+
+    using simd = SIMD<T, W>;
+
+    const simd eps(std::max(
+        static_cast<T>(1e-8), 4 * std::numeric_limits<T>::epsilon()));
+    const simd zero(static_cast<T>(0));
+    const simd half(static_cast<T>(0.5));
+    const simd one(static_cast<T>(1));
+    for (std::size_t i = 0; i < n; i += W) {
+        const std::size_t m = std::min(W, n - i);
+        const simd av = a.template load<W>(i, m);
+        const simd bv = b.template load<W>(i, m);
+        const simd pv = simd::load(p + i, m);
+        const SIMDMask<T, W> valid = vmf_betai_valid(av, bv, pv);
+        simd x(zero);
+        if (any_of(valid)) {
+            const simd lbeta = vmf_lbeta_simd(av, bv);
+            const simd a1 = av - one;
+            const simd b1 = bv - one;
+            SIMDMask<T, W> act(valid);
+            x = vmf_betaiinv_init_simd(av, bv, pv);
+            for (int k = 0; k != 100; ++k) {
+                act = act & (x > zero) & (x < one);
+                if (none_of(act)) {
+                    break;
+                }
+
+                const simd err = vmf_betai_simd(av, bv, x, lbeta, act) - pv;
+                const simd xa = select(act, x, half);
+                const simd u = err /
+                    ::mckl::exp(a1 * ::mckl::log(xa) +
+                        b1 * ::mckl::log(one - xa) + lbeta);
+                const simd t = u /
+                    (one - half * min(one, u * (a1 / xa - b1 / (one - xa))));
+                simd z = x - t;
+                z = select(z <= zero, half * (z + t), z);
+                z = select(z >= one, half * (z + t + one), z);
+                x = select(act, z, x);
+                if (k != 0) {
+                    act = act & (abs(t) >= eps * z);
+                }
+            }
+        }
+        vmf_special_store(m, x, valid, y + i, [=](std::size_t j, T &s) {
+            const T aj = a[i + j];
+            const T bj = b[i + j];
+            const T pj = p[i + j];
+            if (!vmf_betai_valid(aj, bj, pj)) {
+                s = static_cast<T>(::mckl::betaiinv(static_cast<double>(aj),
+                    static_cast<double>(bj), static_cast<double>(pj)));
+            }
+        });
+    }
+}
+
+template <typename T>
+inline void vmf_betaiinv(std::size_t n, VMFSpecialArg<T> a,
+    VMFSpecialArg<T> b, const T *p, T *y, std::false_type)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        y[i] = static_cast<T>(::mckl::betaiinv(static_cast<double>(a[i]),
+            static_cast<double>(b[i]), static_cast<double>(p[i])));
+    }
+}
+
+inline void vmf_betaiinv(std::size_t n, VMFSpecialArg<float> a,
+    VMFSpecialArg<float> b, const float *p, float *y, std::true_type)
+{
+    vmf_special(n, [=](std::size_t i, std::size_t m) {
+        VMFSpecialBuffer<double> ab;
+        VMFSpecialBuffer<double> bb;
+        VMFSpecialBuffer<double> pb;
+        std::copy_n(p + i, m, pb.data());
+        vmf_betaiinv<double>(m, a.block(i, m, ab.data()),
+            b.block(i, m, bb.data()), pb.data(), pb.data(), std::true_type());
+        std::copy_n(pb.data(), m, y + i);
+    });
+}
+
+} // namespace internal
+
 /// \defgroup vSpecial Special functions
 /// \ingroup VMF
 /// @{
@@ -1387,11 +2211,113 @@ inline void cdfnorminv(std::size_t n, const T *a, T *y)
 }
 
 /// \brief For \f$i=1,\ldots,n\f$, compute \f$y_i = \ln\Gamma(a_i)\f$
-MCKL_DEFINE_MATH_VMF_1(std::lgamma, lgamma)
+template <typename T>
+inline void lgamma(std::size_t n, const T *a, T *y)
+{
+    internal::vmf_lgamma(n, a, y, internal::VMFSpecialSIMD<T>());
+}
 
 /// \brief For \f$i=1,\ldots,n\f$, compute \f$y_i = \Gamma(a_i)\f$
 MCKL_DEFINE_MATH_VMF_1(std::tgamma, tgamma)
 
+/// \brief For \f$i=1,\ldots,n\f$, compute
+/// \f$y_i = \psi(a_i) = \Gamma'(a_i) / \Gamma(a_i)\f$
+template <typename T>
+inline void digamma(std::size_t n, const T *a, T *y)
+{
+    internal::vmf_digamma(n, a, y, internal::VMFSpecialSIMD<T>());
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute the regularized lower incomplete
+/// Gamma function \f$y_i = P(a_i, x_i)\f$
+template <typename T>
+inline void gammap(std::size_t n, const T *a, const T *x, T *y)
+{
+    internal::vmf_gammapq(n, internal::VMFSpecialArg<T>(a), x, y, true,
+        internal::VMFSpecialSIMD<T>());
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute the regularized lower incomplete
+/// Gamma function \f$y_i = P(a, x_i)\f$
+template <typename T>
+inline void gammap(std::size_t n, T a, const T *x, T *y)
+{
+    internal::vmf_gammapq(n, internal::VMFSpecialArg<T>(a), x, y, true,
+        internal::VMFSpecialSIMD<T>());
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute the regularized upper incomplete
+/// Gamma function \f$y_i = Q(a_i, x_i) = 1 - P(a_i, x_i)\f$
+template <typename T>
+inline void gammaq(std::size_t n, const T *a, const T *x, T *y)
+{
+    internal::vmf_gammapq(n, internal::VMFSpecialArg<T>(a), x, y, false,
+        internal::VMFSpecialSIMD<T>());
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute the regularized upper incomplete
+/// Gamma function \f$y_i = Q(a, x_i) = 1 - P(a, x_i)\f$
+template <typename T>
+inline void gammaq(std::size_t n, T a, const T *x, T *y)
+{
+    internal::vmf_gammapq(n, internal::VMFSpecialArg<T>(a), x, y, false,
+        internal::VMFSpecialSIMD<T>());
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute \f$y_i = P^{-1}(a_i, p_i)\f$, the
+/// inverse of the regularized lower incomplete Gamma function
+template <typename T>
+inline void gammapinv(std::size_t n, const T *a, const T *p, T *y)
+{
+    internal::vmf_gammapinv(n, internal::VMFSpecialArg<T>(a), p, y,
+        internal::VMFSpecialSIMD<T>());
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute \f$y_i = P^{-1}(a, p_i)\f$, the
+/// inverse of the regularized lower incomplete Gamma function
+template <typename T>
+inline void gammapinv(std::size_t n, T a, const T *p, T *y)
+{
+    internal::vmf_gammapinv(n, internal::VMFSpecialArg<T>(a), p, y,
+        internal::VMFSpecialSIMD<T>());
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute the regularized incomplete Beta
+/// function \f$y_i = I_{x_i}(a_i, b_i)\f$
+template <typename T>
+inline void betai(std::size_t n, const T *a, const T *b, const T *x, T *y)
+{
+    internal::vmf_betai(n, internal::VMFSpecialArg<T>(a),
+        internal::VMFSpecialArg<T>(b), x, y, internal::VMFSpecialSIMD<T>());
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute the regularized incomplete Beta
+/// function \f$y_i = I_{x_i}(a, b)\f$
+template <typename T>
+inline void betai(std::size_t n, T a, T b, const T *x, T *y)
+{
+    internal::vmf_betai(n, internal::VMFSpecialArg<T>(a),
+        internal::VMFSpecialArg<T>(b), x, y, internal::VMFSpecialSIMD<T>());
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute \f$y_i = I^{-1}_{p_i}(a_i, b_i)\f$,
+/// the inverse of the regularized incomplete Beta function
+template <typename T>
+inline void betaiinv(std::size_t n, const T *a, const T *b, const T *p, T *y)
+{
+    internal::vmf_betaiinv(n, internal::VMFSpecialArg<T>(a),
+        internal::VMFSpecialArg<T>(b), p, y, internal::VMFSpecialSIMD<T>());
+}
+
+/// \brief For \f$i=1,\ldots,n\f$, compute \f$y_i = I^{-1}_{p_i}(a, b)\f$, the
+/// inverse of the regularized incomplete Beta function
+template <typename T>
+inline void betaiinv(std::size_t n, T a, T b, const T *p, T *y)
+{
+    internal::vmf_betaiinv(n, internal::VMFSpecialArg<T>(a),
+        internal::VMFSpecialArg<T>(b), p, y, internal::VMFSpecialSIMD<T>());
+}
+
 /// @} vSpecial
 
 /// \defgroup vRounding Rounding functions
@@ -52,6 +52,9 @@ void mckl_vs_sqrt(size_t, const float *, float *);
 // sqrt.asm
 void mckl_vd_sqrt(size_t, const double *, double *);
 
+// sqrt512.asm
+void mckl_vd512_sqrt(size_t, const double *, double *);
+
 // expf.asm
 void mckl_vs_exp(size_t, const float *, float *);
 void mckl_vs_exp2(size_t, const float *, float *);
@@ -62,6 +65,11 @@ void mckl_vd_exp(size_t, const double *, double *);
 void mckl_vd_exp2(size_t, const double *, double *);
 void mckl_vd_expm1(size_t, const double *, double *);
 
+// exp512.asm
+void mckl_vd512_exp(size_t, const double *, double *);
+void mckl_vd512_exp2(size_t, const double *, double *);
+void mckl_vd512_expm1(size_t, const double *, double *);
+
 // logf.asm
 void mckl_vs_log(size_t, const float *, float *);
 void mckl_vs_log2(size_t, const float *, float *);
@@ -74,6 +82,12 @@ void mckl_vd_log2(size_t, const double *, double *);
 void mckl_vd_log10(size_t, const double *, double *);
 void mckl_vd_log1p(size_t, const double *, double *);
 
+// log512.asm
+void mckl_vd512_log(size_t, const double *, double *);
+void mckl_vd512_log2(size_t, const double *, double *);
+void mckl_vd512_log10(size_t, const double *, double *);
+void mckl_vd512_log1p(size_t, const double *, double *);
+
 // sincosf.asm
 void mckl_vs_sin(size_t, const float *, float *);
 void mckl_vs_cos(size_t, const float *, float *);
@@ -86,6 +100,12 @@ void mckl_vd_cos(size_t, const double *, double *);
 void mckl_vd_sincos(size_t, const double *, double *, double *);
 void mckl_vd_tan(size_t, const double *, double *);
 
+// sincos512.asm
+void mckl_vd512_sin(size_t, const double *, double *);
+void mckl_vd512_cos(size_t, const double *, double *);
+void mckl_vd512_sincos(size_t, const double *, double *, double *);
+void mckl_vd512_tan(size_t, const double *, double *);
+
 // fma.asm
 void mckl_fmadd_vvv_ps(
     size_t, const float *, const float *, const float *, float *);
@@ -44,6 +44,10 @@
 /// \defgroup Core Core
 /// \brief Constructing samplers with operations on the whole particle set
 
+/// \defgroup Checkpoint Checkpoint
+/// \ingroup Core
+/// \brief Binary checkpoint and restart of samplers
+
 /// \defgroup Algorithm Algorithm
 /// \brief Algorithm
 
@@ -116,6 +120,18 @@
 /// \ingroup Random
 /// \brief Random number generating using Random123 Threefry algorithm
 
+/// \defgroup Xoshiro Xoshiro
+/// \ingroup Random
+/// \brief Random number generating using xoshiro256++ algorithm
+
+/// \defgroup PCG PCG
+/// \ingroup Random
+/// \brief Random number generating using PCG64 algorithm
+
+/// \defgroup QMC Quasi-random
+/// \ingroup Random
+/// \brief Low discrepancy sequences using Sobol and Halton algorithms
+
 /// \defgroup MKL Intel Math Kernel Library
 /// \ingroup Random
 /// \brief Random number generating using MKL
@@ -154,6 +170,10 @@
 /// \defgroup Utility Utility
 /// \brief Utilities
 
+/// \defgroup Benchmark Benchmark
+/// \ingroup Utility
+/// \brief Micro-benchmark harness
+
 /// \defgroup Covariance Covariance
 /// \ingroup Utility
 /// \brief Covariance matrix estimation
@@ -56,11 +56,59 @@ inline void arcsine_distribution_impl(
     muladd(n, r, b - a, a, r);
 }
 
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void arcsine_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType y = (x[i] - distribution_param(a, i)) *
+            (distribution_param(b, i) - x[i]);
+        r[i] = y > 0 ? y : 0;
+    }
+    log(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType v =
+            -const_ln_pi<RealType>() - static_cast<RealType>(0.5) * r[i];
+        const bool in = x[i] > distribution_param(a, i) &&
+            x[i] < distribution_param(b, i);
+        r[i] = in ? v : -const_inf<RealType>();
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void arcsine_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType c = distribution_param(a, i);
+        const RealType y = (x[i] - c) / (distribution_param(b, i) - c);
+        r[i] = std::min(std::max(y, const_zero<RealType>()),
+            const_one<RealType>());
+    }
+    sqrt(n, r, r);
+    asinpi(n, r, r);
+    mul(n, static_cast<RealType>(2), r, r);
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void arcsine_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    mul(n, static_cast<RealType>(0.5), x, r);
+    sinpi(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType c = distribution_param(a, i);
+        r[i] = c + (distribution_param(b, i) - c) * r[i] * r[i];
+    }
+}
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     Arcsine, arcsine, RealType, RealType, a, RealType, b)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(Arcsine, arcsine, RealType, a, b)
+
 /// \brief Arcsine distribution
 /// \ingroup Distribution
 template <typename RealType>
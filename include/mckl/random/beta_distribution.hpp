@@ -366,6 +366,50 @@ inline std::size_t beta_distribution_impl(RNGType &rng, std::size_t n,
     return 0;
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void beta_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 alpha, P2 beta)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> u;
+    distribution_param_lbeta(n, alpha, beta, s.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] > 0 && x[i] < 1 ? x[i] : static_cast<RealType>(0.5);
+        u[i] = -t[i];
+    }
+    log(n, t.data(), t.data());
+    log1p(n, u.data(), u.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType a = distribution_param(alpha, i);
+        const RealType b = distribution_param(beta, i);
+        const RealType v = distribution_logpdf_power(a, x[i], t[i]) +
+            distribution_logpdf_power(b, 1 - x[i], u[i]) - s[i];
+        r[i] = x[i] < 0 || x[i] > 1 ? -const_inf<RealType>() : v;
+    }
+}
+
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void beta_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 alpha, P2 beta)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = std::min(std::max(x[i], const_zero<RealType>()),
+            const_one<RealType>());
+    }
+    betai(n, alpha, beta, t.data(), r);
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void beta_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 alpha, P2 beta)
+{
+    betaiinv(n, alpha, beta, x, r);
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 template <typename RealType, typename RNGType>
@@ -402,6 +446,8 @@ inline void beta_distribution(RNGType &rng, std::size_t n, RealType *r,
     beta_distribution(rng, n, r, param.alpha(), param.beta());
 }
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(Beta, beta, RealType, alpha, beta)
+
 /// \brief Beta distribution
 /// \ingroup Distribution
 template <typename RealType>
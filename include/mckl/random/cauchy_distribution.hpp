@@ -56,11 +56,54 @@ inline void cauchy_distribution_impl(
     muladd(n, r, b, a, r);
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void cauchy_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    distribution_param_log(n, b, s.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType z =
+            (x[i] - distribution_param(a, i)) / distribution_param(b, i);
+        r[i] = z * z;
+    }
+    log1p(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -const_ln_pi<RealType>() - s[i] - r[i];
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void cauchy_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = (x[i] - distribution_param(a, i)) / distribution_param(b, i);
+    }
+    atanpi(n, r, r);
+    add(n, r, static_cast<RealType>(0.5), r);
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void cauchy_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    sub(n, x, static_cast<RealType>(0.5), r);
+    tanpi(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = distribution_param(a, i) + distribution_param(b, i) * r[i];
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     Cauchy, cauchy, RealType, RealType, a, RealType, b)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(Cauchy, cauchy, RealType, a, b)
+
 /// \brief Cauchy distribution
 /// \ingroup Distribution
 template <typename RealType>
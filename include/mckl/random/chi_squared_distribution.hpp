@@ -45,6 +45,41 @@ inline bool chi_squared_distribution_check_param(RealType n)
     return n > 0;
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1>
+inline void chi_squared_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 df)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> a;
+    gamma_logpdf_impl<K>(n, x, r,
+        distribution_param_mul(
+            n, df, a.data(), static_cast<RealType>(0.5)),
+        static_cast<RealType>(2));
+}
+
+template <std::size_t K, typename RealType, typename P1>
+inline void chi_squared_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 df)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> a;
+    gamma_cdf_impl<K>(n, x, r,
+        distribution_param_mul(
+            n, df, a.data(), static_cast<RealType>(0.5)),
+        static_cast<RealType>(2));
+}
+
+template <std::size_t K, typename RealType, typename P1>
+inline void chi_squared_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 df)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> a;
+    gamma_quantile_impl<K>(n, x, r,
+        distribution_param_mul(
+            n, df, a.data(), static_cast<RealType>(0.5)),
+        static_cast<RealType>(2));
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 template <typename RealType, typename RNGType>
@@ -61,6 +96,9 @@ inline void chi_squared_distribution(RNGType &rng, std::size_t n, RealType *r,
     chi_squared_distribution(rng, n, r, param.n());
 }
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_1(
+    ChiSquared, chi_squared, RealType, n)
+
 /// \brief The \f$\chi^2\f$ distribution
 /// \ingroup Distribution
 template <typename RealType>
@@ -46,11 +46,25 @@ class ChiSquaredTest
 
     bool pass(double alpha, result_type s) const
     {
-        double p = cdf(s);
+        double p = pvalue(s);
 
         return std::min(p, 1 - p) > 0.5 * alpha;
     }
 
+    /// \brief The probability that the sum of `m` independent statistics is
+    /// less than or equal to `s`
+    ///
+    /// \details
+    /// The sum of \f$m\f$ independent \f$\chi^2\f$ statistics with \f$k\f$
+    /// degrees of freedom has the \f$\chi^2\f$-distribution with \f$mk\f$
+    /// degrees of freedom. Values close to zero or one indicate a failure.
+    double pvalue(result_type s, std::size_t m = 1) const
+    {
+        return gammap(0.5 * static_cast<double>(m) *
+                static_cast<const Derived *>(this)->degree_of_freedom(),
+            0.5 * s);
+    }
+
     double pdf(result_type s) const
     {
         double k =
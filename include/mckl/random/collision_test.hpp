@@ -34,10 +34,95 @@
 
 #include <mckl/random/internal/common.hpp>
 #include <mckl/random/poisson_test.hpp>
-#include <bitset>
+#include <mckl/smp.hpp>
+#include <atomic>
 
 namespace mckl {
 
+namespace internal {
+
+/// \brief Set of occurred cells as a bitmap that can be updated concurrently
+class CollisionBitmap
+{
+  public:
+    CollisionBitmap(std::size_t k, std::size_t) : bits_((k + 63) / 64)
+    {
+        for (auto &b : bits_) {
+            b.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /// \brief Insert a cell and return if it has already occurred
+    bool insert(std::size_t u)
+    {
+        const std::uint64_t mask = UINT64_C(1) << (u % 64);
+        const std::uint64_t b =
+            bits_[u / 64].fetch_or(mask, std::memory_order_relaxed);
+
+        return (b & mask) != 0;
+    }
+
+  private:
+    Vector<std::atomic<std::uint64_t>> bits_;
+}; // class CollisionBitmap
+
+/// \brief Set of occurred cells as an open addressing hash table that can be
+/// updated concurrently
+///
+/// \details
+/// The table has at least twice as many slots as the number of insertions
+/// and uses linear probing. Each slot is claimed by a compare-and-swap of
+/// the cell plus one, such that zero marks an empty slot.
+class CollisionHashSet
+{
+  public:
+    CollisionHashSet(std::size_t, std::size_t n) : mask_(0)
+    {
+        std::size_t m = 2;
+        while (m < 2 * n) {
+            m *= 2;
+        }
+        mask_ = m - 1;
+        table_ = Vector<std::atomic<std::uint64_t>>(m);
+        for (auto &t : table_) {
+            t.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /// \brief Insert a cell and return if it has already occurred
+    bool insert(std::size_t u)
+    {
+        const std::uint64_t key = static_cast<std::uint64_t>(u) + 1;
+        std::size_t i = static_cast<std::size_t>(hash(key)) & mask_;
+        while (true) {
+            std::uint64_t k = table_[i].load(std::memory_order_relaxed);
+            if (k == 0 &&
+                table_[i].compare_exchange_strong(
+                    k, key, std::memory_order_relaxed)) {
+                return false;
+            }
+            if (k == key) {
+                return true;
+            }
+            i = (i + 1) & mask_;
+        }
+    }
+
+  private:
+    std::size_t mask_;
+    Vector<std::atomic<std::uint64_t>> table_;
+
+    static std::uint64_t hash(std::uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+        x = (x ^ (x >> 27)) * UINT64_C(0x94D049BB133111EB);
+
+        return x ^ (x >> 31);
+    }
+}; // class CollisionHashSet
+
+} // namespace internal
+
 /// \brief Collision test
 /// \ingroup RandomTest
 ///
@@ -49,6 +134,11 @@ namespace mckl {
 /// the exact computation. This makes it faster and more easier to conduct some
 /// second-level tests. The approximation is only appropriate if \f$n\f$ is
 /// large and the number of categories \f$D^T\f$ is even larger.
+///
+/// The occurred cells are recorded in a bitmap of \f$D^T\f$ bits if it is
+/// no larger than 16MB, and in a hash table of about \f$16n\f$ bytes
+/// otherwise. Both can be updated concurrently, such that the \f$n\f$
+/// tuples can be generated by multiple independent streams in parallel.
 template <std::size_t D, std::size_t T>
 class CollisionTest : public PoissonTest<CollisionTest<D, T>>
 {
@@ -68,18 +158,34 @@ class CollisionTest : public PoissonTest<CollisionTest<D, T>>
     template <typename RNGType, typename U01DistributionType>
     std::size_t operator()(RNGType &rng, U01DistributionType &u01)
     {
-        using result_type = typename U01DistributionType::result_type;
+        occurs_type occurs(K_, n_);
 
-        const std::size_t k = internal::BufferSize<result_type, T>::value;
-        const std::size_t m = n_ / k;
-        const std::size_t l = n_ % k;
-        Vector<result_type> r(k * T);
-        std::size_t s = 0;
-        occurs_type occurs;
-        for (std::size_t i = 0; i != m; ++i) {
-            generate(rng, u01, k, r.data(), s, occurs);
-        }
-        generate(rng, u01, l, r.data(), s, occurs);
+        return generate(rng, u01, n_, occurs);
+    }
+
+    /// \brief Perform the test with the tuples generated concurrently by `k`
+    /// independent streams
+    ///
+    /// \details
+    /// The `n` tuples are divided as evenly as possible among the streams
+    /// `rng[0]`, ..., `rng[k - 1]`, which are used by the tasks of smp_for
+    /// with a copy of `u01` each. The number of collisions does not depend
+    /// on the order in which the tuples are recorded, and thus the result is
+    /// the same for any number of threads.
+    template <typename Backend = BackendSMP, typename RNGType,
+        typename U01DistributionType>
+    std::size_t operator()(
+        std::size_t k, RNGType *rng, const U01DistributionType &u01)
+    {
+        occurs_type occurs(K_, n_);
+        std::atomic<std::size_t> s(0);
+        smp_for<Backend>(k, [&](std::size_t ibegin, std::size_t iend) {
+            U01DistributionType dist(u01);
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                const std::size_t n = n_ / k + (i < n_ % k ? 1 : 0);
+                s += generate(rng[i], dist, n, occurs);
+            }
+        });
 
         return s;
     }
@@ -89,42 +195,45 @@ class CollisionTest : public PoissonTest<CollisionTest<D, T>>
   private:
     static constexpr std::size_t K_ = internal::Pow<std::size_t, D, T>::value;
 
-    using occurs_type = std::conditional_t<K_ <= (1U << 27), std::bitset<K_>,
-        std::set<std::size_t>>;
+    using occurs_type = std::conditional_t<K_ <= (1U << 27),
+        internal::CollisionBitmap, internal::CollisionHashSet>;
 
     std::size_t n_;
     double mean_;
 
     template <typename RNGType, typename U01DistributionType>
-    void generate(RNGType &rng, U01DistributionType &u01, std::size_t n,
-        typename U01DistributionType::result_type *r, std::size_t &s,
+    std::size_t generate(RNGType &rng, U01DistributionType &u01,
+        std::size_t n, occurs_type &occurs) const
+    {
+        using result_type = typename U01DistributionType::result_type;
+
+        const std::size_t k = internal::BufferSize<result_type, T>::value;
+        const std::size_t m = n / k;
+        const std::size_t l = n % k;
+        Vector<result_type> r(k * T);
+        std::size_t s = 0;
+        for (std::size_t i = 0; i != m; ++i) {
+            s += generate(rng, u01, k, r.data(), occurs);
+        }
+        s += generate(rng, u01, l, r.data(), occurs);
+
+        return s;
+    }
+
+    template <typename RNGType, typename U01DistributionType>
+    std::size_t generate(RNGType &rng, U01DistributionType &u01,
+        std::size_t n, typename U01DistributionType::result_type *r,
         occurs_type &occurs) const
     {
         rand(rng, u01, n * T, r);
         mul(n * T, static_cast<typename U01DistributionType::result_type>(D),
             r, r);
+        std::size_t s = 0;
         for (std::size_t i = 0; i != n; ++i, r += T) {
-            count(internal::serial_index<D, T>(r), s, occurs);
+            s += occurs.insert(internal::serial_index<D, T>(r)) ? 1 : 0;
         }
-    }
-
-    void count(std::size_t u, std::size_t &s, std::bitset<K_> &occurs) const
-    {
-        if (occurs.test(u)) {
-            ++s;
-        } else {
-            occurs.set(u);
-        }
-    }
 
-    void count(
-        std::size_t u, std::size_t &s, std::set<std::size_t> &occurs) const
-    {
-        if (occurs.count(u)) {
-            ++s;
-        } else {
-            occurs.insert(u);
-        }
+        return s;
     }
 }; // class CollisionTest
 
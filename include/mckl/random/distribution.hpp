@@ -60,5 +60,6 @@
 #include <mckl/random/uniform_int_distribution.hpp>
 #include <mckl/random/uniform_real_distribution.hpp>
 #include <mckl/random/weibull_distribution.hpp>
+#include <mckl/random/wishart_distribution.hpp>
 
 #endif // MCKL_RANDOM_DISTRIBUTION_HPP
@@ -54,11 +54,54 @@ inline void exponential_distribution_impl(
     mul(n, -1 / lambda, r, r);
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1>
+inline void exponential_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 lambda)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    distribution_param_log(n, lambda, s.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType v = s[i] - distribution_param(lambda, i) * x[i];
+        r[i] = x[i] < 0 ? -const_inf<RealType>() : v;
+    }
+}
+
+template <std::size_t, typename RealType, typename P1>
+inline void exponential_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 lambda)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = x[i] > 0 ? -distribution_param(lambda, i) * x[i] : 0;
+    }
+    expm1(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -r[i];
+    }
+}
+
+template <std::size_t, typename RealType, typename P1>
+inline void exponential_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 lambda)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -x[i];
+    }
+    log1p(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -r[i] / distribution_param(lambda, i);
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_1(
     Exponential, exponential, RealType, RealType, lambda)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_1(
+    Exponential, exponential, RealType, lambda)
+
 /// \brief Exponential distribution
 /// \ingroup Distribution
 template <typename RealType>
@@ -56,11 +56,59 @@ inline void extreme_value_distribution_impl(
     muladd(n, r, -b, a, r);
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void extreme_value_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    distribution_param_log(n, b, s.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = (distribution_param(a, i) - x[i]) / distribution_param(b, i);
+        r[i] = t[i] - s[i];
+    }
+    exp(n, t.data(), t.data());
+    sub(n, r, t.data(), r);
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void extreme_value_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = (distribution_param(a, i) - x[i]) / distribution_param(b, i);
+    }
+    exp(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -r[i];
+    }
+    exp(n, r, r);
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void extreme_value_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    log(n, x, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -r[i];
+    }
+    log(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = distribution_param(a, i) - distribution_param(b, i) * r[i];
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     ExtremeValue, extreme_value, RealType, RealType, a, RealType, b)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(
+    ExtremeValue, extreme_value, RealType, a, b)
+
 /// \brief Extreme value distribution
 /// \ingroup Distribution
 template <typename RealType>
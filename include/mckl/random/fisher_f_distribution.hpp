@@ -57,11 +57,79 @@ inline void fisher_f_distribution_impl(
     div(n, s.data(), r, r);
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void fisher_f_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 df1, P2 df2)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> u;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> v;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> w;
+    distribution_param_lbeta(
+        n, df1, df2, s.data(), static_cast<RealType>(0.5));
+    distribution_param_log(n, df1, v.data());
+    distribution_param_log(n, df2, w.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType y = x[i] > 0 ? x[i] : 0;
+        t[i] = x[i] > 0 ? x[i] : 1;
+        u[i] = distribution_param(df2, i) + distribution_param(df1, i) * y;
+    }
+    log(n, t.data(), t.data());
+    log(n, u.data(), u.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType a =
+            static_cast<RealType>(0.5) * distribution_param(df1, i);
+        const RealType b =
+            static_cast<RealType>(0.5) * distribution_param(df2, i);
+        const RealType c = a * v[i] + b * w[i] +
+            distribution_logpdf_power(a, x[i], t[i]) - (a + b) * u[i] - s[i];
+        r[i] = x[i] < 0 ? -const_inf<RealType>() : c;
+    }
+}
+
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void fisher_f_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 df1, P2 df2)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> a;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> b;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType y = x[i] > 0 ? distribution_param(df1, i) * x[i] : 0;
+        t[i] = y / (y + distribution_param(df2, i));
+    }
+    betai(n,
+        distribution_param_mul(n, df1, a.data(), static_cast<RealType>(0.5)),
+        distribution_param_mul(n, df2, b.data(), static_cast<RealType>(0.5)),
+        t.data(), r);
+}
+
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void fisher_f_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 df1, P2 df2)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> a;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> b;
+    betaiinv(n,
+        distribution_param_mul(n, df1, a.data(), static_cast<RealType>(0.5)),
+        distribution_param_mul(n, df2, b.data(), static_cast<RealType>(0.5)),
+        x, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = distribution_param(df2, i) * r[i] /
+            (distribution_param(df1, i) * (1 - r[i]));
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     FisherF, fisher_f, RealType, RealType, m, RealType, n)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(FisherF, fisher_f, RealType, m, n)
+
 /// \brief Fisher-F distribution
 /// \ingroup Distribution
 template <typename RealType>
@@ -272,6 +272,53 @@ inline std::size_t gamma_distribution_impl(RNGType &rng, std::size_t n,
     return 0;
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void gamma_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 alpha, P2 beta)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> u;
+    distribution_param(n, alpha, s.data(),
+        [](std::size_t m, const RealType *a, RealType *y) {
+            lgamma(m, a, y);
+        });
+    distribution_param_log(n, beta, u.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] > 0 ? x[i] : 1;
+    }
+    log(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType a = distribution_param(alpha, i);
+        const RealType v = distribution_logpdf_power(a, x[i], t[i]) -
+            x[i] / distribution_param(beta, i) - s[i] - a * u[i];
+        r[i] = x[i] < 0 ? -const_inf<RealType>() : v;
+    }
+}
+
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void gamma_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 alpha, P2 beta)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] > 0 ? x[i] / distribution_param(beta, i) : 0;
+    }
+    gammap(n, alpha, t.data(), r);
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void gamma_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 alpha, P2 beta)
+{
+    gammapinv(n, alpha, x, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] *= distribution_param(beta, i);
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 template <typename RealType, typename RNGType>
@@ -308,6 +355,9 @@ inline void gamma_distribution(RNGType &rng, std::size_t n, RealType *r,
     gamma_distribution(rng, n, r, param.alpha(), param.beta());
 }
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(
+    Gamma, gamma, RealType, alpha, beta)
+
 /// \brief Gamma distribution
 /// \ingroup Distribution
 template <typename RealType>
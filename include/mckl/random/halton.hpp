@@ -0,0 +1,329 @@
+//============================================================================
+// MCKL/include/mckl/random/halton.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_HALTON_HPP
+#define MCKL_RANDOM_HALTON_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/qmc.hpp>
+
+namespace mckl {
+
+MCKL_PUSH_CLANG_WARNING("-Wpadded")
+/// \brief Halton sequence generator
+/// \ingroup QMC
+///
+/// \details
+/// Dimension `d` (counting from zero) is the radical inverse in the base of
+/// the `d + 1`-th prime. Each coordinate is the fixed point representation
+/// of the radical inverse truncated to the digits that are significant
+/// within \f$W\f$ bits, where \f$W\f$ is the number of bits of `UIntType`.
+/// The digits of the index are incremented with carry, and each coordinate
+/// is updated for the changed digits only.
+///
+/// The linear matrix scrambling applies random permutations to the digits.
+/// The permutation of digit \f$k\f$ of dimension \f$d\f$ with base \f$b\f$ is
+/// \f$x \mapsto (a_{dk}x + c_{dk}) \bmod b\f$, with \f$a_{dk}\f$ and
+/// \f$c_{dk}\f$ uniform on \f$\{1,\dots,b-1\}\f$ and \f$\{0,\dots,b-1\}\f$,
+/// respectively. This is a linear matrix scrambling with diagonal matrices
+/// and a random digital shift, and it breaks the correlations between the
+/// dimensions with large bases. The nested uniform scrambling is not
+/// supported, since the permutation of each digit would depend on all the
+/// preceding digits, and `QMCScramble::Owen` is rejected by the
+/// constructor.
+template <typename UIntType>
+class HaltonGenerator
+{
+    static_assert(std::is_unsigned<UIntType>::value &&
+            (std::numeric_limits<UIntType>::digits == 32 ||
+                std::numeric_limits<UIntType>::digits == 64),
+        "**HaltonGenerator** used with UIntType other than 32 or 64-bit "
+        "unsigned integer types");
+
+  public:
+    HaltonGenerator(std::size_t dim = 1, std::size_t offset = 0,
+        QMCScramble scramble = QMCScramble::None, std::uint64_t seed = 1)
+        : dim_(dim)
+        , offset_(offset)
+        , scramble_(scramble)
+        , seed_(seed)
+        , index_(0)
+        , base_(dim)
+        , pos_(dim + 1)
+        , x_(dim)
+    {
+        runtime_assert(dim != 0, "**HaltonGenerator** dimension equal to 0");
+        runtime_assert(scramble != QMCScramble::Owen,
+            "**HaltonGenerator** used with nested uniform scrambling");
+
+        prime();
+        scale();
+        reset(seed);
+    }
+
+    void reset(std::uint64_t seed)
+    {
+        seed_ = seed;
+        for (std::size_t d = 0; d != dim_; ++d) {
+            const std::uint64_t b = base_[d];
+            std::uint64_t s = internal::qmc_scramble_seed(seed_, offset_ + d);
+            for (std::size_t k = pos_[d]; k != pos_[d + 1]; ++k) {
+                if (scramble_ != QMCScramble::LMS) {
+                    mul_[k] = 1;
+                    add_[k] = 0;
+                } else {
+                    mul_[k] = static_cast<std::uint32_t>(
+                        1 + internal::splitmix64(s) % (b - 1));
+                    add_[k] = static_cast<std::uint32_t>(
+                        internal::splitmix64(s) % b);
+                }
+            }
+        }
+        seek(0);
+    }
+
+    std::size_t dim() const { return dim_; }
+
+    std::size_t offset() const { return offset_; }
+
+    QMCScramble scramble() const { return scramble_; }
+
+    std::uint64_t seed() const { return seed_; }
+
+    std::uint64_t index() const { return index_; }
+
+    /// \brief The base of each dimension
+    const Vector<std::uint32_t> &base() const { return base_; }
+
+    void seek(std::uint64_t i)
+    {
+        index_ = i;
+        for (std::size_t d = 0; d != dim_; ++d) {
+            const std::uint64_t b = base_[d];
+            std::uint64_t j = i;
+            UIntType x = 0;
+            for (std::size_t k = pos_[d]; k != pos_[d + 1]; ++k) {
+                digit_[k] = static_cast<std::uint32_t>(j % b);
+                x += permute(k, digit_[k], b) * scale_[k];
+                j /= b;
+            }
+            x_[d] = x;
+        }
+    }
+
+    template <typename ResultType>
+    void operator()(std::size_t n, ResultType *r)
+    {
+        static_assert(std::is_same<ResultType, UIntType>::value,
+            "**HaltonGenerator** used with ResultType other than UIntType");
+
+        for (std::size_t i = 0; i != n; ++i, r += dim_) {
+            std::copy(x_.begin(), x_.end(), r);
+            next();
+        }
+    }
+
+    friend bool operator==(const HaltonGenerator<UIntType> &gen1,
+        const HaltonGenerator<UIntType> &gen2)
+    {
+        if (gen1.dim_ != gen2.dim_) {
+            return false;
+        }
+        if (gen1.offset_ != gen2.offset_) {
+            return false;
+        }
+        if (gen1.scramble_ != gen2.scramble_) {
+            return false;
+        }
+        if (gen1.seed_ != gen2.seed_) {
+            return false;
+        }
+        if (gen1.index_ != gen2.index_) {
+            return false;
+        }
+        return true;
+    }
+
+    friend bool operator!=(const HaltonGenerator<UIntType> &gen1,
+        const HaltonGenerator<UIntType> &gen2)
+    {
+        return !(gen1 == gen2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os,
+        const HaltonGenerator<UIntType> &gen)
+    {
+        if (!os) {
+            return os;
+        }
+
+        os << gen.dim_ << ' ';
+        os << gen.offset_ << ' ';
+        os << static_cast<int>(gen.scramble_) << ' ';
+        os << gen.seed_ << ' ';
+        os << gen.index_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is, HaltonGenerator<UIntType> &gen)
+    {
+        if (!is) {
+            return is;
+        }
+
+        std::size_t dim = 0;
+        std::size_t offset = 0;
+        int scramble = 0;
+        std::uint64_t seed = 0;
+        std::uint64_t index = 0;
+        is >> std::ws >> dim;
+        is >> std::ws >> offset;
+        is >> std::ws >> scramble;
+        is >> std::ws >> seed;
+        is >> std::ws >> index;
+
+        if (is) {
+            gen = HaltonGenerator<UIntType>(
+                dim, offset, static_cast<QMCScramble>(scramble), seed);
+            gen.seek(index);
+        }
+
+        return is;
+    }
+
+  private:
+    std::size_t dim_;
+    std::size_t offset_;
+    QMCScramble scramble_;
+    std::uint64_t seed_;
+    std::uint64_t index_;
+    Vector<std::uint32_t> base_;
+    Vector<std::size_t> pos_;
+    Vector<UIntType> scale_;
+    Vector<std::uint32_t> mul_;
+    Vector<std::uint32_t> add_;
+    Vector<std::uint32_t> digit_;
+    Vector<UIntType> x_;
+
+    UIntType permute(std::size_t k, std::uint64_t x, std::uint64_t b) const
+    {
+        return static_cast<UIntType>((mul_[k] * x + add_[k]) % b);
+    }
+
+    void next()
+    {
+        ++index_;
+        for (std::size_t d = 0; d != dim_; ++d) {
+            const std::uint64_t b = base_[d];
+            UIntType x = x_[d];
+            for (std::size_t k = pos_[d]; k != pos_[d + 1]; ++k) {
+                const std::uint32_t u = digit_[k];
+                const std::uint32_t v = u + 1 == b ? 0 : u + 1;
+                digit_[k] = v;
+                x -= permute(k, u, b) * scale_[k];
+                x += permute(k, v, b) * scale_[k];
+                if (v != 0) {
+                    break;
+                }
+            }
+            x_[d] = x;
+        }
+    }
+
+    void prime()
+    {
+        Vector<std::uint32_t> p;
+        p.reserve(offset_ + dim_);
+        for (std::uint32_t n = 2; p.size() != offset_ + dim_; ++n) {
+            bool is_prime = true;
+            for (std::uint32_t q : p) {
+                if (q * q > n) {
+                    break;
+                }
+                if (n % q == 0) {
+                    is_prime = false;
+                    break;
+                }
+            }
+            if (is_prime) {
+                p.push_back(n);
+            }
+        }
+        std::copy(p.begin() + static_cast<std::ptrdiff_t>(offset_), p.end(),
+            base_.begin());
+    }
+
+    // scale_[k] is the value of the digit k (counting from zero) of the
+    // radical inverse, 2^W / b^(k + 1) rounded down, for the significant
+    // digits
+    void scale()
+    {
+        constexpr UIntType M = std::numeric_limits<UIntType>::max();
+
+        scale_.clear();
+        pos_[0] = 0;
+        for (std::size_t d = 0; d != dim_; ++d) {
+            const UIntType b = static_cast<UIntType>(base_[d]);
+            UIntType s = M / b + (M % b == b - 1 ? 1 : 0);
+            while (s != 0) {
+                scale_.push_back(s);
+                s /= b;
+            }
+            pos_[d + 1] = scale_.size();
+        }
+        mul_.resize(scale_.size());
+        add_.resize(scale_.size());
+        digit_.resize(scale_.size());
+    }
+}; // class HaltonGenerator
+MCKL_POP_CLANG_WARNING
+
+/// \brief Halton quasi-random number engine
+/// \ingroup QMC
+template <typename ResultType>
+using HaltonEngine = QMCEngine<ResultType, HaltonGenerator<ResultType>>;
+
+/// \brief Halton quasi-random number engine with 32-bit output
+/// \ingroup QMC
+using Halton = HaltonEngine<std::uint32_t>;
+
+/// \brief Halton quasi-random number engine with 64-bit output
+/// \ingroup QMC
+using Halton_64 = HaltonEngine<std::uint64_t>;
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_HALTON_HPP
@@ -150,6 +150,83 @@
             rng, N, r, param.p1(), param.p2(), param.p3(), param.p4());       \
     }
 
+#define MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTION_1(Name, name, func, T, p1) \
+    template <typename T>                                                     \
+    inline void name##_##func(std::size_t N, const T *x, T p1, T *r)          \
+    {                                                                         \
+        const std::size_t K = BufferSize<T>::value;                           \
+        const std::size_t M = N / K;                                          \
+        const std::size_t L = N % K;                                          \
+        for (std::size_t i = 0; i != M; ++i, x += K, r += K)                  \
+            ::mckl::internal::name##_##func##_impl<K>(K, x, r, p1);           \
+        ::mckl::internal::name##_##func##_impl<K>(L, x, r, p1);               \
+    }                                                                         \
+                                                                              \
+    template <typename T>                                                     \
+    inline void name##_##func(std::size_t N, const T *x, const T *p1, T *r)   \
+    {                                                                         \
+        const std::size_t K = BufferSize<T>::value;                           \
+        const std::size_t M = N / K;                                          \
+        const std::size_t L = N % K;                                          \
+        for (std::size_t i = 0; i != M; ++i, x += K, r += K, p1 += K)         \
+            ::mckl::internal::name##_##func##_impl<K>(K, x, r, p1);           \
+        ::mckl::internal::name##_##func##_impl<K>(L, x, r, p1);               \
+    }                                                                         \
+                                                                              \
+    template <typename T>                                                     \
+    inline void name##_##func(std::size_t N, const T *x,                      \
+        const typename Name##Distribution<T>::param_type &param, T *r)        \
+    {                                                                         \
+        name##_##func(N, x, param.p1(), r);                                   \
+    }
+
+#define MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTION_2(                           \
+    Name, name, func, T, p1, p2)                                              \
+    template <typename T>                                                     \
+    inline void name##_##func(std::size_t N, const T *x, T p1, T p2, T *r)    \
+    {                                                                         \
+        const std::size_t K = BufferSize<T>::value;                           \
+        const std::size_t M = N / K;                                          \
+        const std::size_t L = N % K;                                          \
+        for (std::size_t i = 0; i != M; ++i, x += K, r += K)                  \
+            ::mckl::internal::name##_##func##_impl<K>(K, x, r, p1, p2);       \
+        ::mckl::internal::name##_##func##_impl<K>(L, x, r, p1, p2);           \
+    }                                                                         \
+                                                                              \
+    template <typename T>                                                     \
+    inline void name##_##func(                                                \
+        std::size_t N, const T *x, const T *p1, const T *p2, T *r)            \
+    {                                                                         \
+        const std::size_t K = BufferSize<T>::value;                           \
+        const std::size_t M = N / K;                                          \
+        const std::size_t L = N % K;                                          \
+        for (std::size_t i = 0; i != M; ++i) {                                \
+            ::mckl::internal::name##_##func##_impl<K>(K, x, r, p1, p2);       \
+            x += K;                                                           \
+            r += K;                                                           \
+            p1 += K;                                                          \
+            p2 += K;                                                          \
+        }                                                                     \
+        ::mckl::internal::name##_##func##_impl<K>(L, x, r, p1, p2);           \
+    }                                                                         \
+                                                                              \
+    template <typename T>                                                     \
+    inline void name##_##func(std::size_t N, const T *x,                      \
+        const typename Name##Distribution<T>::param_type &param, T *r)        \
+    {                                                                         \
+        name##_##func(N, x, param.p1(), param.p2(), r);                       \
+    }
+
+#define MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_1(Name, name, T, p1)        \
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTION_1(Name, name, logpdf, T, p1)     \
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTION_1(Name, name, cdf, T, p1)        \
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTION_1(Name, name, quantile, T, p1)
+
+#define MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(Name, name, T, p1, p2)    \
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTION_2(Name, name, logpdf, T, p1, p2) \
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTION_2(Name, name, cdf, T, p1, p2)    \
+    MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTION_2(Name, name, quantile, T, p1, p2)
+
 #define MCKL_DEFINE_RANDOM_DISTRIBUTION_PARAM_TYPE_0(Name, T)                 \
   public:                                                                     \
     class param_type                                                          \
@@ -777,6 +854,127 @@ class DummyDistribution
     DistributionType distribution_;
 }; // class DummyDistribution
 
+// Parameters of the batch distribution functions, either the same for all
+// elements or one for each element
+template <typename RealType>
+inline RealType distribution_param(RealType p, std::size_t)
+{
+    return p;
+}
+
+template <typename RealType>
+inline RealType distribution_param(const RealType *p, std::size_t i)
+{
+    return p[i];
+}
+
+template <typename RealType>
+inline void distribution_param(std::size_t n, RealType p, RealType *r)
+{
+    std::fill_n(r, n, p);
+}
+
+template <typename RealType>
+inline void distribution_param(std::size_t n, const RealType *p, RealType *r)
+{
+    std::copy_n(p, n, r);
+}
+
+// Compute f(p) with a batch function f, only once if the parameter is the
+// same for all elements
+template <typename RealType, typename Func>
+inline void distribution_param(
+    std::size_t n, RealType p, RealType *r, Func &&f)
+{
+    RealType s = 0;
+    f(1, &p, &s);
+    std::fill_n(r, n, s);
+}
+
+template <typename RealType, typename Func>
+inline void distribution_param(
+    std::size_t n, const RealType *p, RealType *r, Func &&f)
+{
+    f(n, p, r);
+}
+
+template <typename RealType, typename Func>
+inline void distribution_param(
+    std::size_t n, RealType p1, RealType p2, RealType *r, Func &&f)
+{
+    RealType s = 0;
+    f(1, &p1, &p2, &s);
+    std::fill_n(r, n, s);
+}
+
+template <typename RealType, typename Func>
+inline void distribution_param(std::size_t n, const RealType *p1,
+    const RealType *p2, RealType *r, Func &&f)
+{
+    f(n, p1, p2, r);
+}
+
+template <typename RealType, typename ParamType>
+inline void distribution_param_log(std::size_t n, ParamType p, RealType *r)
+{
+    distribution_param(n, p, r,
+        [](std::size_t m, const RealType *a, RealType *y) { log(m, a, y); });
+}
+
+// Compute ln B(a, b), with the parameters scaled by s
+template <typename RealType, typename ParamType>
+inline void distribution_param_lbeta(std::size_t n, ParamType p1,
+    ParamType p2, RealType *r, RealType s = 1)
+{
+    distribution_param(n, p1, p2, r,
+        [s](std::size_t m, const RealType *a, const RealType *b,
+            RealType *y) {
+            alignas(MCKL_ALIGNMENT) std::array<RealType, 1024> t;
+            alignas(MCKL_ALIGNMENT) std::array<RealType, 1024> u;
+            for (std::size_t k = 0; k < m; k += t.size()) {
+                const std::size_t l = std::min(t.size(), m - k);
+                mul(l, s, a + k, t.data());
+                mul(l, s, b + k, u.data());
+                add(l, t.data(), u.data(), y + k);
+                lgamma(l, y + k, y + k);
+                lgamma(l, t.data(), t.data());
+                lgamma(l, u.data(), u.data());
+                add(l, t.data(), u.data(), t.data());
+                sub(l, t.data(), y + k, y + k);
+            }
+        });
+}
+
+// Compute (a - 1) ln x given t = ln x, with the limit at x = 0
+template <typename RealType>
+inline RealType distribution_logpdf_power(RealType a, RealType x, RealType t)
+{
+    if (x > 0)
+        return (a - 1) * t;
+    if (a < 1)
+        return const_inf<RealType>();
+    if (a > 1)
+        return -const_inf<RealType>();
+    return 0;
+}
+
+// Scale the parameters by s, returning either a scalar or the buffer r
+template <typename RealType>
+inline RealType distribution_param_mul(
+    std::size_t, RealType p, RealType *, RealType s)
+{
+    return s * p;
+}
+
+template <typename RealType>
+inline const RealType *distribution_param_mul(
+    std::size_t n, const RealType *p, RealType *r, RealType s)
+{
+    mul(n, s, p, r);
+
+    return r;
+}
+
 template <std::size_t N, std::size_t D, std::size_t T>
 inline std::size_t serial_index(const std::size_t *, std::false_type)
 {
@@ -1011,6 +1209,19 @@ class SeedTrait
 template <typename RNGType>
 using SeedType = typename SeedTrait<RNGType>::type;
 
+/// \brief If an RNG generates quasi-random (low discrepancy) sequences
+/// \ingroup Random
+///
+/// \details
+/// Distributions that support such RNGs generate each random number with
+/// exactly one output of the RNG, by inverse CDF transform.
+template <typename>
+class QuasiRandomTrait
+{
+  public:
+    static constexpr bool value = false;
+}; // class QuasiRandomTrait
+
 template <typename = double>
 class ArcsineDistribution;
 
@@ -1038,6 +1249,9 @@ class FisherFDistribution;
 template <typename = double>
 class GammaDistribution;
 
+template <typename = double, std::size_t = 0>
+class InverseWishartDistribution;
+
 template <typename = double>
 class LaplaceDistribution;
 
@@ -1053,7 +1267,7 @@ class LognormalDistribution;
 template <typename = double>
 class NormalDistribution;
 
-template <typename = double>
+template <typename = double, std::size_t = 0>
 class NormalMVDistribution;
 
 template <typename = double>
@@ -1092,6 +1306,9 @@ class UniformRealDistribution;
 template <typename = double>
 class WeibullDistribution;
 
+template <typename = double, std::size_t = 0>
+class WishartDistribution;
+
 template <typename = bool>
 class BernoulliDistribution;
 
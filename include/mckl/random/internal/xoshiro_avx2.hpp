@@ -0,0 +1,114 @@
+//============================================================================
+// MCKL/include/mckl/random/internal/xoshiro_avx2.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_INTERNAL_XOSHIRO_AVX2_HPP
+#define MCKL_RANDOM_INTERNAL_XOSHIRO_AVX2_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/xoshiro_generic.hpp>
+
+MCKL_PUSH_GCC_WARNING("-Wignored-attributes")
+
+#define MCKL_RANDOM_INTERNAL_XOSHIRO_AVX2_ROTL(x, R)                         \
+    _mm256_or_si256(_mm256_slli_epi64(x, R), _mm256_srli_epi64(x, 64 - R))
+
+namespace mckl {
+
+namespace internal {
+
+template <std::size_t K>
+class Xoshiro256PPGeneratorAVX2Impl32
+{
+  public:
+    using state_type = std::array<std::uint64_t, K * 4>;
+
+    template <typename ResultType>
+    static void eval(state_type &s, ResultType *r)
+    {
+        eval(s, 1, r);
+    }
+
+    template <typename ResultType>
+    static void eval(state_type &s, std::size_t n, ResultType *r)
+    {
+        char *c = reinterpret_cast<char *>(r);
+        std::uint64_t *p = s.data();
+        for (std::size_t k = 0; k != K; k += 4, c += 32) {
+            __m256i ymm0 = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(p + k + K * 0));
+            __m256i ymm1 = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(p + k + K * 1));
+            __m256i ymm2 = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(p + k + K * 2));
+            __m256i ymm3 = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(p + k + K * 3));
+            char *q = c;
+            for (std::size_t i = 0; i != n; ++i, q += sizeof(state_type) / 4) {
+                __m256i ymmr = _mm256_add_epi64(ymm0, ymm3);
+                ymmr = MCKL_RANDOM_INTERNAL_XOSHIRO_AVX2_ROTL(ymmr, 23);
+                ymmr = _mm256_add_epi64(ymmr, ymm0);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(q), ymmr);
+
+                const __m256i ymmt = _mm256_slli_epi64(ymm1, 17);
+                ymm2 = _mm256_xor_si256(ymm2, ymm0);
+                ymm3 = _mm256_xor_si256(ymm3, ymm1);
+                ymm1 = _mm256_xor_si256(ymm1, ymm2);
+                ymm0 = _mm256_xor_si256(ymm0, ymm3);
+                ymm2 = _mm256_xor_si256(ymm2, ymmt);
+                ymm3 = MCKL_RANDOM_INTERNAL_XOSHIRO_AVX2_ROTL(ymm3, 45);
+            }
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(p + k + K * 0), ymm0);
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(p + k + K * 1), ymm1);
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(p + k + K * 2), ymm2);
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i *>(p + k + K * 3), ymm3);
+        }
+    }
+}; // class Xoshiro256PPGeneratorAVX2Impl32
+
+template <std::size_t K>
+class Xoshiro256PPGeneratorAVX2Impl
+    : public std::conditional_t<K % 4 == 0,
+          Xoshiro256PPGeneratorAVX2Impl32<K>,
+          Xoshiro256PPGeneratorGenericImpl<K>>
+{
+}; // class Xoshiro256PPGeneratorAVX2Impl
+
+} // namespace internal
+
+} // namespace mckl
+
+MCKL_POP_GCC_WARNING
+
+#endif // MCKL_RANDOM_INTERNAL_XOSHIRO_AVX2_HPP
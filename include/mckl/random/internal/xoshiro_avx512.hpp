@@ -0,0 +1,105 @@
+//============================================================================
+// MCKL/include/mckl/random/internal/xoshiro_avx512.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_INTERNAL_XOSHIRO_AVX512_HPP
+#define MCKL_RANDOM_INTERNAL_XOSHIRO_AVX512_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/xoshiro_avx2.hpp>
+
+MCKL_PUSH_GCC_WARNING("-Wignored-attributes")
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+
+namespace mckl {
+
+namespace internal {
+
+template <std::size_t K>
+class Xoshiro256PPGeneratorAVX512Impl64
+{
+  public:
+    using state_type = std::array<std::uint64_t, K * 4>;
+
+    template <typename ResultType>
+    static void eval(state_type &s, ResultType *r)
+    {
+        eval(s, 1, r);
+    }
+
+    template <typename ResultType>
+    static void eval(state_type &s, std::size_t n, ResultType *r)
+    {
+        char *c = reinterpret_cast<char *>(r);
+        std::uint64_t *p = s.data();
+        for (std::size_t k = 0; k != K; k += 8, c += 64) {
+            __m512i zmm0 = _mm512_loadu_si512(p + k + K * 0);
+            __m512i zmm1 = _mm512_loadu_si512(p + k + K * 1);
+            __m512i zmm2 = _mm512_loadu_si512(p + k + K * 2);
+            __m512i zmm3 = _mm512_loadu_si512(p + k + K * 3);
+            char *q = c;
+            for (std::size_t i = 0; i != n; ++i, q += sizeof(state_type) / 4) {
+                __m512i zmmr = _mm512_add_epi64(zmm0, zmm3);
+                zmmr = _mm512_rol_epi64(zmmr, 23);
+                zmmr = _mm512_add_epi64(zmmr, zmm0);
+                _mm512_storeu_si512(q, zmmr);
+
+                const __m512i zmmt = _mm512_slli_epi64(zmm1, 17);
+                zmm2 = _mm512_xor_si512(zmm2, zmm0);
+                zmm3 = _mm512_xor_si512(zmm3, zmm1);
+                zmm1 = _mm512_xor_si512(zmm1, zmm2);
+                zmm0 = _mm512_xor_si512(zmm0, zmm3);
+                zmm2 = _mm512_xor_si512(zmm2, zmmt);
+                zmm3 = _mm512_rol_epi64(zmm3, 45);
+            }
+            _mm512_storeu_si512(p + k + K * 0, zmm0);
+            _mm512_storeu_si512(p + k + K * 1, zmm1);
+            _mm512_storeu_si512(p + k + K * 2, zmm2);
+            _mm512_storeu_si512(p + k + K * 3, zmm3);
+        }
+    }
+}; // class Xoshiro256PPGeneratorAVX512Impl64
+
+template <std::size_t K>
+class Xoshiro256PPGeneratorAVX512Impl
+    : public std::conditional_t<K % 8 == 0,
+          Xoshiro256PPGeneratorAVX512Impl64<K>,
+          Xoshiro256PPGeneratorAVX2Impl<K>>
+{
+}; // class Xoshiro256PPGeneratorAVX512Impl
+
+} // namespace internal
+
+} // namespace mckl
+
+MCKL_POP_GCC_WARNING
+MCKL_POP_GCC_WARNING
+
+#endif // MCKL_RANDOM_INTERNAL_XOSHIRO_AVX512_HPP
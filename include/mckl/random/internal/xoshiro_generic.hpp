@@ -0,0 +1,105 @@
+//============================================================================
+// MCKL/include/mckl/random/internal/xoshiro_generic.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_INTERNAL_XOSHIRO_GENERIC_HPP
+#define MCKL_RANDOM_INTERNAL_XOSHIRO_GENERIC_HPP
+
+#include <mckl/random/internal/common.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+template <std::size_t K>
+class Xoshiro256PPGeneratorGenericImpl
+{
+  public:
+    using state_type = std::array<std::uint64_t, K * 4>;
+
+    template <typename ResultType>
+    static void eval(state_type &s, ResultType *r)
+    {
+        alignas(MCKL_ALIGNMENT) std::array<std::uint64_t, K> buf;
+        step(s, buf.data());
+        std::memcpy(r, buf.data(), sizeof(std::uint64_t) * K);
+    }
+
+    template <typename ResultType>
+    static void eval(state_type &s, std::size_t n, ResultType *r)
+    {
+        constexpr std::size_t R = sizeof(std::uint64_t) * K /
+            sizeof(ResultType);
+
+        for (std::size_t i = 0; i != n; ++i, r += R) {
+            eval(s, r);
+        }
+    }
+
+    /// \brief Advance one lane without output
+    static void step(std::uint64_t *s0, std::uint64_t *s1, std::uint64_t *s2,
+        std::uint64_t *s3)
+    {
+        const std::uint64_t t = *s1 << 17;
+        *s2 ^= *s0;
+        *s3 ^= *s1;
+        *s1 ^= *s2;
+        *s0 ^= *s3;
+        *s2 ^= t;
+        *s3 = rotl<45>(*s3);
+    }
+
+  private:
+    template <int R>
+    static std::uint64_t rotl(std::uint64_t x)
+    {
+        return (x << R) | (x >> (64 - R));
+    }
+
+    static void step(state_type &s, std::uint64_t *r)
+    {
+        std::uint64_t *s0 = s.data();
+        std::uint64_t *s1 = s0 + K;
+        std::uint64_t *s2 = s1 + K;
+        std::uint64_t *s3 = s2 + K;
+        for (std::size_t i = 0; i != K; ++i) {
+            r[i] = rotl<23>(s0[i] + s3[i]) + s0[i];
+        }
+        for (std::size_t i = 0; i != K; ++i) {
+            step(s0 + i, s1 + i, s2 + i, s3 + i);
+        }
+    }
+}; // class Xoshiro256PPGeneratorGenericImpl
+
+} // namespace internal
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_INTERNAL_XOSHIRO_GENERIC_HPP
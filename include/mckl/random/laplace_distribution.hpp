@@ -65,11 +65,60 @@ inline void laplace_distribution_impl(
     muladd(n, s.data(), r, a, r);
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void laplace_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    distribution_param_log(n, b, s.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType z =
+            (x[i] - distribution_param(a, i)) / distribution_param(b, i);
+        r[i] = -const_ln_2<RealType>() - s[i] - std::abs(z);
+    }
+}
+
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void laplace_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = -std::abs(x[i] - distribution_param(a, i)) /
+            distribution_param(b, i);
+    }
+    exp(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType c = static_cast<RealType>(0.5) * t[i];
+        r[i] = x[i] < distribution_param(a, i) ? c : 1 - c;
+    }
+}
+
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void laplace_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = 1 - std::abs(2 * x[i] - 1);
+    }
+    log(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType c = distribution_param(b, i) * t[i];
+        r[i] = distribution_param(a, i) +
+            (x[i] < static_cast<RealType>(0.5) ? c : -c);
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     Laplace, laplace, RealType, RealType, a, RealType, b)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(Laplace, laplace, RealType, a, b)
+
 /// \brief Laplace distribution
 /// \ingroup Distribution
 template <typename RealType>
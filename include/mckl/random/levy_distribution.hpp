@@ -63,11 +63,61 @@ inline void levy_distribution_impl(
     }
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void levy_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    distribution_param_log(n, b, s.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType y = x[i] - distribution_param(a, i);
+        t[i] = y > 0 ? y : 1;
+    }
+    log(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType y = x[i] - distribution_param(a, i);
+        const RealType v = static_cast<RealType>(0.5) *
+                (s[i] - const_ln_pi_2<RealType>() - 3 * t[i]) -
+            static_cast<RealType>(0.5) * distribution_param(b, i) / y;
+        r[i] = y > 0 ? v : -const_inf<RealType>();
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void levy_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType y = x[i] - distribution_param(a, i);
+        r[i] = static_cast<RealType>(0.5) * distribution_param(b, i) / y;
+        r[i] = y > 0 ? r[i] : const_inf<RealType>();
+    }
+    sqrt(n, r, r);
+    erfc(n, r, r);
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void levy_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    erfcinv(n, x, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = distribution_param(a, i) +
+            static_cast<RealType>(0.5) * distribution_param(b, i) /
+                (r[i] * r[i]);
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     Levy, levy, RealType, RealType, a, RealType, b)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(Levy, levy, RealType, a, b)
+
 /// \brief Levy distribution
 /// \ingroup Distribution
 template <typename RealType>
@@ -57,11 +57,60 @@ inline void logistic_distribution_impl(
     muladd(n, r, b, a, r);
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void logistic_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    distribution_param_log(n, b, s.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = -std::abs(x[i] - distribution_param(a, i)) /
+            distribution_param(b, i);
+        r[i] = t[i] - s[i];
+    }
+    exp(n, t.data(), t.data());
+    log1p(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] -= 2 * t[i];
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void logistic_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = (distribution_param(a, i) - x[i]) / distribution_param(b, i);
+    }
+    exp(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = 1 / (1 + r[i]);
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void logistic_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = x[i] / (1 - x[i]);
+    }
+    log(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = distribution_param(a, i) + distribution_param(b, i) * r[i];
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     Logistic, logistic, RealType, RealType, a, RealType, b)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(Logistic, logistic, RealType, a, b)
+
 /// \brief Logistic distribution
 /// \ingroup Distribution
 template <typename RealType>
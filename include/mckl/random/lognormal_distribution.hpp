@@ -53,11 +53,66 @@ inline void lognormal_distribution_impl(
     exp(n, r, r);
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void lognormal_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 m, P2 s)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> u;
+    distribution_param_log(n, s, u.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] > 0 ? x[i] : 1;
+    }
+    log(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType z =
+            (t[i] - distribution_param(m, i)) / distribution_param(s, i);
+        const RealType v = -static_cast<RealType>(0.5) *
+                (z * z + const_ln_pi_2<RealType>()) -
+            u[i] - t[i];
+        r[i] = x[i] > 0 ? v : -const_inf<RealType>();
+    }
+}
+
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void lognormal_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 m, P2 s)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] > 0 ? x[i] : 1;
+    }
+    log(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = (t[i] - distribution_param(m, i)) / distribution_param(s, i);
+    }
+    cdfnorm(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = x[i] > 0 ? t[i] : 0;
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void lognormal_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 m, P2 s)
+{
+    cdfnorminv(n, x, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = distribution_param(m, i) + distribution_param(s, i) * r[i];
+    }
+    exp(n, r, r);
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     Lognormal, lognormal, RealType, RealType, m, RealType, s)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(
+    Lognormal, lognormal, RealType, m, s)
+
 /// \brief Lognormal distribution
 /// \ingroup Distribution
 template <typename RealType>
@@ -0,0 +1,331 @@
+//============================================================================
+// MCKL/include/mckl/random/multi_stream.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_MULTI_STREAM_HPP
+#define MCKL_RANDOM_MULTI_STREAM_HPP
+
+#include <mckl/random/internal/common.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+inline std::uint64_t splitmix64(std::uint64_t &x)
+{
+    std::uint64_t z = (x += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+
+    return z ^ (z >> 31);
+}
+
+} // namespace internal
+
+MCKL_PUSH_CLANG_WARNING("-Wpadded")
+/// \brief Multi-stream RNG engine
+/// \ingroup Random
+///
+/// \tparam ResultType The ouptut integer type of the multi-stream RNG engine
+/// \tparam Generator The generator that advances a number of independent
+/// streams in lockstep, each step producing one result block with the
+/// outputs of all streams interleaved
+/// - Requirement
+/// ~~~{.cpp}
+/// state_type; /* state of all streams */
+/// static constexpr std::size_t size(); /* Size of the result block in byte */
+/// void reset(std::uint64_t s);         /* seed all streams */
+/// state_type state() const;            /* get the state */
+/// void state(const state_type &);      /* set the state */
+///
+/// /* Advance all streams once and generate one result block */
+/// void operator()(result_type *r);
+///
+/// /* Advance all streams n times and generate n result blocks */
+/// void operator()(std::size_t n, result_type *r);
+///
+/// /* Advance all streams n times without output */
+/// void discard(std::uint64_t n);
+///
+/// /* Jump ahead such that the new streams are disjoint from the old ones */
+/// void jump();
+///
+/// /* Jump ahead by a much larger distance than jump() */
+/// void long_jump();
+/// ~~~
+/// - Restrictions: `size() % sizeof(ResultType) == 0`
+template <typename ResultType, typename Generator>
+class MultiStreamEngine
+{
+    static_assert(std::is_unsigned<ResultType>::value,
+        "**MultiStreamEngine** used with ResultType other than unsigned "
+        "intger types");
+
+    static_assert(Generator::size() % sizeof(ResultType) == 0,
+        "**MultiStreamEngine** used with Generator::size() not divisible by "
+        "sizeof(ResultType)");
+
+  public:
+    using result_type = ResultType;
+    using generator_type = Generator;
+    using state_type = typename generator_type::state_type;
+    using seed_type = std::uint64_t;
+    using skip_type = std::uint64_t;
+
+  private:
+    template <typename T>
+    using is_seed_seq = internal::is_seed_seq<T,
+        MultiStreamEngine<ResultType, Generator>, seed_type>;
+
+  public:
+    explicit MultiStreamEngine(seed_type s = 1) : index_(M_) { seed(s); }
+
+    template <typename SeedSeq>
+    explicit MultiStreamEngine(SeedSeq &seq,
+        std::enable_if_t<is_seed_seq<SeedSeq>::value> * = nullptr)
+        : index_(M_)
+    {
+        seed(seq);
+    }
+
+    void seed(seed_type s)
+    {
+        generator_.reset(s);
+        index_ = M_;
+    }
+
+    template <typename SeedSeq>
+    void seed(SeedSeq &seq,
+        std::enable_if_t<is_seed_seq<SeedSeq>::value> * = nullptr)
+    {
+        std::array<std::uint32_t, 2> s;
+        seq.generate(s.begin(), s.end());
+        seed((static_cast<seed_type>(s.back()) << 32) + s.front());
+    }
+
+    state_type state() const { return generator_.state(); }
+
+    void state(const state_type &s)
+    {
+        generator_.state(s);
+        index_ = M_;
+    }
+
+    generator_type &generator() { return generator_; }
+
+    const generator_type &generator() const { return generator_; }
+
+    result_type operator()()
+    {
+        if (index_ == M_) {
+            generator_(result_.data());
+            index_ = 0;
+        }
+
+        return result_[index_++];
+    }
+
+    void operator()(std::size_t n, result_type *r)
+    {
+        // index_ never exceeds M_, the bound makes it visible to compilers
+        const std::size_t i = std::min<std::size_t>(index_, M_);
+        const std::size_t remain = M_ - i;
+
+        if (n <= remain) {
+            std::memcpy(r, result_.data() + i, sizeof(result_type) * n);
+            index_ = static_cast<unsigned>(i + n);
+            return;
+        }
+
+        std::memcpy(r, result_.data() + i, sizeof(result_type) * remain);
+        r += remain;
+        n -= remain;
+        index_ = M_;
+
+        const std::size_t m = n / M_;
+        generator_(m, r);
+        r += m * M_;
+        n -= m * M_;
+
+        generator_(result_.data());
+        std::memcpy(r, result_.data(), sizeof(result_type) * n);
+        index_ = static_cast<unsigned>(n);
+    }
+
+    /// \brief Discard the result
+    ///
+    /// \return The number of results discarded
+    std::size_t discard()
+    {
+        const std::size_t remain = static_cast<std::size_t>(M_ - index_);
+        index_ = M_;
+
+        return remain;
+    }
+
+    void discard(skip_type nskip)
+    {
+        if (nskip == 0) {
+            return;
+        }
+
+        const skip_type remain = static_cast<skip_type>(M_ - index_);
+        if (nskip <= remain) {
+            index_ += static_cast<unsigned>(nskip);
+            return;
+        }
+        nskip -= remain;
+        index_ = M_;
+
+        const skip_type M = static_cast<skip_type>(M_);
+        generator_.discard(nskip / M);
+        generator_(result_.data());
+        index_ = static_cast<unsigned>(nskip % M);
+    }
+
+    /// \brief Jump ahead such that the streams of the new state are disjoint
+    /// from those of the old one
+    ///
+    /// \details
+    /// Results remaining in the buffer are discarded. A sequence of engines
+    /// obtained by repeated jumps can be used by different threads.
+    void jump()
+    {
+        generator_.jump();
+        index_ = M_;
+    }
+
+    /// \brief Jump ahead by a much larger distance than jump()
+    ///
+    /// \details
+    /// Results remaining in the buffer are discarded. Engines obtained by
+    /// repeated long jumps can each be further partitioned with jump().
+    void long_jump()
+    {
+        generator_.long_jump();
+        index_ = M_;
+    }
+
+    static constexpr result_type min()
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    friend bool operator==(
+        const MultiStreamEngine<ResultType, Generator> &eng1,
+        const MultiStreamEngine<ResultType, Generator> &eng2)
+    {
+        if (eng1.result_ != eng2.result_) {
+            return false;
+        }
+        if (eng1.generator_ != eng2.generator_) {
+            return false;
+        }
+        if (eng1.index_ != eng2.index_) {
+            return false;
+        }
+        return true;
+    }
+
+    friend bool operator!=(
+        const MultiStreamEngine<ResultType, Generator> &eng1,
+        const MultiStreamEngine<ResultType, Generator> &eng2)
+    {
+        return !(eng1 == eng2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os,
+        const MultiStreamEngine<ResultType, Generator> &eng)
+    {
+        if (!os) {
+            return os;
+        }
+
+        os << eng.result_ << ' ';
+        os << eng.generator_ << ' ';
+        os << eng.index_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is,
+        MultiStreamEngine<ResultType, Generator> &eng)
+    {
+        if (!is) {
+            return is;
+        }
+
+        MultiStreamEngine<ResultType, Generator> eng_tmp;
+        is >> std::ws >> eng_tmp.result_;
+        is >> std::ws >> eng_tmp.generator_;
+        is >> std::ws >> eng_tmp.index_;
+
+        if (is) {
+            eng = std::move(eng_tmp);
+        }
+
+        return is;
+    }
+
+  private:
+    static constexpr unsigned M_ = Generator::size() / sizeof(ResultType);
+
+    std::array<result_type, M_> result_;
+    generator_type generator_;
+    unsigned index_;
+}; // class MultiStreamEngine
+MCKL_POP_CLANG_WARNING
+
+template <typename ResultType, typename Generator>
+class SeedTrait<MultiStreamEngine<ResultType, Generator>>
+{
+  public:
+    using type = std::uint64_t;
+}; // class SeedTrait
+
+template <typename ResultType, typename Generator>
+inline void rand(MultiStreamEngine<ResultType, Generator> &rng, std::size_t n,
+    ResultType *r)
+{
+    rng(n, r);
+}
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_MULTI_STREAM_HPP
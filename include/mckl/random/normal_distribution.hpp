@@ -77,11 +77,24 @@ inline void normal_distribution_impl(
     MCKL_POP_INTEL_WARNING
 }
 
-} // namespace internal
+template <typename RealType, typename RNGType>
+inline void normal_distribution_dispatch(RNGType &rng, std::size_t n,
+    RealType *r, RealType mean, RealType stddev, std::true_type)
+{
+    u01_oo_distribution(rng, n, r);
+    cdfnorminv(n, r, r);
+    MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
+    MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
+    if (stddev != 1 || mean != 0) {
+        muladd(n, r, stddev, mean, r);
+    }
+    MCKL_POP_CLANG_WARNING
+    MCKL_POP_INTEL_WARNING
+}
 
 template <typename RealType, typename RNGType>
-inline void normal_distribution(
-    RNGType &rng, std::size_t n, RealType *r, RealType mean, RealType stddev)
+inline void normal_distribution_dispatch(RNGType &rng, std::size_t n,
+    RealType *r, RealType mean, RealType stddev, std::false_type)
 {
     const std::size_t k = BufferSize<RealType>::value;
     const std::size_t m = n / k;
@@ -100,6 +113,55 @@ inline void normal_distribution(
     }
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void normal_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 mean, P2 stddev)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    distribution_param_log(n, stddev, s.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType z = (x[i] - distribution_param(mean, i)) /
+            distribution_param(stddev, i);
+        r[i] = -static_cast<RealType>(0.5) *
+                (z * z + const_ln_pi_2<RealType>()) -
+            s[i];
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void normal_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 mean, P2 stddev)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = (x[i] - distribution_param(mean, i)) /
+            distribution_param(stddev, i);
+    }
+    cdfnorm(n, r, r);
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void normal_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 mean, P2 stddev)
+{
+    cdfnorminv(n, x, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] =
+            distribution_param(mean, i) + distribution_param(stddev, i) * r[i];
+    }
+}
+MCKL_POP_GCC_WARNING
+
+} // namespace internal
+
+template <typename RealType, typename RNGType>
+inline void normal_distribution(
+    RNGType &rng, std::size_t n, RealType *r, RealType mean, RealType stddev)
+{
+    internal::normal_distribution_dispatch(rng, n, r, mean, stddev,
+        std::integral_constant<bool, QuasiRandomTrait<RNGType>::value>());
+}
+
 template <typename RealType, typename RNGType>
 inline void normal_distribution(RNGType &rng, std::size_t n, RealType *r,
     const typename NormalDistribution<RealType>::param_type &param)
@@ -107,6 +169,9 @@ inline void normal_distribution(RNGType &rng, std::size_t n, RealType *r,
     normal_distribution(rng, n, r, param.mean(), param.stddev());
 }
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(
+    Normal, normal, RealType, mean, stddev)
+
 MCKL_PUSH_CLANG_WARNING("-Wpadded")
 /// \brief Normal distribution
 /// \ingroup Distribution
@@ -135,6 +200,23 @@ class NormalDistribution
   private:
     template <typename RNGType>
     result_type generate(RNGType &rng, const param_type &param)
+    {
+        return generate(rng, param,
+            std::integral_constant<bool, QuasiRandomTrait<RNGType>::value>());
+    }
+
+    template <typename RNGType>
+    result_type generate(
+        RNGType &rng, const param_type &param, std::true_type)
+    {
+        U01OODistribution<RealType> u01;
+
+        return param.mean() + param.stddev() * cdfnorminv(u01(rng));
+    }
+
+    template <typename RNGType>
+    result_type generate(
+        RNGType &rng, const param_type &param, std::false_type)
     {
         result_type z = 0;
         if (saved_) {
@@ -57,6 +57,55 @@ inline void normal_mv_distribution_mulchol(
         static_cast<MCKL_BLAS_INT>(dim), r, static_cast<MCKL_BLAS_INT>(dim));
 }
 
+// Multiply each row of the row-major n by Dim matrix r by the transpose of
+// the full lower triangular matrix cholf in-place
+template <std::size_t Dim, typename RealType>
+inline void normal_mv_distribution_mulchol_row(
+    std::size_t n, RealType *r, const RealType *cholf)
+{
+    for (std::size_t k = 0; k != n; ++k, r += Dim) {
+        for (std::size_t i = Dim; i != 0; --i) {
+            const RealType *l = cholf + (i - 1) * Dim;
+            RealType s = l[i - 1] * r[i - 1];
+            for (std::size_t j = 0; j != i - 1; ++j) {
+                s = muladd(l[j], r[j], s);
+            }
+            r[i - 1] = s;
+        }
+    }
+}
+
+// Multiply each row of the column-major n by dim matrix r, with leading
+// dimension ldr, by the transpose of the full lower triangular matrix cholf
+// in-place. If Dim is positive, it is used instead of dim.
+template <std::size_t Dim, typename RealType>
+inline void normal_mv_distribution_mulchol_col(std::size_t n, RealType *r,
+    std::size_t ldr, std::size_t dim, const RealType *cholf)
+{
+    const std::size_t d = Dim == 0 ? dim : Dim;
+    const std::size_t k = BufferSize<RealType>::value;
+    const std::size_t m = n / k;
+    const std::size_t l = n % k;
+    for (std::size_t b = 0; b <= m; ++b) {
+        const std::size_t nb = b < m ? k : l;
+        RealType *rb = r + b * k;
+        for (std::size_t i = d; i != 0; --i) {
+            const RealType *c = cholf + (i - 1) * d;
+            RealType *y = rb + (i - 1) * ldr;
+            for (std::size_t p = 0; p != nb; ++p) {
+                y[p] *= c[i - 1];
+            }
+            for (std::size_t j = 0; j != i - 1; ++j) {
+                const RealType *z = rb + j * ldr;
+                const RealType a = c[j];
+                for (std::size_t p = 0; p != nb; ++p) {
+                    y[p] = muladd(a, z[p], y[p]);
+                }
+            }
+        }
+    }
+}
+
 } // namespace internal
 
 template <typename RealType, typename RNGType>
@@ -131,33 +180,49 @@ inline void normal_mv_distribution(RNGType &rng, std::size_t n, RealType *r,
 /// \brief Multivariate Normal distribution
 /// \ingroup Distribution
 ///
+/// \tparam RealType The floating point type of the result
+/// \tparam Dim The dimension of the distribution, if it is positive
+///
 /// \details
 /// The distribution is parameterized by its mean vector and the lower
 /// triangular elements of the Cholesky decomposition of the covaraince matrix,
 /// packed row by row.
-template <typename RealType>
+///
+/// If `Dim` is zero, the dimension is specified at runtime, and the batch
+/// generation uses BLAS to apply the Cholesky factor. Otherwise, the
+/// dimension is fixed at compile time, and the factor is applied with fully
+/// unrolled loops, which has much less overhead for small dimensions. In both
+/// cases, the factor is unpacked to a full lower triangular matrix once and
+/// cached in the `param_type` object.
+///
+/// In addition to the usual row-major output, the batch generation can write
+/// the random vectors in column-major layout (SoA), with a given leading
+/// dimension, for example, directly into the columns of
+/// `StateMatrix<ColMajor, RealType>`.
+template <typename RealType, std::size_t Dim>
 class NormalMVDistribution
 {
     MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_BLAS_TYPE(NormalMV)
 
   public:
     using result_type = RealType;
-    using distribution_type = NormalMVDistribution<RealType>;
+    using distribution_type = NormalMVDistribution<RealType, Dim>;
 
     MCKL_PUSH_CLANG_WARNING("-Wpadded")
     class param_type
     {
       public:
         using result_type = RealType;
-        using distribution_type = NormalMVDistribution<RealType>;
+        using distribution_type = NormalMVDistribution<RealType, Dim>;
 
-        explicit param_type(std::size_t dim = 1)
+        explicit param_type(std::size_t dim = Dim == 0 ? 1 : Dim)
             : mean_(dim, 0)
             , chol_(dim * (dim + 1) / 2, 0)
             , is_scalar_mean_(true)
             , is_scalar_chol_(true)
         {
             scalar_chol(1);
+            unpack_chol();
         }
 
         param_type(std::size_t dim, result_type mean, result_type chol)
@@ -167,6 +232,7 @@ class NormalMVDistribution
             , is_scalar_chol_(true)
         {
             scalar_chol(chol);
+            unpack_chol();
         }
 
         param_type(std::size_t dim, result_type mean, const result_type *chol)
@@ -175,6 +241,7 @@ class NormalMVDistribution
             , is_scalar_mean_(true)
             , is_scalar_chol_(false)
         {
+            unpack_chol();
         }
 
         param_type(std::size_t dim, const result_type *mean, result_type chol)
@@ -184,6 +251,7 @@ class NormalMVDistribution
             , is_scalar_chol_(true)
         {
             scalar_chol(chol);
+            unpack_chol();
         }
 
         param_type(
@@ -193,6 +261,7 @@ class NormalMVDistribution
             , is_scalar_mean_(false)
             , is_scalar_chol_(false)
         {
+            unpack_chol();
         }
 
         std::size_t dim() const { return mean_.size(); }
@@ -256,7 +325,12 @@ class NormalMVDistribution
             is >> std::ws >> tmp.is_scalar_mean_;
             is >> std::ws >> tmp.is_scalar_chol_;
 
+            if (is && Dim != 0 && tmp.mean_.size() != Dim) {
+                is.setstate(std::ios_base::failbit);
+            }
+
             if (is) {
+                tmp.unpack_chol();
                 param = std::move(tmp);
             } else {
                 is.setstate(std::ios_base::failbit);
@@ -268,6 +342,7 @@ class NormalMVDistribution
       private:
         Vector<result_type> mean_;
         Vector<result_type> chol_;
+        Vector<result_type> cholf_;
         bool is_scalar_mean_;
         bool is_scalar_chol_;
 
@@ -279,11 +354,29 @@ class NormalMVDistribution
                 chol_[(i + 1) * (i + 2) / 2 - 1] = chol;
             }
         }
+
+        void unpack_chol()
+        {
+            runtime_assert(Dim == 0 || dim() == Dim,
+                "**NormalMVDistribution::param_type** constructed with a "
+                "dimension other than Dim");
+
+            const std::size_t d = dim();
+            cholf_.resize(d * d);
+            std::fill(cholf_.begin(), cholf_.end(), const_zero<RealType>());
+            const result_type *chol = chol_.data();
+            for (std::size_t i = 0; i != d; ++i) {
+                for (std::size_t j = 0; j <= i; ++j) {
+                    cholf_[i * d + j] = *chol++;
+                }
+            }
+        }
     }; // class param_type
     MCKL_POP_CLANG_WARNING
 
     /// \brief Construct a distribution with scalar mean and scalar covariance
-    explicit NormalMVDistribution(std::size_t dim = 1) : param_(dim)
+    explicit NormalMVDistribution(std::size_t dim = Dim == 0 ? 1 : Dim)
+        : param_(dim)
     {
         reset();
     }
@@ -388,19 +481,108 @@ class NormalMVDistribution
     void operator()(
         RNGType &rng, std::size_t n, result_type *r, const param_type &param)
     {
-        if (param.is_scalar_mean_ && param.is_scalar_chol_) {
-            normal_mv_distribution(
-                rng, n, r, param.dim(), param.mean()[0], param.chol()[0]);
-        } else if (param.is_scalar_mean_ && !param.is_scalar_chol_) {
-            normal_mv_distribution(
-                rng, n, r, param.dim(), param.mean()[0], param.chol());
-        } else if (!param.is_scalar_mean_ && param.is_scalar_chol_) {
-            normal_mv_distribution(
-                rng, n, r, param.dim(), param.mean(), param.chol()[0]);
-        } else if (!param.is_scalar_mean_ && !param.is_scalar_chol_) {
-            normal_mv_distribution(
-                rng, n, r, param.dim(), param.mean(), param.chol());
+        if (param.is_scalar_chol_) {
+            if (param.is_scalar_mean_) {
+                normal_mv_distribution(
+                    rng, n, r, param.dim(), param.mean()[0], param.chol()[0]);
+            } else {
+                normal_mv_distribution(
+                    rng, n, r, param.dim(), param.mean(), param.chol()[0]);
+            }
+            return;
         }
+
+        const std::size_t d = param.dim();
+        internal::size_check<MCKL_BLAS_INT>(n, "NormalMVDistribution");
+        internal::size_check<MCKL_BLAS_INT>(d, "NormalMVDistribution");
+
+        normal_distribution(
+            rng, n * d, r, const_zero<RealType>(), const_one<RealType>());
+        mulchol_row(n, r, param, std::integral_constant<bool, Dim == 0>());
+        MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
+        MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
+        if (!param.is_scalar_mean_) {
+            for (std::size_t i = 0; i != n; ++i, r += d) {
+                add<result_type>(d, param.mean(), r, r);
+            }
+        } else if (param.mean()[0] != 0) {
+            add(n * d, param.mean()[0], r, r);
+        }
+        MCKL_POP_CLANG_WARNING
+        MCKL_POP_INTEL_WARNING
+    }
+
+    /// \brief Generate random vectors in a given storage layout
+    ///
+    /// \param rng The RNG engine
+    /// \param layout The storage layout of the output
+    /// \param n The number of random vectors
+    /// \param r The output. If `layout` is RowMajor, the \f$j\f$-th
+    /// component of the \f$i\f$-th vector is written to `r[i * ldr + j]`.
+    /// Otherwise it is written to `r[i + j * ldr]`.
+    /// \param ldr The leading dimension of the output, at least `dim()` if
+    /// `layout` is RowMajor, and at least `n` otherwise
+    ///
+    /// \details
+    /// With the column-major layout, each component is generated as a whole,
+    /// and the Cholesky factor is applied to blocks of components, which
+    /// vectorizes well. The results differ from those of the row-major
+    /// layout with the same RNG state.
+    template <typename RNGType>
+    void operator()(RNGType &rng, MatrixLayout layout, std::size_t n,
+        result_type *r, std::size_t ldr)
+    {
+        operator()(rng, layout, n, r, ldr, param_);
+    }
+
+    /// \brief Generate random vectors in a given storage layout
+    template <typename RNGType>
+    void operator()(RNGType &rng, MatrixLayout layout, std::size_t n,
+        result_type *r, std::size_t ldr, const param_type &param)
+    {
+        const std::size_t d = param.dim();
+
+        if (layout == RowMajor) {
+            runtime_assert(ldr >= d,
+                "**NormalMVDistribution** used with leading dimension less "
+                "than the dimension of a row-major output");
+            if (ldr == d) {
+                operator()(rng, n, r, param);
+            } else {
+                for (std::size_t i = 0; i != n; ++i, r += ldr) {
+                    operator()(rng, 1, r, param);
+                }
+            }
+            return;
+        }
+
+        runtime_assert(ldr >= n,
+            "**NormalMVDistribution** used with leading dimension less than "
+            "the number of rows of a column-major output");
+
+        if (param.is_scalar_chol_) {
+            for (std::size_t j = 0; j != d; ++j) {
+                normal_distribution(rng, n, r + j * ldr,
+                    const_zero<RealType>(), param.chol()[0]);
+            }
+        } else {
+            for (std::size_t j = 0; j != d; ++j) {
+                normal_distribution(rng, n, r + j * ldr,
+                    const_zero<RealType>(), const_one<RealType>());
+            }
+            internal::normal_mv_distribution_mulchol_col<Dim>(
+                n, r, ldr, d, param.cholf_.data());
+        }
+        MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
+        MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
+        for (std::size_t j = 0; j != d; ++j) {
+            const result_type m = param.mean()[param.is_scalar_mean_ ? 0 : j];
+            if (m != 0) {
+                add(n, m, r + j * ldr, r + j * ldr);
+            }
+        }
+        MCKL_POP_CLANG_WARNING
+        MCKL_POP_INTEL_WARNING
     }
 
     friend bool operator==(
@@ -467,7 +649,7 @@ class NormalMVDistribution
             for (std::size_t i = 0; i != param.dim(); ++i) {
                 r[i] = normal(rng);
             }
-            mulchol(r, param);
+            mulchol(r, param, std::integral_constant<bool, Dim == 0>());
             if (param.mean()[0] != 0) {
                 add<result_type>(param.dim(), param.mean(), r, r);
             }
@@ -480,42 +662,71 @@ class NormalMVDistribution
         } else if (!param.is_scalar_mean_ && !param.is_scalar_chol_) {
             NormalDistribution<RealType> normal(0, 1);
             normal(rng, param.dim(), r);
-            mulchol(r, param);
+            mulchol(r, param, std::integral_constant<bool, Dim == 0>());
             add<result_type>(param.dim(), param.mean(), r, r);
         }
         MCKL_POP_CLANG_WARNING
         MCKL_POP_INTEL_WARNING
     }
 
-    void mulchol(float *r, const param_type &param)
+    void mulchol(result_type *r, const param_type &param, std::false_type)
+    {
+        internal::normal_mv_distribution_mulchol_row<Dim>(
+            1, r, param.cholf_.data());
+    }
+
+    void mulchol(float *r, const param_type &param, std::true_type)
     {
         internal::cblas_stpmv(internal::CblasRowMajor, internal::CblasLower,
             internal::CblasNoTrans, internal::CblasNonUnit,
             static_cast<MCKL_BLAS_INT>(dim()), param.chol(), r, 1);
     }
 
-    void mulchol(double *r, const param_type &param)
+    void mulchol(double *r, const param_type &param, std::true_type)
     {
         internal::cblas_dtpmv(internal::CblasRowMajor, internal::CblasLower,
             internal::CblasNoTrans, internal::CblasNonUnit,
             static_cast<MCKL_BLAS_INT>(dim()), param.chol(), r, 1);
     }
+
+    void mulchol_row(std::size_t n, result_type *r, const param_type &param,
+        std::false_type)
+    {
+        internal::normal_mv_distribution_mulchol_row<Dim>(
+            n, r, param.cholf_.data());
+    }
+
+    void mulchol_row(std::size_t n, result_type *r, const param_type &param,
+        std::true_type)
+    {
+        internal::normal_mv_distribution_mulchol(
+            n, r, param.dim(), param.cholf_.data());
+    }
 }; // class NormalMVDistribution
 
-template <typename RealType, typename RNGType>
-inline void rand(
-    RNGType &rng, NormalMVDistribution<RealType> &distribution, RealType *r)
+template <typename RealType, std::size_t Dim, typename RNGType>
+inline void rand(RNGType &rng,
+    NormalMVDistribution<RealType, Dim> &distribution, RealType *r)
 {
     distribution(rng, r);
 }
 
-template <typename RealType, typename RNGType>
-inline void rand(RNGType &rng, NormalMVDistribution<RealType> &distribution,
-    std::size_t n, RealType *r)
+template <typename RealType, std::size_t Dim, typename RNGType>
+inline void rand(RNGType &rng,
+    NormalMVDistribution<RealType, Dim> &distribution, std::size_t n,
+    RealType *r)
 {
     distribution(rng, n, r);
 }
 
+template <typename RealType, std::size_t Dim, typename RNGType>
+inline void rand(RNGType &rng,
+    NormalMVDistribution<RealType, Dim> &distribution, MatrixLayout layout,
+    std::size_t n, RealType *r, std::size_t ldr)
+{
+    distribution(rng, layout, n, r, ldr);
+}
+
 } // namespace mckl
 
 #endif // MCKL_RANDOM_NORMAL_MV_DISTRIBUTION_HPP
@@ -54,11 +54,71 @@ inline void pareto_distribution_impl(
     mul(n, b, r, r);
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void pareto_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> u;
+    distribution_param_log(n, a, s.data());
+    distribution_param_log(n, b, u.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] > 0 ? x[i] : 1;
+    }
+    log(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType c = distribution_param(a, i);
+        const RealType v = s[i] + c * u[i] - (c + 1) * t[i];
+        r[i] = x[i] < distribution_param(b, i) ? -const_inf<RealType>() : v;
+    }
+}
+
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void pareto_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType c = distribution_param(b, i);
+        t[i] = x[i] > c ? c / x[i] : 1;
+    }
+    log(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] *= distribution_param(a, i);
+    }
+    expm1(n, t.data(), r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -r[i];
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void pareto_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -x[i];
+    }
+    log1p(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] /= -distribution_param(a, i);
+    }
+    exp(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] *= distribution_param(b, i);
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     Pareto, pareto, RealType, RealType, a, RealType, b)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(Pareto, pareto, RealType, a, b)
+
 /// \brief Pareto distribution
 /// \ingroup Distribution
 template <typename RealType>
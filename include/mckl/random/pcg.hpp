@@ -0,0 +1,273 @@
+//============================================================================
+// MCKL/include/mckl/random/pcg.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_PCG_HPP
+#define MCKL_RANDOM_PCG_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/philox_common.hpp>
+#include <mckl/random/multi_stream.hpp>
+
+namespace mckl {
+
+/// \brief PCG64 (XSL-RR 128/64) RNG generator with multiple streams
+/// \ingroup PCG
+///
+/// \tparam K Number of streams advanced in lockstep
+///
+/// \details
+/// All streams share the same increment, and the state of stream `i` is that
+/// of stream `i - 1` advanced by \f$2^{64}\f$ steps. The 128-bit states are
+/// stored as pairs of 64-bit words, low word first, word-major across the
+/// streams. There is no vector instruction for the full 64-bit
+/// multiplication, and the streams are instead interleaved such that their
+/// independent scalar multiplications can be pipelined.
+template <std::size_t K>
+class PCG64Generator
+{
+    static_assert(K != 0, "**PCG64Generator** used with K equal to 0");
+
+  public:
+    using state_type = std::array<std::uint64_t, K * 4>;
+
+    static constexpr std::size_t size() { return sizeof(std::uint64_t) * K; }
+
+    PCG64Generator() { reset(1); }
+
+    /// \brief Seed the first stream with SplitMix64 and partition the rest
+    void reset(std::uint64_t s)
+    {
+        s_[K * 0] = internal::splitmix64(s);
+        s_[K * 1] = internal::splitmix64(s);
+        s_[K * 2] = internal::splitmix64(s) | 1;
+        s_[K * 3] = internal::splitmix64(s);
+        for (std::size_t i = 1; i != K; ++i) {
+            for (std::size_t j = 0; j != 4; ++j) {
+                s_[K * j + i] = s_[K * j + i - 1];
+            }
+            advance(i, 1, 0);
+        }
+    }
+
+    const state_type &state() const { return s_; }
+
+    void state(const state_type &s) { s_ = s; }
+
+    template <typename ResultType>
+    void operator()(ResultType *r)
+    {
+        alignas(MCKL_ALIGNMENT) std::array<std::uint64_t, K> buf;
+        generate(buf.data());
+        std::memcpy(r, buf.data(), sizeof(std::uint64_t) * K);
+    }
+
+    template <typename ResultType>
+    void operator()(std::size_t n, ResultType *r)
+    {
+        constexpr std::size_t R = sizeof(std::uint64_t) * K /
+            sizeof(ResultType);
+
+        for (std::size_t i = 0; i != n; ++i, r += R) {
+            operator()(r);
+        }
+    }
+
+    /// \brief Advance each stream by `n` steps in \f$O(\log n)\f$ time
+    void discard(std::uint64_t n)
+    {
+        for (std::size_t i = 0; i != K; ++i) {
+            advance(i, 0, n);
+        }
+    }
+
+    /// \brief Advance each stream by \f$K 2^{64}\f$ steps
+    void jump()
+    {
+        for (std::size_t i = 0; i != K; ++i) {
+            advance(i, K, 0);
+        }
+    }
+
+    /// \brief Advance each stream by \f$2^{96}\f$ steps
+    void long_jump()
+    {
+        for (std::size_t i = 0; i != K; ++i) {
+            advance(i, const_one<std::uint64_t>() << 32, 0);
+        }
+    }
+
+    friend bool operator==(
+        const PCG64Generator<K> &gen1, const PCG64Generator<K> &gen2)
+    {
+        return gen1.s_ == gen2.s_;
+    }
+
+    friend bool operator!=(
+        const PCG64Generator<K> &gen1, const PCG64Generator<K> &gen2)
+    {
+        return !(gen1 == gen2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os, const PCG64Generator<K> &gen)
+    {
+        if (!os) {
+            return os;
+        }
+
+        os << gen.s_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is, PCG64Generator<K> &gen)
+    {
+        if (!is) {
+            return is;
+        }
+
+        state_type s;
+        is >> std::ws >> s;
+
+        if (is) {
+            gen.s_ = s;
+        }
+
+        return is;
+    }
+
+  private:
+    static constexpr std::uint64_t mul_lo_ = UINT64_C(4865540595714422341);
+    static constexpr std::uint64_t mul_hi_ = UINT64_C(2549297995355413924);
+
+    state_type s_;
+
+    void generate(std::uint64_t *r)
+    {
+        std::uint64_t *lo = s_.data();
+        std::uint64_t *hi = lo + K;
+        const std::uint64_t *inc_lo = hi + K;
+        const std::uint64_t *inc_hi = inc_lo + K;
+        for (std::size_t i = 0; i != K; ++i) {
+            mul(hi[i], lo[i], mul_hi_, mul_lo_);
+            add(hi[i], lo[i], inc_hi[i], inc_lo[i]);
+        }
+        for (std::size_t i = 0; i != K; ++i) {
+            const std::uint64_t x = hi[i] ^ lo[i];
+            const int rot = static_cast<int>(hi[i] >> 58);
+            r[i] = (x >> rot) | (x << ((64 - rot) & 63));
+        }
+    }
+
+    // Brown, F. B. (1994). Random number generation with arbitrary strides.
+    void advance(std::size_t i, std::uint64_t delta_hi, std::uint64_t delta_lo)
+    {
+        std::uint64_t acc_mul_hi = 0;
+        std::uint64_t acc_mul_lo = 1;
+        std::uint64_t acc_add_hi = 0;
+        std::uint64_t acc_add_lo = 0;
+        std::uint64_t cur_mul_hi = mul_hi_;
+        std::uint64_t cur_mul_lo = mul_lo_;
+        std::uint64_t cur_add_hi = s_[K * 3 + i];
+        std::uint64_t cur_add_lo = s_[K * 2 + i];
+        while (delta_hi != 0 || delta_lo != 0) {
+            if ((delta_lo & 1) != 0) {
+                mul(acc_mul_hi, acc_mul_lo, cur_mul_hi, cur_mul_lo);
+                mul(acc_add_hi, acc_add_lo, cur_mul_hi, cur_mul_lo);
+                add(acc_add_hi, acc_add_lo, cur_add_hi, cur_add_lo);
+            }
+            std::uint64_t t_hi = cur_mul_hi;
+            std::uint64_t t_lo = cur_mul_lo;
+            add(t_hi, t_lo, 0, 1);
+            mul(cur_add_hi, cur_add_lo, t_hi, t_lo);
+            mul(cur_mul_hi, cur_mul_lo, cur_mul_hi, cur_mul_lo);
+            delta_lo = (delta_lo >> 1) | (delta_hi << 63);
+            delta_hi >>= 1;
+        }
+        mul(s_[K * 1 + i], s_[K * 0 + i], acc_mul_hi, acc_mul_lo);
+        add(s_[K * 1 + i], s_[K * 0 + i], acc_add_hi, acc_add_lo);
+    }
+
+    // (ah, al) = (ah, al) * (bh, bl) modulo 2^128
+    static void mul(std::uint64_t &ah, std::uint64_t &al, std::uint64_t bh,
+        std::uint64_t bl)
+    {
+        std::uint64_t h = 0;
+        const std::uint64_t l =
+            internal::PhiloxHiLo<std::uint64_t>::eval(al, bl, h);
+        ah = h + ah * bl + al * bh;
+        al = l;
+    }
+
+    // (ah, al) = (ah, al) + (bh, bl) modulo 2^128
+    static void add(std::uint64_t &ah, std::uint64_t &al, std::uint64_t bh,
+        std::uint64_t bl)
+    {
+        al += bl;
+        ah += bh + (al < bl ? 1 : 0);
+    }
+}; // class PCG64Generator
+
+/// \brief PCG64 RNG engine with multiple streams
+/// \ingroup PCG
+template <typename ResultType, std::size_t K = 1>
+using PCG64Engine = MultiStreamEngine<ResultType, PCG64Generator<K>>;
+
+/// \brief PCG64 RNG engine with 32-bit output and a single stream
+/// \ingroup PCG
+using PCG64 = PCG64Engine<std::uint32_t>;
+
+/// \brief PCG64 RNG engine with 32-bit output and 4 streams
+/// \ingroup PCG
+using PCG64x4 = PCG64Engine<std::uint32_t, 4>;
+
+/// \brief PCG64 RNG engine with 32-bit output and 8 streams
+/// \ingroup PCG
+using PCG64x8 = PCG64Engine<std::uint32_t, 8>;
+
+/// \brief PCG64 RNG engine with 64-bit output and a single stream
+/// \ingroup PCG
+using PCG64_64 = PCG64Engine<std::uint64_t>;
+
+/// \brief PCG64 RNG engine with 64-bit output and 4 streams
+/// \ingroup PCG
+using PCG64x4_64 = PCG64Engine<std::uint64_t, 4>;
+
+/// \brief PCG64 RNG engine with 64-bit output and 8 streams
+/// \ingroup PCG
+using PCG64x8_64 = PCG64Engine<std::uint64_t, 8>;
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_PCG_HPP
@@ -46,20 +46,34 @@ class PoissonTest
 
     bool pass(double alpha, result_type s) const
     {
-        double l = cdf(s);
-        double r = s > 0 ? 1 - cdf(s - 1) : 1;
-        double p = 0;
-        if (r < l) {
-            p = r;
-        } else if (l < 0.5) {
-            p = 1 - l;
-        } else {
-            p = 0.5;
-        }
+        double p = pvalue(s);
 
         return std::min(p, 1 - p) > 0.5 * alpha;
     }
 
+    /// \brief The p-value of the sum of `m` independent statistics
+    ///
+    /// \details
+    /// The sum of \f$m\f$ independent Poisson statistics with mean
+    /// \f$\lambda\f$ has the Poisson distribution with mean
+    /// \f$m\lambda\f$. The probability of the right tail is returned if it
+    /// is the smaller one, and one minus that of the left tail otherwise,
+    /// such that values close to zero or one indicate a failure.
+    double pvalue(result_type s, std::size_t m = 1) const
+    {
+        double mean = static_cast<double>(m) *
+            static_cast<const Derived *>(this)->mean();
+        double l = cdf(s, mean);
+        double r = s > 0 ? 1 - cdf(s - 1, mean) : 1;
+        if (r < l) {
+            return r;
+        }
+        if (l < 0.5) {
+            return 1 - l;
+        }
+        return 0.5;
+    }
+
     double pdf(result_type s) const
     {
         double mean = static_cast<const Derived *>(this)->mean();
@@ -71,8 +85,12 @@ class PoissonTest
 
     double cdf(result_type s) const
     {
-        double mean = static_cast<const Derived *>(this)->mean();
+        return cdf(s, static_cast<const Derived *>(this)->mean());
+    }
 
+  private:
+    double cdf(result_type s, double mean) const
+    {
         return 1 - gammap(static_cast<double>(s + 1), mean);
     }
 }; // class PoissonTest
@@ -0,0 +1,336 @@
+//============================================================================
+// MCKL/include/mckl/random/qmc.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_QMC_HPP
+#define MCKL_RANDOM_QMC_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/multi_stream.hpp>
+
+namespace mckl {
+
+/// \brief Scrambling of quasi-random sequences
+/// \ingroup QMC
+enum class QMCScramble {
+    None, ///< No scrambling
+    LMS,  ///< Linear matrix scrambling and random digital shift
+    Owen  ///< Nested uniform scrambling
+};        // enum class QMCScramble
+
+/// \brief No scrambling
+/// \ingroup QMC
+constexpr QMCScramble QMCScrambleNone = QMCScramble::None;
+
+/// \brief Linear matrix scrambling and random digital shift
+/// \ingroup QMC
+constexpr QMCScramble QMCScrambleLMS = QMCScramble::LMS;
+
+/// \brief Nested uniform scrambling
+/// \ingroup QMC
+constexpr QMCScramble QMCScrambleOwen = QMCScramble::Owen;
+
+namespace internal {
+
+/// \brief Seed of the random bits used to scramble a given dimension
+///
+/// \details
+/// The seed depends only on the seed of the sequence and the (absolute)
+/// dimension, such that an engine restricted to a subset of dimensions
+/// produces the same coordinates as one over all the dimensions.
+inline std::uint64_t qmc_scramble_seed(std::uint64_t seed, std::size_t d)
+{
+    std::uint64_t s = splitmix64(seed) ^ static_cast<std::uint64_t>(d);
+
+    return splitmix64(s);
+}
+
+} // namespace internal
+
+MCKL_PUSH_CLANG_WARNING("-Wpadded")
+/// \brief Quasi-random number engine
+/// \ingroup QMC
+///
+/// \tparam ResultType The output unsigned integer type. Each coordinate is
+/// the fixed point representation of a number in \f$[0, 1)\f$. Use 64-bit
+/// integers for double precision output, such that each floating point
+/// number consumes exactly one coordinate
+/// \tparam Generator The generator of the points
+/// - Requirement
+/// ~~~{.cpp}
+/// /* Construct with dim coordinates, starting from dimension offset */
+/// Generator(std::size_t dim, std::size_t offset,
+///     QMCScramble scramble, std::uint64_t seed);
+/// void reset(std::uint64_t seed); /* rescramble and seek(0) */
+/// std::size_t dim() const;
+/// std::size_t offset() const;
+/// QMCScramble scramble() const;
+/// std::uint64_t seed() const;
+/// std::uint64_t index() const; /* index of the next point */
+/// void seek(std::uint64_t i);  /* move to the point with index i */
+///
+/// /* Generate n points (n * dim() coordinates, row major) */
+/// void operator()(std::size_t n, ResultType *r);
+/// ~~~
+///
+/// \details
+/// The engine is a uniform random bit generator that outputs the coordinates
+/// of successive points. For example, `u01_co_distribution(rng, n * dim, r)`
+/// generates a row major `n` by `dim` matrix of points in \f$[0,1)^d\f$,
+/// and `normal_distribution(rng, n * dim, r, 0.0, 1.0)` transforms them to
+/// standard normal by the inverse CDF. Other continuous distributions do not
+/// in general preserve the low discrepancy of the sequence.
+///
+/// To use the sequence within SMCSampler, partition the dimensions among
+/// the iterations, for example with an engine constructed with `offset`
+/// equal to the number of dimensions consumed by previous iterations, and
+/// partition the points among the particles with `seek`, such that the
+/// particle `i` uses the point `i`.
+template <typename ResultType, typename Generator>
+class QMCEngine
+{
+    static_assert(std::is_unsigned<ResultType>::value,
+        "**QMCEngine** used with ResultType other than unsigned intger "
+        "types");
+
+  public:
+    using result_type = ResultType;
+    using generator_type = Generator;
+    using skip_type = std::uint64_t;
+
+    /// \brief Construct an engine
+    ///
+    /// \param dim The number of dimensions
+    /// \param scramble The scrambling method
+    /// \param s The seed of the scrambling
+    /// \param offset The first dimension of the sequence used by this engine
+    explicit QMCEngine(std::size_t dim = 1,
+        QMCScramble scramble = QMCScramble::None, std::uint64_t s = 1,
+        std::size_t offset = 0)
+        : generator_(dim, offset, scramble, s), point_(dim), index_(dim)
+    {
+    }
+
+    /// \brief Rescramble the sequence and move to the first point
+    void seed(std::uint64_t s)
+    {
+        generator_.reset(s);
+        index_ = point_.size();
+    }
+
+    std::size_t dim() const { return generator_.dim(); }
+
+    std::size_t offset() const { return generator_.offset(); }
+
+    QMCScramble scramble() const { return generator_.scramble(); }
+
+    generator_type &generator() { return generator_; }
+
+    const generator_type &generator() const { return generator_; }
+
+    /// \brief The index of the point of the next coordinate
+    std::uint64_t index() const
+    {
+        return index_ == point_.size() ? generator_.index() :
+                                         generator_.index() - 1;
+    }
+
+    /// \brief Move to the first coordinate of the point with index `i`
+    void seek(std::uint64_t i)
+    {
+        generator_.seek(i);
+        index_ = point_.size();
+    }
+
+    result_type operator()()
+    {
+        if (index_ == point_.size()) {
+            generator_(1, point_.data());
+            index_ = 0;
+        }
+
+        return point_[index_++];
+    }
+
+    void operator()(std::size_t n, result_type *r)
+    {
+        const std::size_t d = point_.size();
+        const std::size_t remain = d - index_;
+
+        if (n <= remain) {
+            std::copy_n(point_.data() + index_, n, r);
+            index_ += n;
+            return;
+        }
+
+        std::copy_n(point_.data() + index_, remain, r);
+        r += remain;
+        n -= remain;
+        index_ = d;
+
+        const std::size_t m = n / d;
+        generator_(m, r);
+        r += m * d;
+        n -= m * d;
+
+        if (n != 0) {
+            generator_(1, point_.data());
+            std::copy_n(point_.data(), n, r);
+            index_ = n;
+        }
+    }
+
+    /// \brief Discard the remaining coordinates of the current point
+    ///
+    /// \return The number of coordinates discarded
+    std::size_t discard()
+    {
+        const std::size_t remain = point_.size() - index_;
+        index_ = point_.size();
+
+        return remain;
+    }
+
+    void discard(skip_type nskip)
+    {
+        const skip_type d = static_cast<skip_type>(point_.size());
+        const skip_type remain =
+            static_cast<skip_type>(point_.size() - index_);
+        if (nskip <= remain) {
+            index_ += static_cast<std::size_t>(nskip);
+            return;
+        }
+        nskip -= remain;
+
+        generator_.seek(generator_.index() + nskip / d);
+        index_ = static_cast<std::size_t>(nskip % d);
+        if (index_ != 0) {
+            generator_(1, point_.data());
+        } else {
+            index_ = point_.size();
+        }
+    }
+
+    static constexpr result_type min()
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    friend bool operator==(const QMCEngine<ResultType, Generator> &eng1,
+        const QMCEngine<ResultType, Generator> &eng2)
+    {
+        if (eng1.generator_ != eng2.generator_) {
+            return false;
+        }
+        if (eng1.index_ != eng2.index_) {
+            return false;
+        }
+        return eng1.point_ == eng2.point_;
+    }
+
+    friend bool operator!=(const QMCEngine<ResultType, Generator> &eng1,
+        const QMCEngine<ResultType, Generator> &eng2)
+    {
+        return !(eng1 == eng2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os,
+        const QMCEngine<ResultType, Generator> &eng)
+    {
+        if (!os) {
+            return os;
+        }
+
+        os << eng.generator_ << ' ';
+        os << eng.point_ << ' ';
+        os << eng.index_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is,
+        QMCEngine<ResultType, Generator> &eng)
+    {
+        if (!is) {
+            return is;
+        }
+
+        QMCEngine<ResultType, Generator> eng_tmp;
+        is >> std::ws >> eng_tmp.generator_;
+        is >> std::ws >> eng_tmp.point_;
+        is >> std::ws >> eng_tmp.index_;
+
+        if (is) {
+            eng = std::move(eng_tmp);
+        }
+
+        return is;
+    }
+
+  private:
+    generator_type generator_;
+    Vector<result_type> point_;
+    std::size_t index_;
+}; // class QMCEngine
+MCKL_POP_CLANG_WARNING
+
+template <typename ResultType, typename Generator>
+class SeedTrait<QMCEngine<ResultType, Generator>>
+{
+  public:
+    using type = std::uint64_t;
+}; // class SeedTrait
+
+template <typename ResultType, typename Generator>
+class QuasiRandomTrait<QMCEngine<ResultType, Generator>>
+{
+  public:
+    static constexpr bool value = true;
+}; // class QuasiRandomTrait
+
+template <typename ResultType, typename Generator>
+inline void rand(
+    QMCEngine<ResultType, Generator> &rng, std::size_t n, ResultType *r)
+{
+    rng(n, r);
+}
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_QMC_HPP
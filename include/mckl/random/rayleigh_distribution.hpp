@@ -55,11 +55,66 @@ inline void rayleigh_distribution_impl(
     sqrt(n, r, r);
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1>
+inline void rayleigh_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 sigma)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    distribution_param_log(n, sigma, s.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] > 0 ? x[i] : 0;
+    }
+    log(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType z = x[i] / distribution_param(sigma, i);
+        const RealType v =
+            t[i] - 2 * s[i] - static_cast<RealType>(0.5) * z * z;
+        r[i] = x[i] < 0 ? -const_inf<RealType>() : v;
+    }
+}
+
+template <std::size_t, typename RealType, typename P1>
+inline void rayleigh_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 sigma)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType z = x[i] / distribution_param(sigma, i);
+        r[i] = x[i] > 0 ? -static_cast<RealType>(0.5) * z * z : 0;
+    }
+    expm1(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -r[i];
+    }
+}
+
+template <std::size_t, typename RealType, typename P1>
+inline void rayleigh_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 sigma)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -x[i];
+    }
+    log1p(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] *= -2;
+    }
+    sqrt(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] *= distribution_param(sigma, i);
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_1(
     Rayleigh, rayleigh, RealType, RealType, sigma)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_1(
+    Rayleigh, rayleigh, RealType, sigma)
+
 /// \brief Rayleigh distribution
 /// \ingroup Distribution
 template <typename RealType>
@@ -55,8 +55,12 @@
 #endif
 
 #include <mckl/random/aes.hpp>
+#include <mckl/random/halton.hpp>
+#include <mckl/random/pcg.hpp>
 #include <mckl/random/philox.hpp>
+#include <mckl/random/sobol.hpp>
 #include <mckl/random/threefry.hpp>
+#include <mckl/random/xoshiro.hpp>
 
 #if MCKL_HAS_MKL
 #include <mckl/random/mkl.hpp>
@@ -71,6 +71,8 @@ class RNGSetScalar
 
     rng_type &operator[](size_type) { return rng_; }
 
+    const rng_type &operator[](size_type) const { return rng_; }
+
   private:
     std::size_t size_;
     rng_type rng_;
@@ -115,6 +117,11 @@ class RNGSetVector
 
     rng_type &operator[](size_type id) { return rng_[id % size()]; }
 
+    const rng_type &operator[](size_type id) const
+    {
+        return rng_[id % size()];
+    }
+
   private:
     Vector<rng_type> rng_;
 }; // class RNGSetVector
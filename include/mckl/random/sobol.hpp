@@ -0,0 +1,404 @@
+//============================================================================
+// MCKL/include/mckl/random/sobol.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_SOBOL_HPP
+#define MCKL_RANDOM_SOBOL_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/sobol_constants.hpp>
+#include <mckl/random/qmc.hpp>
+
+namespace mckl {
+
+namespace internal {
+
+template <typename UIntType>
+inline UIntType sobol_parity(UIntType x)
+{
+    constexpr int W = std::numeric_limits<UIntType>::digits;
+
+    for (int s = W / 2; s != 0; s /= 2) {
+        x ^= x >> s;
+    }
+
+    return x & 1;
+}
+
+/// \brief Nested uniform scrambling with the random permutation of each
+/// node of the binary tree given by a hash of the node and the seed
+template <typename UIntType>
+inline UIntType sobol_owen(UIntType x, std::uint64_t seed)
+{
+    constexpr int W = std::numeric_limits<UIntType>::digits;
+
+    UIntType y = x;
+    for (int j = 0; j != W; ++j) {
+        const std::uint64_t prefix =
+            j == 0 ? 0 : static_cast<std::uint64_t>(x >> (W - j));
+        const std::uint64_t node = (UINT64_C(1) << j) | prefix;
+        std::uint64_t z = seed + node * UINT64_C(0x9E3779B97F4A7C15);
+        z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+        z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+        y ^= static_cast<UIntType>((z ^ (z >> 31)) >> 63) << (W - 1 - j);
+    }
+
+    return y;
+}
+
+} // namespace internal
+
+MCKL_PUSH_CLANG_WARNING("-Wpadded")
+/// \brief Sobol sequence generator
+/// \ingroup QMC
+///
+/// \details
+/// The first dimension is the van der Corput sequence, and the primitive
+/// polynomials and initial direction numbers of the others are those of
+/// Joe and Kuo (2008), up to 1024 dimensions. The points are generated in
+/// the Gray code order, such that each point is obtained from the previous
+/// one by a XOR with one direction number for each dimension, and any point
+/// can be reached in \f$O(W)\f$ operations for each dimension, where \f$W\f$
+/// is the number of bits of `UIntType`. At most \f$2^W\f$ points can be
+/// generated. Seeking or generating beyond them is a runtime assertion
+/// failure.
+///
+/// With linear matrix scrambling, the direction numbers are multiplied by
+/// random lower triangular binary matrices with unit diagonal, and the
+/// points are shifted by random digital shifts. With Owen scrambling, each
+/// coordinate of each point is scrambled by random permutations nested
+/// along its binary digits. Both preserve the net properties of the
+/// sequence. The Owen scrambling is exact and costs \f$O(W)\f$ hashes for
+/// each coordinate, while the linear matrix scrambling costs nothing after
+/// the construction.
+template <typename UIntType>
+class SobolGenerator
+{
+    static_assert(std::is_unsigned<UIntType>::value &&
+            (std::numeric_limits<UIntType>::digits == 32 ||
+                std::numeric_limits<UIntType>::digits == 64),
+        "**SobolGenerator** used with UIntType other than 32 or 64-bit "
+        "unsigned integer types");
+
+  public:
+    SobolGenerator(std::size_t dim = 1, std::size_t offset = 0,
+        QMCScramble scramble = QMCScramble::None, std::uint64_t seed = 1)
+        : dim_(dim)
+        , offset_(offset)
+        , scramble_(scramble)
+        , seed_(seed)
+        , index_(0)
+        , v_(dim * W_)
+        , x_(dim)
+        , shift_(dim)
+        , owen_(dim)
+    {
+        runtime_assert(dim != 0, "**SobolGenerator** dimension equal to 0");
+        runtime_assert(offset + dim <= max_dim(),
+            "**SobolGenerator** dimension larger than max_dim()");
+
+        reset(seed);
+    }
+
+    /// \brief The maximum number of dimensions
+    static constexpr std::size_t max_dim()
+    {
+        return internal::SobolConstants::max_dim();
+    }
+
+    void reset(std::uint64_t seed)
+    {
+        seed_ = seed;
+        direction();
+        switch (scramble_) {
+            case QMCScramble::None:
+                std::fill(shift_.begin(), shift_.end(), 0);
+                break;
+            case QMCScramble::LMS:
+                scramble_lms();
+                break;
+            case QMCScramble::Owen:
+                std::fill(shift_.begin(), shift_.end(), 0);
+                for (std::size_t d = 0; d != dim_; ++d) {
+                    owen_[d] = internal::qmc_scramble_seed(seed_, offset_ + d);
+                }
+                break;
+        }
+        seek(0);
+    }
+
+    std::size_t dim() const { return dim_; }
+
+    std::size_t offset() const { return offset_; }
+
+    QMCScramble scramble() const { return scramble_; }
+
+    std::uint64_t seed() const { return seed_; }
+
+    std::uint64_t index() const { return index_; }
+
+    void seek(std::uint64_t i)
+    {
+        runtime_assert(valid(i),
+            "**SobolGenerator::seek** index beyond the end of the sequence");
+
+        index_ = i;
+        std::copy(shift_.begin(), shift_.end(), x_.begin());
+        const UIntType *v = v_.data();
+        for (std::uint64_t g = i ^ (i >> 1); g != 0; g >>= 1, v += dim_) {
+            if ((g & 1) != 0) {
+                for (std::size_t d = 0; d != dim_; ++d) {
+                    x_[d] ^= v[d];
+                }
+            }
+        }
+    }
+
+    template <typename ResultType>
+    void operator()(std::size_t n, ResultType *r)
+    {
+        static_assert(std::is_same<ResultType, UIntType>::value,
+            "**SobolGenerator** used with ResultType other than UIntType");
+
+        if (n == 0) {
+            return;
+        }
+        runtime_assert(valid(index_ + (n - 1)),
+            "**SobolGenerator** index beyond the end of the sequence");
+
+        const UIntType *x = x_.data();
+        for (std::size_t i = 0; i != n; ++i, r += dim_) {
+            if (scramble_ == QMCScramble::Owen) {
+                for (std::size_t d = 0; d != dim_; ++d) {
+                    r[d] = internal::sobol_owen(x[d], owen_[d]);
+                }
+            } else {
+                std::copy_n(x, dim_, r);
+            }
+            next();
+        }
+    }
+
+    friend bool operator==(
+        const SobolGenerator<UIntType> &gen1,
+        const SobolGenerator<UIntType> &gen2)
+    {
+        if (gen1.dim_ != gen2.dim_) {
+            return false;
+        }
+        if (gen1.offset_ != gen2.offset_) {
+            return false;
+        }
+        if (gen1.scramble_ != gen2.scramble_) {
+            return false;
+        }
+        if (gen1.seed_ != gen2.seed_) {
+            return false;
+        }
+        if (gen1.index_ != gen2.index_) {
+            return false;
+        }
+        return true;
+    }
+
+    friend bool operator!=(
+        const SobolGenerator<UIntType> &gen1,
+        const SobolGenerator<UIntType> &gen2)
+    {
+        return !(gen1 == gen2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os,
+        const SobolGenerator<UIntType> &gen)
+    {
+        if (!os) {
+            return os;
+        }
+
+        os << gen.dim_ << ' ';
+        os << gen.offset_ << ' ';
+        os << static_cast<int>(gen.scramble_) << ' ';
+        os << gen.seed_ << ' ';
+        os << gen.index_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is, SobolGenerator<UIntType> &gen)
+    {
+        if (!is) {
+            return is;
+        }
+
+        std::size_t dim = 0;
+        std::size_t offset = 0;
+        int scramble = 0;
+        std::uint64_t seed = 0;
+        std::uint64_t index = 0;
+        is >> std::ws >> dim;
+        is >> std::ws >> offset;
+        is >> std::ws >> scramble;
+        is >> std::ws >> seed;
+        is >> std::ws >> index;
+
+        if (is) {
+            gen = SobolGenerator<UIntType>(
+                dim, offset, static_cast<QMCScramble>(scramble), seed);
+            gen.seek(index);
+        }
+
+        return is;
+    }
+
+  private:
+    static constexpr int W_ = std::numeric_limits<UIntType>::digits;
+
+    std::size_t dim_;
+    std::size_t offset_;
+    QMCScramble scramble_;
+    std::uint64_t seed_;
+    std::uint64_t index_;
+    Vector<UIntType> v_;
+    Vector<UIntType> x_;
+    Vector<UIntType> shift_;
+    Vector<std::uint64_t> owen_;
+
+    // The sequence has 2^W points, indexed from zero
+    static bool valid(std::uint64_t i) { return ((i >> (W_ - 1)) >> 1) == 0; }
+
+    void next()
+    {
+        std::size_t c = 0;
+        for (std::uint64_t i = index_; (i & 1) != 0; i >>= 1) {
+            ++c;
+        }
+        ++index_;
+
+        // Past the last point, which operator() rejects before any output
+        if (c >= static_cast<std::size_t>(W_)) {
+            return;
+        }
+
+        const UIntType *v = v_.data() + c * dim_;
+        UIntType *x = x_.data();
+        for (std::size_t d = 0; d != dim_; ++d) {
+            x[d] ^= v[d];
+        }
+    }
+
+    // v_[k * dim_ + d] is the direction number k of dimension d, scaled such
+    // that it is the coordinate of the point with index 2^k
+    void direction()
+    {
+        for (std::size_t d = 0; d != dim_; ++d) {
+            const std::size_t a = offset_ + d;
+            if (a == 0) {
+                for (int k = 0; k != W_; ++k) {
+                    v_[k * dim_ + d] = const_one<UIntType>() << (W_ - 1 - k);
+                }
+                continue;
+            }
+
+            const std::uint16_t poly =
+                internal::SobolConstants::polynomial(a - 1);
+            const std::uint16_t *m = internal::SobolConstants::minit(a - 1);
+            int s = 0;
+            while ((poly >> (s + 1)) != 0) {
+                ++s;
+            }
+            for (int k = 0; k != s; ++k) {
+                v_[k * dim_ + d] = static_cast<UIntType>(m[k]) << (W_ - 1 - k);
+            }
+            for (int k = s; k < W_; ++k) {
+                const UIntType vs = v_[(k - s) * dim_ + d];
+                UIntType v = vs ^ (vs >> s);
+                for (int j = 1; j != s; ++j) {
+                    if (((poly >> (s - j)) & 1) != 0) {
+                        v ^= v_[(k - j) * dim_ + d];
+                    }
+                }
+                v_[k * dim_ + d] = v;
+            }
+        }
+    }
+
+    void scramble_lms()
+    {
+        std::array<UIntType, W_> l;
+        for (std::size_t d = 0; d != dim_; ++d) {
+            std::uint64_t s = internal::qmc_scramble_seed(seed_, offset_ + d);
+
+            // Row j of the matrix maps the leading j + 1 digits to digit j
+            for (int j = 0; j != W_; ++j) {
+                const int b = W_ - 1 - j;
+                l[j] = (random_bits(s) & (~UIntType() << b)) |
+                    (const_one<UIntType>() << b);
+            }
+            shift_[d] = random_bits(s);
+
+            for (int k = 0; k != W_; ++k) {
+                const UIntType v = v_[k * dim_ + d];
+                UIntType u = 0;
+                for (int j = 0; j != W_; ++j) {
+                    const UIntType lv = static_cast<UIntType>(l[j] & v);
+                    u |= internal::sobol_parity(lv) << (W_ - 1 - j);
+                }
+                v_[k * dim_ + d] = u;
+            }
+        }
+    }
+
+    static UIntType random_bits(std::uint64_t &s)
+    {
+        return static_cast<UIntType>(internal::splitmix64(s));
+    }
+}; // class SobolGenerator
+MCKL_POP_CLANG_WARNING
+
+/// \brief Sobol quasi-random number engine
+/// \ingroup QMC
+template <typename ResultType>
+using SobolEngine = QMCEngine<ResultType, SobolGenerator<ResultType>>;
+
+/// \brief Sobol quasi-random number engine with 32-bit output
+/// \ingroup QMC
+using Sobol = SobolEngine<std::uint32_t>;
+
+/// \brief Sobol quasi-random number engine with 64-bit output
+/// \ingroup QMC
+using Sobol_64 = SobolEngine<std::uint64_t>;
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_SOBOL_HPP
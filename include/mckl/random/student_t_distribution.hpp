@@ -66,11 +66,87 @@ inline void student_t_distribution_impl(
     }
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1>
+inline void student_t_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 df)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    distribution_param(n, df, s.data(),
+        [&t](std::size_t m, const RealType *a, RealType *y) {
+            for (std::size_t i = 0; i != m; ++i) {
+                t[i] = static_cast<RealType>(0.5) * a[i];
+                y[i] = t[i] + static_cast<RealType>(0.5);
+            }
+            lgamma(m, t.data(), t.data());
+            lgamma(m, y, y);
+            sub(m, y, t.data(), y);
+            log(m, a, t.data());
+            for (std::size_t i = 0; i != m; ++i) {
+                y[i] -= static_cast<RealType>(0.5) *
+                    (t[i] + const_ln_pi<RealType>());
+            }
+        });
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] * x[i] / distribution_param(df, i);
+    }
+    log1p(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = s[i] -
+            static_cast<RealType>(0.5) * (distribution_param(df, i) + 1) *
+                t[i];
+    }
+}
+
+template <std::size_t K, typename RealType, typename P1>
+inline void student_t_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 df)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> a;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> b;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType v = distribution_param(df, i);
+        a[i] = static_cast<RealType>(0.5) * v;
+        b[i] = static_cast<RealType>(0.5);
+        t[i] = v / (v + x[i] * x[i]);
+    }
+    betai(n, a.data(), b.data(), t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType c = static_cast<RealType>(0.5) * t[i];
+        r[i] = x[i] > 0 ? 1 - c : c;
+    }
+}
+
+template <std::size_t K, typename RealType, typename P1>
+inline void student_t_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 df)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> a;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> b;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    for (std::size_t i = 0; i != n; ++i) {
+        a[i] = static_cast<RealType>(0.5) * distribution_param(df, i);
+        b[i] = static_cast<RealType>(0.5);
+        t[i] = 2 * std::min(x[i], 1 - x[i]);
+    }
+    betaiinv(n, a.data(), b.data(), t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType v =
+            std::sqrt(distribution_param(df, i) * (1 - t[i]) / t[i]);
+        r[i] = x[i] < static_cast<RealType>(0.5) ? -v : v;
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_1(
     StudentT, student_t, RealType, RealType, n)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_1(StudentT, student_t, RealType, n)
+
 /// \brief Student-t distribution
 /// \ingroup Distribution
 template <typename RealType>
@@ -44,5 +44,6 @@
 #include <mckl/random/poker_test.hpp>
 #include <mckl/random/run_test.hpp>
 #include <mckl/random/serial_test.hpp>
+#include <mckl/random/test_runner.hpp>
 
 #endif // MCKL_RANDOM_TEST_HPP
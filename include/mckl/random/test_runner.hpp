@@ -0,0 +1,193 @@
+//============================================================================
+// MCKL/include/mckl/random/test_runner.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_TEST_RUNNER_HPP
+#define MCKL_RANDOM_TEST_RUNNER_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/rng.hpp>
+#include <mckl/random/seed.hpp>
+#include <mckl/random/u01_distribution.hpp>
+#include <mckl/smp.hpp>
+
+namespace mckl {
+
+/// \brief Results of a randomness test replicated on independent streams
+/// \ingroup RandomTest
+template <typename ResultType>
+class RandomTestResult
+{
+  public:
+    using result_type = ResultType;
+
+    RandomTestResult(Vector<result_type> &&stat, Vector<double> &&pvalue,
+        double pvalue_sum)
+        : stat_(std::move(stat))
+        , pvalue_(std::move(pvalue))
+        , pvalue_sum_(pvalue_sum)
+    {
+    }
+
+    /// \brief The number of replications
+    std::size_t size() const { return stat_.size(); }
+
+    /// \brief The statistics of the replications
+    const Vector<result_type> &stat() const { return stat_; }
+
+    /// \brief The p-values of the replications
+    const Vector<double> &pvalue() const { return pvalue_; }
+
+    /// \brief The p-value of the sum of the statistics of all replications
+    double pvalue_sum() const { return pvalue_sum_; }
+
+    /// \brief The proportion of replications that pass the test at the
+    /// significance level `alpha`
+    double pass(double alpha) const
+    {
+        std::size_t n = 0;
+        for (double p : pvalue_) {
+            n += std::min(p, 1 - p) > 0.5 * alpha ? 1 : 0;
+        }
+
+        return static_cast<double>(n) / static_cast<double>(size());
+    }
+
+    /// \brief If the sum of the statistics of all replications passes the
+    /// test at the significance level `alpha`
+    bool pass_sum(double alpha) const
+    {
+        return std::min(pvalue_sum_, 1 - pvalue_sum_) > 0.5 * alpha;
+    }
+
+  private:
+    Vector<result_type> stat_;
+    Vector<double> pvalue_;
+    double pvalue_sum_;
+}; // class RandomTestResult
+
+/// \brief Run randomness tests replicated on independent streams in
+/// parallel
+/// \ingroup RandomTest
+///
+/// \tparam RNGType The RNG engine type
+/// \tparam U01DistributionType The distribution that transforms the output
+/// of the RNG to uniform random numbers
+/// \tparam Backend The SMP backend used to run the replications
+///
+/// \details
+/// Each replication of a test uses its own RNG seeded with
+/// `Seed<RNGType>::instance().get()`, and the seeds are drawn sequentially
+/// before the replications are distributed among the threads with smp_for.
+/// The results are thus the same for any number of threads. Each task
+/// performs its replications with a copy of the test object. The statistics
+/// of the tests in this library are either Poisson or \f$\chi^2\f$, and the
+/// sum of the statistics of all replications is tested as a single
+/// statistic with the same family of distributions, in addition to the
+/// individual replications.
+///
+/// Tests can be run on substreams of a single RNG instead of fresh seeds by
+/// supplying the streams, for example engines obtained by `jump` of a
+/// multi-stream engine.
+template <typename RNGType = RNG,
+    typename U01DistributionType = U01Distribution<double>,
+    typename Backend = BackendSMP>
+class RandomTestRunner
+{
+  public:
+    using rng_type = RNGType;
+    using u01_distribution_type = U01DistributionType;
+
+    /// \brief Construct a runner with `m` replications of each test
+    explicit RandomTestRunner(
+        std::size_t m, const U01DistributionType &u01 = U01DistributionType())
+        : u01_(u01)
+    {
+        rng_.reserve(m);
+        for (std::size_t i = 0; i != m; ++i) {
+            rng_.emplace_back(Seed<RNGType>::instance().get());
+        }
+    }
+
+    /// \brief Construct a runner with one replication of each test for each
+    /// stream in the range `[first, last)`
+    template <typename InputIter>
+    RandomTestRunner(InputIter first, InputIter last,
+        const U01DistributionType &u01 = U01DistributionType())
+        : rng_(first, last), u01_(u01)
+    {
+    }
+
+    /// \brief The number of replications
+    std::size_t size() const { return rng_.size(); }
+
+    /// \brief The stream of the `i`-th replication
+    RNGType &rng(std::size_t i) { return rng_[i]; }
+
+    /// \brief Perform the replications of a test
+    ///
+    /// \details
+    /// The streams continue from where they stopped, such that successive
+    /// calls, with the same or different tests, use disjoint parts of the
+    /// streams.
+    template <typename TestType>
+    RandomTestResult<typename TestType::result_type> operator()(
+        const TestType &test)
+    {
+        using result_type = typename TestType::result_type;
+
+        const std::size_t m = size();
+        Vector<result_type> stat(m);
+        Vector<double> pvalue(m);
+        smp_for<Backend>(m, [&](std::size_t ibegin, std::size_t iend) {
+            TestType t(test);
+            U01DistributionType u01(u01_);
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                stat[i] = t(rng_[i], u01);
+                pvalue[i] = t.pvalue(stat[i]);
+            }
+        });
+
+        const result_type sum =
+            std::accumulate(stat.begin(), stat.end(), result_type());
+        const double pvalue_sum = test.pvalue(sum, m);
+
+        return RandomTestResult<result_type>(
+            std::move(stat), std::move(pvalue), pvalue_sum);
+    }
+
+  private:
+    Vector<RNGType> rng_;
+    U01DistributionType u01_;
+}; // class RandomTestRunner
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_TEST_RUNNER_HPP
@@ -35,6 +35,13 @@
 #include <mckl/random/internal/common.hpp>
 #include <mckl/random/seed.hpp>
 
+#if MCKL_HAS_POSIX
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 extern "C" {
 
 #include <TestU01.h>
@@ -43,6 +50,78 @@ extern "C" {
 
 namespace mckl {
 
+namespace internal {
+
+/// \brief Uniform random numbers served to TestU01 from buffers filled by
+/// the batch generator
+///
+/// \details
+/// The buffer of `N * M` numbers is filled by `M` independent streams, `N`
+/// numbers each, with `rand(rng, u01, N, r)`.
+template <typename RNGType, typename U01Type, std::size_t N, std::size_t M>
+class TestU01Bulk
+{
+  public:
+    TestU01Bulk() : index_(N * M), rng_(M), result_(N * M) { seed(); }
+
+    void seed()
+    {
+        for (auto &rng : rng_) {
+            rng.seed(Seed<RNGType>::instance().get());
+        }
+        index_ = N * M;
+    }
+
+    double operator()()
+    {
+        if (index_ == N * M) {
+            double *r = result_.data();
+            for (std::size_t i = 0; i != M; ++i, r += N) {
+                mckl::rand(rng_[i], u01_, N, r);
+            }
+            index_ = 0;
+        }
+
+        return result_[index_++];
+    }
+
+    static double get_u01(void *, void *state)
+    {
+        return (*static_cast<TestU01Bulk<RNGType, U01Type, N, M> *>(state))();
+    }
+
+    static unsigned long get_bits(void *param, void *state)
+    {
+        const double u = get_u01(param, state) * 4294967296.0;
+
+        return static_cast<unsigned long>(std::min(u, 4294967295.0));
+    }
+
+    static void write(void *) {}
+
+    static void reseed(void *state, std::size_t np, std::size_t rank)
+    {
+        using seed_type = typename Seed<RNGType>::seed_type;
+
+        Seed<RNGType>::instance().partition(
+            static_cast<seed_type>(np), static_cast<seed_type>(rank));
+        static_cast<TestU01Bulk<RNGType, U01Type, N, M> *>(state)->seed();
+    }
+
+    static void destroy(void *state)
+    {
+        delete static_cast<TestU01Bulk<RNGType, U01Type, N, M> *>(state);
+    }
+
+  private:
+    std::size_t index_;
+    U01Type u01_;
+    Vector<RNGType> rng_;
+    Vector<double> result_;
+}; // class TestU01Bulk
+
+} // namespace internal
+
 /// \brief Perform TestU01 tests on different RNG and U01 types
 /// \ingroup RandomTest
 class TestU01
@@ -51,6 +130,8 @@ class TestU01
     TestU01(const TestU01 &) = delete;
     TestU01 &operator=(const TestU01 &) = delete;
 
+    ~TestU01() { release(); }
+
     static TestU01 &instance()
     {
         static TestU01 testu01;
@@ -62,35 +143,46 @@ class TestU01
     bool empty() const { return gen_ == nullptr; }
 
     /// \brief Reset the TestU01 generator to specified RNG and distribution
+    ///
+    /// \details
+    /// The generator serves TestU01 directly from a buffer of 65536 numbers
+    /// filled by the batch generator, or 8 buffers of 8192 numbers each
+    /// filled by 8 independent streams if `parallel` is `true`.
     template <typename RNGType, typename U01Type>
     void reset(const std::string &name, bool parallel = false)
     {
-        parallel ? reset(name, u01_mt<RNGType, U01Type, 1024, 8>) :
-                   reset(name, u01_st<RNGType, U01Type, 4096>);
+        parallel ? reset_bulk<RNGType, U01Type, 8192, 8>(name) :
+                   reset_bulk<RNGType, U01Type, 65536, 1>(name);
     }
 
     /// \brief Reset the TestU01 generator to specified RNG and distribution
     template <typename RNGType, typename U01Type, std::size_t N, std::size_t M>
     void reset(const std::string &name, bool parallel = false)
     {
-        parallel ? reset(name, u01_mt<RNGType, U01Type, N, M>) :
-                   reset(name, u01_st<RNGType, U01Type, N>);
+        parallel ? reset_bulk<RNGType, U01Type, N, M>(name) :
+                   reset_bulk<RNGType, U01Type, N, 1>(name);
     }
 
     /// \brief Reset the TestU01 generator to specified distribution
     void reset(const std::string &name, double (*u01)())
     {
         release();
-        gen_ =
-            ::unif01_CreateExternGen01(const_cast<char *>(name.c_str()), u01);
+        name_ = name;
+        gen_ = ::unif01_CreateExternGen01(
+            const_cast<char *>(name_.c_str()), u01);
     }
 
     /// \brief Release the TestU01 generator
     void release()
     {
-        if (gen_ != nullptr)
+        if (gen_ == &bulk_) {
+            destroy_(bulk_.state);
+        } else if (gen_ != nullptr) {
             ::unif01_DeleteExternGen01(gen_);
+        }
         gen_ = nullptr;
+        reseed_ = nullptr;
+        destroy_ = nullptr;
     }
 
     /// \brief Get the TestU01 generator
@@ -133,56 +225,228 @@ class TestU01
         battery_repeat(gen_, rep.data());
     }
 
-  private:
-    TestU01() : gen_(nullptr) {}
-
-    ::unif01_Gen *gen_;
+    /// \brief Apply a battery with its tests divided among multiple
+    /// processes
+    ///
+    /// \param battery_repeat A battery that accepts a `unif01_Gen` pointer
+    /// as the first input, and an array of type `int` that specifies the
+    /// replication number, such as `bbattery_RepeatBigCrush`
+    /// \param ntests The number of tests of the battery, for example, 10, 96
+    /// and 106 for SmallCrush, Crush and BigCrush, respectively
+    /// \param np The number of processes
+    /// \param init A callable object invoked as `init(np, rank)` by each
+    /// process before it performs its tests
+    ///
+    /// \return The names and p-values of all tests in the order of the
+    /// battery
+    ///
+    /// \details
+    /// The test `i` (counting from one) is performed by the process with
+    /// rank `(i - 1) % np`, created by `fork`. If the generator is set with
+    /// an RNG type, each process reseeds it with seeds from
+    /// `Seed<RNGType>::instance()` partitioned with `partition(np, rank)`,
+    /// such that the processes use independent streams. The output of
+    /// TestU01 within each process is discarded, and a summary of all the
+    /// tests is written to the standard output in the format of TestU01.
+    /// Without POSIX support the tests are performed by the calling process.
+    template <typename BatteryRepeat, typename Init>
+    Vector<std::pair<std::string, double>> parallel(
+        BatteryRepeat &&battery_repeat, int ntests, std::size_t np,
+        Init &&init)
+    {
+        using result_type = std::tuple<int, std::string, double>;
 
-    template <typename RNGType, typename U01Type, std::size_t N, std::size_t M>
-    static double u01_mt()
-    {
-        MCKL_PUSH_CLANG_WARNING("-Wexit-time-destructors")
-        static std::size_t index = N * M;
-        static Vector<RNGType> rs(M);
-        static Vector<double> result(N * M);
-        static bool init = false;
-        MCKL_POP_CLANG_WARNING
-
-        if (index == N * M) {
-            if (!init) {
-                for (auto &rng : rs)
-                    rng.seed(Seed<RNGType>::instance().get());
-                init = true;
+        Vector<result_type> result;
+#if MCKL_HAS_POSIX
+        Vector<::pid_t> pid(np, -1);
+        Vector<int> fd(np, -1);
+        std::cout.flush();
+        std::fflush(stdout);
+        for (std::size_t rank = 0; rank != np; ++rank) {
+            int pfd[2];
+            if (::pipe(pfd) == 0) {
+                pid[rank] = ::fork();
+                if (pid[rank] == 0) {
+                    ::close(pfd[0]);
+                    int null = ::open("/dev/null", O_WRONLY);
+                    if (null >= 0) {
+                        ::dup2(null, STDOUT_FILENO);
+                        ::close(null);
+                    }
+                    init(np, rank);
+                    Vector<result_type> r;
+                    run(battery_repeat, ntests, np, rank, r);
+                    std::string buf;
+                    for (const auto &t : r) {
+                        std::stringstream ss;
+                        ss.precision(17);
+                        ss << std::get<0>(t) << '\t' << std::get<2>(t) << '\t'
+                           << std::get<1>(t) << '\n';
+                        buf += ss.str();
+                    }
+                    const char *p = buf.data();
+                    std::size_t n = buf.size();
+                    while (n != 0) {
+                        ::ssize_t w = ::write(pfd[1], p, n);
+                        if (w <= 0) {
+                            break;
+                        }
+                        p += w;
+                        n -= static_cast<std::size_t>(w);
+                    }
+                    ::close(pfd[1]);
+                    ::_exit(0);
+                }
+                ::close(pfd[1]);
+                if (pid[rank] > 0) {
+                    fd[rank] = pfd[0];
+                } else {
+                    ::close(pfd[0]);
+                }
             }
-            double *r = result.data();
-            for (std::size_t i = 0; i != M; ++i, r += N) {
-                RNGType rng(std::move(rs[i]));
-                U01Type dist;
-                mckl::rand(rng, dist, N, r);
-                rs[i] = std::move(rng);
+            if (pid[rank] <= 0) {
+                init(np, rank);
+                run(battery_repeat, ntests, np, rank, result);
+            }
+        }
+        for (std::size_t rank = 0; rank != np; ++rank) {
+            if (pid[rank] <= 0) {
+                continue;
             }
-            index = 0;
+            std::string buf;
+            char tmp[4096];
+            ::ssize_t n = 0;
+            while ((n = ::read(fd[rank], tmp, sizeof(tmp))) > 0) {
+                buf.append(tmp, static_cast<std::size_t>(n));
+            }
+            ::close(fd[rank]);
+            int status = 0;
+            ::waitpid(pid[rank], &status, 0);
+            runtime_assert(WIFEXITED(status) && WEXITSTATUS(status) == 0,
+                "**TestU01::parallel** a process failed");
+            std::stringstream ss(buf);
+            std::string line;
+            while (std::getline(ss, line)) {
+                std::stringstream ls(line);
+                int t = 0;
+                double p = 0;
+                std::string name;
+                ls >> t >> p;
+                ls.ignore(1);
+                std::getline(ls, name);
+                result.emplace_back(t, name, p);
+            }
+        }
+#else  // MCKL_HAS_POSIX
+        for (std::size_t rank = 0; rank != np; ++rank) {
+            init(np, rank);
+            run(battery_repeat, ntests, np, rank, result);
+        }
+#endif // MCKL_HAS_POSIX
+
+        std::stable_sort(result.begin(), result.end(),
+            [](const result_type &a, const result_type &b) {
+                return std::get<0>(a) < std::get<0>(b);
+            });
+        Vector<std::pair<std::string, double>> pvalue;
+        for (const auto &t : result) {
+            pvalue.emplace_back(std::get<1>(t), std::get<2>(t));
         }
+        summary(np, pvalue);
 
-        return result[index++];
+        return pvalue;
     }
 
-    template <typename RNGType, typename U01Type, std::size_t N>
-    static double u01_st()
+    /// \brief Apply a battery with its tests divided among multiple
+    /// processes
+    template <typename BatteryRepeat>
+    Vector<std::pair<std::string, double>> parallel(
+        BatteryRepeat &&battery_repeat, int ntests, std::size_t np)
     {
-        MCKL_PUSH_CLANG_WARNING("-Wexit-time-destructors")
-        static std::size_t index = N;
-        static RNGType rng(mckl::Seed<RNGType>::instance().get());
-        static mckl::Vector<double> result(N);
-        MCKL_POP_CLANG_WARNING
+        return parallel(std::forward<BatteryRepeat>(battery_repeat), ntests,
+            np, [](std::size_t, std::size_t) {});
+    }
+
+  private:
+    ::unif01_Gen *gen_;
+    ::unif01_Gen bulk_;
+    std::string name_;
+    void (*reseed_)(void *, std::size_t, std::size_t);
+    void (*destroy_)(void *);
 
-        if (index == N) {
-            U01Type dist;
-            mckl::rand(rng, dist, N, result.data());
-            index = 0;
+    TestU01() : gen_(nullptr), reseed_(nullptr), destroy_(nullptr) {}
+
+    template <typename RNGType, typename U01Type, std::size_t N, std::size_t M>
+    void reset_bulk(const std::string &name)
+    {
+        using bulk_type = internal::TestU01Bulk<RNGType, U01Type, N, M>;
+
+        release();
+        name_ = name;
+        bulk_.state = new bulk_type();
+        bulk_.param = nullptr;
+        bulk_.name = const_cast<char *>(name_.c_str());
+        bulk_.GetU01 = bulk_type::get_u01;
+        bulk_.GetBits = bulk_type::get_bits;
+        bulk_.Write = bulk_type::write;
+        reseed_ = bulk_type::reseed;
+        destroy_ = bulk_type::destroy;
+        gen_ = &bulk_;
+    }
+
+    template <typename BatteryRepeat>
+    void run(BatteryRepeat &&battery_repeat, int ntests, std::size_t np,
+        std::size_t rank, Vector<std::tuple<int, std::string, double>> &r)
+    {
+        if (reseed_ != nullptr) {
+            reseed_(bulk_.state, np, rank);
         }
 
-        return result[index++];
+        const int n = static_cast<int>(np);
+        for (int t = static_cast<int>(rank) + 1; t <= ntests; t += n) {
+            Vector<int> rep(128, 0);
+            rep[static_cast<std::size_t>(t)] = 1;
+            battery_repeat(gen_, rep.data());
+            for (int i = 0; i != ::bbattery_NTests; ++i) {
+                r.emplace_back(t, std::string(::bbattery_TestNames[i]),
+                    ::bbattery_pVal[i]);
+            }
+        }
+    }
+
+    void summary(std::size_t np,
+        const Vector<std::pair<std::string, double>> &pvalue) const
+    {
+        const double eps = ::gofw_Suspectp;
+
+        std::cout << "\n========= Summary results of " << name_
+                  << " in " << np << " processes =========\n\n";
+        std::cout << " Generator:            " << name_ << '\n';
+        std::cout << " Number of statistics: " << pvalue.size() << '\n';
+
+        std::size_t nfail = 0;
+        for (const auto &p : pvalue) {
+            if (p.second < eps || p.second > 1 - eps) {
+                if (nfail == 0) {
+                    std::cout << " The following tests gave p-values "
+                              << "outside [" << eps << ", " << 1 - eps
+                              << "]:\n\n";
+                    std::cout << "       Test" << std::string(30, ' ')
+                              << "p-value\n";
+                    std::cout << std::string(54, '-') << '\n';
+                }
+                ++nfail;
+                std::cout << ' ' << std::setw(40) << std::left << p.first
+                          << std::setw(12) << std::right << p.second << '\n';
+            }
+        }
+        if (nfail == 0) {
+            std::cout << "\n All tests were passed\n\n\n";
+        } else {
+            std::cout << std::string(54, '-') << '\n';
+            std::cout << " All other tests were passed\n\n\n";
+        }
+        std::cout.flush();
     }
 
     static Vector<int> repeat(int n) { return Vector<int>(128, n); }
@@ -121,7 +121,7 @@ inline void u01_canonical_distribution_impl(
     constexpr int W = std::numeric_limits<UIntType>::digits;
     constexpr int M = std::numeric_limits<RealType>::digits;
     constexpr int P = (M + W - 1) / W;
-    constexpr int Q = 1 > P ? 1 : P;
+    constexpr int Q = 1 > P || QuasiRandomTrait<RNGType>::value ? 1 : P;
 
     alignas(MCKL_ALIGNMENT) std::array<UIntType, K * Q> s;
     uniform_bits_distribution(rng, n * Q, s.data());
@@ -165,7 +165,7 @@ class U01CanonicalDistribution
         constexpr int W = std::numeric_limits<UIntType>::digits;
         constexpr int M = std::numeric_limits<RealType>::digits;
         constexpr int P = (M + W - 1) / W;
-        constexpr int Q = 1 > P ? 1 : P;
+        constexpr int Q = 1 > P || QuasiRandomTrait<RNGType>::value ? 1 : P;
 
         std::array<UIntType, Q> u;
         generate<0>(rng, u, std::true_type());
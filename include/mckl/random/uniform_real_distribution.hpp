@@ -57,11 +57,55 @@ inline void uniform_real_distribution_impl(
 #endif
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void uniform_real_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    distribution_param(n, a, b, s.data(),
+        [](std::size_t m, const RealType *p, const RealType *q, RealType *y) {
+            sub(m, q, p, y);
+            log(m, y, y);
+        });
+    for (std::size_t i = 0; i != n; ++i) {
+        const bool in = x[i] >= distribution_param(a, i) &&
+            x[i] <= distribution_param(b, i);
+        r[i] = in ? -s[i] : -const_inf<RealType>();
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void uniform_real_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType c = distribution_param(a, i);
+        const RealType y = (x[i] - c) / (distribution_param(b, i) - c);
+        r[i] = std::min(std::max(y, const_zero<RealType>()),
+            const_one<RealType>());
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void uniform_real_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType c = distribution_param(a, i);
+        r[i] = c + (distribution_param(b, i) - c) * x[i];
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     UniformReal, uniform_real, RealType, RealType, a, RealType, b)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(
+    UniformReal, uniform_real, RealType, a, b)
+
 /// \brief Uniform real distribution
 /// \ingroup Distribution
 template <typename RealType>
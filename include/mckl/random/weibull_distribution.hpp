@@ -65,11 +65,87 @@ inline void weibull_distribution_impl(
     MCKL_POP_INTEL_WARNING
 }
 
+MCKL_PUSH_GCC_WARNING("-Wmaybe-uninitialized")
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void weibull_logpdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> s;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> u;
+    distribution_param(n, a, b, s.data(),
+        [](std::size_t m, const RealType *p, const RealType *q, RealType *y) {
+            div(m, p, q, y);
+            log(m, y, y);
+        });
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] > 0 ? x[i] / distribution_param(b, i) : 1;
+    }
+    log(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        u[i] = x[i] > 0 ? distribution_param(a, i) * t[i] :
+                          -const_inf<RealType>();
+    }
+    exp(n, u.data(), u.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        const RealType v = s[i] +
+            distribution_logpdf_power(distribution_param(a, i), x[i], t[i]) -
+            u[i];
+        r[i] = x[i] < 0 ? -const_inf<RealType>() : v;
+    }
+}
+
+template <std::size_t K, typename RealType, typename P1, typename P2>
+inline void weibull_cdf_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    alignas(MCKL_ALIGNMENT) std::array<RealType, K> t;
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] > 0 ? x[i] / distribution_param(b, i) : 1;
+    }
+    log(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] *= distribution_param(a, i);
+    }
+    exp(n, t.data(), t.data());
+    for (std::size_t i = 0; i != n; ++i) {
+        t[i] = x[i] > 0 ? -t[i] : 0;
+    }
+    expm1(n, t.data(), r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -r[i];
+    }
+}
+
+template <std::size_t, typename RealType, typename P1, typename P2>
+inline void weibull_quantile_impl(
+    std::size_t n, const RealType *x, RealType *r, P1 a, P2 b)
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -x[i];
+    }
+    log1p(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] = -r[i];
+    }
+    log(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] /= distribution_param(a, i);
+    }
+    exp(n, r, r);
+    for (std::size_t i = 0; i != n; ++i) {
+        r[i] *= distribution_param(b, i);
+    }
+}
+MCKL_POP_GCC_WARNING
+
 } // namespace internal
 
 MCKL_DEFINE_RANDOM_DISTRIBUTION_BATCH_2(
     Weibull, weibull, RealType, RealType, a, RealType, b)
 
+MCKL_DEFINE_RANDOM_DISTRIBUTION_FUNCTIONS_2(Weibull, weibull, RealType, a, b)
+
 /// \brief Weibull distribution
 /// \ingroup Distribution
 template <typename RealType>
@@ -0,0 +1,647 @@
+//============================================================================
+// MCKL/include/mckl/random/wishart_distribution.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_WISHART_DISTRIBUTION_HPP
+#define MCKL_RANDOM_WISHART_DISTRIBUTION_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/chi_squared_distribution.hpp>
+#include <mckl/random/normal_distribution.hpp>
+
+#define MCKL_DEFINE_RANDOM_WISHART_DISTRIBUTION(Name, inverse)                \
+    template <typename RealType, std::size_t Dim>                             \
+    class Name##Distribution                                                  \
+    {                                                                         \
+        MCKL_DEFINE_RANDOM_DISTRIBUTION_ASSERT_BLAS_TYPE(Name)                \
+                                                                              \
+      public:                                                                 \
+        using result_type = RealType;                                         \
+        using distribution_type = Name##Distribution<RealType, Dim>;          \
+                                                                              \
+        MCKL_PUSH_CLANG_WARNING("-Wpadded")                                   \
+        class param_type                                                      \
+        {                                                                     \
+          public:                                                             \
+            using result_type = RealType;                                     \
+            using distribution_type = Name##Distribution<RealType, Dim>;      \
+                                                                              \
+            explicit param_type(std::size_t dim = Dim == 0 ? 1 : Dim)         \
+                : param_type(dim, static_cast<result_type>(dim), 1)           \
+            {                                                                 \
+            }                                                                 \
+                                                                              \
+            param_type(std::size_t dim, result_type df, result_type chol = 1) \
+                : dim_(dim)                                                   \
+                , df_(df)                                                     \
+                , chol_(dim * (dim + 1) / 2, 0)                               \
+                , is_scalar_chol_(true)                                       \
+            {                                                                 \
+                for (std::size_t i = 0; i != dim; ++i) {                      \
+                    chol_[i * (i + 3) / 2] = chol;                            \
+                }                                                             \
+                unpack_chol();                                                \
+            }                                                                 \
+                                                                              \
+            param_type(                                                       \
+                std::size_t dim, result_type df, const result_type *chol)     \
+                : dim_(dim)                                                   \
+                , df_(df)                                                     \
+                , chol_(chol, chol + dim * (dim + 1) / 2)                     \
+                , is_scalar_chol_(false)                                      \
+            {                                                                 \
+                unpack_chol();                                                \
+            }                                                                 \
+                                                                              \
+            std::size_t dim() const { return dim_; }                          \
+                                                                              \
+            result_type df() const { return df_; }                            \
+                                                                              \
+            const result_type *chol() const { return chol_.data(); }          \
+                                                                              \
+            friend bool operator==(                                           \
+                const param_type &param1, const param_type &param2)           \
+            {                                                                 \
+                MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")                      \
+                MCKL_PUSH_INTEL_WARNING(1572)                                 \
+                if (param1.dim_ != param2.dim_) {                             \
+                    return false;                                             \
+                }                                                             \
+                if (param1.df_ != param2.df_) {                               \
+                    return false;                                             \
+                }                                                             \
+                if (param1.chol_ != param2.chol_) {                           \
+                    return false;                                             \
+                }                                                             \
+                if (param1.is_scalar_chol_ != param2.is_scalar_chol_) {       \
+                    return false;                                             \
+                }                                                             \
+                return true;                                                  \
+                MCKL_POP_CLANG_WARNING                                        \
+                MCKL_POP_INTEL_WARNING                                        \
+            }                                                                 \
+                                                                              \
+            friend bool operator!=(                                           \
+                const param_type &param1, const param_type &param2)           \
+            {                                                                 \
+                return !(param1 == param2);                                   \
+            }                                                                 \
+                                                                              \
+            template <typename CharT, typename Traits>                        \
+            friend std::basic_ostream<CharT, Traits> &operator<<(             \
+                std::basic_ostream<CharT, Traits> &os,                        \
+                const param_type &param)                                      \
+            {                                                                 \
+                if (!os) {                                                    \
+                    return os;                                                \
+                }                                                             \
+                                                                              \
+                os << param.dim_ << ' ';                                      \
+                os << param.df_ << ' ';                                       \
+                os << param.chol_ << ' ';                                     \
+                os << param.is_scalar_chol_;                                  \
+                                                                              \
+                return os;                                                    \
+            }                                                                 \
+                                                                              \
+            template <typename CharT, typename Traits>                        \
+            friend std::basic_istream<CharT, Traits> &operator>>(             \
+                std::basic_istream<CharT, Traits> &is, param_type &param)     \
+            {                                                                 \
+                if (!is) {                                                    \
+                    return is;                                                \
+                }                                                             \
+                                                                              \
+                param_type tmp;                                               \
+                                                                              \
+                is >> std::ws >> tmp.dim_;                                    \
+                is >> std::ws >> tmp.df_;                                     \
+                is >> std::ws >> tmp.chol_;                                   \
+                is >> std::ws >> tmp.is_scalar_chol_;                         \
+                                                                              \
+                const std::size_t p = tmp.dim_ * (tmp.dim_ + 1) / 2;          \
+                if (is && tmp.chol_.size() != p) {                            \
+                    is.setstate(std::ios_base::failbit);                      \
+                }                                                             \
+                                                                              \
+                if (is && Dim != 0 && tmp.dim_ != Dim) {                      \
+                    is.setstate(std::ios_base::failbit);                      \
+                }                                                             \
+                                                                              \
+                if (is && !internal::wishart_distribution_check_param(        \
+                              tmp.dim_, tmp.df_)) {                           \
+                    is.setstate(std::ios_base::failbit);                      \
+                }                                                             \
+                                                                              \
+                if (is) {                                                     \
+                    tmp.unpack_chol();                                        \
+                    param = std::move(tmp);                                   \
+                } else {                                                      \
+                    is.setstate(std::ios_base::failbit);                      \
+                }                                                             \
+                                                                              \
+                return is;                                                    \
+            }                                                                 \
+                                                                              \
+          private:                                                            \
+            std::size_t dim_;                                                 \
+            result_type df_;                                                  \
+            Vector<result_type> chol_;                                        \
+            Vector<result_type> cholf_;                                       \
+            bool is_scalar_chol_;                                             \
+                                                                              \
+            friend distribution_type;                                         \
+                                                                              \
+            void unpack_chol()                                                \
+            {                                                                 \
+                runtime_assert(Dim == 0 || dim() == Dim,                      \
+                    "**" #Name "Distribution::param_type** constructed with " \
+                    "a dimension other than Dim");                            \
+                runtime_assert(                                               \
+                    internal::wishart_distribution_check_param(dim(), df()),  \
+                    "**" #Name "Distribution::param_type** constructed with " \
+                    "degrees of freedom not larger than dim - 1");            \
+                                                                              \
+                cholf_ = internal::wishart_distribution_cholf(dim(), chol()); \
+            }                                                                 \
+        };                                                                    \
+        MCKL_POP_CLANG_WARNING                                                \
+                                                                              \
+        explicit Name##Distribution(std::size_t dim = Dim == 0 ? 1 : Dim)     \
+            : param_(dim)                                                     \
+        {                                                                     \
+            reset();                                                          \
+        }                                                                     \
+                                                                              \
+        Name##Distribution(                                                   \
+            std::size_t dim, result_type df, result_type chol = 1)            \
+            : param_(dim, df, chol)                                           \
+        {                                                                     \
+            reset();                                                          \
+        }                                                                     \
+                                                                              \
+        Name##Distribution(                                                   \
+            std::size_t dim, result_type df, const result_type *chol)         \
+            : param_(dim, df, chol)                                           \
+        {                                                                     \
+            reset();                                                          \
+        }                                                                     \
+                                                                              \
+        explicit Name##Distribution(const param_type &param) : param_(param)  \
+        {                                                                     \
+            reset();                                                          \
+        }                                                                     \
+                                                                              \
+        explicit Name##Distribution(param_type &&param)                       \
+            : param_(std::move(param))                                        \
+        {                                                                     \
+            reset();                                                          \
+        }                                                                     \
+                                                                              \
+        template <typename OutputIter>                                        \
+        OutputIter min(OutputIter first) const                                \
+        {                                                                     \
+            return std::fill_n(first, size(),                                 \
+                std::numeric_limits<result_type>::lowest());                  \
+        }                                                                     \
+                                                                              \
+        template <typename OutputIter>                                        \
+        OutputIter max(OutputIter first) const                                \
+        {                                                                     \
+            return std::fill_n(                                               \
+                first, size(), std::numeric_limits<result_type>::max());      \
+        }                                                                     \
+                                                                              \
+        void reset() {}                                                       \
+                                                                              \
+        std::size_t dim() const { return param_.dim(); }                      \
+                                                                              \
+        std::size_t size() const { return dim() * (dim() + 1) / 2; }          \
+                                                                              \
+        result_type df() const { return param_.df(); }                        \
+                                                                              \
+        const result_type *chol() const { return param_.chol(); }             \
+                                                                              \
+        const param_type &param() const { return param_; }                    \
+                                                                              \
+        void param(const param_type &param)                                   \
+        {                                                                     \
+            param_ = param;                                                   \
+            reset();                                                          \
+        }                                                                     \
+                                                                              \
+        void param(param_type &&param)                                        \
+        {                                                                     \
+            param_ = std::move(param);                                        \
+            reset();                                                          \
+        }                                                                     \
+                                                                              \
+        template <typename RNGType>                                           \
+        void operator()(RNGType &rng, result_type *r)                         \
+        {                                                                     \
+            operator()(rng, 1, r, param_);                                    \
+        }                                                                     \
+                                                                              \
+        template <typename RNGType>                                           \
+        void operator()(                                                      \
+            RNGType &rng, result_type *r, const param_type &param)            \
+        {                                                                     \
+            operator()(rng, 1, r, param);                                     \
+        }                                                                     \
+                                                                              \
+        template <typename RNGType>                                           \
+        void operator()(RNGType &rng, std::size_t n, result_type *r)          \
+        {                                                                     \
+            operator()(rng, n, r, param_);                                    \
+        }                                                                     \
+                                                                              \
+        template <typename RNGType>                                           \
+        void operator()(RNGType &rng, std::size_t n, result_type *r,          \
+            const param_type &param)                                          \
+        {                                                                     \
+            internal::size_check<MCKL_BLAS_INT>(n, #Name "Distribution");     \
+            internal::size_check<MCKL_BLAS_INT>(                              \
+                param.dim(), #Name "Distribution");                           \
+                                                                              \
+            internal::wishart_distribution_impl<Dim>(rng, n, r,               \
+                param.dim(), param.df(), param.chol()[0],                     \
+                param.is_scalar_chol_ ? nullptr : param.cholf_.data(),        \
+                inverse);                                                     \
+        }                                                                     \
+                                                                              \
+        friend bool operator==(                                               \
+            const distribution_type &dist1, const distribution_type &dist2)   \
+        {                                                                     \
+            if (dist1.param_ != dist2.param_) {                               \
+                return false;                                                 \
+            }                                                                 \
+            return true;                                                      \
+        }                                                                     \
+                                                                              \
+        friend bool operator!=(                                               \
+            const distribution_type &dist1, const distribution_type &dist2)   \
+        {                                                                     \
+            return !(dist1 == dist2);                                         \
+        }                                                                     \
+                                                                              \
+        template <typename CharT, typename Traits>                            \
+        friend std::basic_ostream<CharT, Traits> &operator<<(                 \
+            std::basic_ostream<CharT, Traits> &os,                            \
+            const distribution_type &dist)                                    \
+        {                                                                     \
+            if (!os) {                                                        \
+                return os;                                                    \
+            }                                                                 \
+                                                                              \
+            os << dist.param_;                                                \
+                                                                              \
+            return os;                                                        \
+        }                                                                     \
+                                                                              \
+        template <typename CharT, typename Traits>                            \
+        friend std::basic_istream<CharT, Traits> &operator>>(                 \
+            std::basic_istream<CharT, Traits> &is, distribution_type &dist)   \
+        {                                                                     \
+            if (!is) {                                                        \
+                return is;                                                    \
+            }                                                                 \
+                                                                              \
+            param_type param;                                                 \
+            is >> std::ws >> param;                                           \
+            if (is) {                                                         \
+                dist.param_ = std::move(param);                               \
+            }                                                                 \
+                                                                              \
+            return is;                                                        \
+        }                                                                     \
+                                                                              \
+      private:                                                                \
+        param_type param_;                                                    \
+    };                                                                        \
+                                                                              \
+    template <typename RealType, std::size_t Dim, typename RNGType>           \
+    inline void rand(RNGType &rng,                                            \
+        Name##Distribution<RealType, Dim> &distribution, RealType *r)         \
+    {                                                                         \
+        distribution(rng, r);                                                 \
+    }                                                                         \
+                                                                              \
+    template <typename RealType, std::size_t Dim, typename RNGType>           \
+    inline void rand(RNGType &rng,                                            \
+        Name##Distribution<RealType, Dim> &distribution, std::size_t n,       \
+        RealType *r)                                                          \
+    {                                                                         \
+        distribution(rng, n, r);                                              \
+    }
+
+namespace mckl {
+
+namespace internal {
+
+template <typename RealType>
+inline bool wishart_distribution_check_param(std::size_t dim, RealType df)
+{
+    return dim > 0 && df > static_cast<RealType>(dim - 1);
+}
+
+// Generate the packed lower triangular Bartlett factors. The diagonal of the
+// i-th row is the square root of a chi-squared random variable with df - i
+// degrees of freedom, or df - dim + 1 + i if inverse is true.
+template <typename RealType, typename RNGType>
+inline void wishart_distribution_bartlett(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType df, bool inverse)
+{
+    const std::size_t p = dim * (dim + 1) / 2;
+    const std::size_t k = BufferSize<RealType>::value;
+    const std::size_t m = std::min(n, k);
+
+    normal_distribution(
+        rng, n * p, r, const_zero<RealType>(), const_one<RealType>());
+    Vector<RealType> s(m);
+    for (std::size_t i = 0; i != dim; ++i) {
+        const std::size_t j = inverse ? dim - 1 - i : i;
+        const RealType v = df - static_cast<RealType>(j);
+        RealType *d = r + i * (i + 3) / 2;
+        for (std::size_t b = 0; b < n; b += m) {
+            const std::size_t nb = std::min(m, n - b);
+            chi_squared_distribution(rng, nb, s.data(), v);
+            sqrt(nb, s.data(), s.data());
+            for (std::size_t l = 0; l != nb; ++l, d += p) {
+                *d = s[l];
+            }
+        }
+    }
+}
+
+// Invert the packed lower triangular matrix a in-place. If Dim is positive,
+// it is used instead of dim.
+template <std::size_t Dim, typename RealType>
+inline void wishart_distribution_invtri(std::size_t dim, RealType *a)
+{
+    const std::size_t d = Dim == 0 ? dim : Dim;
+    for (std::size_t i = 0; i != d; ++i) {
+        RealType *ai = a + i * (i + 1) / 2;
+        const RealType t = 1 / ai[i];
+        for (std::size_t j = 0; j != i; ++j) {
+            RealType s = 0;
+            for (std::size_t k = j; k != i; ++k) {
+                s = muladd(ai[k], a[k * (k + 1) / 2 + j], s);
+            }
+            ai[j] = -s * t;
+        }
+        ai[i] = t;
+    }
+}
+
+// Multiply the packed lower triangular matrix a by the full lower triangular
+// matrix cholf from the left in-place. If Dim is positive, it is used
+// instead of dim.
+template <std::size_t Dim, typename RealType>
+inline void wishart_distribution_mulchol(
+    std::size_t dim, RealType *a, const RealType *cholf)
+{
+    const std::size_t d = Dim == 0 ? dim : Dim;
+    for (std::size_t i = d; i != 0; --i) {
+        const RealType *l = cholf + (i - 1) * d;
+        RealType *ai = a + (i - 1) * i / 2;
+        for (std::size_t j = 0; j != i; ++j) {
+            RealType s = 0;
+            for (std::size_t k = j; k != i; ++k) {
+                s = muladd(l[k], a[k * (k + 1) / 2 + j], s);
+            }
+            ai[j] = s;
+        }
+    }
+}
+
+inline void wishart_distribution_trmm(std::size_t m, std::size_t n,
+    const float *a, float *b, std::size_t ldb)
+{
+    cblas_strmm(CblasRowMajor, CblasLeft, CblasLower, CblasNoTrans,
+        CblasNonUnit, static_cast<MCKL_BLAS_INT>(m),
+        static_cast<MCKL_BLAS_INT>(n), 1, a, static_cast<MCKL_BLAS_INT>(m),
+        b, static_cast<MCKL_BLAS_INT>(ldb));
+}
+
+inline void wishart_distribution_trmm(std::size_t m, std::size_t n,
+    const double *a, double *b, std::size_t ldb)
+{
+    cblas_dtrmm(CblasRowMajor, CblasLeft, CblasLower, CblasNoTrans,
+        CblasNonUnit, static_cast<MCKL_BLAS_INT>(m),
+        static_cast<MCKL_BLAS_INT>(n), 1, a, static_cast<MCKL_BLAS_INT>(m),
+        b, static_cast<MCKL_BLAS_INT>(ldb));
+}
+
+// Multiply each of the n packed lower triangular matrices in r by the full
+// lower triangular matrix cholf from the left, with fully unrolled loops
+template <std::size_t Dim, typename RealType>
+inline void wishart_distribution_mulchol(std::size_t n, RealType *r,
+    std::size_t, const RealType *cholf, std::false_type)
+{
+    const std::size_t p = Dim * (Dim + 1) / 2;
+    for (std::size_t i = 0; i != n; ++i, r += p) {
+        wishart_distribution_mulchol<Dim>(Dim, r, cholf);
+    }
+}
+
+// Multiply each of the n packed lower triangular matrices in r by the full
+// lower triangular matrix cholf from the left, with BLAS. The matrices are
+// unpacked side by side, such that each block is a single call to TRMM.
+template <std::size_t, typename RealType>
+inline void wishart_distribution_mulchol(std::size_t n, RealType *r,
+    std::size_t dim, const RealType *cholf, std::true_type)
+{
+    const std::size_t q = dim * dim;
+    const std::size_t m = std::max(
+        static_cast<std::size_t>(1), BufferSize<RealType>::value * 32 / q);
+    Vector<RealType> s(std::min(n, m) * q);
+    for (std::size_t b = 0; b < n; b += m) {
+        const std::size_t nb = std::min(m, n - b);
+        const std::size_t ldb = nb * dim;
+        std::fill(s.begin(), s.end(), const_zero<RealType>());
+        const RealType *a = r;
+        for (std::size_t l = 0; l != nb; ++l) {
+            for (std::size_t i = 0; i != dim; ++i, a += i) {
+                std::copy_n(a, i + 1, s.data() + i * ldb + l * dim);
+            }
+        }
+        wishart_distribution_trmm(dim, ldb, cholf, s.data(), ldb);
+        for (std::size_t l = 0; l != nb; ++l) {
+            for (std::size_t i = 0; i != dim; ++i, r += i) {
+                std::copy_n(s.data() + i * ldb + l * dim, i + 1, r);
+            }
+        }
+    }
+}
+
+// Generate n packed lower triangular Cholesky factors of Wishart (or inverse
+// Wishart if inverse is true) random matrices. The scale matrix is given by
+// the full lower triangular Cholesky factor cholf, or by the scalar chol if
+// cholf is a null pointer.
+template <std::size_t Dim, typename RealType, typename RNGType>
+inline void wishart_distribution_impl(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType df, RealType chol,
+    const RealType *cholf, bool inverse)
+{
+    const std::size_t p = dim * (dim + 1) / 2;
+
+    wishart_distribution_bartlett(rng, n, r, dim, df, inverse);
+    if (inverse) {
+        RealType *a = r;
+        for (std::size_t i = 0; i != n; ++i, a += p) {
+            wishart_distribution_invtri<Dim>(dim, a);
+        }
+    }
+    if (cholf != nullptr) {
+        wishart_distribution_mulchol<Dim>(
+            n, r, dim, cholf, std::integral_constant<bool, Dim == 0>());
+    } else {
+        MCKL_PUSH_CLANG_WARNING("-Wfloat-equal")
+        MCKL_PUSH_INTEL_WARNING(1572) // floating-point comparison
+        if (chol != 1) {
+            mul(n * p, chol, r, r);
+        }
+        MCKL_POP_CLANG_WARNING
+        MCKL_POP_INTEL_WARNING
+    }
+}
+
+template <typename RealType>
+inline Vector<RealType> wishart_distribution_cholf(
+    std::size_t dim, const RealType *chol)
+{
+    Vector<RealType> cholf(dim * dim, const_zero<RealType>());
+    for (std::size_t i = 0; i != dim; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            cholf[i * dim + j] = *chol++;
+        }
+    }
+
+    return cholf;
+}
+
+} // namespace internal
+
+template <typename RealType, typename RNGType>
+inline void wishart_distribution(RNGType &rng, std::size_t n, RealType *r,
+    std::size_t dim, RealType df, RealType chol)
+{
+    internal::size_check<MCKL_BLAS_INT>(n, "wishart_distribution");
+    internal::size_check<MCKL_BLAS_INT>(dim, "wishart_distribution");
+
+    internal::wishart_distribution_impl<0>(rng, n, r, dim, df, chol,
+        static_cast<const RealType *>(nullptr), false);
+}
+
+template <typename RealType, typename RNGType>
+inline void wishart_distribution(RNGType &rng, std::size_t n, RealType *r,
+    std::size_t dim, RealType df, const RealType *chol)
+{
+    internal::size_check<MCKL_BLAS_INT>(n, "wishart_distribution");
+    internal::size_check<MCKL_BLAS_INT>(dim, "wishart_distribution");
+
+    Vector<RealType> cholf = internal::wishart_distribution_cholf(dim, chol);
+    internal::wishart_distribution_impl<0>(rng, n, r, dim, df,
+        const_one<RealType>(), cholf.data(), false);
+}
+
+template <typename RealType, typename RNGType>
+inline void inverse_wishart_distribution(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType df, RealType chol)
+{
+    internal::size_check<MCKL_BLAS_INT>(n, "inverse_wishart_distribution");
+    internal::size_check<MCKL_BLAS_INT>(dim, "inverse_wishart_distribution");
+
+    internal::wishart_distribution_impl<0>(rng, n, r, dim, df, chol,
+        static_cast<const RealType *>(nullptr), true);
+}
+
+template <typename RealType, typename RNGType>
+inline void inverse_wishart_distribution(RNGType &rng, std::size_t n,
+    RealType *r, std::size_t dim, RealType df, const RealType *chol)
+{
+    internal::size_check<MCKL_BLAS_INT>(n, "inverse_wishart_distribution");
+    internal::size_check<MCKL_BLAS_INT>(dim, "inverse_wishart_distribution");
+
+    Vector<RealType> cholf = internal::wishart_distribution_cholf(dim, chol);
+    internal::wishart_distribution_impl<0>(rng, n, r, dim, df,
+        const_one<RealType>(), cholf.data(), true);
+}
+
+/// \brief Wishart distribution
+/// \ingroup Distribution
+///
+/// \tparam RealType The floating point type of the result
+/// \tparam Dim The dimension of the distribution, if it is positive
+///
+/// \details
+/// The distribution is parameterized by its degrees of freedom \f$\nu >
+/// d - 1\f$ and the lower triangular elements of the Cholesky decomposition
+/// \f$L\f$ of the scale matrix \f$\Sigma = LL^T\f$, packed row by row. A
+/// scalar `chol` \f$\sigma\f$ means \f$L = \sigma I_d\f$.
+///
+/// Each random matrix \f$W\f$ is generated with the Bartlett decomposition
+/// \f$W = LAA^TL^T\f$, where \f$A\f$ is lower triangular, \f$A_{ii}^2\f$
+/// are chi-squared with \f$\nu - i + 1\f$ degrees of freedom, and the
+/// elements below the diagonal are standard Normal. The result is the
+/// Cholesky factor \f$LA\f$ of \f$W\f$, packed row by row in \f$d(d + 1) /
+/// 2\f$ elements, such that it can be used without factorizing \f$W\f$
+/// again.
+///
+/// The Normal and chi-squared random variables are generated in batches for
+/// all matrices. If `Dim` is zero, the dimension is specified at runtime,
+/// and the products with \f$L\f$ use BLAS, unpacking a block of matrices
+/// side by side for each call. Otherwise, the products use fully unrolled
+/// loops, which has much less overhead for small dimensions.
+MCKL_DEFINE_RANDOM_WISHART_DISTRIBUTION(Wishart, false)
+
+/// \brief Inverse Wishart distribution
+/// \ingroup Distribution
+///
+/// \tparam RealType The floating point type of the result
+/// \tparam Dim The dimension of the distribution, if it is positive
+///
+/// \details
+/// The distribution is parameterized by its degrees of freedom \f$\nu >
+/// d - 1\f$ and the lower triangular elements of the Cholesky decomposition
+/// \f$L\f$ of the scale matrix \f$\Psi = LL^T\f$, packed row by row, such
+/// that \f$X^{-1}\f$ is Wishart with scale matrix \f$\Psi^{-1}\f$.
+///
+/// Each random matrix is generated as \f$X = LT^{-1}T^{-T}L^T\f$, where
+/// \f$T\f$ is a Bartlett factor with the degrees of freedom of its diagonal
+/// in the reverse order, \f$T_{ii}^2\f$ chi-squared with \f$\nu - d + i\f$
+/// degrees of freedom. The result is the Cholesky factor \f$LT^{-1}\f$ of
+/// \f$X\f$, packed row by row. See WishartDistribution for the other
+/// details.
+MCKL_DEFINE_RANDOM_WISHART_DISTRIBUTION(InverseWishart, true)
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_WISHART_DISTRIBUTION_HPP
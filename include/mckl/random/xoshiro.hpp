@@ -0,0 +1,404 @@
+//============================================================================
+// MCKL/include/mckl/random/xoshiro.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_RANDOM_XOSHIRO_HPP
+#define MCKL_RANDOM_XOSHIRO_HPP
+
+#include <mckl/random/internal/common.hpp>
+#include <mckl/random/internal/xoshiro_generic.hpp>
+#include <mckl/random/multi_stream.hpp>
+
+#if MCKL_HAS_AVX2
+#include <mckl/random/internal/xoshiro_avx2.hpp>
+#endif
+
+#if MCKL_HAS_AVX512
+#include <mckl/random/internal/xoshiro_avx512.hpp>
+#endif
+
+namespace mckl {
+
+namespace internal {
+
+#if MCKL_USE_AVX512
+template <std::size_t K>
+using Xoshiro256PPGeneratorImpl = Xoshiro256PPGeneratorAVX512Impl<K>;
+#elif MCKL_USE_AVX2
+template <std::size_t K>
+using Xoshiro256PPGeneratorImpl = Xoshiro256PPGeneratorAVX2Impl<K>;
+#else  // MCKL_USE_AVX2
+template <std::size_t K>
+using Xoshiro256PPGeneratorImpl = Xoshiro256PPGeneratorGenericImpl<K>;
+#endif // MCKL_USE_AVX2
+
+} // namespace internal
+
+/// \brief Xoshiro256++ RNG generator with multiple streams
+/// \ingroup Xoshiro
+///
+/// \tparam K Number of streams advanced in lockstep
+///
+/// \details
+/// The state of stream `i` is that of stream `i - 1` advanced by
+/// \f$2^{128}\f$ steps. Each step produces one 64-bit output for each stream
+/// and they are interleaved in the result block. The state is stored
+/// word-major, such that the streams are evaluated with SIMD instructions
+/// when `K` is a multiple of 4 (AVX2) or 8 (AVX-512).
+template <std::size_t K>
+class Xoshiro256PPGenerator
+{
+    static_assert(K != 0, "**Xoshiro256PPGenerator** used with K equal to 0");
+
+  public:
+    using state_type = std::array<std::uint64_t, K * 4>;
+
+    static constexpr std::size_t size() { return sizeof(std::uint64_t) * K; }
+
+    Xoshiro256PPGenerator() { reset(1); }
+
+    /// \brief Seed the first stream with SplitMix64 and partition the rest
+    void reset(std::uint64_t s)
+    {
+        for (std::size_t j = 0; j != 4; ++j) {
+            s_[K * j] = internal::splitmix64(s);
+        }
+        for (std::size_t i = 1; i != K; ++i) {
+            for (std::size_t j = 0; j != 4; ++j) {
+                s_[K * j + i] = s_[K * j + i - 1];
+            }
+            jump(i, jump_poly());
+        }
+    }
+
+    const state_type &state() const { return s_; }
+
+    void state(const state_type &s) { s_ = s; }
+
+    template <typename ResultType>
+    void operator()(ResultType *r)
+    {
+        internal::Xoshiro256PPGeneratorImpl<K>::eval(s_, r);
+    }
+
+    template <typename ResultType>
+    void operator()(std::size_t n, ResultType *r)
+    {
+        internal::Xoshiro256PPGeneratorImpl<K>::eval(s_, n, r);
+    }
+
+    /// \brief Advance each stream by `n` steps
+    ///
+    /// \details
+    /// For small `n` the streams are stepped. Otherwise, the polynomial
+    /// \f$x^n\f$ modulo the characteristic polynomial of the state transition
+    /// is computed by repeated squaring and applied the same way as the jump
+    /// polynomials, such that the cost is \f$O(\log n)\f$.
+    void discard(std::uint64_t n)
+    {
+        if (n < discard_threshold()) {
+            for (std::size_t i = 0; i != K; ++i) {
+                std::uint64_t *s = s_.data() + i;
+                for (std::uint64_t j = 0; j != n; ++j) {
+                    internal::Xoshiro256PPGeneratorGenericImpl<K>::step(
+                        s, s + K, s + K * 2, s + K * 3);
+                }
+            }
+            return;
+        }
+
+        const std::array<std::uint64_t, 4> poly = discard_poly(n);
+        for (std::size_t i = 0; i != K; ++i) {
+            jump(i, poly);
+        }
+    }
+
+    /// \brief Advance each stream by \f$K 2^{128}\f$ steps
+    void jump()
+    {
+        for (std::size_t i = 0; i != K; ++i) {
+            for (std::size_t k = 0; k != K; ++k) {
+                jump(i, jump_poly());
+            }
+        }
+    }
+
+    /// \brief Advance each stream by \f$2^{192}\f$ steps
+    void long_jump()
+    {
+        for (std::size_t i = 0; i != K; ++i) {
+            jump(i, long_jump_poly());
+        }
+    }
+
+    friend bool operator==(const Xoshiro256PPGenerator<K> &gen1,
+        const Xoshiro256PPGenerator<K> &gen2)
+    {
+        return gen1.s_ == gen2.s_;
+    }
+
+    friend bool operator!=(const Xoshiro256PPGenerator<K> &gen1,
+        const Xoshiro256PPGenerator<K> &gen2)
+    {
+        return !(gen1 == gen2);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os,
+        const Xoshiro256PPGenerator<K> &gen)
+    {
+        if (!os) {
+            return os;
+        }
+
+        os << gen.s_;
+
+        return os;
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(
+        std::basic_istream<CharT, Traits> &is, Xoshiro256PPGenerator<K> &gen)
+    {
+        if (!is) {
+            return is;
+        }
+
+        state_type s;
+        is >> std::ws >> s;
+
+        if (is) {
+            gen.s_ = s;
+        }
+
+        return is;
+    }
+
+  private:
+    // Polynomials over GF(2) of degree at most 256, the coefficient of x^k is
+    // bit k % 64 of word k / 64
+    using poly_type = std::array<std::uint64_t, 5>;
+
+    state_type s_;
+
+    // Stepping costs about a nanosecond per stream, and computing the jump
+    // polynomial about a hundred microseconds
+    static constexpr std::uint64_t discard_threshold()
+    {
+        return (UINT64_C(1) << 17) / K + 1;
+    }
+
+    static const std::array<std::uint64_t, 4> &jump_poly()
+    {
+        static const std::array<std::uint64_t, 4> poly = {
+            {UINT64_C(0x180EC6D33CFD0ABA), UINT64_C(0xD5A61266F0C9392C),
+                UINT64_C(0xA9582618E03FC9AA), UINT64_C(0x39ABDC4529B1661C)}};
+
+        return poly;
+    }
+
+    static const std::array<std::uint64_t, 4> &long_jump_poly()
+    {
+        static const std::array<std::uint64_t, 4> poly = {
+            {UINT64_C(0x76E15D3EFEFDCBBF), UINT64_C(0xC5004E441C522FB3),
+                UINT64_C(0x77710069854EE241), UINT64_C(0x39109BB02ACBE635)}};
+
+        return poly;
+    }
+
+    // The characteristic polynomial of the state transition, found by the
+    // Berlekamp-Massey algorithm from a bit sequence of a single stream
+    static const poly_type &char_poly()
+    {
+        static const poly_type poly = make_char_poly();
+
+        return poly;
+    }
+
+    static poly_type make_char_poly()
+    {
+        constexpr std::size_t N = 512;
+
+        std::uint64_t x = 1;
+        std::array<std::uint64_t, 4> s;
+        for (auto &w : s) {
+            w = internal::splitmix64(x);
+        }
+        std::array<unsigned char, N> a;
+        for (std::size_t k = 0; k != N; ++k) {
+            a[k] = static_cast<unsigned char>(s[0] & 1);
+            internal::Xoshiro256PPGeneratorGenericImpl<1>::step(
+                &s[0], &s[1], &s[2], &s[3]);
+        }
+
+        std::array<unsigned char, N + 1> c;
+        std::array<unsigned char, N + 1> b;
+        std::fill(c.begin(), c.end(), 0);
+        std::fill(b.begin(), b.end(), 0);
+        c[0] = b[0] = 1;
+        std::size_t l = 0;
+        std::size_t m = 1;
+        for (std::size_t n = 0; n != N; ++n) {
+            unsigned char d = a[n];
+            for (std::size_t i = 1; i <= l; ++i) {
+                d ^= c[i] & a[n - i];
+            }
+            if (d == 0) {
+                ++m;
+                continue;
+            }
+            const std::array<unsigned char, N + 1> t(c);
+            for (std::size_t i = 0; i + m <= N; ++i) {
+                c[i + m] ^= b[i];
+            }
+            if (2 * l <= n) {
+                l = n + 1 - l;
+                b = t;
+                m = 1;
+            } else {
+                ++m;
+            }
+        }
+
+        poly_type poly = {{0, 0, 0, 0, 0}};
+        for (std::size_t k = 0; k <= l; ++k) {
+            if (c[l - k] != 0) {
+                poly[k / 64] |= const_one<std::uint64_t>() << (k % 64);
+            }
+        }
+
+        return poly;
+    }
+
+    // r = r * x modulo the characteristic polynomial
+    static void mulx(poly_type &r)
+    {
+        for (std::size_t w = 4; w != 0; --w) {
+            r[w] = (r[w] << 1) | (r[w - 1] >> 63);
+        }
+        r[0] <<= 1;
+        if ((r[4] & 1) != 0) {
+            const poly_type &p = char_poly();
+            for (std::size_t w = 0; w != 5; ++w) {
+                r[w] ^= p[w];
+            }
+        }
+    }
+
+    // a * b modulo the characteristic polynomial
+    static poly_type mulmod(const poly_type &a, const poly_type &b)
+    {
+        poly_type r = {{0, 0, 0, 0, 0}};
+        for (std::size_t k = 256; k != 0; --k) {
+            mulx(r);
+            if (((b[(k - 1) / 64] >> ((k - 1) % 64)) & 1) != 0) {
+                for (std::size_t w = 0; w != 4; ++w) {
+                    r[w] ^= a[w];
+                }
+            }
+        }
+
+        return r;
+    }
+
+    // x^n modulo the characteristic polynomial
+    static std::array<std::uint64_t, 4> discard_poly(std::uint64_t n)
+    {
+        poly_type r = {{1, 0, 0, 0, 0}};
+        int k = 63;
+        while (((n >> k) & 1) == 0) {
+            --k;
+        }
+        for (; k >= 0; --k) {
+            r = mulmod(r, r);
+            if (((n >> k) & 1) != 0) {
+                mulx(r);
+            }
+        }
+
+        return {{r[0], r[1], r[2], r[3]}};
+    }
+
+    void jump(std::size_t i, const std::array<std::uint64_t, 4> &poly)
+    {
+        std::uint64_t *s = s_.data() + i;
+        std::array<std::uint64_t, 4> t = {{0, 0, 0, 0}};
+        for (std::size_t w = 0; w != 4; ++w) {
+            for (int b = 0; b != 64; ++b) {
+                if ((poly[w] & (const_one<std::uint64_t>() << b)) != 0) {
+                    t[0] ^= s[K * 0];
+                    t[1] ^= s[K * 1];
+                    t[2] ^= s[K * 2];
+                    t[3] ^= s[K * 3];
+                }
+                internal::Xoshiro256PPGeneratorGenericImpl<K>::step(
+                    s, s + K, s + K * 2, s + K * 3);
+            }
+        }
+        for (std::size_t j = 0; j != 4; ++j) {
+            s[K * j] = t[j];
+        }
+    }
+}; // class Xoshiro256PPGenerator
+
+/// \brief Xoshiro256++ RNG engine with multiple streams
+/// \ingroup Xoshiro
+template <typename ResultType, std::size_t K = 1>
+using Xoshiro256PPEngine =
+    MultiStreamEngine<ResultType, Xoshiro256PPGenerator<K>>;
+
+/// \brief Xoshiro256++ RNG engine with 32-bit output and a single stream
+/// \ingroup Xoshiro
+using Xoshiro256PP = Xoshiro256PPEngine<std::uint32_t>;
+
+/// \brief Xoshiro256++ RNG engine with 32-bit output and 4 streams
+/// \ingroup Xoshiro
+using Xoshiro256PPx4 = Xoshiro256PPEngine<std::uint32_t, 4>;
+
+/// \brief Xoshiro256++ RNG engine with 32-bit output and 8 streams
+/// \ingroup Xoshiro
+using Xoshiro256PPx8 = Xoshiro256PPEngine<std::uint32_t, 8>;
+
+/// \brief Xoshiro256++ RNG engine with 64-bit output and a single stream
+/// \ingroup Xoshiro
+using Xoshiro256PP_64 = Xoshiro256PPEngine<std::uint64_t>;
+
+/// \brief Xoshiro256++ RNG engine with 64-bit output and 4 streams
+/// \ingroup Xoshiro
+using Xoshiro256PPx4_64 = Xoshiro256PPEngine<std::uint64_t, 4>;
+
+/// \brief Xoshiro256++ RNG engine with 64-bit output and 8 streams
+/// \ingroup Xoshiro
+using Xoshiro256PPx8_64 = Xoshiro256PPEngine<std::uint64_t, 8>;
+
+} // namespace mckl
+
+#endif // MCKL_RANDOM_XOSHIRO_HPP
@@ -33,7 +33,10 @@
 #define MCKL_SMP_BACKEND_BASE_HPP
 
 #include <mckl/internal/common.hpp>
+#include <mckl/core/matrix.hpp>
 #include <mckl/core/particle.hpp>
+#include <mckl/utility/stop_watch.hpp>
+#include <atomic>
 
 MCKL_PUSH_CLANG_WARNING("-Wweak-vtables")
 
@@ -107,6 +110,391 @@ class SMCSamplerEvalSMP;
 template <typename T, typename = Virtual, typename = BackendSMP>
 class SMCEstimatorEvalSMP;
 
+/// \brief Scheduling of particle ranges by the STD and OMP backends
+/// \ingroup SMP
+///
+/// \details
+/// Except for `Static`, the boundaries of the ranges are multiples of the
+/// number of `double` values in a cache line, such that writes into buffers
+/// indexed by particles, such as the incremental weights, do not share cache
+/// lines between threads.
+///
+/// With `Affinity`, the same range of particles is evaluated by the same
+/// thread, on the same core where possible, in every step and iteration
+/// until the sample size or the number of threads changes. BackendSTD uses a
+/// pool of persistent threads, each bound to one of the processors available
+/// to the process on Linux. BackendOMP binds the threads with
+/// `proc_bind(close)`. BackendTBB uses a `tbb::affinity_partitioner` shared
+/// by all steps that use the same particle system. BackendTBB ignores other
+/// values.
+enum class SMPSchedule {
+    Static,   ///< One range of equal size for each thread
+    Dynamic,  ///< Chunks of equal size, taken by threads on demand
+    Guided,   ///< Chunks of decreasing size, taken by threads on demand
+    Adaptive, ///< One range for each thread, resized by the measured costs
+    Affinity  ///< One range of equal size for each thread, always evaluated
+              ///< by the same thread
+};            // enum SMPSchedule
+
+namespace internal {
+
+template <typename>
+class SMPFor;
+
+template <typename T>
+inline auto backend_advise_dispatch(const ParticleRange<T> &range, int)
+    -> decltype(range.particle().state().advise(range.ibegin(), range.iend()))
+{
+    range.particle().state().advise(range.ibegin(), range.iend());
+}
+
+template <typename T>
+inline void backend_advise_dispatch(const ParticleRange<T> &, long)
+{
+}
+
+/// \brief Advise the state that a range will be accessed sequentially, if it
+/// has a member function `advise(ibegin, iend)`
+template <typename T>
+inline void backend_advise(const ParticleRange<T> &range)
+{
+    backend_advise_dispatch(range, 0);
+}
+
+/// \brief Measure the evaluation of a range in its scope, if the particle
+/// system is being profiled
+template <typename T>
+class BackendProfileRange
+{
+  public:
+    explicit BackendProfileRange(const ParticleRange<T> &range)
+        : range_(range), handler_(range.particle().profiler())
+    {
+        if (handler_ != nullptr) {
+            watch_.start();
+        }
+    }
+
+    BackendProfileRange(const BackendProfileRange &) = delete;
+    BackendProfileRange &operator=(const BackendProfileRange &) = delete;
+
+    ~BackendProfileRange()
+    {
+        if (handler_ != nullptr) {
+            watch_.stop();
+            handler_->range(static_cast<std::size_t>(range_.ibegin()),
+                static_cast<std::size_t>(range_.iend()),
+                watch_.nanoseconds());
+        }
+    }
+
+  private:
+    ParticleRange<T> range_;
+    ParticleProfilerHandler *handler_;
+    StopWatch watch_;
+}; // class BackendProfileRange
+
+// The number of particles whose double values fill a cache line
+constexpr std::size_t backend_align() { return 64 / sizeof(double); }
+
+/// \brief Partition of particles into ranges for each call of a backend
+class BackendSchedule
+{
+  public:
+    explicit BackendSchedule(SMPSchedule schedule = SMPSchedule::Static)
+        : schedule_(schedule), N_(0), np_(0), chunk_(0), next_(0)
+    {
+    }
+
+    BackendSchedule(const BackendSchedule &other)
+        : schedule_(other.schedule_), N_(0), np_(0), chunk_(0), next_(0)
+    {
+    }
+
+    BackendSchedule &operator=(const BackendSchedule &other)
+    {
+        if (this != &other) {
+            schedule(other.schedule_);
+        }
+
+        return *this;
+    }
+
+    SMPSchedule schedule() const { return schedule_; }
+
+    void schedule(SMPSchedule s)
+    {
+        schedule_ = s;
+        N_ = 0;
+        np_ = 0;
+    }
+
+    /// \brief Prepare for the evaluation of `N` particles by `np` workers
+    void start(std::size_t N, std::size_t np, std::size_t grainsize)
+    {
+        np = std::max<std::size_t>(np, 1);
+        grainsize = std::max<std::size_t>(grainsize, 1);
+        next_ = 0;
+        switch (schedule_) {
+            case SMPSchedule::Static:
+                partition(N, np, 1);
+                break;
+            case SMPSchedule::Dynamic:
+                chunk_ = align(std::max(grainsize, N / (np * 8)));
+                break;
+            case SMPSchedule::Guided:
+                chunk_ = align(grainsize);
+                break;
+            case SMPSchedule::Adaptive:
+                if (N != N_ || np != np_) {
+                    partition(N, np, backend_align());
+                }
+                cost_.resize(np);
+                std::fill(cost_.begin(), cost_.end(), 0.0);
+                break;
+            case SMPSchedule::Affinity:
+                if (N != N_ || np != np_) {
+                    partition(N, np, backend_align());
+                }
+                break;
+        }
+        N_ = N;
+        np_ = np;
+    }
+
+    /// \brief Evaluate `f(ibegin, iend)` for the ranges of a worker
+    ///
+    /// \details
+    /// Each worker `id` in `[0, np)` shall be called exactly once, possibly
+    /// concurrently
+    template <typename Func>
+    void eval(std::size_t id, Func &&f)
+    {
+        std::size_t ibegin = 0;
+        std::size_t iend = 0;
+        switch (schedule_) {
+            case SMPSchedule::Static:
+            case SMPSchedule::Affinity:
+                if (bound_[id] != bound_[id + 1]) {
+                    f(bound_[id], bound_[id + 1]);
+                }
+                break;
+            case SMPSchedule::Dynamic:
+                while (next_dynamic(ibegin, iend)) {
+                    f(ibegin, iend);
+                }
+                break;
+            case SMPSchedule::Guided:
+                while (next_guided(ibegin, iend)) {
+                    f(ibegin, iend);
+                }
+                break;
+            case SMPSchedule::Adaptive:
+                if (bound_[id] != bound_[id + 1]) {
+                    StopWatch watch;
+                    watch.start();
+                    f(bound_[id], bound_[id + 1]);
+                    watch.stop();
+                    cost_[id] = watch.nanoseconds();
+                }
+                break;
+        }
+    }
+
+    /// \brief Finish the evaluation, after all workers have returned
+    ///
+    /// \details
+    /// With `Adaptive`, the costs of the ranges measured by eval() are
+    /// assumed to be uniform within each range, and the ranges of the next
+    /// call are chosen such that their estimated costs are equal.
+    void stop()
+    {
+        if (schedule_ != SMPSchedule::Adaptive) {
+            return;
+        }
+
+        double total = 0;
+        for (double c : cost_) {
+            total += c;
+        }
+        if (!(total > 0)) {
+            return;
+        }
+
+        Vector<std::size_t> bound(np_ + 1);
+        bound.front() = 0;
+        bound.back() = N_;
+        std::size_t j = 0;
+        double sum = 0;
+        for (std::size_t k = 1; k != np_; ++k) {
+            const double target = total * k / np_;
+            while (j != np_ - 1 && sum + cost_[j] < target) {
+                sum += cost_[j++];
+            }
+            const double len = static_cast<double>(bound_[j + 1] - bound_[j]);
+            const double pos = cost_[j] > 0 ?
+                bound_[j] + len * (target - sum) / cost_[j] :
+                static_cast<double>(bound_[j]);
+            const std::size_t b = std::min(
+                N_, align(static_cast<std::size_t>(pos + 0.5), false));
+            bound[k] = std::max(bound[k - 1], b);
+        }
+        bound_ = std::move(bound);
+    }
+
+    /// \brief The boundaries of the ranges of the last `Static`, `Adaptive`
+    /// or `Affinity` partition, with size `np + 1`
+    const Vector<std::size_t> &bound() const { return bound_; }
+
+  private:
+    SMPSchedule schedule_;
+    std::size_t N_;
+    std::size_t np_;
+    std::size_t chunk_;
+    std::atomic<std::size_t> next_;
+    Vector<std::size_t> bound_;
+    Vector<double> cost_;
+
+    static std::size_t align(std::size_t n, bool up = true)
+    {
+        const std::size_t a = backend_align();
+
+        return (up ? n + a - 1 : n + a / 2) / a * a;
+    }
+
+    void partition(std::size_t N, std::size_t np, std::size_t a)
+    {
+        const std::size_t M = (N + a - 1) / a;
+        const std::size_t m = M / np;
+        const std::size_t r = M % np;
+        bound_.resize(np + 1);
+        bound_.front() = 0;
+        for (std::size_t i = 0; i != np; ++i) {
+            bound_[i + 1] =
+                std::min(N, bound_[i] + (m + (i < r ? 1 : 0)) * a);
+        }
+    }
+
+    bool next_dynamic(std::size_t &ibegin, std::size_t &iend)
+    {
+        ibegin = next_.fetch_add(chunk_, std::memory_order_relaxed);
+        if (ibegin >= N_) {
+            return false;
+        }
+        iend = std::min(N_, ibegin + chunk_);
+
+        return true;
+    }
+
+    bool next_guided(std::size_t &ibegin, std::size_t &iend)
+    {
+        ibegin = next_.load(std::memory_order_relaxed);
+        do {
+            if (ibegin >= N_) {
+                return false;
+            }
+            const std::size_t n = (N_ - ibegin) / (2 * np_);
+            iend = std::min(N_, ibegin + std::max(chunk_, align(n)));
+        } while (!next_.compare_exchange_weak(
+            ibegin, iend, std::memory_order_relaxed));
+
+        return true;
+    }
+}; // class BackendSchedule
+
+template <typename S, typename ForEach>
+inline auto backend_first_touch_dispatch(S &obj, ForEach &&for_each, int)
+    -> decltype(obj.first_touch(std::forward<ForEach>(for_each)))
+{
+    obj.first_touch(std::forward<ForEach>(for_each));
+}
+
+template <typename S, typename ForEach>
+inline void backend_first_touch_dispatch(S &, ForEach &&, long)
+{
+}
+
+} // namespace internal
+
+/// \brief Apply a function to disjoint sub-ranges of \f$[0, N)\f$ in parallel
+/// \ingroup SMP
+///
+/// \param N The size of the index range
+/// \param f A callable object, invoked as `f(ibegin, iend)` once for each
+/// sub-range, possibly concurrently
+/// \param grainsize The minimum size of each sub-range. Backends that do not
+/// support it treat it as a hint on the number of sub-ranges.
+template <typename Backend = BackendSMP, typename Func>
+inline void smp_for(std::size_t N, Func &&f, std::size_t grainsize = 1)
+{
+    if (N == 0) {
+        return;
+    }
+
+    internal::SMPFor<Backend>::eval(N, std::forward<Func>(f), grainsize);
+}
+
+/// \brief Callable object that calls smp_for
+/// \ingroup SMP
+///
+/// \details
+/// `SMPForEach<Backend>(grainsize)(N, f)` calls
+/// `smp_for<Backend>(N, f, grainsize)`. It can be passed where a `for_each`
+/// callable object is expected, such as `StateMatrix::first_touch`,
+/// `Matrix::relayout` and `SMCSampler::estimator_for_each`.
+template <typename Backend = BackendSMP>
+class SMPForEach
+{
+  public:
+    explicit SMPForEach(std::size_t grainsize = 1) : grainsize_(grainsize) {}
+
+    template <typename Func>
+    void operator()(std::size_t N, Func &&f) const
+    {
+        smp_for<Backend>(N, std::forward<Func>(f), grainsize_);
+    }
+
+  private:
+    std::size_t grainsize_;
+}; // class SMPForEach
+
+/// \brief Reallocate the state and weights of a particle system in parallel
+/// \ingroup SMP
+///
+/// \details
+/// For each of `particle.state()` and `particle.weight()` that has a member
+/// function `first_touch`, such as StateMatrix and Weight, its storage is
+/// reallocated and copied with smp_for, which partitions the particles the
+/// same way as the backend does for `eval_range`. On NUMA systems with a
+/// first-touch policy, each range of particles is then placed on the node of
+/// the thread that processes it, instead of the node of the thread that
+/// constructed the particle system. The memory shall be obtained from a
+/// policy that does not touch the pages it returns, such as MemoryHUGE or,
+/// for large sizes, MemorySYS. Other states are left unchanged.
+template <typename Backend = BackendSMP, typename T>
+inline void smp_first_touch(Particle<T> &particle)
+{
+    const SMPForEach<Backend> for_each;
+    internal::backend_first_touch_dispatch(particle.state(), for_each, 0);
+    internal::backend_first_touch_dispatch(particle.weight(), for_each, 0);
+}
+
+/// \brief Convert a matrix to the other storage layout in parallel
+/// \ingroup SMP
+///
+/// \details
+/// The matrix is partitioned into blocks along its larger dimension, and the
+/// blocks are transposed with smp_for. Either argument may be a StateMatrix,
+/// such that samples can be kept in column major order for vectorized
+/// `eval_range` and converted to row major order for output.
+template <typename Backend = BackendSMP, typename T, MatrixLayout Layout,
+    typename Alloc>
+inline void smp_relayout(const Matrix<T, Layout, Alloc> &src,
+    typename Matrix<T, Layout, Alloc>::transpose_type &dst)
+{
+    src.relayout(dst, SMPForEach<Backend>());
+}
+
 /// \brief SMCSampler evaluation base dispatch class
 /// \ingroup SMP
 template <typename T, typename Derived>
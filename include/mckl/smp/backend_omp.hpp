@@ -59,6 +59,95 @@ inline void backend_omp_range(IntType N, IntType &ibegin, IntType &iend)
     iend = ibegin + n;
 }
 
+inline int backend_omp_np(std::size_t N, std::size_t grainsize)
+{
+#if MCKL_HAS_OMP
+    const std::size_t np = static_cast<std::size_t>(::omp_get_max_threads());
+#else
+    const std::size_t np = 1;
+#endif
+    const std::size_t n = N / std::max<std::size_t>(grainsize, 1);
+
+    return static_cast<int>(std::max<std::size_t>(1, std::min(np, n)));
+}
+
+template <typename T, typename Func>
+inline void backend_omp_run(Particle<T> &particle, BackendSchedule &schedule,
+    std::size_t grainsize, Func &&f)
+{
+#if MCKL_HAS_OMP
+    int np = ::omp_get_max_threads();
+#else
+    int np = 1;
+#endif
+    schedule.start(static_cast<std::size_t>(particle.size()),
+        static_cast<std::size_t>(np), grainsize);
+
+    auto work = [&particle, &f](std::size_t ibegin, std::size_t iend) {
+        const ParticleRange<T> range = particle.range(
+            static_cast<typename Particle<T>::size_type>(ibegin),
+            static_cast<typename Particle<T>::size_type>(iend));
+        backend_advise(range);
+        const BackendProfileRange<T> profile(range);
+        f(range);
+    };
+
+    // The team may have fewer threads than requested
+    auto team = [&schedule, &work, np]() {
+#if MCKL_HAS_OMP
+        const int id = ::omp_get_thread_num();
+        const int nt = ::omp_get_num_threads();
+#else
+        const int id = 0;
+        const int nt = 1;
+#endif
+        for (int k = id; k < np; k += nt) {
+            schedule.eval(static_cast<std::size_t>(k), work);
+        }
+    };
+
+    if (schedule.schedule() == SMPSchedule::Affinity) {
+#if MCKL_HAS_OMP
+#pragma omp parallel num_threads(np) proc_bind(close) default(none) \
+    shared(team)
+#endif
+        team();
+    } else {
+#if MCKL_HAS_OMP
+#pragma omp parallel num_threads(np) default(none) shared(team)
+#endif
+        team();
+    }
+    schedule.stop();
+}
+
+template <>
+class SMPFor<BackendOMP>
+{
+  public:
+    template <typename Func>
+    static void eval(std::size_t N, Func &&f, std::size_t grainsize)
+    {
+        const int np = backend_omp_np(N, grainsize);
+        if (np == 1) {
+            f(static_cast<std::size_t>(0), N);
+            return;
+        }
+
+#if MCKL_HAS_OMP
+#pragma omp parallel num_threads(np) default(none) shared(f) firstprivate(N)
+#endif
+        {
+            std::size_t ibegin = 0;
+            std::size_t iend = 0;
+            backend_omp_range(N, ibegin, iend);
+            if (ibegin != iend) {
+                f(ibegin, iend);
+            }
+        }
+    }
+}; // class SMPFor
+
 } // namespace internal
 
 /// \brief SMCSampler<T>::eval_type subtype using OpenMP
@@ -73,6 +162,12 @@ class SMCSamplerEvalSMP<T, Derived, BackendOMP>
         run(iter, particle);
     }
 
+    /// \brief The scheduling of particle ranges
+    SMPSchedule schedule() const { return schedule_.schedule(); }
+
+    /// \brief Set the scheduling of particle ranges
+    void schedule(SMPSchedule s) { schedule_.schedule(s); }
+
   protected:
     MCKL_DEFINE_SMP_BACKEND_SPECIAL(OMP, SMCSamplerEval)
 
@@ -82,23 +177,19 @@ class SMCSamplerEvalSMP<T, Derived, BackendOMP>
     }
 
     template <typename... Args>
-    void run(std::size_t iter, Particle<T> &particle, std::size_t, Args &&...)
+    void run(std::size_t iter, Particle<T> &particle, std::size_t grainsize,
+        Args &&...)
     {
-        using size_type = typename Particle<T>::size_type;
-
         this->eval_first(iter, particle);
-        Particle<T> *pptr = &particle;
-#if MCKL_HAS_OMP
-#pragma omp parallel default(none) firstprivate(pptr, iter)
-#endif
-        {
-            size_type ibegin = 0;
-            size_type iend = 0;
-            internal::backend_omp_range(pptr->size(), ibegin, iend);
-            this->eval_range(iter, pptr->range(ibegin, iend));
-        }
+        internal::backend_omp_run(particle, schedule_, grainsize,
+            [this, iter](const ParticleRange<T> &range) {
+                this->eval_range(iter, range);
+            });
         this->eval_last(iter, particle);
     }
+
+  private:
+    internal::BackendSchedule schedule_;
 }; // class SMCSamplerEvalSMP
 
 /// \brief SMCEstimator<T>::eval_type subtype using OpenMP
@@ -114,6 +205,12 @@ class SMCEstimatorEvalSMP<T, Derived, BackendOMP>
         run(iter, dim, particle, r);
     }
 
+    /// \brief The scheduling of particle ranges
+    SMPSchedule schedule() const { return schedule_.schedule(); }
+
+    /// \brief Set the scheduling of particle ranges
+    void schedule(SMPSchedule s) { schedule_.schedule(s); }
+
   protected:
     MCKL_DEFINE_SMP_BACKEND_SPECIAL(OMP, SMCEstimatorEval)
 
@@ -125,24 +222,19 @@ class SMCEstimatorEvalSMP<T, Derived, BackendOMP>
 
     template <typename... Args>
     void run(std::size_t iter, std::size_t dim, Particle<T> &particle,
-        double *r, std::size_t, Args &&...)
+        double *r, std::size_t grainsize, Args &&...)
     {
-        using size_type = typename Particle<T>::size_type;
-
         this->eval_first(iter, particle);
-        Particle<T> *pptr = &particle;
-#if MCKL_HAS_OMP
-#pragma omp parallel default(none) firstprivate(pptr, iter, dim, r)
-#endif
-        {
-            size_type ibegin = 0;
-            size_type iend = 0;
-            internal::backend_omp_range(pptr->size(), ibegin, iend);
-            this->eval_range(iter, dim, pptr->range(ibegin, iend),
-                r + static_cast<std::size_t>(ibegin) * dim);
-        }
+        internal::backend_omp_run(particle, schedule_, grainsize,
+            [this, iter, dim, r](const ParticleRange<T> &range) {
+                this->eval_range(iter, dim, range,
+                    r + static_cast<std::size_t>(range.ibegin()) * dim);
+            });
         this->eval_last(iter, particle);
     }
+
+  private:
+    internal::BackendSchedule schedule_;
 }; // class SMCEstimatorEvalSMP
 
 /// \brief SMCSampler<T>::eval_type subtype using OpenMP
@@ -36,6 +36,21 @@
 
 namespace mckl {
 
+namespace internal {
+
+template <>
+class SMPFor<BackendSEQ>
+{
+  public:
+    template <typename Func>
+    static void eval(std::size_t N, Func &&f, std::size_t)
+    {
+        f(static_cast<std::size_t>(0), N);
+    }
+}; // class SMPFor
+
+} // namespace internal
+
 /// \brief SMCSampler<T>::eval_type subtype
 /// \ingroup SEQ
 template <typename T, typename Derived>
@@ -60,7 +75,11 @@ class SMCSamplerEvalSMP<T, Derived, BackendSEQ>
     void run(std::size_t iter, Particle<T> &particle, std::size_t, Args &&...)
     {
         this->eval_first(iter, particle);
-        this->eval_range(iter, particle.range());
+        internal::backend_advise(particle.range());
+        {
+            const internal::BackendProfileRange<T> profile(particle.range());
+            this->eval_range(iter, particle.range());
+        }
         this->eval_last(iter, particle);
     }
 }; // class SMCSamplerEvalSMP
@@ -92,7 +111,11 @@ class SMCEstimatorEvalSMP<T, Derived, BackendSEQ>
         double *r, std::size_t, Args &&...)
     {
         this->eval_first(iter, particle);
-        this->eval_range(iter, dim, particle.range(), r);
+        internal::backend_advise(particle.range());
+        {
+            const internal::BackendProfileRange<T> profile(particle.range());
+            this->eval_range(iter, dim, particle.range(), r);
+        }
         this->eval_last(iter, particle);
     }
 }; // class SMCEstimatorEvalSMP
@@ -34,9 +34,17 @@
 
 #include <mckl/core/iterator.hpp>
 #include <mckl/smp/backend_base.hpp>
+#include <condition_variable>
+#include <exception>
 #include <future>
+#include <mutex>
 #include <thread>
 
+#if MCKL_HAS_POSIX && defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace mckl {
 
 class BackendSTD
@@ -66,27 +74,234 @@ class BackendSTD
 
 namespace internal {
 
-template <typename T>
-inline mckl::Vector<ParticleRange<T>> backend_std_range(Particle<T> &particle)
+// Persistent threads, such that the same worker evaluates the same range of
+// particles in every call
+class BackendSTDPool
+{
+  public:
+    BackendSTDPool(const BackendSTDPool &) = delete;
+    BackendSTDPool &operator=(const BackendSTDPool &) = delete;
+
+    static BackendSTDPool &instance()
+    {
+        static BackendSTDPool pool;
+
+        return pool;
+    }
+
+    ~BackendSTDPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (auto &t : thread_) {
+            t.join();
+        }
+    }
+
+    /// \brief Call `f(id)` for each `id` in `[0, np)` on worker `id` and
+    /// wait for all of them to return
+    ///
+    /// \details
+    /// If called from a worker, the calls are made sequentially on the
+    /// calling thread instead. If any call throws, the exception of the
+    /// worker with the smallest `id` is rethrown after all calls return.
+    template <typename Func>
+    void run(std::size_t np, Func &&f)
+    {
+        if (is_worker()) {
+            for (std::size_t id = 0; id != np; ++id) {
+                f(id);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> run_lock(run_mutex_);
+        std::function<void(std::size_t)> task(std::ref(f));
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (thread_.size() < np) {
+            const std::size_t id = thread_.size();
+            thread_.emplace_back([this, id]() { work(id); });
+        }
+        error_.resize(np);
+        task_ = &task;
+        active_ = np;
+        remain_ = np;
+        ++generation_;
+        start_.notify_all();
+        finish_.wait(lock, [this]() { return remain_ == 0; });
+        task_ = nullptr;
+
+        std::exception_ptr error;
+        for (std::size_t id = 0; id != np; ++id) {
+            if (error == nullptr) {
+                error = error_[id];
+            }
+            error_[id] = nullptr;
+        }
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+
+  private:
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable finish_;
+    std::vector<std::thread> thread_;
+    std::vector<std::exception_ptr> error_;
+    std::function<void(std::size_t)> *task_;
+    std::size_t active_;
+    std::size_t remain_;
+    std::size_t generation_;
+    bool stop_;
+
+    BackendSTDPool()
+        : task_(nullptr), active_(0), remain_(0), generation_(0), stop_(false)
+    {
+    }
+
+    static bool &is_worker()
+    {
+        static thread_local bool flag = false;
+
+        return flag;
+    }
+
+    void work(std::size_t id)
+    {
+        is_worker() = true;
+        bind(id);
+
+        std::size_t generation = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            start_.wait(lock, [this, generation]() {
+                return stop_ || generation_ != generation;
+            });
+            if (stop_) {
+                return;
+            }
+            generation = generation_;
+            if (id >= active_) {
+                continue;
+            }
+
+            std::function<void(std::size_t)> *task = task_;
+            lock.unlock();
+            try {
+                (*task)(id);
+            } catch (...) {
+                error_[id] = std::current_exception();
+            }
+            lock.lock();
+            if (--remain_ == 0) {
+                finish_.notify_all();
+            }
+        }
+    }
+
+    // Bind worker id to the id-th processor available to the process
+    static void bind(std::size_t id)
+    {
+#if MCKL_HAS_POSIX && defined(__linux__)
+        ::cpu_set_t available;
+        CPU_ZERO(&available);
+        if (::sched_getaffinity(0, sizeof(available), &available) != 0) {
+            return;
+        }
+        const int n = CPU_COUNT(&available);
+        if (n < 2) {
+            return;
+        }
+        std::size_t k = id % static_cast<std::size_t>(n);
+        for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &available) && k-- == 0) {
+                ::cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+                return;
+            }
+        }
+#else
+        static_cast<void>(id);
+#endif
+    }
+}; // class BackendSTDPool
+
+template <typename T, typename Func>
+inline void backend_std_run(Particle<T> &particle, BackendSchedule &schedule,
+    std::size_t grainsize, Func &&f)
 {
-    const std::size_t N = static_cast<std::size_t>(particle.size());
-    const std::size_t n =
+    const std::size_t np =
         static_cast<std::size_t>(std::max(1U, BackendSTD::instance().np()));
-    const std::size_t m = N / n;
-    const std::size_t r = N % n;
+    schedule.start(static_cast<std::size_t>(particle.size()), np, grainsize);
 
-    ParticleIndex<T> b = particle.begin();
-    mckl::Vector<ParticleRange<T>> range;
-    range.reserve(n);
-    for (std::size_t i = 0; i != n; ++i) {
-        const std::size_t l = m + (i < r ? 1 : 0);
-        range.emplace_back(b, b + l);
-        b += l;
+    auto work = [&particle, &f](std::size_t ibegin, std::size_t iend) {
+        const ParticleRange<T> range = particle.range(
+            static_cast<typename Particle<T>::size_type>(ibegin),
+            static_cast<typename Particle<T>::size_type>(iend));
+        backend_advise(range);
+        const BackendProfileRange<T> profile(range);
+        f(range);
+    };
+
+    if (schedule.schedule() == SMPSchedule::Affinity) {
+        BackendSTDPool::instance().run(np,
+            [&schedule, &work](std::size_t id) { schedule.eval(id, work); });
+        schedule.stop();
+        return;
     }
 
-    return range;
+    mckl::Vector<std::future<void>> task_group;
+    task_group.reserve(np);
+    for (std::size_t id = 0; id != np; ++id) {
+        task_group.push_back(std::async(std::launch::async,
+            [&schedule, &work, id]() { schedule.eval(id, work); }));
+    }
+    for (auto &task : task_group) {
+        task.wait();
+    }
+    schedule.stop();
 }
 
+template <>
+class SMPFor<BackendSTD>
+{
+  public:
+    template <typename Func>
+    static void eval(std::size_t N, Func &&f, std::size_t grainsize)
+    {
+        const std::size_t np = std::max<std::size_t>(
+            1, static_cast<std::size_t>(BackendSTD::instance().np()));
+        const std::size_t n = std::max<std::size_t>(
+            1, std::min(np, N / std::max<std::size_t>(grainsize, 1)));
+        if (n == 1) {
+            f(static_cast<std::size_t>(0), N);
+            return;
+        }
+
+        const std::size_t m = N / n;
+        const std::size_t r = N % n;
+        std::size_t ibegin = 0;
+        mckl::Vector<std::future<void>> task_group;
+        task_group.reserve(n);
+        for (std::size_t i = 0; i != n; ++i) {
+            const std::size_t iend = ibegin + m + (i < r ? 1 : 0);
+            task_group.push_back(std::async(std::launch::async,
+                [&f, ibegin, iend]() { f(ibegin, iend); }));
+            ibegin = iend;
+        }
+        for (auto &task : task_group) {
+            task.wait();
+        }
+    }
+}; // class SMPFor
+
 } // namespace internal
 
 /// \brief SMCSampler<T>::eval_type subtype using the standard library
@@ -101,6 +316,12 @@ class SMCSamplerEvalSMP<T, Derived, BackendSTD>
         run(iter, particle);
     }
 
+    /// \brief The scheduling of particle ranges
+    SMPSchedule schedule() const { return schedule_.schedule(); }
+
+    /// \brief Set the scheduling of particle ranges
+    void schedule(SMPSchedule s) { schedule_.schedule(s); }
+
   protected:
     MCKL_DEFINE_SMP_BACKEND_SPECIAL(STD, SMCSamplerEval)
 
@@ -110,21 +331,19 @@ class SMCSamplerEvalSMP<T, Derived, BackendSTD>
     }
 
     template <typename... Args>
-    void run(std::size_t iter, Particle<T> &particle, std::size_t, Args &&...)
+    void run(std::size_t iter, Particle<T> &particle, std::size_t grainsize,
+        Args &&...)
     {
         this->eval_first(iter, particle);
-        mckl::Vector<std::future<void>> task_group;
-        for (auto range : internal::backend_std_range(particle)) {
-            task_group.push_back(std::async(
-                std::launch::async, [this, iter, &particle, range]() {
-                    this->eval_range(iter, range);
-                }));
-        }
-        for (auto &task : task_group) {
-            task.wait();
-        }
+        internal::backend_std_run(particle, schedule_, grainsize,
+            [this, iter](const ParticleRange<T> &range) {
+                this->eval_range(iter, range);
+            });
         this->eval_last(iter, particle);
     }
+
+  private:
+    internal::BackendSchedule schedule_;
 }; // class SMCSamplerEvalSMP
 
 /// \brief SMCEstimator<T>::eval_type subtype using the standard library
@@ -140,6 +359,12 @@ class SMCEstimatorEvalSMP<T, Derived, BackendSTD>
         run(iter, dim, particle, r);
     }
 
+    /// \brief The scheduling of particle ranges
+    SMPSchedule schedule() const { return schedule_.schedule(); }
+
+    /// \brief Set the scheduling of particle ranges
+    void schedule(SMPSchedule s) { schedule_.schedule(s); }
+
   protected:
     MCKL_DEFINE_SMP_BACKEND_SPECIAL(STD, SMCEstimatorEval)
 
@@ -151,22 +376,19 @@ class SMCEstimatorEvalSMP<T, Derived, BackendSTD>
 
     template <typename... Args>
     void run(std::size_t iter, std::size_t dim, Particle<T> &particle,
-        double *r, std::size_t, Args &&...)
+        double *r, std::size_t grainsize, Args &&...)
     {
         this->eval_first(iter, particle);
-        mckl::Vector<std::future<void>> task_group;
-        for (auto range : internal::backend_std_range(particle)) {
-            task_group.push_back(std::async(
-                std::launch::async, [this, iter, dim, &particle, r, range]() {
-                    this->eval_range(iter, dim, range,
-                        r + static_cast<std::size_t>(range.ibegin()) * dim);
-                }));
-        }
-        for (auto &task : task_group) {
-            task.wait();
-        }
+        internal::backend_std_run(particle, schedule_, grainsize,
+            [this, iter, dim, r](const ParticleRange<T> &range) {
+                this->eval_range(iter, dim, range,
+                    r + static_cast<std::size_t>(range.ibegin()) * dim);
+            });
         this->eval_last(iter, particle);
     }
+
+  private:
+    internal::BackendSchedule schedule_;
 }; // class SMCEstimatorEvalSMP
 
 /// \brief SMCSampler<T>::eval_type subtype using the standard library
@@ -33,8 +33,11 @@
 #define MCKL_SMP_BACKEND_TBB_HPP
 
 #include <mckl/smp/backend_base.hpp>
+#include <memory>
+#include <mutex>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
 
 namespace mckl {
 
@@ -48,6 +51,63 @@ inline ::tbb::blocked_range<IntType> backend_tbb_range(
                             ::tbb::blocked_range<IntType>(0, N, grainsize);
 }
 
+// Affinity partitioners shared by all steps that evaluate the same particle
+// system
+class BackendTBBAffinity
+{
+  public:
+    BackendTBBAffinity(const BackendTBBAffinity &) = delete;
+    BackendTBBAffinity &operator=(const BackendTBBAffinity &) = delete;
+
+    static BackendTBBAffinity &instance()
+    {
+        static BackendTBBAffinity affinity;
+
+        return affinity;
+    }
+
+    std::shared_ptr<::tbb::affinity_partitioner> get(const void *key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto iter = map_.find(key);
+        if (iter != map_.end()) {
+            auto ptr = iter->second.lock();
+            if (ptr) {
+                return ptr;
+            }
+        }
+
+        for (auto i = map_.begin(); i != map_.end();) {
+            i = i->second.expired() ? map_.erase(i) : std::next(i);
+        }
+        auto ptr = std::make_shared<::tbb::affinity_partitioner>();
+        map_[key] = ptr;
+
+        return ptr;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::map<const void *, std::weak_ptr<::tbb::affinity_partitioner>> map_;
+
+    BackendTBBAffinity() = default;
+}; // class BackendTBBAffinity
+
+template <>
+class SMPFor<BackendTBB>
+{
+  public:
+    template <typename Func>
+    static void eval(std::size_t N, Func &&f, std::size_t grainsize)
+    {
+        ::tbb::parallel_for(backend_tbb_range(N, grainsize),
+            [&f](const ::tbb::blocked_range<std::size_t> &range) {
+                f(range.begin(), range.end());
+            });
+    }
+}; // class SMPFor
+
 } // namespace internal
 
 /// \brief SMCSampler<T>::eval_type subtype using Intel Threading Building
@@ -70,7 +130,11 @@ class SMCSamplerEvalSMP<T, Derived, BackendTBB>
 
         void operator()(const ::tbb::blocked_range<size_type> &range) const
         {
-            wptr_->eval_range(iter_, pptr_->range(range.begin(), range.end()));
+            const ParticleRange<T> prange =
+                pptr_->range(range.begin(), range.end());
+            internal::backend_advise(prange);
+            const internal::BackendProfileRange<T> profile(prange);
+            wptr_->eval_range(iter_, prange);
         }
 
       private:
@@ -85,6 +149,12 @@ class SMCSamplerEvalSMP<T, Derived, BackendTBB>
         run(iter, particle);
     }
 
+    /// \brief The scheduling of particle ranges
+    SMPSchedule schedule() const { return schedule_; }
+
+    /// \brief Set the scheduling of particle ranges
+    void schedule(SMPSchedule s) { schedule_ = s; }
+
   protected:
     MCKL_DEFINE_SMP_BACKEND_SPECIAL(TBB, SMCSamplerEval)
 
@@ -93,6 +163,15 @@ class SMCSamplerEvalSMP<T, Derived, BackendTBB>
         run(iter, particle, 1);
     }
 
+    void run(std::size_t iter, Particle<T> &particle, std::size_t grainsize)
+    {
+        if (schedule_ == SMPSchedule::Affinity) {
+            run(iter, particle, grainsize, affinity(particle));
+        } else {
+            run<>(iter, particle, grainsize);
+        }
+    }
+
     template <typename... Args>
     void run(std::size_t iter, Particle<T> &particle, std::size_t grainsize,
         Args &&... args)
@@ -103,6 +182,22 @@ class SMCSamplerEvalSMP<T, Derived, BackendTBB>
             work_type(this, iter, &particle), std::forward<Args>(args)...);
         this->eval_last(iter, particle);
     }
+
+  private:
+    SMPSchedule schedule_ = SMPSchedule::Static;
+    std::shared_ptr<::tbb::affinity_partitioner> affinity_;
+    const void *key_ = nullptr;
+
+    ::tbb::affinity_partitioner &affinity(const Particle<T> &particle)
+    {
+        if (!affinity_ || key_ != &particle) {
+            affinity_ =
+                internal::BackendTBBAffinity::instance().get(&particle);
+            key_ = &particle;
+        }
+
+        return *affinity_;
+    }
 }; // class SMCSamplerEvalSMP
 
 /// \brief SMCEstimator<T>::eval_type subtype using Intel Threading Building
@@ -125,8 +220,11 @@ class SMCEstimatorEvalSMP<T, Derived, BackendTBB>
 
         void operator()(const ::tbb::blocked_range<size_type> &range) const
         {
-            wptr_->eval_range(iter_, dim_,
-                pptr_->range(range.begin(), range.end()),
+            const ParticleRange<T> prange =
+                pptr_->range(range.begin(), range.end());
+            internal::backend_advise(prange);
+            const internal::BackendProfileRange<T> profile(prange);
+            wptr_->eval_range(iter_, dim_, prange,
                 r_ + static_cast<std::size_t>(range.begin()) * dim_);
         }
 
@@ -145,6 +243,12 @@ class SMCEstimatorEvalSMP<T, Derived, BackendTBB>
         run(iter, dim, particle, r);
     }
 
+    /// \brief The scheduling of particle ranges
+    SMPSchedule schedule() const { return schedule_; }
+
+    /// \brief Set the scheduling of particle ranges
+    void schedule(SMPSchedule s) { schedule_ = s; }
+
   protected:
     MCKL_DEFINE_SMP_BACKEND_SPECIAL(TBB, SMCEstimatorEval)
 
@@ -154,6 +258,16 @@ class SMCEstimatorEvalSMP<T, Derived, BackendTBB>
         run(iter, dim, particle, r, 1);
     }
 
+    void run(std::size_t iter, std::size_t dim, Particle<T> &particle,
+        double *r, std::size_t grainsize)
+    {
+        if (schedule_ == SMPSchedule::Affinity) {
+            run(iter, dim, particle, r, grainsize, affinity(particle));
+        } else {
+            run<>(iter, dim, particle, r, grainsize);
+        }
+    }
+
     template <typename... Args>
     void run(std::size_t iter, std::size_t dim, Particle<T> &particle,
         double *r, std::size_t grainsize, Args &&... args)
@@ -165,6 +279,22 @@ class SMCEstimatorEvalSMP<T, Derived, BackendTBB>
             std::forward<Args>(args)...);
         this->eval_last(iter, particle);
     }
+
+  private:
+    SMPSchedule schedule_ = SMPSchedule::Static;
+    std::shared_ptr<::tbb::affinity_partitioner> affinity_;
+    const void *key_ = nullptr;
+
+    ::tbb::affinity_partitioner &affinity(const Particle<T> &particle)
+    {
+        if (!affinity_ || key_ != &particle) {
+            affinity_ =
+                internal::BackendTBBAffinity::instance().get(&particle);
+            key_ = &particle;
+        }
+
+        return *affinity_;
+    }
 }; // class SMCEstimatorEvalSMP
 
 /// \brief SMCSampler<T>::eval_type subtype using Intel Threading Building
@@ -33,7 +33,9 @@
 #define MCKL_UTILITY_HPP
 
 #include <mckl/internal/config.h>
+#include <mckl/utility/benchmark.hpp>
 #include <mckl/utility/covariance.hpp>
+#include <mckl/utility/perf_event.hpp>
 #include <mckl/utility/stop_watch.hpp>
 
 #if MCKL_HAS_HDF5
@@ -0,0 +1,548 @@
+//============================================================================
+// MCKL/include/mckl/utility/benchmark.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_UTILITY_BENCHMARK_HPP
+#define MCKL_UTILITY_BENCHMARK_HPP
+
+#include <mckl/internal/common.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+namespace mckl {
+
+/// \brief Summary statistics of repeated measurements
+/// \ingroup Benchmark
+class BenchmarkStat
+{
+  public:
+    BenchmarkStat() : min_(0), median_(0), mean_(0), sd_(0) {}
+
+    BenchmarkStat(double min, double median, double mean, double sd)
+        : min_(min), median_(median), mean_(mean), sd_(sd)
+    {
+    }
+
+    /// \brief Compute the statistics of a sample
+    template <typename InputIter>
+    BenchmarkStat(InputIter first, InputIter last)
+        : min_(0), median_(0), mean_(0), sd_(0)
+    {
+        Vector<double> x(first, last);
+        const std::size_t n = x.size();
+        if (n == 0) {
+            return;
+        }
+
+        std::sort(x.begin(), x.end());
+        min_ = x.front();
+        median_ = n % 2 == 0 ? 0.5 * (x[n / 2 - 1] + x[n / 2]) : x[n / 2];
+        mean_ = std::accumulate(x.begin(), x.end(), 0.0) / n;
+        if (n > 1) {
+            double ss = 0;
+            for (std::size_t i = 0; i != n; ++i) {
+                ss += (x[i] - mean_) * (x[i] - mean_);
+            }
+            sd_ = std::sqrt(ss / (n - 1));
+        }
+    }
+
+    double min() const { return min_; }
+
+    double median() const { return median_; }
+
+    double mean() const { return mean_; }
+
+    double sd() const { return sd_; }
+
+  private:
+    double min_;
+    double median_;
+    double mean_;
+    double sd_;
+}; // class BenchmarkStat
+
+/// \brief Result of a benchmark case
+/// \ingroup Benchmark
+class BenchmarkResult
+{
+  public:
+    BenchmarkResult() : elements_(0), bytes_(0), repeat_(0) {}
+
+    BenchmarkResult(const std::string &name, std::size_t elements,
+        std::size_t bytes, std::size_t repeat, const BenchmarkStat &ns,
+        const BenchmarkStat &cycles)
+        : name_(name)
+        , elements_(elements)
+        , bytes_(bytes)
+        , repeat_(repeat)
+        , ns_(ns)
+        , cycles_(cycles)
+    {
+    }
+
+    /// \brief The name of the case
+    const std::string &name() const { return name_; }
+
+    /// \brief The number of elements processed by each operation
+    std::size_t elements() const { return elements_; }
+
+    /// \brief The number of bytes produced or consumed by each operation
+    std::size_t bytes() const { return bytes_; }
+
+    /// \brief The number of measured operations
+    std::size_t repeat() const { return repeat_; }
+
+    /// \brief Statistics of the nanoseconds of each operation
+    const BenchmarkStat &ns() const { return ns_; }
+
+    /// \brief Statistics of the cycles of each operation
+    ///
+    /// \details
+    /// All zero if cycles are neither counted by StopWatch nor estimated from
+    /// a nominal frequency
+    const BenchmarkStat &cycles() const { return cycles_; }
+
+    /// \brief If cycles are available
+    bool has_cycles() const { return cycles_.median() > 0; }
+
+    /// \brief Median nanoseconds per operation
+    double ns_per_op() const { return ns_.median(); }
+
+    /// \brief Median nanoseconds per element
+    double ns_per_element() const
+    {
+        return elements_ == 0 ? 0 : ns_.median() / elements_;
+    }
+
+    /// \brief Median cycles per element
+    double cpe() const
+    {
+        return elements_ == 0 ? 0 : cycles_.median() / elements_;
+    }
+
+    /// \brief Median cycles per byte
+    double cpb() const
+    {
+        return bytes_ == 0 ? 0 : cycles_.median() / bytes_;
+    }
+
+  private:
+    std::string name_;
+    std::size_t elements_;
+    std::size_t bytes_;
+    std::size_t repeat_;
+    BenchmarkStat ns_;
+    BenchmarkStat cycles_;
+}; // class BenchmarkResult
+
+/// \brief Print benchmark results as a table
+/// \ingroup Benchmark
+template <typename CharT, typename Traits>
+inline std::basic_ostream<CharT, Traits> &benchmark_print(
+    std::basic_ostream<CharT, Traits> &os,
+    const Vector<BenchmarkResult> &result)
+{
+    if (!os) {
+        return os;
+    }
+
+    const int nwid = 40;
+    const int twid = 12;
+    const std::size_t lwid = nwid + twid * 5;
+
+    os << std::string(lwid, '=') << std::endl;
+    os << std::left << std::setw(nwid) << "Benchmark";
+    os << std::right << std::setw(twid) << "ns/op";
+    os << std::right << std::setw(twid) << "sd/op";
+    os << std::right << std::setw(twid) << "ns/elem";
+    os << std::right << std::setw(twid) << "cpE";
+    os << std::right << std::setw(twid) << "cpB";
+    os << std::endl;
+    os << std::string(lwid, '-') << std::endl;
+    for (const auto &r : result) {
+        os << std::left << std::setw(nwid) << r.name();
+        os << std::fixed << std::setprecision(2);
+        os << std::right << std::setw(twid) << r.ns_per_op();
+        os << std::right << std::setw(twid) << r.ns().sd();
+        os << std::right << std::setw(twid) << r.ns_per_element();
+        if (r.has_cycles()) {
+            os << std::right << std::setw(twid) << r.cpe();
+            os << std::right << std::setw(twid) << r.cpb();
+        } else {
+            os << std::right << std::setw(twid) << '-';
+            os << std::right << std::setw(twid) << '-';
+        }
+        os << std::endl;
+    }
+    os << std::string(lwid, '-') << std::endl;
+
+    return os;
+}
+
+/// \brief Write benchmark results in JSON
+/// \ingroup Benchmark
+template <typename CharT, typename Traits>
+inline std::basic_ostream<CharT, Traits> &benchmark_write_json(
+    std::basic_ostream<CharT, Traits> &os,
+    const Vector<BenchmarkResult> &result)
+{
+    if (!os) {
+        return os;
+    }
+
+    auto stat = [&os](const BenchmarkStat &s) {
+        os << "{\"min\": " << s.min() << ", \"median\": " << s.median()
+           << ", \"mean\": " << s.mean() << ", \"sd\": " << s.sd() << '}';
+    };
+
+    os << std::setprecision(10);
+    os << "{\n  \"results\": [";
+    for (std::size_t i = 0; i != result.size(); ++i) {
+        const BenchmarkResult &r = result[i];
+        os << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"";
+        for (char c : r.name()) {
+            if (c == '"' || c == '\\') {
+                os << '\\';
+            }
+            os << c;
+        }
+        os << "\", \"elements\": " << r.elements();
+        os << ", \"bytes\": " << r.bytes();
+        os << ", \"repeat\": " << r.repeat();
+        os << ",\n     \"ns\": ";
+        stat(r.ns());
+        os << ",\n     \"cycles\": ";
+        stat(r.cycles());
+        os << ",\n     \"ns_per_element\": " << r.ns_per_element();
+        os << ", \"cpe\": " << r.cpe();
+        os << ", \"cpb\": " << r.cpb() << '}';
+    }
+    os << "\n  ]\n}" << std::endl;
+
+    return os;
+}
+
+/// \brief Read benchmark results written by `benchmark_write_json`
+/// \ingroup Benchmark
+///
+/// \details
+/// Only the subset of JSON written by `benchmark_write_json` is understood.
+/// Derived quantities such as `cpe` are recomputed from the statistics.
+template <typename CharT, typename Traits>
+inline Vector<BenchmarkResult> benchmark_read_json(
+    std::basic_istream<CharT, Traits> &is)
+{
+    std::string json((std::istreambuf_iterator<CharT, Traits>(is)),
+        std::istreambuf_iterator<CharT, Traits>());
+
+    Vector<BenchmarkResult> result;
+    std::array<std::string, 4> key;
+    std::array<std::array<double, 4>, 2> stat = {{{{0}}, {{0}}}};
+    std::string name;
+    std::size_t elements = 0;
+    std::size_t bytes = 0;
+    std::size_t repeat = 0;
+    std::size_t depth = 0;
+    std::size_t i = 0;
+    const std::size_t n = json.size();
+    while (i < n) {
+        const char c = json[i];
+        if (c == '{') {
+            ++depth;
+            if (depth == 2) {
+                name.clear();
+                elements = bytes = repeat = 0;
+                stat = {{{{0}}, {{0}}}};
+            }
+            ++i;
+        } else if (c == '}') {
+            if (depth == 2) {
+                result.emplace_back(name, elements, bytes, repeat,
+                    BenchmarkStat(
+                        stat[0][0], stat[0][1], stat[0][2], stat[0][3]),
+                    BenchmarkStat(
+                        stat[1][0], stat[1][1], stat[1][2], stat[1][3]));
+            }
+            depth = depth == 0 ? 0 : depth - 1;
+            ++i;
+        } else if (c == '"') {
+            std::string str;
+            ++i;
+            while (i < n && json[i] != '"') {
+                if (json[i] == '\\' && i + 1 < n) {
+                    ++i;
+                }
+                str.push_back(json[i++]);
+            }
+            ++i;
+            const std::size_t j = json.find_first_not_of(" \t\r\n", i);
+            if (j < n && json[j] == ':') {
+                if (depth < key.size()) {
+                    key[depth] = str;
+                }
+                i = j + 1;
+            } else if (depth == 2 && key[2] == "name") {
+                name = str;
+            }
+        } else if (c == '-' || (c >= '0' && c <= '9')) {
+            char *end = nullptr;
+            const double v = std::strtod(json.c_str() + i, &end);
+            i = static_cast<std::size_t>(end - json.c_str());
+            const std::size_t u = static_cast<std::size_t>(std::max(v, 0.0));
+            if (depth == 2) {
+                if (key[2] == "elements") {
+                    elements = u;
+                } else if (key[2] == "bytes") {
+                    bytes = u;
+                } else if (key[2] == "repeat") {
+                    repeat = u;
+                }
+            } else if (depth == 3) {
+                const std::size_t s = key[2] == "ns" ? 0 : 1;
+                if (key[2] == "ns" || key[2] == "cycles") {
+                    if (key[3] == "min") {
+                        stat[s][0] = v;
+                    } else if (key[3] == "median") {
+                        stat[s][1] = v;
+                    } else if (key[3] == "mean") {
+                        stat[s][2] = v;
+                    } else if (key[3] == "sd") {
+                        stat[s][3] = v;
+                    }
+                }
+            }
+        } else {
+            ++i;
+        }
+    }
+
+    return result;
+}
+
+/// \brief Read benchmark results from a JSON file
+/// \ingroup Benchmark
+inline Vector<BenchmarkResult> benchmark_read_json(const std::string &filename)
+{
+    std::ifstream is(filename);
+
+    return benchmark_read_json(is);
+}
+
+/// \brief Compare benchmark results against a baseline
+/// \ingroup Benchmark
+///
+/// \details
+/// Cases are matched by name. A case is flagged as regressed if its median
+/// time per operation exceeds that of the baseline by more than a factor of
+/// `1 + threshold`, and its minimum also exceeds the baseline median, such
+/// that differences within the noise of the measurements are not flagged.
+/// Improvements are flagged symmetrically. A table of the comparison is
+/// written to `os`.
+///
+/// \return The number of regressed cases
+template <typename CharT, typename Traits>
+inline std::size_t benchmark_compare(const Vector<BenchmarkResult> &baseline,
+    const Vector<BenchmarkResult> &result, double threshold,
+    std::basic_ostream<CharT, Traits> &os)
+{
+    const int nwid = 40;
+    const int twid = 12;
+    const std::size_t lwid = nwid + twid * 4;
+
+    os << std::string(lwid, '=') << std::endl;
+    os << std::left << std::setw(nwid) << "Benchmark";
+    os << std::right << std::setw(twid) << "Baseline";
+    os << std::right << std::setw(twid) << "Current";
+    os << std::right << std::setw(twid) << "Ratio";
+    os << std::right << std::setw(twid) << "Status";
+    os << std::endl;
+    os << std::string(lwid, '-') << std::endl;
+
+    std::size_t regressed = 0;
+    for (const auto &r : result) {
+        auto b = std::find_if(baseline.begin(), baseline.end(),
+            [&r](const BenchmarkResult &x) { return x.name() == r.name(); });
+        if (b == baseline.end()) {
+            continue;
+        }
+
+        const double ratio = b->ns_per_op() > 0 ?
+            r.ns_per_op() / b->ns_per_op() :
+            const_inf<double>();
+        std::string status;
+        if (ratio > 1 + threshold && r.ns().min() > b->ns_per_op()) {
+            status = "Regressed";
+            ++regressed;
+        } else if (ratio < 1 / (1 + threshold) &&
+            b->ns().min() > r.ns_per_op()) {
+            status = "Improved";
+        }
+        os << std::left << std::setw(nwid) << r.name();
+        os << std::fixed << std::setprecision(2);
+        os << std::right << std::setw(twid) << b->ns_per_op();
+        os << std::right << std::setw(twid) << r.ns_per_op();
+        os << std::right << std::setw(twid) << ratio;
+        os << std::right << std::setw(twid) << status;
+        os << std::endl;
+    }
+    os << std::string(lwid, '-') << std::endl;
+
+    return regressed;
+}
+
+/// \brief Compare benchmark results against a baseline, writing the table
+/// to the standard output
+/// \ingroup Benchmark
+inline std::size_t benchmark_compare(const Vector<BenchmarkResult> &baseline,
+    const Vector<BenchmarkResult> &result, double threshold = 0.05)
+{
+    return benchmark_compare(baseline, result, threshold, std::cout);
+}
+
+/// \brief Micro-benchmark harness
+/// \ingroup Benchmark
+///
+/// \details
+/// Each case is a callable performing one operation, which processes a given
+/// number of elements and bytes. It is called `warmup()` times without being
+/// measured, then `repeat()` times each measured by a StopWatch. The results
+/// can be printed as a table, written to and read from JSON, and compared
+/// against a baseline with `benchmark_compare`.
+class Benchmark
+{
+  public:
+    /// \brief Construct a benchmark harness
+    ///
+    /// \param repeat The number of measured calls of each case
+    /// \param warmup The number of calls of each case before measuring
+    /// \param frequency The nominal CPU frequency in GHz, used to estimate
+    /// cycles from time if StopWatch does not count cycles. If it is zero,
+    /// cycles are only reported when counted.
+    explicit Benchmark(
+        std::size_t repeat = 10, std::size_t warmup = 1, double frequency = 0)
+        : repeat_(std::max<std::size_t>(repeat, 1))
+        , warmup_(warmup)
+        , frequency_(frequency)
+    {
+    }
+
+    std::size_t repeat() const { return repeat_; }
+
+    void repeat(std::size_t n) { repeat_ = std::max<std::size_t>(n, 1); }
+
+    std::size_t warmup() const { return warmup_; }
+
+    void warmup(std::size_t n) { warmup_ = n; }
+
+    double frequency() const { return frequency_; }
+
+    void frequency(double ghz) { frequency_ = ghz; }
+
+    /// \brief Run a case
+    ///
+    /// \param name The name of the case
+    /// \param elements The number of elements processed by each call
+    /// \param bytes The number of bytes produced or consumed by each call
+    /// \param f A callable with signature `void f()`
+    template <typename Func>
+    const BenchmarkResult &run(const std::string &name, std::size_t elements,
+        std::size_t bytes, Func &&f)
+    {
+        for (std::size_t i = 0; i != warmup_; ++i) {
+            f();
+        }
+
+        Vector<double> ns(repeat_);
+        Vector<double> cycles(repeat_);
+        for (std::size_t i = 0; i != repeat_; ++i) {
+            StopWatch watch;
+            watch.start();
+            f();
+            watch.stop();
+            ns[i] = watch.nanoseconds();
+            cycles[i] = StopWatch::has_cycles() ?
+                static_cast<double>(watch.cycles()) :
+                ns[i] * frequency_;
+        }
+        result_.emplace_back(name, elements, bytes, repeat_,
+            BenchmarkStat(ns.begin(), ns.end()),
+            BenchmarkStat(cycles.begin(), cycles.end()));
+
+        return result_.back();
+    }
+
+    /// \brief Results of all cases run so far
+    const Vector<BenchmarkResult> &result() const { return result_; }
+
+    /// \brief Clear all results
+    void clear() { result_.clear(); }
+
+    /// \brief Print the results as a table
+    template <typename CharT, typename Traits>
+    std::basic_ostream<CharT, Traits> &print(
+        std::basic_ostream<CharT, Traits> &os) const
+    {
+        return benchmark_print(os, result_);
+    }
+
+    /// \brief Write the results in JSON
+    template <typename CharT, typename Traits>
+    std::basic_ostream<CharT, Traits> &write_json(
+        std::basic_ostream<CharT, Traits> &os) const
+    {
+        return benchmark_write_json(os, result_);
+    }
+
+    /// \brief Write the results in JSON to a file
+    bool write_json(const std::string &filename) const
+    {
+        std::ofstream os(filename);
+        write_json(os);
+
+        return static_cast<bool>(os);
+    }
+
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os, const Benchmark &benchmark)
+    {
+        return benchmark.print(os);
+    }
+
+  private:
+    std::size_t repeat_;
+    std::size_t warmup_;
+    double frequency_;
+    Vector<BenchmarkResult> result_;
+}; // class Benchmark
+
+} // namespace mckl
+
+#endif // MCKL_UTILITY_BENCHMARK_HPP
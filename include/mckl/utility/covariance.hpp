@@ -34,9 +34,92 @@
 
 #include <mckl/internal/common.hpp>
 #include <mckl/internal/cblas.hpp>
+#include <mckl/smp.hpp>
+#include <mutex>
 
 namespace mckl {
 
+/// \brief Covariance computation methods
+/// \ingroup Covariance
+enum class CovarianceMethod {
+    OnePass, ///< Merge the moments of blocks of samples in one pass
+    TwoPass  ///< Compute the mean first and the co-moment in a second pass
+};           // enum CovarianceMethod
+
+constexpr CovarianceMethod CovarianceOnePass = CovarianceMethod::OnePass;
+constexpr CovarianceMethod CovarianceTwoPass = CovarianceMethod::TwoPass;
+
+namespace internal {
+
+// Pack the full symmetric p by p matrix c into cov
+template <typename RealType>
+inline void covariance_pack(std::size_t p, const RealType *c, RealType *cov,
+    MatrixLayout cov_layout, bool cov_upper, bool cov_packed)
+{
+    if (!cov_packed) {
+        std::memcpy(cov, c, sizeof(RealType) * p * p);
+        return;
+    }
+
+    unsigned l = cov_layout == RowMajor ? 0 : 1;
+    unsigned u = cov_upper ? 1 : 0;
+    unsigned t = (l << 1) + u;
+    switch (t) {
+        case 0: // Row, Lower, Pack
+            for (size_t i = 0; i != p; ++i) {
+                for (std::size_t j = 0; j <= i; ++j) {
+                    *cov++ = c[i * p + j];
+                }
+            }
+            break;
+        case 1: // Row, Upper, Pack
+            for (std::size_t i = 0; i != p; ++i) {
+                for (std::size_t j = i; j != p; ++j) {
+                    *cov++ = c[i * p + j];
+                }
+            }
+            break;
+        case 2: // Col, Lower, Pack
+            for (std::size_t j = 0; j != p; ++j) {
+                for (std::size_t i = j; i != p; ++i) {
+                    *cov++ = c[j * p + i];
+                }
+            }
+            break;
+        case 3: // Col, Upper, Pack
+            for (std::size_t j = 0; j != p; ++j) {
+                for (std::size_t i = 0; i <= j; ++i) {
+                    *cov++ = c[j * p + i];
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+inline void covariance_syrk(MatrixLayout layout, std::size_t p,
+    std::size_t n, const float *a, float *c)
+{
+    cblas_ssyrk(layout == RowMajor ? CblasRowMajor : CblasColMajor,
+        CblasLower, CblasTrans, static_cast<MCKL_BLAS_INT>(p),
+        static_cast<MCKL_BLAS_INT>(n), 1, a,
+        static_cast<MCKL_BLAS_INT>(layout == RowMajor ? p : n), 1, c,
+        static_cast<MCKL_BLAS_INT>(p));
+}
+
+inline void covariance_syrk(MatrixLayout layout, std::size_t p,
+    std::size_t n, const double *a, double *c)
+{
+    cblas_dsyrk(layout == RowMajor ? CblasRowMajor : CblasColMajor,
+        CblasLower, CblasTrans, static_cast<MCKL_BLAS_INT>(p),
+        static_cast<MCKL_BLAS_INT>(n), 1, a,
+        static_cast<MCKL_BLAS_INT>(layout == RowMajor ? p : n), 1, c,
+        static_cast<MCKL_BLAS_INT>(p));
+}
+
+} // namespace internal
+
 /// \brief Covariance
 /// \ingroup Covariance
 template <typename RealType = double>
@@ -238,48 +321,712 @@ class Covariance
             }
         }
 
-        if (!cov_packed) {
-            std::memcpy(cov, cov_.data(), sizeof(result_type) * cov_.size());
+        internal::covariance_pack(
+            p, cov_.data(), cov, cov_layout, cov_upper, cov_packed);
+    }
+}; // class Covariance
+
+/// \brief Parallel covariance
+/// \ingroup Covariance
+///
+/// \details
+/// The samples are partitioned into ranges by smp_for using the SMP backend
+/// `Backend`. Within each range, samples are processed in blocks that fit in
+/// the cache. For each range a triple of the sum of weights, the mean and the
+/// co-moment matrix is computed, and the triples are merged with the
+/// formulae of Chan et al. in the order of the ranges.
+///
+/// With CovarianceOnePass, the data is read once. The triple of each block
+/// is computed from the block mean and merged into that of the range. With
+/// CovarianceTwoPass, the mean is computed in a first pass, and the co-moment
+/// of samples centered at the mean is computed in a second pass. Both are
+/// numerically stable, the first is faster when the data does not fit in
+/// the cache.
+template <typename RealType = double, typename Backend = BackendSMP>
+class CovarianceSMP
+{
+    static_assert(internal::is_blas_floating_point<RealType>::value,
+        "**CovarianceSMP** used with RealType other than float or double");
+
+  public:
+    using result_type = RealType;
+
+    explicit CovarianceSMP(CovarianceMethod method = CovarianceOnePass)
+        : method_(method)
+    {
+    }
+
+    /// \brief The computation method
+    CovarianceMethod method() const { return method_; }
+
+    /// \brief Set the computation method
+    void method(CovarianceMethod m) { method_ = m; }
+
+    /// \brief Compute the sample covariance matrix
+    ///
+    /// \details
+    /// The parameters and results are the same as those of
+    /// Covariance::operator()
+    void operator()(MatrixLayout layout, std::size_t n, std::size_t p,
+        const result_type *x, const result_type *w, result_type *mean,
+        result_type *cov, MatrixLayout cov_layout = RowMajor,
+        bool cov_upper = false, bool cov_packed = false)
+    {
+        if (n * p == 0) {
+            return;
+        }
+
+        if (x == nullptr) {
+            return;
+        }
+
+        if (mean == nullptr && cov == nullptr) {
             return;
         }
 
-        unsigned l = cov_layout == RowMajor ? 0 : 1;
-        unsigned u = cov_upper ? 1 : 0;
-        unsigned c = (l << 1) + u;
-        switch (c) {
-            case 0: // Row, Lower, Pack
-                for (size_t i = 0; i != p; ++i) {
-                    for (std::size_t j = 0; j <= i; ++j) {
-                        *cov++ = cov_[i * p + j];
+        internal::size_check<MCKL_BLAS_INT>(p, "CovarianceSMP::operator()");
+        internal::size_check<MCKL_BLAS_INT>(n, "CovarianceSMP::operator()");
+
+        const std::size_t b = std::max<std::size_t>(
+            64, internal::BufferSize<result_type>::value / p);
+
+        if (cov == nullptr || method_ == CovarianceTwoPass) {
+            run(n, p, b, false,
+                [&](std::size_t ibegin, std::size_t iend, moment_type &m) {
+                    sum(layout, n, p, x, w, ibegin, iend, m);
+                });
+            moment_ = merge(p, true);
+            div(p, moment_.mean.data(), moment_.sw, moment_.mean.data());
+        }
+
+        if (cov != nullptr && method_ == CovarianceTwoPass) {
+            const result_type *mu = moment_.mean.data();
+            run(n, p, b, true,
+                [&](std::size_t ibegin, std::size_t iend, moment_type &m) {
+                    Vector<result_type> a(b * p);
+                    Vector<result_type> ws(b);
+                    for (std::size_t k = ibegin; k < iend; k += b) {
+                        const std::size_t l = std::min(b, iend - k);
+                        center(layout, n, p, x, w, k, l, mu, a.data(),
+                            ws.data());
+                        internal::covariance_syrk(
+                            layout, p, l, a.data(), m.moment.data());
                     }
+                });
+            moment_.moment = merge(p, false).moment;
+        }
+
+        if (cov != nullptr && method_ == CovarianceOnePass) {
+            run(n, p, b, true,
+                [&](std::size_t ibegin, std::size_t iend, moment_type &m) {
+                    Vector<result_type> a(b * p);
+                    Vector<result_type> ws(b);
+                    moment_type t(p, false);
+                    for (std::size_t k = ibegin; k < iend; k += b) {
+                        const std::size_t l = std::min(b, iend - k);
+                        t.sw = 0;
+                        std::fill(t.mean.begin(), t.mean.end(), 0);
+                        sum(layout, n, p, x, w, k, k + l, t);
+                        if (!(t.sw > 0)) {
+                            continue;
+                        }
+                        div(p, t.mean.data(), t.sw, t.mean.data());
+                        center(layout, n, p, x, w, k, l, t.mean.data(),
+                            a.data(), ws.data());
+                        internal::covariance_syrk(
+                            layout, p, l, a.data(), m.moment.data());
+                        m.merge(p, t);
+                    }
+                    m.sw2 += t.sw2;
+                });
+            moment_ = merge(p, false);
+        }
+
+        if (mean != nullptr) {
+            std::copy_n(moment_.mean.data(), p, mean);
+        }
+
+        if (cov == nullptr) {
+            return;
+        }
+
+        // Symmetrize from the lower triangular in the storage layout
+        result_type *c = moment_.moment.data();
+        for (std::size_t i = 0; i != p; ++i) {
+            for (std::size_t j = 0; j != i; ++j) {
+                if (layout == RowMajor) {
+                    c[j * p + i] = c[i * p + j];
+                } else {
+                    c[i * p + j] = c[j * p + i];
                 }
-                break;
-            case 1: // Row, Upper, Pack
+            }
+        }
+        const result_type d = moment_.sw - moment_.sw2 / moment_.sw;
+        div(p * p, c, d, c);
+        internal::covariance_pack(
+            p, c, cov, cov_layout, cov_upper, cov_packed);
+    }
+
+  private:
+    class moment_type
+    {
+      public:
+        moment_type() : sw(0), sw2(0) {}
+
+        moment_type(std::size_t p, bool with_moment)
+            : sw(0), sw2(0), mean(p, 0), moment(with_moment ? p * p : 0, 0)
+        {
+        }
+
+        // Merge the sum of weights and the mean of another sample, and add
+        // the correction term to the co-moment. The co-moment of the other
+        // sample is not added.
+        void merge(std::size_t p, const moment_type &other)
+        {
+            if (!(other.sw > 0)) {
+                return;
+            }
+
+            const result_type s = sw + other.sw;
+            if (!moment.empty()) {
+                const result_type c = sw * other.sw / s;
                 for (std::size_t i = 0; i != p; ++i) {
-                    for (std::size_t j = i; j != p; ++j) {
-                        *cov++ = cov_[i * p + j];
+                    const result_type di = c * (other.mean[i] - mean[i]);
+                    result_type *mi = moment.data() + i * p;
+                    for (std::size_t j = 0; j != p; ++j) {
+                        mi[j] += di * (other.mean[j] - mean[j]);
                     }
                 }
-                break;
-            case 2: // Col, Lower, Pack
+            }
+            const result_type r = other.sw / s;
+            for (std::size_t i = 0; i != p; ++i) {
+                mean[i] += r * (other.mean[i] - mean[i]);
+            }
+            sw = s;
+        }
+
+        result_type sw;
+        result_type sw2;
+        Vector<result_type> mean;
+        Vector<result_type> moment;
+    }; // class moment_type
+
+    CovarianceMethod method_;
+    moment_type moment_;
+    Vector<std::pair<std::size_t, moment_type>> range_;
+
+    // Compute a triple for each range, ordered by the beginning of ranges
+    template <typename Func>
+    void run(std::size_t n, std::size_t p, std::size_t b, bool with_moment,
+        Func &&f)
+    {
+        std::mutex mtx;
+        range_.clear();
+        smp_for<Backend>(n,
+            [&](std::size_t ibegin, std::size_t iend) {
+                moment_type m(p, with_moment);
+                f(ibegin, iend, m);
+                std::lock_guard<std::mutex> lock(mtx);
+                range_.emplace_back(ibegin, std::move(m));
+            },
+            b);
+        std::sort(range_.begin(), range_.end(),
+            [](const std::pair<std::size_t, moment_type> &r1,
+                const std::pair<std::size_t, moment_type> &r2) {
+                return r1.first < r2.first;
+            });
+    }
+
+    // Merge the triples of all ranges. If `sums` is true, the means are sums
+    // computed by `sum()` and they are added, such as the first pass of
+    // CovarianceTwoPass or when only the mean is requested. Otherwise the
+    // triples are merged with the formulae of Chan et al. In the second pass
+    // of CovarianceTwoPass, the sums of weights are zero and only the
+    // co-moments, centered at the same mean, are added.
+    moment_type merge(std::size_t p, bool sums)
+    {
+        moment_type m(std::move(range_.front().second));
+        for (std::size_t k = 1; k < range_.size(); ++k) {
+            moment_type &r = range_[k].second;
+            if (!r.moment.empty()) {
+                add(r.moment.size(), m.moment.data(), r.moment.data(),
+                    m.moment.data());
+            }
+            if (sums) {
+                add(p, m.mean.data(), r.mean.data(), m.mean.data());
+                m.sw += r.sw;
+            } else {
+                m.merge(p, r);
+            }
+            m.sw2 += r.sw2;
+        }
+        range_.clear();
+
+        return m;
+    }
+
+    // Weighted sums of samples in [ibegin, iend)
+    static void sum(MatrixLayout layout, std::size_t n, std::size_t p,
+        const result_type *x, const result_type *w, std::size_t ibegin,
+        std::size_t iend, moment_type &m)
+    {
+        result_type *s = m.mean.data();
+        for (std::size_t i = ibegin; i != iend; ++i) {
+            const result_type wi = w == nullptr ? 1 : w[i];
+            m.sw += wi;
+            m.sw2 += wi * wi;
+        }
+        if (layout == RowMajor) {
+            for (std::size_t i = ibegin; i != iend; ++i) {
+                const result_type wi = w == nullptr ? 1 : w[i];
+                const result_type *xi = x + i * p;
                 for (std::size_t j = 0; j != p; ++j) {
-                    for (std::size_t i = j; i != p; ++i) {
-                        *cov++ = cov_[j * p + i];
-                    }
+                    s[j] += wi * xi[j];
                 }
-                break;
-            case 3: // Col, Upper, Pack
-                for (std::size_t j = 0; j != p; ++j) {
-                    for (std::size_t i = 0; i <= j; ++i) {
-                        *cov++ = cov_[j * p + i];
+            }
+        } else {
+            for (std::size_t j = 0; j != p; ++j) {
+                const result_type *xj = x + j * n;
+                result_type t = 0;
+                if (w == nullptr) {
+                    for (std::size_t i = ibegin; i != iend; ++i) {
+                        t += xj[i];
+                    }
+                } else {
+                    for (std::size_t i = ibegin; i != iend; ++i) {
+                        t += w[i] * xj[i];
                     }
                 }
-                break;
-            default:
-                break;
+                s[j] += t;
+            }
         }
     }
-}; // class Covariance
+
+    // The l by p matrix of samples in [k, k + l), centered at mu and scaled
+    // by the square roots of weights, stored in the same layout as x
+    static void center(MatrixLayout layout, std::size_t n, std::size_t p,
+        const result_type *x, const result_type *w, std::size_t k,
+        std::size_t l, const result_type *mu, result_type *a, result_type *ws)
+    {
+        if (w != nullptr) {
+            sqrt(l, w + k, ws);
+        }
+        if (layout == RowMajor) {
+            for (std::size_t i = 0; i != l; ++i) {
+                const result_type *xi = x + (k + i) * p;
+                result_type *ai = a + i * p;
+                sub(p, xi, mu, ai);
+                if (w != nullptr) {
+                    mul(p, ai, ws[i], ai);
+                }
+            }
+        } else {
+            for (std::size_t j = 0; j != p; ++j) {
+                const result_type *xj = x + j * n + k;
+                result_type *aj = a + j * l;
+                sub(l, xj, mu[j], aj);
+                if (w != nullptr) {
+                    mul(l, aj, ws, aj);
+                }
+            }
+        }
+    }
+}; // class CovarianceSMP
+
+/// \brief Rank-one update of a Cholesky factor
+/// \ingroup Covariance
+///
+/// \param layout The storage layout of `l`
+/// \param p The dimension of the factor
+/// \param l On input the full `p` by `p` lower triangular matrix \f$L\f$. On
+/// output the lower triangular matrix \f$\tilde{L}\f$ such that
+/// \f$\tilde{L}\tilde{L}^T = LL^T + xx^T\f$. The strict upper triangular is
+/// not referenced.
+/// \param x The update vector of length `p`. It is overwritten on output.
+///
+/// \details
+/// The factor is updated by a sequence of Givens rotations in
+/// \f$O(p^2)\f$ operations. The diagonal of \f$L\f$ may contain zeros.
+template <typename RealType>
+inline void cholesky_update(
+    MatrixLayout layout, std::size_t p, RealType *l, RealType *x)
+{
+    const std::size_t si = layout == RowMajor ? p : 1;
+    const std::size_t sk = layout == RowMajor ? 1 : p;
+    for (std::size_t k = 0; k != p; ++k) {
+        RealType *lk = l + k * sk;
+        const RealType r = std::hypot(lk[k * si], x[k]);
+        if (!(r > 0)) {
+            continue;
+        }
+        const RealType c = lk[k * si] / r;
+        const RealType s = x[k] / r;
+        lk[k * si] = r;
+        x[k] = 0;
+        for (std::size_t i = k + 1; i < p; ++i) {
+            const RealType t = lk[i * si];
+            lk[i * si] = c * t + s * x[i];
+            x[i] = c * x[i] - s * t;
+        }
+    }
+}
+
+/// \brief Rank-one downdate of a Cholesky factor
+/// \ingroup Covariance
+///
+/// \param layout The storage layout of `l`
+/// \param p The dimension of the factor
+/// \param l On input the full `p` by `p` lower triangular matrix \f$L\f$. On
+/// output the lower triangular matrix \f$\tilde{L}\f$ such that
+/// \f$\tilde{L}\tilde{L}^T = LL^T - xx^T\f$. The strict upper triangular is
+/// not referenced.
+/// \param x The downdate vector of length `p`. It is overwritten on output.
+///
+/// \return `false` if \f$LL^T - xx^T\f$ is not positive definite, in which
+/// case `l` is left unchanged
+///
+/// \details
+/// The downdate follows the LINPACK routine `dchdd`. Feasibility is checked
+/// by a forward substitution before the factor is modified by a sequence of
+/// Givens rotations. Both steps take \f$O(p^2)\f$ operations.
+template <typename RealType>
+inline bool cholesky_downdate(
+    MatrixLayout layout, std::size_t p, RealType *l, RealType *x)
+{
+    const std::size_t si = layout == RowMajor ? p : 1;
+    const std::size_t sk = layout == RowMajor ? 1 : p;
+
+    // Solve L a = x, a is stored in x
+    RealType a2 = 0;
+    for (std::size_t i = 0; i != p; ++i) {
+        const RealType *li = l + i * si;
+        if (!(li[i * sk] > 0)) {
+            return false;
+        }
+        RealType t = x[i];
+        for (std::size_t k = 0; k != i; ++k) {
+            t -= li[k * sk] * x[k];
+        }
+        x[i] = t / li[i * sk];
+        a2 += x[i] * x[i];
+    }
+    if (!(a2 < 1)) {
+        return false;
+    }
+
+    // Compute the rotations, the sines are stored in x
+    Vector<RealType> c(p);
+    RealType alpha = std::sqrt(1 - a2);
+    for (std::size_t i = p; i-- > 0;) {
+        const RealType scale = alpha + std::abs(x[i]);
+        const RealType a = alpha / scale;
+        const RealType b = x[i] / scale;
+        const RealType r = std::sqrt(a * a + b * b);
+        c[i] = a / r;
+        x[i] = b / r;
+        alpha = scale * r;
+    }
+
+    // Apply the rotations to each row of L
+    for (std::size_t j = 0; j != p; ++j) {
+        RealType *lj = l + j * si;
+        RealType t = 0;
+        for (std::size_t i = j + 1; i-- > 0;) {
+            const RealType u = c[i] * t + x[i] * lj[i * sk];
+            lj[i * sk] = c[i] * lj[i * sk] - x[i] * t;
+            t = u;
+        }
+    }
+
+    return true;
+}
+
+/// \brief Online weighted covariance
+/// \ingroup Covariance
+///
+/// \details
+/// Samples are accumulated one at a time with the weighted Welford update.
+/// Besides the sum of weights and the mean, the object keeps the co-moment
+/// matrix \f$M = \sum_i w_i(x_i - \bar{x})(x_i - \bar{x})^T\f$ together
+/// with its Cholesky factor. Adding or removing a sample costs \f$O(p^2)\f$
+/// operations. Two accumulators, for example those of different threads, can
+/// be merged with the formulae of Chan et al.
+template <typename RealType = double>
+class OnlineCovariance
+{
+    static_assert(std::is_floating_point<RealType>::value,
+        "**OnlineCovariance** used with RealType other than floating point "
+        "types");
+
+  public:
+    using result_type = RealType;
+
+    explicit OnlineCovariance(std::size_t p = 0) { reset(p); }
+
+    /// \brief Clear all samples and set a new dimension
+    void reset(std::size_t p)
+    {
+        p_ = p;
+        n_ = 0;
+        sw_ = 0;
+        sw2_ = 0;
+        mean_.resize(p);
+        moment_.resize(p * p);
+        chol_.resize(p * p);
+        x_.resize(p);
+        clear();
+    }
+
+    /// \brief Clear all samples
+    void clear()
+    {
+        n_ = 0;
+        sw_ = 0;
+        sw2_ = 0;
+        std::fill(mean_.begin(), mean_.end(), 0);
+        std::fill(moment_.begin(), moment_.end(), 0);
+        std::fill(chol_.begin(), chol_.end(), 0);
+    }
+
+    /// \brief The dimension of the random variable
+    std::size_t dim() const { return p_; }
+
+    /// \brief The number of samples accumulated
+    std::size_t size() const { return n_; }
+
+    /// \brief The sum of weights
+    result_type sum_weight() const { return sw_; }
+
+    /// \brief The sum of squared weights
+    result_type sum_weight2() const { return sw2_; }
+
+    /// \brief The mean vector
+    const result_type *mean() const { return mean_.data(); }
+
+    /// \brief The co-moment matrix, row major, only the lower triangular is
+    /// referenced
+    const result_type *moment() const { return moment_.data(); }
+
+    /// \brief The divisor that scales the co-moment matrix into the unbiased
+    /// covariance matrix, \f$\sum w_i - \sum w_i^2 / \sum w_i\f$
+    result_type divisor() const { return sw_ > 0 ? sw_ - sw2_ / sw_ : 0; }
+
+    /// \brief Add a sample `x` with weight `w`
+    void add(const result_type *x, result_type w = 1)
+    {
+        runtime_assert(
+            w >= 0, "**OnlineCovariance::add** negative weight");
+
+        if (!(w > 0)) {
+            return;
+        }
+
+        const result_type sw = sw_ + w;
+        const result_type c = w * sw_ / sw;
+        for (std::size_t i = 0; i != p_; ++i) {
+            x_[i] = x[i] - mean_[i];
+            mean_[i] += w / sw * x_[i];
+        }
+        update(c);
+        ++n_;
+        sw_ = sw;
+        sw2_ += w * w;
+    }
+
+    /// \brief Remove a sample `x` with weight `w`, previously added
+    ///
+    /// \return `false` if the co-moment matrix after removal is not positive
+    /// definite, in which case the object is left unchanged
+    bool remove(const result_type *x, result_type w = 1)
+    {
+        runtime_assert(
+            w >= 0, "**OnlineCovariance::remove** negative weight");
+
+        if (!(w > 0)) {
+            return true;
+        }
+
+        if (n_ <= 1 || !(sw_ > w)) {
+            clear();
+            return true;
+        }
+
+        const result_type sw = sw_ - w;
+        const result_type c = w * sw / sw_;
+        remove_diff(x, w, sw);
+        mul(p_, x_.data(), std::sqrt(c), x_.data());
+        if (!cholesky_downdate(ColMajor, p_, chol_.data(), x_.data())) {
+            return false;
+        }
+        remove_diff(x, w, sw);
+        for (std::size_t i = 0; i != p_; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                moment_[i * p_ + j] -= c * x_[i] * x_[j];
+            }
+        }
+        for (std::size_t i = 0; i != p_; ++i) {
+            mean_[i] = (sw_ * mean_[i] - w * x[i]) / sw;
+        }
+        --n_;
+        sw_ = sw;
+        sw2_ -= w * w;
+
+        return true;
+    }
+
+    /// \brief Merge the samples accumulated by another object
+    ///
+    /// \details
+    /// The moments are merged in \f$O(p^2)\f$ operations. The Cholesky
+    /// factor is merged by \f$p + 1\f$ rank-one updates.
+    void merge(const OnlineCovariance<RealType> &other)
+    {
+        runtime_assert(other.p_ == p_,
+            "**OnlineCovariance::merge** objects with different dimensions");
+
+        if (!(other.sw_ > 0)) {
+            return;
+        }
+
+        if (!(sw_ > 0)) {
+            *this = other;
+            return;
+        }
+
+        const result_type sw = sw_ + other.sw_;
+        const result_type c = sw_ * other.sw_ / sw;
+        for (std::size_t i = 0; i != p_; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                moment_[i * p_ + j] += other.moment_[i * p_ + j];
+            }
+        }
+        for (std::size_t k = 0; k != p_; ++k) {
+            std::copy_n(other.chol_.data() + k * p_, p_, x_.data());
+            cholesky_update(ColMajor, p_, chol_.data(), x_.data());
+        }
+        for (std::size_t i = 0; i != p_; ++i) {
+            x_[i] = other.mean_[i] - mean_[i];
+            mean_[i] += other.sw_ / sw * x_[i];
+        }
+        update(c);
+        n_ += other.n_;
+        sw_ = sw;
+        sw2_ += other.sw2_;
+    }
+
+    /// \brief Compute the mean and covariance matrix of samples accumulated
+    /// so far
+    ///
+    /// \param mean Output storage of the mean. If it is a null pointer, then
+    /// it is ignored.
+    /// \param cov Output storage of the covarianc matrix. If it is a null
+    /// pointer, then it is ignored.
+    /// \param cov_layout The storage layout of the covariance matrix.
+    /// \param cov_upper If true, then the upper triangular of the covariance
+    /// matrix is packed, otherwise the lower triangular is packed. Ignored if
+    /// `cov_pack` is `false`.
+    /// \param cov_packed If true, then the covariance matrix is packed.
+    ///
+    /// \details
+    /// The covariance matrix is the co-moment matrix scaled by the same
+    /// divisor used by Covariance. It is zero if `divisor()` is not positive.
+    void operator()(result_type *mean, result_type *cov,
+        MatrixLayout cov_layout = RowMajor, bool cov_upper = false,
+        bool cov_packed = false) const
+    {
+        if (mean != nullptr) {
+            std::copy(mean_.begin(), mean_.end(), mean);
+        }
+        if (cov == nullptr) {
+            return;
+        }
+
+        const result_type d = divisor();
+        const result_type s = d > 0 ? 1 / d : 0;
+        Vector<result_type> c(p_ * p_);
+        for (std::size_t i = 0; i != p_; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                c[i * p_ + j] = c[j * p_ + i] = s * moment_[i * p_ + j];
+            }
+        }
+        internal::covariance_pack(
+            p_, c.data(), cov, cov_layout, cov_upper, cov_packed);
+    }
+
+    /// \brief Compute the Cholesky factor of the covariance matrix
+    ///
+    /// \param chol Output storage of the lower triangular Cholesky factor,
+    /// packed in row major order, as expected by
+    /// NormalMVDistribution::param_type
+    /// \param scale The covariance matrix is multiplied by this value before
+    /// the factor is computed
+    ///
+    /// \details
+    /// The factor is copied from the one maintained incrementally, and no
+    /// factorization is performed. The cost is \f$O(p^2)\f$.
+    void chol(result_type *chol, result_type scale = 1) const
+    {
+        const result_type d = divisor();
+        const result_type s = d > 0 ? std::sqrt(scale / d) : 0;
+        for (std::size_t i = 0; i != p_; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                *chol++ = s * chol_[j * p_ + i];
+            }
+        }
+    }
+
+    /// \brief Multiply a vector by the Cholesky factor of the covariance
+    /// matrix
+    ///
+    /// \param z Input vector of length `dim()`
+    /// \param r Output vector of length `dim()`, shall not overlap with `z`
+    /// \param scale The covariance matrix is multiplied by this value before
+    /// the factor is computed
+    void mulchol(
+        const result_type *z, result_type *r, result_type scale = 1) const
+    {
+        const result_type d = divisor();
+        const result_type s = d > 0 ? std::sqrt(scale / d) : 0;
+        std::fill_n(r, p_, 0);
+        for (std::size_t j = 0; j != p_; ++j) {
+            const result_type *l = chol_.data() + j * p_;
+            const result_type t = s * z[j];
+            for (std::size_t i = j; i < p_; ++i) {
+                r[i] += l[i] * t;
+            }
+        }
+    }
+
+  private:
+    std::size_t p_;
+    std::size_t n_;
+    result_type sw_;
+    result_type sw2_;
+    Vector<result_type> mean_;
+    Vector<result_type> moment_;
+    Vector<result_type> chol_;
+    Vector<result_type> x_;
+
+    // x_ = x - mean after removal of x with weight w
+    void remove_diff(const result_type *x, result_type w, result_type sw)
+    {
+        for (std::size_t i = 0; i != p_; ++i) {
+            x_[i] = x[i] - (sw_ * mean_[i] - w * x[i]) / sw;
+        }
+    }
+
+    // moment += c * x_ * x_^T
+    void update(result_type c)
+    {
+        for (std::size_t i = 0; i != p_; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                moment_[i * p_ + j] += c * x_[i] * x_[j];
+            }
+        }
+        mul(p_, x_.data(), std::sqrt(c), x_.data());
+        cholesky_update(ColMajor, p_, chol_.data(), x_.data());
+    }
+}; // class OnlineCovariance
 
 } // namespace mckl
 
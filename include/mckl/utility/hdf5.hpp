@@ -34,6 +34,10 @@
 
 #include <mckl/internal/common.hpp>
 #include <mckl/core/matrix.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <hdf5.h>
 
 extern "C" inline ::herr_t mckl_hdf5_add_link(
@@ -968,6 +972,358 @@ inline bool hdf5load(Location &&location, const std::string &name,
     return data.read(type, mat->data());
 }
 
+/// \brief Asynchronous writer of HDF5 data sets
+/// \ingroup HDF5
+///
+/// \details
+/// Data are appended as rows of two dimensional data sets. Each data set is
+/// chunked along rows and optionally compressed. Appended rows are first
+/// copied into a buffer. When the size of the buffer exceeds a threshold, it
+/// is handed to a background thread, which writes all pending rows of each
+/// data set with a single extension of the data set. Writing to the file
+/// overlaps with the appending of new rows into a second buffer. All calls
+/// into the HDF5 library happen in the background thread, except those of the
+/// constructor, `flush()` and `close()`, during which the background thread
+/// is idle.
+class HDF5Writer
+{
+  public:
+    /// \brief Open or create an HDF5 file for writing
+    ///
+    /// \param filename The name of the file to open/create
+    /// \param append If true then an existing file is open, otherwise a new
+    /// one is created
+    /// \param chunk_size The number of rows of each chunk of data sets
+    /// \param compression The level of deflate compression, zero for no
+    /// compression
+    /// \param buffer_size The size in bytes of the buffer that triggers
+    /// writing
+    explicit HDF5Writer(const std::string &filename, bool append = false,
+        std::size_t chunk_size = 1024, unsigned compression = 0,
+        std::size_t buffer_size = 1 << 20)
+        : file_(filename, append)
+        , chunk_size_(std::max<std::size_t>(chunk_size, 1))
+        , compression_(std::min(compression, 9U))
+        , buffer_size_(buffer_size)
+        , bytes_(0)
+        , busy_(false)
+        , stop_(false)
+        , error_(!file_)
+    {
+        if (file_) {
+            thread_ = std::thread([this]() { run(); });
+        }
+    }
+
+    HDF5Writer(const HDF5Writer &) = delete;
+    HDF5Writer &operator=(const HDF5Writer &) = delete;
+
+    ~HDF5Writer() { close(); }
+
+    /// \brief If no error has occurred so far
+    bool good() const { return !error_; }
+
+    /// \brief Append rows to a data set
+    ///
+    /// \param name The name of the data set, intermediate groups are created
+    /// if necessary
+    /// \param nrow The number of rows to append
+    /// \param ncol The number of columns of the data set
+    /// \param first The beginning of the row major data
+    template <typename T>
+    void append(const std::string &name, std::size_t nrow, std::size_t ncol,
+        const T *first)
+    {
+        T *dst = insert<T>(name, nrow, ncol);
+        std::copy_n(first, nrow * ncol, dst);
+        commit(nrow * ncol * sizeof(T));
+    }
+
+    /// \brief Append a value as a row with a single column
+    template <typename T>
+    void append(const std::string &name, const T &value,
+        decltype(hdf5typeid(static_cast<T *>(nullptr))) * = nullptr)
+    {
+        append(name, 1, 1, &value);
+    }
+
+    /// \brief Append a vector as a single row
+    template <typename T, typename Alloc>
+    void append(const std::string &name, const Vector<T, Alloc> &vec)
+    {
+        append(name, 1, vec.size(), vec.data());
+    }
+
+    /// \brief Append all rows of a matrix
+    ///
+    /// \details
+    /// The data set is always row major, a column major matrix is transposed
+    /// while it is copied into the buffer.
+    template <typename T, MatrixLayout Layout, typename Alloc>
+    void append(const std::string &name, const Matrix<T, Layout, Alloc> &mat)
+    {
+        const std::size_t nrow = mat.nrow();
+        const std::size_t ncol = mat.ncol();
+        T *dst = insert<T>(name, nrow, ncol);
+        if (Layout == RowMajor) {
+            std::copy_n(mat.data(), nrow * ncol, dst);
+        } else {
+            for (std::size_t i = 0; i != nrow; ++i) {
+                for (std::size_t j = 0; j != ncol; ++j) {
+                    *dst++ = mat(i, j);
+                }
+            }
+        }
+        commit(nrow * ncol * sizeof(T));
+    }
+
+    /// \brief Write all buffered data to the file and wait for completion
+    void flush()
+    {
+        if (!thread_.joinable()) {
+            return;
+        }
+
+        submit();
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return !busy_; });
+        ::H5Fflush(file_.id(), H5F_SCOPE_LOCAL);
+    }
+
+    /// \brief Write all buffered data, stop the background thread and close
+    /// the file
+    void close()
+    {
+        if (!thread_.joinable()) {
+            return;
+        }
+
+        submit();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return !busy_; });
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+        dataset_.clear();
+        file_ = HDF5File();
+    }
+
+  private:
+    class block_type
+    {
+      public:
+        std::string name;
+        std::size_t nrow;
+        std::size_t ncol;
+        std::size_t bytes;
+        HDF5DataType (*type)();
+        Vector<char> data;
+    }; // class block_type
+
+    class buffer_type
+    {
+      public:
+        Vector<block_type> block;
+        std::map<std::string, std::size_t> index;
+    }; // class buffer_type
+
+    HDF5File file_;
+    std::size_t chunk_size_;
+    unsigned compression_;
+    std::size_t buffer_size_;
+    std::size_t bytes_;
+    buffer_type front_;
+    buffer_type back_;
+    std::map<std::string, HDF5DataSet> dataset_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool busy_;
+    bool stop_;
+    std::atomic<bool> error_;
+
+    template <typename T>
+    T *insert(const std::string &name, std::size_t nrow, std::size_t ncol)
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "**HDF5Writer::append** used with T not trivially copyable");
+
+        runtime_assert(thread_.joinable(),
+            "**HDF5Writer::append** used with a closed writer");
+
+        auto iter = front_.index.find(name);
+        if (iter == front_.index.end()) {
+            iter = front_.index.emplace(name, front_.block.size()).first;
+            front_.block.emplace_back();
+            front_.block.back().name = name;
+            front_.block.back().nrow = 0;
+            front_.block.back().ncol = ncol;
+            front_.block.back().bytes = sizeof(T);
+            front_.block.back().type = hdf5type<T>;
+        }
+
+        block_type &blk = front_.block[iter->second];
+        runtime_assert(blk.ncol == ncol && blk.bytes == sizeof(T),
+            "**HDF5Writer::append** data set appended with different number "
+            "of columns or type");
+
+        const std::size_t offset = blk.data.size();
+        blk.data.resize(offset + nrow * ncol * sizeof(T));
+        blk.nrow += nrow;
+
+        return reinterpret_cast<T *>(blk.data.data() + offset);
+    }
+
+    void commit(std::size_t bytes)
+    {
+        bytes_ += bytes;
+        if (bytes_ >= buffer_size_) {
+            submit();
+        }
+    }
+
+    void submit()
+    {
+        if (bytes_ == 0) {
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return !busy_; });
+            std::swap(front_, back_);
+            busy_ = true;
+        }
+        cv_.notify_all();
+        bytes_ = 0;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this]() { return busy_ || stop_; });
+            if (!busy_) {
+                return;
+            }
+            lock.unlock();
+            for (auto &blk : back_.block) {
+                if (blk.nrow != 0 && !write(blk)) {
+                    error_ = true;
+                }
+                blk.nrow = 0;
+                blk.data.clear();
+            }
+            lock.lock();
+            busy_ = false;
+            cv_.notify_all();
+        }
+    }
+
+    bool write(const block_type &blk)
+    {
+        auto type = blk.type();
+        if (!type) {
+            return false;
+        }
+
+        auto iter = dataset_.find(blk.name);
+        if (iter == dataset_.end()) {
+            HDF5DataSet data = open(blk, type);
+            if (!data) {
+                return false;
+            }
+            iter = dataset_.emplace(blk.name, std::move(data)).first;
+        }
+        const HDF5DataSet &data = iter->second;
+
+        auto space = data.space();
+        if (!space || space.ndims() != 2) {
+            return false;
+        }
+
+        ::hsize_t dims[2];
+        space.dims(dims);
+        if (dims[1] != blk.ncol) {
+            return false;
+        }
+
+        ::hsize_t offset[] = {dims[0], 0};
+        ::hsize_t exts[] = {blk.nrow, blk.ncol};
+        dims[0] += blk.nrow;
+        if (::H5Dset_extent(data.id(), dims) != 0) {
+            return false;
+        }
+
+        if (blk.ncol == 0) {
+            return true;
+        }
+
+        space = data.space();
+        if (!space) {
+            return false;
+        }
+
+        if (::H5Sselect_hyperslab(
+                space.id(), H5S_SELECT_SET, offset, nullptr, exts, nullptr) !=
+            0) {
+            return false;
+        }
+
+        HDF5DataSpace mspace(2, exts);
+        if (!mspace) {
+            return false;
+        }
+
+        return ::H5Dwrite(data.id(), type.id(), mspace.id(), space.id(),
+                   H5P_DEFAULT, blk.data.data()) >= 0;
+    }
+
+    HDF5DataSet open(const block_type &blk, const HDF5DataType &type)
+    {
+        bool print_error = hdf5_error_printing(false);
+        ::htri_t exists =
+            ::H5Lexists(file_.id(), blk.name.c_str(), H5P_DEFAULT);
+        hdf5_error_printing(print_error);
+        if (exists > 0) {
+            return HDF5DataSet(file_, blk.name);
+        }
+
+        ::hsize_t dims[] = {0, blk.ncol};
+        ::hsize_t maxdims[] = {H5S_UNLIMITED, blk.ncol};
+        HDF5DataSpace space(2, dims, maxdims);
+        if (!space) {
+            return HDF5DataSet();
+        }
+
+        HDF5PropertyList lcpl(::H5Pcreate(H5P_LINK_CREATE));
+        if (!lcpl || ::H5Pset_create_intermediate_group(lcpl.id(), 1) < 0) {
+            return HDF5DataSet();
+        }
+
+        HDF5PropertyList dcpl(::H5Pcreate(H5P_DATASET_CREATE));
+        if (!dcpl) {
+            return HDF5DataSet();
+        }
+
+        ::hsize_t chunk_dims[] = {
+            chunk_size_, std::max<::hsize_t>(blk.ncol, 1)};
+        if (::H5Pset_chunk(dcpl.id(), 2, chunk_dims) < 0) {
+            return HDF5DataSet();
+        }
+
+        if (compression_ != 0 &&
+            ::H5Pset_deflate(dcpl.id(), compression_) < 0) {
+            return HDF5DataSet();
+        }
+
+        return HDF5DataSet(::H5Dcreate2(file_.id(), blk.name.c_str(),
+            type.id(), space.id(), lcpl.id(), dcpl.id(), H5P_DEFAULT));
+    }
+}; // class HDF5Writer
+
 } // namespace mckl
 
 #endif // MCKL_UTILITY_HDF5_HPP
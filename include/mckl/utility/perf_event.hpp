@@ -0,0 +1,483 @@
+//============================================================================
+// MCKL/include/mckl/utility/perf_event.hpp
+//----------------------------------------------------------------------------
+// MCKL: Monte Carlo Kernel Library
+//----------------------------------------------------------------------------
+// Copyright (c) 2013-2018, Yan Zhou
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+//
+//   Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//============================================================================
+
+#ifndef MCKL_UTILITY_PERF_EVENT_HPP
+#define MCKL_UTILITY_PERF_EVENT_HPP
+
+#include <mckl/internal/common.hpp>
+#include <mckl/utility/stop_watch.hpp>
+
+#if MCKL_HAS_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mckl {
+
+/// \brief Events counted by StopWatchPerf
+/// \ingroup StopWatch
+enum class PerfEvent {
+    Cycles,             ///< CPU cycles
+    Instructions,       ///< Retired instructions
+    CacheReferences,    ///< Last level cache references
+    CacheMisses,        ///< Last level cache misses
+    BranchInstructions, ///< Retired branch instructions
+    BranchMisses,       ///< Mispredicted branch instructions
+    RefCycles,          ///< Reference cycles at a constant frequency
+    Slots,              ///< Top-down microarchitecture analysis slots (Intel)
+    TaskClock,          ///< Task clock in nanoseconds (software)
+    PageFaults,         ///< Page faults (software)
+    ContextSwitches     ///< Context switches (software)
+};                      // enum PerfEvent
+
+namespace internal {
+
+constexpr std::size_t perf_event_size() { return 11; }
+
+inline const char *perf_event_name(PerfEvent event)
+{
+    switch (event) {
+        case PerfEvent::Cycles:
+            return "Cycles";
+        case PerfEvent::Instructions:
+            return "Instructions";
+        case PerfEvent::CacheReferences:
+            return "CacheReferences";
+        case PerfEvent::CacheMisses:
+            return "CacheMisses";
+        case PerfEvent::BranchInstructions:
+            return "BranchInstructions";
+        case PerfEvent::BranchMisses:
+            return "BranchMisses";
+        case PerfEvent::RefCycles:
+            return "RefCycles";
+        case PerfEvent::Slots:
+            return "Slots";
+        case PerfEvent::TaskClock:
+            return "TaskClock";
+        case PerfEvent::PageFaults:
+            return "PageFaults";
+        case PerfEvent::ContextSwitches:
+            return "ContextSwitches";
+    }
+
+    return "";
+}
+
+#if MCKL_HAS_PERF_EVENT
+
+inline bool perf_event_attr(PerfEvent event, ::perf_event_attr &attr)
+{
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    switch (event) {
+        case PerfEvent::Cycles:
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PerfEvent::Instructions:
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PerfEvent::CacheReferences:
+            attr.config = PERF_COUNT_HW_CACHE_REFERENCES;
+            break;
+        case PerfEvent::CacheMisses:
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PerfEvent::BranchInstructions:
+            attr.config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS;
+            break;
+        case PerfEvent::BranchMisses:
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PerfEvent::RefCycles:
+            attr.config = PERF_COUNT_HW_REF_CPU_CYCLES;
+            break;
+        case PerfEvent::Slots:
+            // TOPDOWN.SLOTS, event 0x00 umask 0x04 on Ice Lake and later
+            attr.type = PERF_TYPE_RAW;
+            attr.config = 0x0400;
+            break;
+        case PerfEvent::TaskClock:
+            attr.type = PERF_TYPE_SOFTWARE;
+            attr.config = PERF_COUNT_SW_TASK_CLOCK;
+            break;
+        case PerfEvent::PageFaults:
+            attr.type = PERF_TYPE_SOFTWARE;
+            attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+            break;
+        case PerfEvent::ContextSwitches:
+            attr.type = PERF_TYPE_SOFTWARE;
+            attr.config = PERF_COUNT_SW_CONTEXT_SWITCHES;
+            break;
+    }
+
+    return attr.type != PERF_TYPE_SOFTWARE;
+}
+
+inline int perf_event_open(::perf_event_attr &attr, int group_fd)
+{
+    return static_cast<int>(
+        ::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+#if MCKL_HAS_X86
+inline std::uint64_t perf_event_rdpmc(unsigned c)
+{
+    unsigned a = 0;
+    unsigned d = 0;
+    __asm__ volatile("rdpmc" : "=a"(a), "=d"(d) : "c"(c));
+
+    return (static_cast<std::uint64_t>(d) << 32) + a;
+}
+#endif
+
+#endif // MCKL_HAS_PERF_EVENT
+
+} // namespace internal
+
+MCKL_PUSH_CLANG_WARNING("-Wpadded")
+/// \brief StopWatch with hardware performance counters
+/// \ingroup StopWatch
+///
+/// \details
+/// The events are opened with the Linux `perf_event_open` system call for
+/// the calling thread, in user space only. Hardware events are opened as a
+/// group, such that they are scheduled onto the PMU together, and software
+/// events are opened individually. An event that cannot be opened, because
+/// the PMU does not support it, or the system does not permit it, or on
+/// other systems, is reported as unavailable by `has()`, and its count is
+/// always zero. When the kernel permits it, counters are read in user space
+/// with the `rdpmc` instruction through the memory mapped page of each
+/// event, and otherwise with the `read` system call. If the events are
+/// multiplexed, counts read by the system call are scaled by the fraction of
+/// the time they were scheduled.
+///
+/// Only the thread that constructed the watch is measured, and the watch
+/// shall be started and stopped by the same thread.
+class StopWatchPerf
+{
+  public:
+    /// \brief Count cycles, instructions, cache references and misses,
+    /// branch instructions and misses
+    StopWatchPerf()
+        : StopWatchPerf({PerfEvent::Cycles, PerfEvent::Instructions,
+              PerfEvent::CacheReferences, PerfEvent::CacheMisses,
+              PerfEvent::BranchInstructions, PerfEvent::BranchMisses})
+    {
+    }
+
+    /// \brief Count the specified events
+    explicit StopWatchPerf(std::initializer_list<PerfEvent> events)
+        : running_(false)
+    {
+        counter_.fill(Counter());
+        open(events);
+        reset();
+    }
+
+    StopWatchPerf(const StopWatchPerf &) = delete;
+    StopWatchPerf &operator=(const StopWatchPerf &) = delete;
+
+    ~StopWatchPerf() { close(); }
+
+    /// \brief If an event is counted
+    bool has(PerfEvent event) const
+    {
+        return counter_[static_cast<std::size_t>(event)].fd >= 0;
+    }
+
+    /// \brief If cycles are counted
+    bool has_cycles() const { return has(PerfEvent::Cycles); }
+
+    /// \brief If the watch is running
+    bool running() const { return running_; }
+
+    /// \brief Start the watch, no effect if already started
+    bool start()
+    {
+        if (running_) {
+            return false;
+        }
+
+        running_ = true;
+        watch_.start();
+        for (auto &c : counter_) {
+            if (c.fd >= 0) {
+                c.start = read(c);
+            }
+        }
+
+        return true;
+    }
+
+    /// \brief Stop the watch, no effect if already stopped
+    bool stop()
+    {
+        if (!running_) {
+            return false;
+        }
+
+        for (auto &c : counter_) {
+            if (c.fd >= 0) {
+                c.count += read(c) - c.start;
+            }
+        }
+        watch_.stop();
+        running_ = false;
+
+        return true;
+    }
+
+    /// \brief Stop and reset the elapsed time and counts to zero
+    void reset()
+    {
+        watch_.reset();
+        for (auto &c : counter_) {
+            c.count = 0;
+        }
+        running_ = false;
+    }
+
+    /// \brief Return the accumulated count of an event
+    std::uint64_t count(PerfEvent event) const
+    {
+        return counter_[static_cast<std::size_t>(event)].count;
+    }
+
+    /// \brief Return the accumulated cycles
+    std::uint64_t cycles() const { return count(PerfEvent::Cycles); }
+
+    /// \brief Instructions per cycle, zero if either is not counted
+    double ipc() const
+    {
+        return ratio(PerfEvent::Instructions, PerfEvent::Cycles);
+    }
+
+    /// \brief The fraction of cache references that missed, zero if either is
+    /// not counted
+    double cache_miss_rate() const
+    {
+        return ratio(PerfEvent::CacheMisses, PerfEvent::CacheReferences);
+    }
+
+    /// \brief The fraction of branch instructions that were mispredicted,
+    /// zero if either is not counted
+    double branch_miss_rate() const
+    {
+        return ratio(PerfEvent::BranchMisses, PerfEvent::BranchInstructions);
+    }
+
+    /// \brief Return the accumulated elapsed time in its native format
+    StopWatch::clock_type::duration time() const { return watch_.time(); }
+
+    /// \brief Return the accumulated elapsed time in specified format
+    template <typename Rep, typename Period>
+    Rep time() const
+    {
+        return watch_.time<Rep, Period>();
+    }
+
+    /// \brief Equivalent to `time<double, std::nano>()`
+    double nanoseconds() const { return watch_.nanoseconds(); }
+
+    /// \brief Equivalent to `time<double, std::micro>()`
+    double microseconds() const { return watch_.microseconds(); }
+
+    /// \brief Equivalent to `time<double, std::milli>()`
+    double milliseconds() const { return watch_.milliseconds(); }
+
+    /// \brief Equivalent to `time<double, std::ratio<1>>()`
+    double seconds() const { return watch_.seconds(); }
+
+    /// \brief Equivalent to `time<double, std::ratio<60>>()`
+    double minutes() const { return watch_.minutes(); }
+
+    /// \brief Equivalent to `time<double, std::ratio<3600>>()`
+    double hours() const { return watch_.hours(); }
+
+    /// \brief Print the time and the counts of all available events
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(
+        std::basic_ostream<CharT, Traits> &os, const StopWatchPerf &watch)
+    {
+        if (!os) {
+            return os;
+        }
+
+        os << "Time (ns): " << watch.nanoseconds() << std::endl;
+        for (std::size_t i = 0; i != internal::perf_event_size(); ++i) {
+            const PerfEvent event = static_cast<PerfEvent>(i);
+            if (watch.has(event)) {
+                os << internal::perf_event_name(event) << ": "
+                   << watch.count(event) << std::endl;
+            }
+        }
+
+        return os;
+    }
+
+  private:
+    class Counter
+    {
+      public:
+        int fd = -1;
+        void *page = nullptr;
+        std::uint64_t start = 0;
+        std::uint64_t count = 0;
+    }; // class Counter
+
+    StopWatch watch_;
+    std::array<Counter, internal::perf_event_size()> counter_;
+    bool running_;
+
+    double ratio(PerfEvent num, PerfEvent den) const
+    {
+        return has(num) && has(den) && count(den) != 0 ?
+            static_cast<double>(count(num)) / count(den) :
+            0;
+    }
+
+#if MCKL_HAS_PERF_EVENT
+
+    void open(std::initializer_list<PerfEvent> events)
+    {
+        const long page_size = ::sysconf(_SC_PAGESIZE);
+        int leader = -1;
+        for (PerfEvent event : events) {
+            Counter &c = counter_[static_cast<std::size_t>(event)];
+            if (c.fd >= 0) {
+                continue;
+            }
+
+            ::perf_event_attr attr;
+            const bool hardware = internal::perf_event_attr(event, attr);
+            if (hardware && leader >= 0) {
+                c.fd = internal::perf_event_open(attr, leader);
+            }
+            if (c.fd < 0) {
+                c.fd = internal::perf_event_open(attr, -1);
+                if (hardware && leader < 0 && c.fd >= 0) {
+                    leader = c.fd;
+                }
+            }
+            if (c.fd < 0 || !hardware) {
+                continue;
+            }
+
+            c.page = ::mmap(nullptr, static_cast<std::size_t>(page_size),
+                PROT_READ, MAP_SHARED, c.fd, 0);
+            if (c.page == MAP_FAILED) {
+                c.page = nullptr;
+            }
+        }
+    }
+
+    void close()
+    {
+        const long page_size = ::sysconf(_SC_PAGESIZE);
+        for (auto &c : counter_) {
+            if (c.page != nullptr) {
+                ::munmap(c.page, static_cast<std::size_t>(page_size));
+            }
+            if (c.fd >= 0) {
+                ::close(c.fd);
+            }
+            c = Counter();
+        }
+    }
+
+    static std::uint64_t read(const Counter &c)
+    {
+#if MCKL_HAS_X86
+        if (c.page != nullptr) {
+            const volatile ::perf_event_mmap_page *pc =
+                static_cast<const volatile ::perf_event_mmap_page *>(c.page);
+            std::uint32_t seq = 0;
+            std::uint32_t idx = 0;
+            std::int64_t count = 0;
+            do {
+                seq = pc->lock;
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+                idx = pc->index;
+                count = pc->offset;
+                if (pc->cap_user_rdpmc && idx != 0) {
+                    const unsigned width = pc->pmc_width;
+                    std::int64_t pmc = static_cast<std::int64_t>(
+                        internal::perf_event_rdpmc(idx - 1));
+                    pmc <<= 64 - width;
+                    pmc >>= 64 - width;
+                    count += pmc;
+                }
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+            } while (pc->lock != seq);
+
+            if (pc->cap_user_rdpmc && idx != 0) {
+                return static_cast<std::uint64_t>(count);
+            }
+        }
+#endif // MCKL_HAS_X86
+
+        std::uint64_t buf[3] = {0, 0, 0};
+        if (::read(c.fd, buf, sizeof(buf)) != sizeof(buf)) {
+            return 0;
+        }
+        if (buf[2] != 0 && buf[2] < buf[1]) {
+            return static_cast<std::uint64_t>(
+                static_cast<double>(buf[0]) * buf[1] / buf[2]);
+        }
+
+        return buf[0];
+    }
+
+#else // MCKL_HAS_PERF_EVENT
+
+    void open(std::initializer_list<PerfEvent>) {}
+
+    void close() {}
+
+    static std::uint64_t read(const Counter &) { return 0; }
+
+#endif // MCKL_HAS_PERF_EVENT
+}; // class StopWatchPerf
+MCKL_POP_CLANG_WARNING
+
+} // namespace mckl
+
+#endif // MCKL_UTILITY_PERF_EVENT_HPP
@@ -0,0 +1,241 @@
+;;============================================================================
+;; MCKL/lib/asm/exp512.asm
+;;----------------------------------------------------------------------------
+;; MCKL: Monte Carlo Kernel Library
+;;----------------------------------------------------------------------------
+;; Copyright (c) 2013-2018, Yan Zhou
+;; All rights reserved.
+;;
+;; Redistribution and use in source and binary forms, with or without
+;; modification, are permitted provided that the following conditions are met:
+;;
+;;   Redistributions of source code must retain the above copyright notice,
+;;   this list of conditions and the following disclaimer.
+;;
+;;   Redistributions in binary form must reproduce the above copyright notice,
+;;   this list of conditions and the following disclaimer in the documentation
+;;   and/or other materials provided with the distribution.
+;;
+;; THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+;; AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+;; IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+;; ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+;; LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+;; CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+;; SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+;; INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+;; CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+;; ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+;; POSSIBILITY OF SUCH DAMAGE.
+;;============================================================================
+
+%include "/math512.asm"
+
+global mckl_vd512_exp
+global mckl_vd512_exp2
+global mckl_vd512_expm1
+
+default rel
+
+; register used as constants: zmm6, zmm8, zmm10, zmm12, zmm14
+; register used as variables: zmm1-5, zmm7, zmm9, zmm11, zmm13, zmm15
+; mask register used as variables: k1-k6
+
+%macro expm1x_constants 0
+    vmovapd zmm6,  [ln2inv]
+    vmovapd zmm8,  [ln2hi]
+    vmovapd zmm10, [ln2lo]
+    vmovapd zmm12, [bias]
+%endmacro
+
+; exp(x) - 1 = c13 * x^13 + ... + c2 * x^2 + x
+%macro expm1x 1 ; implicity input zmm1, zmm15, output zmm13, zmm15, k1-k4
+    vmovapd zmm13, [c13]
+    vmovapd zmm11, [c11]
+    vmovapd zmm9,  [c9]
+    vmovapd zmm7,  [c7]
+    vmovapd zmm5,  [c5]
+    vmovapd zmm3,  [c3]
+
+    vmulpd zmm2, zmm1, zmm1 ; x^2
+    vmulpd zmm4, zmm2, zmm2 ; x^4
+
+    vfmadd213pd zmm13, zmm1, [c12] ; u13 = c13 * x + c12
+    vfmadd213pd zmm11, zmm1, [c10] ; u11 = c11 * x + c10
+    vfmadd213pd zmm9,  zmm1, [c8]  ; u9  = c9  * x + c8
+    vfmadd213pd zmm7,  zmm1, [c6]  ; u7  = c7  * x + c6
+    vfmadd213pd zmm5,  zmm1, [c4]  ; u5  = c5  * x + c4
+    vfmadd213pd zmm3,  zmm1, [c2]  ; u3  = c3  * x + c2
+
+    vfmadd213pd zmm13, zmm2, zmm11 ; v13 = u13 * x^2 + u11
+    vfmadd213pd zmm9,  zmm2, zmm7  ; v9  = u9  * x^2 + u7
+    vfmadd213pd zmm5,  zmm2, zmm3  ; v5  = u5  * x^2 + u3
+
+    vcmppd k3, zmm0, zmm0, 0x4 ; a != a
+    vaddpd zmm15, zmm15, zmm12 ; 2^k
+    vpsllq zmm15, zmm15, 52
+
+    vfmadd213pd zmm13, zmm4, zmm9 ; w13 = v13 * x^4 + v9
+    vfmadd213pd zmm5,  zmm2, zmm1 ; w5  = v5  * x^2 + x
+
+    vmulpd zmm4, zmm4, zmm2 ; x^6
+    vcmppd k1, zmm0, [%{1}_min_a], 0x1 ; a < min_a
+    vcmppd k2, zmm0, [%{1}_max_a], 0xE ; a > max_a
+
+    vfmadd213pd zmm13, zmm4, zmm5 ; z13 = w13 * x^6 + w5
+
+    korw k4, k1, k2
+    korw k4, k4, k3
+%endmacro
+
+%macro select 1 ; implicit input k1-k4, zmm13, output zmm13
+    kortestw k4, k4
+    jz %%skip
+    vblendmpd zmm13{k1}, zmm13, [%{1}_min_y] ; min_y
+    vblendmpd zmm13{k2}, zmm13, [%{1}_max_y] ; max_y
+    vblendmpd zmm13{k3}, zmm13, zmm0         ; a
+%%skip:
+%endmacro
+
+%macro exp_constants 0
+    expm1x_constants
+%endmacro
+
+%macro exp 2
+    vmovupd zmm0, %2
+
+    ; k = round(a / log(2))
+    vmulpd zmm15, zmm0, zmm6
+    vrndscalepd zmm15, zmm15, 0x8
+
+    ; x = a - k * log(2)
+    vmovapd zmm1, zmm0
+    vfnmadd231pd zmm1, zmm15, zmm8
+    vfnmadd231pd zmm1, zmm15, zmm10
+
+    expm1x exp ; exp(x) = R + 1
+
+    ; exp(a) = exp(x) * 2^k = R * 2^k + 2^k
+    vfmadd213pd zmm13, zmm15, zmm15
+
+    select exp
+    vmovupd %1, zmm13
+%endmacro
+
+%macro exp2_constants 0
+    expm1x_constants
+    vmovapd zmm14, [ln2]
+%endmacro
+
+%macro exp2 2
+    vmovupd zmm0, %2
+
+    ; k = round(a)
+    vrndscalepd zmm15, zmm0, 0x8
+
+    ; x = (a - k) * log(2)
+    vsubpd zmm1, zmm0, zmm15
+    vmulpd zmm1, zmm1, zmm14
+
+    expm1x exp2 ; exp(x) = R + 1
+
+    ; 2^a = exp(x) * 2^k = R * 2^k + 2^k
+    vfmadd213pd zmm13, zmm15, zmm15
+
+    select exp2
+    vmovupd %1, zmm13
+%endmacro
+
+%macro expm1_constants 0
+    expm1x_constants
+%endmacro
+
+%macro expm1 2
+    vmovupd zmm0, %2
+
+    ; log(2) / 2 <= abs(a) <= log(2)
+    vpxorq zmm15, zmm15, zmm15 ; k = 0
+    vmulpd zmm1, zmm0, [half]  ; x = 0.5 * a
+    vpandq zmm2, zmm0, [pmask] ; abs(a)
+    vcmppd k5, zmm2, [ln2by2], 0x1 ; abs(a) < log(2) / 2
+    vcmppd k6, zmm2, [ln2], 0xE    ; abs(a) > log(2)
+    korw k5, k5, k6 ; abs(a) < log(2) / 2 || abs(a) > log(2)
+    kortestw k5, k5 ; log(2) / 2 <= abs(a) <= log(2)
+    jz %%skip
+
+    ; k = round(a / log(2))
+    vmulpd zmm15, zmm0, zmm6
+    vrndscalepd zmm15, zmm15, 0x8
+
+    ; x = a - k * log(2)
+    vmovapd zmm2, zmm0
+    vfnmadd231pd zmm2, zmm15, zmm8
+    vfnmadd231pd zmm2, zmm15, zmm10
+
+    vblendmpd zmm1{k5}, zmm1, zmm2
+
+%%skip:
+
+    expm1x expm1 ; exp(x) = R + 1
+
+    ; exp(a) - 1 = exp(x) * 2^k - 1 = R * 2^k + (2^k - 1)
+    vsubpd zmm5, zmm15, [one] ; 2^k - 1
+    vaddpd zmm9, zmm13, zmm13 ; 2 * R
+    vmovapd zmm11, zmm13
+    vfmadd213pd zmm13, zmm15, zmm5 ; R * 2^k + (2^k - 1)
+    vfmadd213pd zmm11, zmm11, zmm9 ; R * R + 2 * R
+    vblendmpd zmm13{k5}, zmm11, zmm13
+
+    select expm1
+    vmovupd %1, zmm13
+%endmacro
+
+section .rodata
+
+align 64
+
+exp_min_a: times 8 dq 0xC086232BDD7ABCD2 ; -708.3964185322641
+exp_max_a: times 8 dq 0x40862B7D369A5AA7 ; 709.4361393031039
+exp_min_y: times 8 dq 0x0000000000000000 ; 0.0
+exp_max_y: times 8 dq 0x7FF0000000000000 ; HUGE_VAL
+
+exp2_min_a: times 8 dq 0xC08FF00000000000 ; -1022.0
+exp2_max_a: times 8 dq 0x408FF80000000000 ; 1023
+exp2_min_y: times 8 dq 0x0000000000000000 ; 0.0
+exp2_max_y: times 8 dq 0x7FF0000000000000 ; HUGE_VAL
+
+expm1_min_a: times 8 dq 0xC086232BDD7ABCD2 ; -708.3964185322641
+expm1_max_a: times 8 dq 0x40862B7D369A5AA7 ; 709.4361393031039
+expm1_min_y: times 8 dq 0xBFF0000000000000 ; -1.0
+expm1_max_y: times 8 dq 0x7FF0000000000000 ; HUGE_VAL
+
+c2:  times 8 dq 0x3FE0000000000000
+c3:  times 8 dq 0x3FC5555555555555
+c4:  times 8 dq 0x3FA5555555555555
+c5:  times 8 dq 0x3F81111111111111
+c6:  times 8 dq 0x3F56C16C16C16C17
+c7:  times 8 dq 0x3F2A01A01A01A01A
+c8:  times 8 dq 0x3EFA01A01A01A01A
+c9:  times 8 dq 0x3EC71DE3A556C734
+c10: times 8 dq 0x3E927E4FB7789F5C
+c11: times 8 dq 0x3E5AE64567F544E4
+c12: times 8 dq 0x3E21EED8EFF8D898
+c13: times 8 dq 0x3DE6124613A86D09
+
+bias:   times 8 dq 0x43300000000003FF ; 2^52 + 1023
+one:    times 8 dq 0x3FF0000000000000 ; 1.0
+half:   times 8 dq 0x3FE0000000000000 ; 0.5
+pmask:  times 8 dq 0x7FFFFFFFFFFFFFFF ; abs(x) = x & pmask
+ln2:    times 8 dq 0x3FE62E42FEFA39EF ; log(2.0l)
+ln2hi:  times 8 dq 0x3FE62E42FEE00000
+ln2lo:  times 8 dq 0x3DEA39EF35793C76
+ln2inv: times 8 dq 0x3FF71547652B82FE ; 1.0l / log(2.0l)
+ln2by2: times 8 dq 0x3FD62E42FEFA39EF ; log(2.0l) / 2.0l
+
+section .text
+
+mckl_vd512_exp:   math_kernel512_a1r1 8, exp
+mckl_vd512_exp2:  math_kernel512_a1r1 8, exp2
+mckl_vd512_expm1: math_kernel512_a1r1 8, expm1
+
+; vim:ft=nasm
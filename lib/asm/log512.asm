@@ -0,0 +1,274 @@
+;;============================================================================
+;; MCKL/lib/asm/log512.asm
+;;----------------------------------------------------------------------------
+;; MCKL: Monte Carlo Kernel Library
+;;----------------------------------------------------------------------------
+;; Copyright (c) 2013-2018, Yan Zhou
+;; All rights reserved.
+;;
+;; Redistribution and use in source and binary forms, with or without
+;; modification, are permitted provided that the following conditions are met:
+;;
+;;   Redistributions of source code must retain the above copyright notice,
+;;   this list of conditions and the following disclaimer.
+;;
+;;   Redistributions in binary form must reproduce the above copyright notice,
+;;   this list of conditions and the following disclaimer in the documentation
+;;   and/or other materials provided with the distribution.
+;;
+;; THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+;; AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+;; IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+;; ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+;; LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+;; CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+;; SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+;; INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+;; CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+;; ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+;; POSSIBILITY OF SUCH DAMAGE.
+;;============================================================================
+
+%include "/math512.asm"
+
+global mckl_vd512_log
+global mckl_vd512_log2
+global mckl_vd512_log10
+global mckl_vd512_log1p
+
+default rel
+
+; register used as constants: zmm6, zmm8-10, zmm12
+; register used as variables: zmm1-5, zmm7, zmm11, zmm13-15
+; mask register used as variables: k1-k5
+
+%macro log1pf_constants 0
+    vmovapd zmm6, [rel sqrt2by2]
+    vmovapd zmm8, [rel one]
+    vmovapd zmm9, [rel two]
+%endmacro
+
+; log(1 + f) * (f + 2) / f - 2 = c15 * x^14 + ... + c5 * x^4 + c3 * x^2
+%macro log1pf 3 ; implicity input zmm1, output zmm15
+    vcmppd k1, zmm0, %1, 0x1
+    vcmppd k2, zmm0, %2, 0xE
+    vpxorq zmm13, zmm13, zmm13 ; k = 0
+%if %3 == 0
+    vaddpd zmm1, zmm0, zmm8 ; b = a + 1
+    vmovapd zmm14, zmm0     ; f = a;
+%elif %3 == 1
+    vmovapd zmm1, zmm0       ; b = a
+    vsubpd zmm14, zmm0, zmm8 ; f = a - 1;
+%else
+    %error
+%endif
+    korw k1, k1, k2
+    kortestw k1, k1
+    jz %%skip
+
+    ; k = exponent(b)
+    vpsrlq zmm2, zmm1, 52
+    vporq zmm2, zmm2, [emask0]
+    vsubpd zmm3, zmm2, [emask1] ; exponent(b)
+
+    ; fraction(b) / 2
+    vpandq zmm1, zmm1, [fmask0]
+    vporq zmm4, zmm1, [fmask1] ; fraction(b) / 2
+
+    ; fraction(b) > sqrt(2)
+    vcmppd k2, zmm4, zmm6, 0xE
+    knotw k3, k2
+    vaddpd zmm3{k2}, zmm3, zmm8
+    vaddpd zmm4{k3}, zmm4, zmm4
+
+    ; f = fraction(b) - 1
+    vsubpd zmm4, zmm4, zmm8
+
+    ; skip reduction if zmm0 in range
+    vblendmpd zmm13{k1}, zmm13, zmm3
+    vblendmpd zmm14{k1}, zmm14, zmm4
+
+%%skip:
+
+    ; x = f / (f + 2)
+    vaddpd zmm1, zmm14, zmm9
+    vdivpd zmm1, zmm14, zmm1
+
+    vmovapd zmm15, [c15]
+    vmovapd zmm11, [c11]
+    vmovapd zmm7,  [c7]
+
+    vmulpd zmm2, zmm1, zmm1 ; x^2
+    vmulpd zmm3, zmm2, [c3] ; u3  = c3  * x^2
+    vmulpd zmm4, zmm2, zmm2 ; x^4
+
+    vfmadd213pd zmm15, zmm2, [c13] ; u15 = c15 * x^2 + c13
+    vfmadd213pd zmm11, zmm2, [c9]  ; u11 = c11 * x^2 + c9
+    vfmadd213pd zmm7,  zmm2, [c5]  ; u7  = c7  * x^2 + c5
+
+    vfmadd213pd zmm15, zmm4, zmm11 ; v15 = u15 * x^4 + u11
+    vfmadd213pd zmm7,  zmm4, zmm3  ; v7  = u7  * x^4 + u3
+
+    vmulpd zmm4, zmm4, zmm4
+    vfmadd213pd zmm15, zmm4, zmm7 ; z15 = v15 * x^8 + v7
+%endmacro
+
+%macro select 1 ; implicit input zmm0, zmm15, output zmm15
+    vcmppd k1, zmm0, [%{1}_min_a], 0x1 ; a < min_a
+    vcmppd k2, zmm0, [%{1}_max_a], 0xE ; a > max_a
+    vcmppd k3, zmm0, [%{1}_nan_a], 0x1 ; a < nan_a
+    vcmppd k4, zmm0, zmm0, 0x4         ; a != a
+    korw k5, k1, k2
+    korw k5, k5, k3
+    korw k5, k5, k4
+    kortestw k5, k5
+    jz %%skip
+    vblendmpd zmm15{k1}, zmm15, [%{1}_min_y] ; min_y
+    vblendmpd zmm15{k2}, zmm15, [%{1}_max_y] ; max_y
+    vblendmpd zmm15{k3}, zmm15, [%{1}_nan_y] ; nan_y
+    vblendmpd zmm15{k4}, zmm15, zmm0         ; a
+%%skip:
+%endmacro
+
+%macro log_constants 0
+    log1pf_constants
+    vmovapd zmm10, [ln2]
+%endmacro
+
+%macro log 2
+    vmovupd zmm0, %2
+
+    log1pf zmm6, [sqrt2], 1 ; log(1 + f) = f - x * (f - R)
+
+    ; log(a) = k * log(2) + log(1 + f)
+    vsubpd zmm15, zmm14, zmm15
+    vfnmadd213pd zmm15, zmm1, zmm14
+    vfmadd231pd zmm15, zmm13, zmm10
+
+    select log
+    vmovupd %1, zmm15
+%endmacro
+
+%macro log2_constants 0
+    log1pf_constants
+    vmovapd zmm10, [ln2inv]
+%endmacro
+
+%macro log2 2
+    vmovupd zmm0, %2
+
+    log1pf zmm6, [sqrt2], 1 ; log(1 + f) = f - x * (f - R)
+
+    ; log2(a) = k + log(1 + f) / log(2)
+    vsubpd zmm15, zmm14, zmm15
+    vfnmadd213pd zmm15, zmm1, zmm14
+    vfmadd213pd zmm15, zmm10, zmm13
+
+    select log2
+    vmovupd %1, zmm15
+%endmacro
+
+%macro log10_constants 0
+    log1pf_constants
+    vmovapd zmm10, [ln10_2]
+    vmovapd zmm12, [ln10inv]
+%endmacro
+
+%macro log10 2
+    vmovupd zmm0, %2
+
+    log1pf zmm6, [sqrt2], 1 ; log(1 + f) = f - x * (f - R)
+
+    ; log10(a) = k * log(10) / log(2) + log(1 + f) / log(10)
+    vsubpd zmm15, zmm14, zmm15
+    vfnmadd213pd zmm15, zmm1, zmm14
+    vmulpd zmm13, zmm13, zmm10
+    vfmadd213pd zmm15, zmm12, zmm13
+
+    select log10
+    vmovupd %1, zmm15
+%endmacro
+
+%macro log1p_constants 0
+    log1pf_constants
+    vmovapd zmm10, [ln2]
+%endmacro
+
+%macro log1p 2
+    vmovupd zmm0, %2
+
+    log1pf [sqrt2m2], [sqrt2m1], 0 ; log(1 + f) = f - x * (f - R)
+
+    ; log(1 + a) = k * log2 + log(1 + f)
+    vsubpd zmm15, zmm14, zmm15
+    vfnmadd213pd zmm15, zmm1, zmm14
+    vfmadd231pd zmm15, zmm13, zmm10
+
+    select log1p
+    vmovupd %1, zmm15
+%endmacro
+
+section .rodata
+
+align 64
+
+log_min_a: times 8 dq 0x0010000000000000 ; DBL_MIN
+log_max_a: times 8 dq 0x7FEFFFFFFFFFFFFF ; DBL_MAX
+log_nan_a: times 8 dq 0x0000000000000000 ; 0.0
+log_min_y: times 8 dq 0xFFF0000000000000 ; -HUGE_VAL
+log_max_y: times 8 dq 0x7FF0000000000000 ; HUGE_VAL
+log_nan_y: times 8 dq 0x7FF8000000000000 ; NaN
+
+log2_min_a: times 8 dq 0x0010000000000000 ; DBL_MIN
+log2_max_a: times 8 dq 0x7FEFFFFFFFFFFFFF ; DBL_MAX
+log2_nan_a: times 8 dq 0x0000000000000000 ; 0.0
+log2_min_y: times 8 dq 0xFFF0000000000000 ; -HUGE_VAL
+log2_max_y: times 8 dq 0x7FF0000000000000 ; HUGE_VAL
+log2_nan_y: times 8 dq 0x7FF8000000000000 ; NaN
+
+log10_min_a: times 8 dq 0x0010000000000000 ; DBL_MIN
+log10_max_a: times 8 dq 0x7FEFFFFFFFFFFFFF ; DBL_MAX
+log10_nan_a: times 8 dq 0x0000000000000000 ; 0.0
+log10_min_y: times 8 dq 0xFFF0000000000000 ; -HUGE_VAL
+log10_max_y: times 8 dq 0x7FF0000000000000 ; HUGE_VAL
+log10_nan_y: times 8 dq 0x7FF8000000000000 ; NaN
+
+log1p_min_a: times 8 dq 0xBFEFFFFFFFFFFFFF ; nextafter(-1.0, 0.0)
+log1p_max_a: times 8 dq 0x7FEFFFFFFFFFFFFF ; DBL_MAX
+log1p_nan_a: times 8 dq 0xBFF0000000000000 ; -1.0
+log1p_min_y: times 8 dq 0xFFF0000000000000 ; -HUGE_VAL
+log1p_max_y: times 8 dq 0x7FF0000000000000 ; HUGE_VAL
+log1p_nan_y: times 8 dq 0x7FF8000000000000 ; NaN
+
+c3:  times 8 dq 0x3FE5555555555593
+c5:  times 8 dq 0x3FD999999997FA04
+c7:  times 8 dq 0x3FD2492494229359
+c9:  times 8 dq 0x3FCC71C51D8E78AF
+c11: times 8 dq 0x3FC7466496CB03DE
+c13: times 8 dq 0x3FC39A09D078C69F
+c15: times 8 dq 0x3FC2F112DF3E5244
+
+emask0: times 8 dq 0x4330000000000000 ; 2^52
+emask1: times 8 dq 0x43300000000003FF ; 2^52 + 1023
+fmask0: times 8 dq 0x000FFFFFFFFFFFFF ; fraction mask
+fmask1: times 8 dq 0x3FE0000000000000 ; fraction(a) / 2
+
+one:      times 8 dq 0x3FF0000000000000 ; 1.0
+two:      times 8 dq 0x4000000000000000 ; 2.0
+ln2:      times 8 dq 0x3FE62E42FEFA39EF ; log(2.0l)
+ln2inv:   times 8 dq 0x3FF71547652B82FE ; 1.0l / log(2.0l)
+ln10_2:   times 8 dq 0x3FD34413509F79FF ; log10(2.0l)
+ln10inv:  times 8 dq 0x3FDBCB7B1526E50E ; 1.0l / log(10.0l)
+sqrt2:    times 8 dq 0x3FF6A09E667F3BCD ; sqrt(2.0l)
+sqrt2by2: times 8 dq 0x3FE6A09E667F3BCD ; sqrt(2.0l) / 2.0l
+sqrt2m1:  times 8 dq 0x3FDA827999FCEF32 ; sqrt(2.0l) - 1.0l
+sqrt2m2:  times 8 dq 0xBFD2BEC333018867 ; sqrt(2.0l) / 2.0l - 1.0l
+
+section .text
+
+mckl_vd512_log:   math_kernel512_a1r1 8, log
+mckl_vd512_log2:  math_kernel512_a1r1 8, log2
+mckl_vd512_log10: math_kernel512_a1r1 8, log10
+mckl_vd512_log1p: math_kernel512_a1r1 8, log1p
+
+; vim:ft=nasm
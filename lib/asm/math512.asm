@@ -0,0 +1,132 @@
+;;============================================================================
+;; MCKL/lib/asm/math512.asm
+;;----------------------------------------------------------------------------
+;; MCKL: Monte Carlo Kernel Library
+;;----------------------------------------------------------------------------
+;; Copyright (c) 2013-2018, Yan Zhou
+;; All rights reserved.
+;;
+;; Redistribution and use in source and binary forms, with or without
+;; modification, are permitted provided that the following conditions are met:
+;;
+;;   Redistributions of source code must retain the above copyright notice,
+;;   this list of conditions and the following disclaimer.
+;;
+;;   Redistributions in binary form must reproduce the above copyright notice,
+;;   this list of conditions and the following disclaimer in the documentation
+;;   and/or other materials provided with the distribution.
+;;
+;; THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+;; AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+;; IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+;; ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+;; LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+;; CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+;; SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+;; INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+;; CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+;; ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+;; POSSIBILITY OF SUCH DAMAGE.
+;;============================================================================
+
+; k7 = the first rax elements, implicit input rax, output k7
+%macro math_kernel512_mask 1 ; operand size
+%if %1 != 4 && %1 != 8
+    %error
+%endif
+    mov r8d, -1
+    bzhi r8d, r8d, eax
+    kmovw k7, r8d
+%endmacro
+
+; rdi:n
+; rsi:a
+; rdx:y
+%macro math_kernel512_a1r1 2 ; operand size, function
+    test rdi, rdi
+    jz .return
+
+    %{2}_constants
+
+    mov rax, rdi
+    and rax, (0x40 / %1) - 1
+    sub rdi, rax
+
+    test rdi, rdi
+    jz .last
+
+align 16
+.loop:
+    %2 [rdx], [rsi]
+    add rsi, 0x40
+    add rdx, 0x40
+    sub rdi, 0x40 / %1
+    jnz .loop
+
+.last:
+    test rax, rax
+    jz .return
+    math_kernel512_mask %1
+%if %1 == 4
+    vmovups zmm0{k7}{z}, [rsi]
+    %2 zmm0, zmm0
+    vmovups [rdx]{k7}, zmm0
+%else
+    vmovupd zmm0{k7}{z}, [rsi]
+    %2 zmm0, zmm0
+    vmovupd [rdx]{k7}, zmm0
+%endif
+
+.return:
+    vzeroupper
+    ret
+%endmacro
+
+; rdi:n
+; rsi:a
+; rdx:y
+; rcx:z
+%macro math_kernel512_a1r2 2 ; operand size, function
+    test rdi, rdi
+    jz .return
+
+    %{2}_constants
+
+    mov rax, rdi
+    and rax, (0x40 / %1) - 1
+    sub rdi, rax
+
+    test rdi, rdi
+    jz .last
+
+align 16
+.loop:
+    %2 [rdx], [rcx], [rsi]
+    add rsi, 0x40
+    add rdx, 0x40
+    add rcx, 0x40
+    sub rdi, 0x40 / %1
+    jnz .loop
+
+.last:
+    test rax, rax
+    jz .return
+    math_kernel512_mask %1
+%if %1 == 4
+    vmovups zmm0{k7}{z}, [rsi]
+    %2 zmm0, zmm1, zmm0
+    vmovups [rdx]{k7}, zmm0
+    vmovups [rcx]{k7}, zmm1
+%else
+    vmovupd zmm0{k7}{z}, [rsi]
+    %2 zmm0, zmm1, zmm0
+    vmovupd [rdx]{k7}, zmm0
+    vmovupd [rcx]{k7}, zmm1
+%endif
+
+.return:
+    vzeroupper
+    ret
+%endmacro
+
+; vim:ft=nasm
@@ -0,0 +1,237 @@
+;;============================================================================
+;; MCKL/lib/asm/sincos512.asm
+;;----------------------------------------------------------------------------
+;; MCKL: Monte Carlo Kernel Library
+;;----------------------------------------------------------------------------
+;; Copyright (c) 2013-2018, Yan Zhou
+;; All rights reserved.
+;;
+;; Redistribution and use in source and binary forms, with or without
+;; modification, are permitted provided that the following conditions are met:
+;;
+;;   Redistributions of source code must retain the above copyright notice,
+;;   this list of conditions and the following disclaimer.
+;;
+;;   Redistributions in binary form must reproduce the above copyright notice,
+;;   this list of conditions and the following disclaimer in the documentation
+;;   and/or other materials provided with the distribution.
+;;
+;; THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+;; AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+;; IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+;; ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+;; LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+;; CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+;; SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+;; INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+;; CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+;; ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+;; POSSIBILITY OF SUCH DAMAGE.
+;;============================================================================
+
+%include "/math512.asm"
+
+global mckl_vd512_sin
+global mckl_vd512_cos
+global mckl_vd512_sincos
+global mckl_vd512_tan
+
+default rel
+
+%macro sincostan 1 ; implicit input zmm0, output zmm13, zmm14, zmm15
+    ; b = abs(a)
+    vpandq zmm1, zmm0, [pmask]
+    vcmppd k2, zmm1, [nan_a], 0xE
+    vcmppd k5, zmm1, [max_a], 0xE
+    vblendmpd zmm0{k2}, zmm0, [nan_y]
+    kortestw k5, k5
+    jz %%inrange
+
+    ; reduce zmm1 to around 2^53 if zmm1 > 2^53
+    vpandq zmm2, zmm1, [max253]
+    vcmppd k3, zmm1, [pow253], 0xE
+    vblendmpd zmm1{k3}, zmm1, zmm2
+
+    ; reduce zmm1 to zmm1 - k * 2 * pi if zmm1 > max_a
+    vsubpd zmm4, zmm1, [max_a]
+    vmulpd zmm4, zmm4, [pi2inv]
+    vrndscalepd zmm4, zmm4, 0xA
+    vmovapd zmm2, zmm1
+    vfnmadd231pd zmm2, zmm4, [pi2]
+    vblendmpd zmm1{k5}, zmm1, zmm2
+
+    %%inrange:
+
+    ; n = trunc(4 * b / pi)
+    vmulpd zmm11, zmm1, [pi4inv]
+    vcvttpd2dq ymm11, zmm11
+
+    ; k = floor((n + 1) / 2) * 2
+    vpaddd ymm11, ymm11, [ddone]
+    vpand ymm11, ymm11, [ddmask]
+
+    ; x = a - k * pi / 4
+    vcvtdq2pd zmm2, ymm11
+    vfnmadd231pd zmm1, zmm2, [pi4dp1]
+    vfnmadd231pd zmm1, zmm2, [pi4dp2]
+    vfnmadd231pd zmm1, zmm2, [pi4dp3]
+
+    ; sin(x) = c13 * x^13 + ... + c3 * x^3 + x
+    ; cos(x) = c14 * x^14 + ... + c2 * x^2 + 1
+
+    vmovapd zmm14, [c14]
+    vmovapd zmm13, [c13]
+    vmovapd zmm10, [c10]
+    vmovapd zmm9,  [c9]
+    vmovapd zmm6,  [c6]
+    vmovapd zmm5,  [c5]
+    vmovapd zmm12, [c2]
+
+    vmulpd zmm2, zmm1, zmm1 ; x2 = x^2
+    vmulpd zmm3, zmm2, zmm1 ; x3 = x^3
+    vmulpd zmm4, zmm2, zmm2 ; x4 = x^4
+    vmulpd zmm7, zmm4, zmm3 ; x7 = x^7
+    vmulpd zmm8, zmm4, zmm4 ; x8 = x^8
+
+    vfmadd213pd zmm14, zmm2, [c12] ; u14 = c14 * x^2 + c12
+    vfmadd213pd zmm13, zmm2, [c11] ; u13 = c13 * x^2 + c11
+    vfmadd213pd zmm10, zmm2, [c8]  ; u10 = c10 * x^2 + c8
+    vfmadd213pd zmm9,  zmm2, [c7]  ; u9  = c9  * x^2 + c7
+    vfmadd213pd zmm6,  zmm2, [c4]  ; u6  = c6  * x^2 + c4
+    vfmadd213pd zmm5,  zmm2, [c3]  ; u5  = c5  * x^2 + c3
+    vfmadd213pd zmm12, zmm2, [c0]  ; u5  = c2  * x^2 + c0
+
+    vfmadd213pd zmm14, zmm4, zmm10 ; v14 = u14 * x^4 + u10
+    vfmadd213pd zmm13, zmm4, zmm9  ; v13 = u13 * x^4 + u9
+    vfmadd213pd zmm6,  zmm4, zmm12 ; v6  = u6  * x^4 + u5
+    vfmadd213pd zmm5,  zmm3, zmm1  ; v5  = u5  * x^3 + x
+
+    vfmadd213pd zmm14, zmm8, zmm6 ; z14 = v14 * x^8 + v6
+    vfmadd213pd zmm13, zmm7, zmm5 ; z13 = v13 * x^7 + v5
+
+    ; swap
+    vpmovsxdq zmm11, ymm11
+    vptestmq k1, zmm11, [dqtwo]
+%if %1 & 0x5 ; sin(a), tan(a)
+    vblendmpd zmm3{k1}, zmm13, zmm14
+%endif
+%if %1 & 0x6 ; cos(a), tan(a)
+    vblendmpd zmm4{k1}, zmm14, zmm13
+%endif
+
+    ; signs
+%if %1 & 0x5 ; sin(a), tan(a)
+    vpsllq zmm1, zmm11, 61
+    vpxorq zmm1, zmm1, zmm0
+    vpandq zmm1, zmm1, [smask]
+    vpxorq zmm13, zmm3, zmm1
+%endif
+%if %1 & 0x6 ; cos(a), tan(a)
+    vpaddq zmm1, zmm11, [dqtwo]
+    vpsllq zmm1, zmm1, 61
+    vpandq zmm1, zmm1, [smask]
+    vpxorq zmm14, zmm4, zmm1
+%endif
+%if %1 & 0x4 ; tan(a)
+    vdivpd zmm15, zmm13, zmm14
+%endif
+
+    vcmppd k1, zmm0, zmm0, 0x4 ; a != a
+    kortestw k1, k1
+    jz %%skip
+%if %1 & 0x1 ; sin(a)
+    vblendmpd zmm13{k1}, zmm13, zmm0
+%endif
+%if %1 & 0x2 ; cos(a)
+    vblendmpd zmm14{k1}, zmm14, zmm0
+%endif
+%if %1 & 0x4 ; tan(a)
+    vblendmpd zmm15{k1}, zmm15, zmm0
+%endif
+%%skip:
+%endmacro
+
+%macro sin_constants 0
+%endmacro
+
+%macro cos_constants 0
+%endmacro
+
+%macro sincos_constants 0
+%endmacro
+
+%macro tan_constants 0
+%endmacro
+
+%macro sin 2
+    vmovupd zmm0, %2
+    sincostan 0x1
+    vmovupd %1, zmm13
+%endmacro
+
+%macro cos 2
+    vmovupd zmm0, %2
+    sincostan 0x2
+    vmovupd %1, zmm14
+%endmacro
+
+%macro sincos 3
+    vmovupd zmm0, %3
+    sincostan 0x3
+    vmovupd %1, zmm13
+    vmovupd %2, zmm14
+%endmacro
+
+%macro tan 2
+    vmovupd zmm0, %2
+    sincostan 0x4
+    vmovupd %1, zmm15
+%endmacro
+
+section .rodata
+
+align 64
+
+nan_a: times 8 dq 0x7FEFFFFFFFFFFFFF ; DBL_MAX
+max_a: times 8 dq 0x41D921FB5411E920 ; 1686629712.279854
+nan_y: times 8 dq 0x7FF8000000000000 ; NaN
+
+c0:  times 8 dq 0x3FF0000000000000
+c1:  times 8 dq 0xBFE0000000000000
+c2:  times 8 dq 0xBFE0000000000000
+c3:  times 8 dq 0xBFC5555555555549
+c4:  times 8 dq 0x3FA555555555554C
+c5:  times 8 dq 0x3F8111111110F8A6
+c6:  times 8 dq 0xBF56C16C16C15177
+c7:  times 8 dq 0xBF2A01A019C161D5
+c8:  times 8 dq 0x3EFA01A019CB1590
+c9:  times 8 dq 0x3EC71DE357B1FE7D
+c10: times 8 dq 0xBE927E4F809C52AD
+c11: times 8 dq 0xBE5AE5E68A2B9CEB
+c12: times 8 dq 0x3E21EE9EBDB4B1C4
+c13: times 8 dq 0x3DE5D93A5ACFD57C
+c14: times 8 dq 0xBDA8FAE9BE8838D4
+
+ddmask: times 8 dd 0xFFFFFFFE ; ~1
+ddone:  times 8 dd 0x00000001 ; 1
+dqtwo:  times 8 dq 0x0000000000000002 ; 2
+
+pmask:  times 8 dq 0x7FFFFFFFFFFFFFFF ; abs(x)  = x & pmask
+smask:  times 8 dq 0x8000000000000000 ; sign(x) = x & smask
+pi4dp1: times 8 dq 0x3FE921FB50000000
+pi4dp2: times 8 dq 0x3E4110B460000000
+pi4dp3: times 8 dq 0x3C81A62633145C07
+pi4inv: times 8 dq 0x3FF45F306DC9C883 ; 4.0l / pi
+pi2:    times 8 dq 0x401921FB54442D18 ; 2 * pi
+pi2inv: times 8 dq 0x3FC45F306DC9C883 ; 1.0l / (2 * pi)
+pow253: times 8 dq 0x4340000000000000 ; 2^53
+max253: times 8 dq 0x434FFFFFFFFFFFFF ; 2^53 * 1.1...1b
+
+section .text
+
+mckl_vd512_sin:    math_kernel512_a1r1 8, sin
+mckl_vd512_cos:    math_kernel512_a1r1 8, cos
+mckl_vd512_sincos: math_kernel512_a1r2 8, sincos
+mckl_vd512_tan:    math_kernel512_a1r1 8, tan
+
+; vim:ft=nasm
@@ -0,0 +1,51 @@
+;;============================================================================
+;; MCKL/lib/asm/sqrt512.asm
+;;----------------------------------------------------------------------------
+;; MCKL: Monte Carlo Kernel Library
+;;----------------------------------------------------------------------------
+;; Copyright (c) 2013-2018, Yan Zhou
+;; All rights reserved.
+;;
+;; Redistribution and use in source and binary forms, with or without
+;; modification, are permitted provided that the following conditions are met:
+;;
+;;   Redistributions of source code must retain the above copyright notice,
+;;   this list of conditions and the following disclaimer.
+;;
+;;   Redistributions in binary form must reproduce the above copyright notice,
+;;   this list of conditions and the following disclaimer in the documentation
+;;   and/or other materials provided with the distribution.
+;;
+;; THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+;; AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+;; IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+;; ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+;; LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+;; CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+;; SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+;; INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+;; CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+;; ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+;; POSSIBILITY OF SUCH DAMAGE.
+;;============================================================================
+
+%include "/math512.asm"
+
+global mckl_vd512_sqrt
+
+default rel
+
+%macro sqrt_constants 0
+%endmacro
+
+%macro sqrt 2
+    vmovupd zmm0, %2
+    vsqrtpd zmm0, zmm0
+    vmovupd %1, zmm0
+%endmacro
+
+section .text
+
+mckl_vd512_sqrt: math_kernel512_a1r1 8, sqrt
+
+; vim:ft=nasm